@@ -1,7 +1,7 @@
 /****************************  cmdline.cpp  **********************************
 * Author:        Agner Fog
 * Date created:  2006-07-25
-* Last modified: 2017-04-14
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        cmdline.cpp
 * Description:
@@ -90,7 +90,11 @@ void CCommandLineInterpreter::ReadCommandLine(int argc, char * argv[]) {
     for (int i = 1; i < argc; i++) {
         ReadCommandItem(argv[i]);
     }
-    if (ShowHelp || (InputFile == 0 && OutputFile == 0) /* || !OutputType */) {
+    if (BatchFile && (InputFile || OutputFile)) {
+        // File names must be in batch file
+        err.submit(2109);
+    }
+    if (ShowHelp || (InputFile == 0 && OutputFile == 0 && BatchFile == 0) /* || !OutputType */) {
         // No useful command found. Print help
         Help();  ShowHelp = 1;
         return;
@@ -101,10 +105,12 @@ void CCommandLineInterpreter::ReadCommandLine(int argc, char * argv[]) {
         // Adding object files to library. Library may not exist
         FileOptions = CMDL_FILE_IN_IF_EXISTS;
     }
-    if (DumpOptions || ((LibraryOptions & CMDL_LIBRARY_EXTRACTMEM) && !(LibraryOptions & CMDL_LIBRARY_ADDMEMBER))) {
-        // Dumping or extracting. Output file not used
+    if (DumpOptions || ((LibraryOptions & (CMDL_LIBRARY_EXTRACTMEM | CMDL_LIBRARY_FINDSYMBOL)) && !(LibraryOptions & CMDL_LIBRARY_ADDMEMBER))) {
+        // Dumping, extracting or searching. Output file not used
         if (OutputFile) err.submit(1103); // Output file name ignored
         OutputFile = 0;
+        // JSON dump must have nothing but records on stdout
+        if (DumpOptions & DUMP_JSON) Verbose = CMDL_VERBOSE_NO;
     }
     else {
         // Output file required
@@ -296,7 +302,34 @@ void CCommandLineInterpreter::InterpretCommandOption(char * string) {
     case 'l': case 'L':   // Library option
         InterpretLibraryOption(string);  break;
 
-    case 'c':  // Count instruction codes supported
+    case 't': case 'T':   // Number of threads
+        InterpretThreadsOption(string);  break;
+
+    case 'b': case 'B':   // Batch file
+        if (strnicmp(string, "batch", 5) == 0) {
+            InterpretBatchOption(string);  break;
+        }
+        // Measure speed of instruction decoding
+        if (strcmp(string, "benchmark") == 0) {
+            Benchmark = 1;  break;
+        }
+        err.submit(1002, string);  break;
+
+    case 's': case 'S':   // Stream output
+        if (stricmp(string, "stream") == 0) {
+            StreamOutput = 1;  break;
+        }
+        // Report time and counters
+        if (stricmp(string, "stats") == 0) {
+            Stats = 1;  break;
+        }
+        err.submit(1002, string);  break;
+
+    case 'c': case 'C':   // Disassembly cache
+        if (strnicmp(string, "cache", 5) == 0) {
+            InterpretCacheOption(string);  break;
+        }
+        // Count instruction codes supported
         // This is an easter egg: You can only get it if you know it's there
         if (strncmp(string,"countinstructions", 17) == 0) {
             CDisassembler::CountInstructions();
@@ -388,6 +421,15 @@ void CCommandLineInterpreter::InterpretLibraryOption(char * string) {
         }
         break;
 
+    case 'f': case 'F':  // Find member that defines symbol
+        if (name1) {
+            cmd.LibraryOptions = CMDL_LIBRARY_FINDSYMBOL;
+            sym.Action  = SYMA_FIND_SYMBOL;
+            SymbolList.Push(&sym, sizeof(sym));
+        }
+        else err.submit(2004, string);
+        break;
+
     case 'd': case 'D':  // Delete member from library
         if (name1) {
             // Delete specified member
@@ -537,11 +579,13 @@ void CCommandLineInterpreter::InterpretDumpOption(char * string) {
             DumpOptions |= DUMP_STRINGTB;  break;
         case 'c': case 'C':  // dump comment records (currently only for OMF)
             DumpOptions |= DUMP_COMMENT;  break;         
+        case 'j': case 'J':  // machine-readable output, one JSON record per line
+            DumpOptions |= DUMP_JSON;  break;
         default:
             err.submit(2004, string-1);  // Unknown option
         }
     }
-    if (DumpOptions == 0) DumpOptions = DUMP_FILEHDR;
+    if ((DumpOptions & ~DUMP_JSON) == 0) DumpOptions |= DUMP_FILEHDR;
     OutputType = CMDL_OUTPUT_DUMP;
     if (OutputType && OutputType != CMDL_OUTPUT_DUMP) err.submit(2007); // Both dump and convert specified
     OutputType = CMDL_OUTPUT_DUMP;
@@ -793,6 +837,46 @@ void CCommandLineInterpreter::InterpretImagebaseOption(char * string) {
     }
 }
 
+void CCommandLineInterpreter::InterpretThreadsOption(char * string) {
+    // Interpret number of threads option: -threads:N
+    // Pass 2 of the disassembler is divided between N worker processes
+    char * p = string;
+    if (strnicmp(p, "threads", 7) != 0 || (p[7] != ':' && p[7] != '=')) {
+        err.submit(1002, string);  return;       // Unknown option
+    }
+    p += 8;
+    Threads = 0;
+    if (*p < '0' || *p > '9') {
+        err.submit(1002, string);  return;       // Number missing
+    }
+    while (*p >= '0' && *p <= '9') {
+        Threads = Threads * 10 + (*p++ - '0');
+        if (Threads > 1024) {
+            err.submit(1002, string);  return;   // Unreasonable number
+        }
+    }
+    if (*p) err.submit(1002, string);            // Garbage after number
+}
+
+void CCommandLineInterpreter::InterpretBatchOption(char * string) {
+    // Interpret batch file option: -batch:filename
+    // The file contains a list of input files and output files to convert with the same options
+    if (strnicmp(string, "batch", 5) != 0 || (string[5] != ':' && string[5] != '=') || string[6] <= ' ') {
+        err.submit(1002, string);  return;       // Unknown option or file name missing
+    }
+    if (BatchFile) err.submit(2017, string+6);   // Specified more than once
+    BatchFile = string + 6;
+}
+
+void CCommandLineInterpreter::InterpretCacheOption(char * string) {
+    // Interpret disassembly cache option: -cache:directory
+    // The disassembly of each section is saved in the directory and reused when unchanged
+    if (strnicmp(string, "cache", 5) != 0 || (string[5] != ':' && string[5] != '=') || string[6] <= ' ') {
+        err.submit(1002, string);  return;       // Unknown option or directory name missing
+    }
+    CacheDirectory = string + 6;
+}
+
 
 SSymbolChange const * CCommandLineInterpreter::GetMemberToAdd() {
     // Get names of object files to add to library
@@ -815,6 +899,17 @@ SSymbolChange const * CCommandLineInterpreter::GetMemberToAdd() {
 }
 
 
+char const * CCommandLineInterpreter::GetSymbolToFind(uint32 n) {
+    // Get name of n'th symbol to find in library with -lf option.
+    // Returns 0 if there are no more symbols to find
+    for (uint32 i = 0; i < SymbolList.GetDataSize(); i += sizeof(SSymbolChange)) {
+        SSymbolChange * Sym = (SSymbolChange *)(SymbolList.Buf() + i);
+        if (Sym->Action == SYMA_FIND_SYMBOL && n-- == 0) return Sym->Name1;
+    }
+    return 0;
+}
+
+
 void CCommandLineInterpreter::CheckExtractSuccess() {
     // Check if library members to extract were found
 
@@ -849,14 +944,154 @@ void CCommandLineInterpreter::CheckSymbolModifySuccess() {
 
 int CCommandLineInterpreter::SymbolIsInList(char const * name) {
     // Check if name is already in symbol list
-    int isym, nsym = SymbolList.GetNumEntries();
-    SSymbolChange * List = (SSymbolChange *)SymbolList.Buf(), * psym;
+    return FindSymbolName(name) >= 0;
+}
+
+
+// Index for searching SymbolList.
+// A response file may contain tens of thousands of symbol change commands, and
+// SymbolChange() is called for every symbol in the file. Names are found in a 
+// hash table. Prefixes are found in a trie, and suffixes in a trie of reversed 
+// names. The tries are stored as a hash table of edges. The index is updated 
+// when entries have been added to SymbolList.
+
+static inline uint32 SymbolNameHashKey(char const * name) {
+    // Hash function for NameHash (FNV-1a)
+    uint32 h = 0x811C9DC5u;
+    while (*name) h = (h ^ (uint8)*name++) * 0x01000193u;
+    return h ^ (h >> 15);
+}
 
-    // Search for name in list of names specified by user on command line
-    for (isym = 0, psym = List; isym < nsym; isym++, psym++) {
-        if (strcmp(name, psym->Name1) == 0) return 1;  // Matching name found
+static inline uint32 TrieEdgeHashKey(uint32 Node, uint32 Char) {
+    // Hash function for TrieEdges
+    uint32 h = Node * 0x9E3779B1u ^ Char * 0x85EBCA77u;
+    return h ^ (h >> 15);
+}
+
+uint32 CCommandLineInterpreter::TrieChild(uint32 node, uint32 c, int insert) {
+    // Find child of trie node for character c. Returns 0 if not found.
+    // Inserts a new child node if not found and insert = 1
+    uint32 h, Mask, i;
+    if (insert && TrieEntry.GetNumEntries() * 2 >= TrieEdges.GetNumEntries()) {
+        // Make hash table bigger. The number of edges is the number of nodes - 2
+        uint32 OldSize = TrieEdges.GetNumEntries();
+        uint32 NewSize = OldSize ? OldSize * 2 : 64;
+        CSList<SSymbolTrieEdge> Old;
+        for (i = 0; i < OldSize; i++) {
+            if (TrieEdges[i].Child) Old.Push(TrieEdges[i]);
+        }
+        TrieEdges.SetNum(0);  TrieEdges.SetNum(NewSize);
+        Mask = NewSize - 1;
+        for (i = 0; i < Old.GetNumEntries(); i++) {
+            h = TrieEdgeHashKey(Old[i].Node, Old[i].Char) & Mask;
+            while (TrieEdges[h].Child) h = (h + 1) & Mask; // Linear probing
+            TrieEdges[h] = Old[i];
+        }
     }
-    return 0;
+    if (TrieEdges.GetNumEntries() == 0) return 0;
+    Mask = TrieEdges.GetNumEntries() - 1;
+    h = TrieEdgeHashKey(node, c) & Mask;
+    while (TrieEdges[h].Child) {
+        if (TrieEdges[h].Node == node && TrieEdges[h].Char == c) return TrieEdges[h].Child; // Found
+        h = (h + 1) & Mask;
+    }
+    if (!insert) return 0;
+    // Make new node
+    TrieEdges[h].Node = node;
+    TrieEdges[h].Char = c;
+    TrieEdges[h].Child = TrieEntry.GetNumEntries();
+    TrieEntry.PushZero();
+    return TrieEdges[h].Child;
+}
+
+void CCommandLineInterpreter::UpdateSymbolIndex() {
+    // Add new SymbolList entries to NameHash and tries
+    uint32 i, h, Mask, node;
+    int    len;
+    uint32 n = SymbolList.GetNumEntries();        // Number of entries in SymbolList
+    SSymbolChange * List = (SSymbolChange *)SymbolList.Buf();
+    if (SymbolIndexNum == n) return;              // Index is up to date
+
+    // Make hash table of names
+    if (NameHash.GetNumEntries() < n * 2) {
+        // Hash table is too small. Make new hash table of all names
+        uint32 HashSize = 16;                     // Size of hash table. Must be a power of 2
+        while (HashSize < n * 4) HashSize <<= 1;
+        NameHash.SetNum(0);  NameHash.SetNum(HashSize);
+        SymbolIndexNum = 0;  TrieEntry.SetNum(0);  TrieEdges.SetNum(0);
+    }
+    Mask = NameHash.GetNumEntries() - 1;
+    for (i = SymbolIndexNum; i < n; i++) {
+        if (List[i].Name1 == 0) continue;
+        h = SymbolNameHashKey(List[i].Name1) & Mask;
+        while (NameHash[h]) {
+            if (strcmp(List[NameHash[h]-1].Name1, List[i].Name1) == 0) break; // Duplicate. Keep first
+            h = (h + 1) & Mask;               // Linear probing
+        }
+        if (NameHash[h] == 0) NameHash[h] = i + 1;
+    }
+
+    // Put prefix and suffix entries into tries
+    if (TrieEntry.GetNumEntries() == 0) TrieEntry.SetNum(2); // Root nodes
+    for (i = SymbolIndexNum; i < n; i++) {
+        if (List[i].Name1 == 0) continue;
+        switch (List[i].Action & ~SYMA_ALIAS) {
+        case SYMA_CHANGE_PREFIX:
+            for (node = 0, len = 0; List[i].Name1[len]; len++) {
+                node = TrieChild(node, (uint8)List[i].Name1[len], 1);
+            }
+            break;
+        case SYMA_CHANGE_SUFFIX:
+            node = 1;
+            for (len = (int)strlen(List[i].Name1) - 1; len >= 0; len--) {
+                node = TrieChild(node, (uint8)List[i].Name1[len], 1);
+            }
+            break;
+        default:
+            continue;
+        }
+        if (TrieEntry[node] == 0) TrieEntry[node] = i + 1; // First entry with this prefix or suffix
+    }
+    SymbolIndexNum = n;
+}
+
+int CCommandLineInterpreter::FindSymbolName(char const * name) {
+    // Find SymbolList entry with this name. Returns index or -1 if not found
+    uint32 h, Mask;
+    SSymbolChange * List = (SSymbolChange *)SymbolList.Buf();
+    if (name == 0 || SymbolList.GetNumEntries() == 0) return -1;
+    UpdateSymbolIndex();
+    Mask = NameHash.GetNumEntries() - 1;
+    h = SymbolNameHashKey(name) & Mask;
+    while (NameHash[h]) {
+        if (strcmp(List[NameHash[h]-1].Name1, name) == 0) return NameHash[h] - 1; // Found
+        h = (h + 1) & Mask;
+    }
+    return -1;                                    // Not found
+}
+
+int CCommandLineInterpreter::FindSymbolEntry(char const * name) {
+    // Find the first SymbolList entry that has this name, or is a prefix or suffix 
+    // entry matching the beginning or end of name. Returns index or -1 if none
+    uint32 node;                                  // Trie node
+    int    len;                                   // Position in name
+    int    i = FindSymbolName(name);              // Entry with exact name
+    uint32 First = i >= 0 ? i + 1 : 0xFFFFFFFF;   // First matching entry + 1
+    if (i < 0 && SymbolList.GetNumEntries() == 0) return -1;
+
+    // Search for prefix entries that match the beginning of name
+    for (node = 0, len = 0; name[len]; len++) {
+        node = TrieChild(node, (uint8)name[len], 0);
+        if (node == 0) break;                     // No longer prefix
+        if (TrieEntry[node] && TrieEntry[node] < First) First = TrieEntry[node];
+    }
+    // Search for suffix entries that match the end of name
+    for (node = 1, len = (int)strlen(name) - 1; len >= 0; len--) {
+        node = TrieChild(node, (uint8)name[len], 0);
+        if (node == 0) break;                     // No longer suffix
+        if (TrieEntry[node] && TrieEntry[node] < First) First = TrieEntry[node];
+    }
+    return First == 0xFFFFFFFF ? -1 : (int)First - 1;
 }
 
 
@@ -901,16 +1136,12 @@ int CCommandLineInterpreter::SymbolChange(char const * oldname, char const ** ne
     static char NameBuffer[MAXSYMBOLLENGTH];
 
     SSymbolChange * List = (SSymbolChange *)SymbolList.Buf(), * psym;
-    // search for name in list of names specified by user on command line
-    for (isym = 0, psym = List; isym < nsym; isym++, psym++) {
-        if (strcmp(oldname, psym->Name1) == 0) break;  // Matching name found
-        int n1len = (int)strlen(psym->Name1); // Length of string to search for
-        int onlen = (int)strlen(oldname);     // Length of string to match
-        if ((psym->Action&~SYMA_ALIAS) == SYMA_CHANGE_PREFIX && strncmp(oldname, psym->Name1, n1len)==0) break; // matching prefix found
-        if ((psym->Action&~SYMA_ALIAS) == SYMA_CHANGE_SUFFIX && strcmp(oldname+onlen-n1len, psym->Name1)==0) break; // matching suffix found
-    }
-    if (isym < nsym) {
+    // search for name in list of names specified by user on command line.
+    // The first entry with a matching name, prefix or suffix is used
+    isym = nsym ? FindSymbolEntry(oldname) : -1;
+    if (isym >= 0) {
         // A matching name was found.
+        psym = List + isym;
         action = psym->Action;
         // Whatever action is specified here is overriding any general option
         // Statistics counting
@@ -1122,6 +1353,33 @@ int CCommandLineInterpreter::SymbolChangesRequested() {
 }
 
 
+uint32 CCommandLineInterpreter::NumStatistics() {
+    // Number of statistics counters. Used for transferring statistics from worker processes
+    return 12 + SymbolList.GetNumEntries();
+}
+
+
+int & CCommandLineInterpreter::Statistic(uint32 i) {
+    // Access statistics counter number i. 
+    // Counters 0-11 are the Count... counters. The rest are the Done counters of SymbolList entries
+    switch (i) {
+    case 0: return CountUnderscoreConversions;
+    case 1: return CountSectionDotConversions;
+    case 2: return CountSymbolNameChanges;
+    case 3: return CountSymbolNameAliases;
+    case 4: return CountSymbolsWeakened;
+    case 5: return CountSymbolsMadeLocal;
+    case 6: return CountUnusedSymbolsHidden;
+    case 7: return CountDebugSectionsRemoved;
+    case 8: return CountExceptionSectionsRemoved;
+    case 9: return CountInstructions;
+    case 10: return CountSymbols;
+    case 11: return CountRelocations;
+    }
+    return ((SSymbolChange *)SymbolList.Buf() + (i - 12))->Done;
+}
+
+
 void CCommandLineInterpreter::CountDebugRemoved() {
     // Count debug sections removed
     CountDebugSectionsRemoved++;
@@ -1140,6 +1398,116 @@ void CCommandLineInterpreter::CountSymbolsHidden() {
 }
 
 
+void CCommandLineInterpreter::CountDisassembly(uint32 Instructions, uint32 Symbols, uint32 Relocations) {
+    // Add to counters of instructions decoded and disassembler table sizes
+    CountInstructions += Instructions;
+    CountSymbols += Symbols;
+    CountRelocations += Relocations;
+}
+
+
+// Names of phase timers
+static char const * PhaseNames[STAT_PHASES] = {
+    "Read file", "Parse file", "Symbol tables", "Disassembly pass 1", 
+    "Disassembly pass 2", "Write file"
+};
+
+static double WallClock() {
+    // Elapsed time in seconds from an arbitrary starting point
+#if defined(CLOCK_MONOTONIC)
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1E-9;
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+
+uint32 CCommandLineInterpreter::FindTimer(char const * Name) {
+    // Find or make timer for converter class. Returns timer index
+    uint32 t;
+    if (NumTimers < STAT_PHASES) NumTimers = STAT_PHASES;
+    for (t = STAT_PHASES; t < NumTimers; t++) {
+        if (strcmp(Timers[t].Name, Name) == 0) return t;
+    }
+    if (NumTimers >= STAT_MAXTIMERS) return STAT_MAXTIMERS - 1;  // Table full. Should not occur
+    Timers[t].Name = Name;
+    return NumTimers++;
+}
+
+
+void CCommandLineInterpreter::StartTimer(uint32 Timer) {
+    // Start timer for -stats option
+    if (Timer >= STAT_MAXTIMERS) return;
+    Timers[Timer].Start = WallClock();
+    Timers[Timer].Running = 1;
+    Timers[Timer].Count++;
+}
+
+
+void CCommandLineInterpreter::StopTimer(uint32 Timer) {
+    // Stop timer and add the time since it was started
+    if (Timer >= STAT_MAXTIMERS || !Timers[Timer].Running) return;
+    Timers[Timer].Total += WallClock() - Timers[Timer].Start;
+    Timers[Timer].Running = 0;
+}
+
+
+double CCommandLineInterpreter::GetTime(uint32 Timer) {
+    // Get total time of timer, not including time since it was started
+    return Timer < STAT_MAXTIMERS ? Timers[Timer].Total : 0.;
+}
+
+
+void CCommandLineInterpreter::AddTime(uint32 Timer, double t) {
+    // Add time measured by worker process to timer
+    if (Timer < STAT_MAXTIMERS) Timers[Timer].Total += t;
+}
+
+
+void CCommandLineInterpreter::ReportTimes() {
+    // Report time used by each phase and converter class, and counters, for -stats option.
+    // The time for a converter class includes the phases it does.
+    // Instructions decoded counts the instructions written in pass 2, including those
+    // written by worker processes with -threads
+    uint32 t;                                     // Timer index
+    char const * Name;                            // Timer name
+    if (DumpOptions & DUMP_JSON) {
+        // Machine-readable report. One record for each timer. Times in microseconds
+        CJsonLineWriter json;
+        for (t = 0; t < NumTimers || t < STAT_PHASES; t++) {
+            if (Timers[t].Count == 0) continue;
+            json.Begin("timer");
+            json.Str("name", t < STAT_PHASES ? PhaseNames[t] : Timers[t].Name);
+            json.Bool("phase", t < STAT_PHASES);
+            json.UInt("count", Timers[t].Count);
+            json.UInt("microseconds", (uint64)(Timers[t].Total * 1E6 + 0.5));
+            json.End();
+        }
+        json.Begin("counters");
+        json.UInt("instructions", (uint32)CountInstructions);
+        json.UInt("symbols", (uint32)CountSymbols);
+        json.UInt("relocations", (uint32)CountRelocations);
+        json.UInt("allocations", CMemoryBuffer::Statistics.NumAllocations);
+        json.UInt("bytes_allocated", CMemoryBuffer::Statistics.BytesAllocated);
+        json.End();
+        return;
+    }
+    printf("\n\nPhase                     seconds  count");
+    for (t = 0; t < NumTimers || t < STAT_PHASES; t++) {
+        if (t == STAT_PHASES) printf("\nConverter class");
+        if (Timers[t].Count == 0) continue;
+        Name = t < STAT_PHASES ? PhaseNames[t] : Timers[t].Name;
+        printf("\n  %-20s %10.4f %6u", Name, Timers[t].Total, Timers[t].Count);
+    }
+    printf("\nInstructions decoded: %10u", (uint32)CountInstructions);
+    printf("\nSymbols:              %10u", (uint32)CountSymbols);
+    printf("\nRelocations:          %10u", (uint32)CountRelocations);
+    CMemoryBuffer::ReportStatistics();
+}
+
+
 void CCommandLineInterpreter::ReportStatistics() {
     // Report statistics about name changes etc.
     if (DebugInfo == CMDL_DEBUG_STRIP || ExeptionInfo == CMDL_EXCEPTION_STRIP 
@@ -1191,11 +1559,19 @@ void CCommandLineInterpreter::Help() {
     printf("\n\nOptions:");
     printf("\n-fXXX[SS]  Output file format XXX, word size SS. Supported formats:");
     printf("\n           PE, COFF, ELF, OMF, MACHO\n");
-    printf("\n-fasm      Disassemble file (-fmasm, -fnasm, -fyasm, -fgasm)\n");
+    printf("\n-fasm      Disassemble file (-fmasm, -fnasm, -fyasm, -fgasm)");
+    printf("\n-threads:N Use N worker processes for disassembly, library or batch conversion.");
+    printf("\n-stream    Write disassembly to output file while disassembling.");
+    printf("\n-cache:D   Save disassembly of each section in directory D and reuse it");
+    printf("\n           for sections that have not changed.");
+    printf("\n-stats     Report time used by each phase and converter class, and counters.");
+    printf("\n-batch:F   Convert all files listed in file F. Each line has an input");
+    printf("\n           file name and optionally an output file name.\n");
     printf("\n-dXXX      Dump file contents to console.");
     printf("\n           Values of XXX (can be combined):");
     printf("\n           f: File header, h: section Headers, s: Symbol table,");
-    printf("\n           r: Relocation table, n: string table.\n");
+    printf("\n           r: Relocation table, n: string table.");
+    printf("\n           j: write records as JSON Lines, one object per line.\n");
 
     printf("\n-nu        change symbol Name Underscores to the default for the target format.");
     printf("\n-nu-       remove Underscores from symbol Names.");
@@ -1216,6 +1592,7 @@ void CCommandLineInterpreter::Help() {
 
     printf("\n-lx        eXtract all members from Library.");
     printf("\n-lx:N1:N2  eXtract member N1 from Library to file N2.");
+    printf("\n-lf:S      Find which member of Library defines symbol S.");
     printf("\n-ld:N1     Delete member N1 from Library.");
     printf("\n-la:N1:N2  Add object file N1 to Library as member N2.");
     printf("\n           Alternative: -lib LIBRARYNAME OBJECTFILENAMES.\n");
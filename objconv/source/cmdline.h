@@ -1,7 +1,7 @@
 /****************************  cmdline.h   ***********************************
 * Author:        Agner Fog
 * Date created:  2006-07-25
-* Last modified: 2006-07-25
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        cmdline.h
 * Description:
@@ -42,6 +42,7 @@
 #define DUMP_RELTAB             0x0020     // Dump relocation table
 #define DUMP_STRINGTB           0x0040     // Dump string table
 #define DUMP_COMMENT            0x0080     // Dump comment records
+#define DUMP_JSON               0x1000     // Write dump as JSON Lines records instead of text
 
 // Constants for stripping or converting debug information from file
 #define CMDL_DEBUG_DEFAULT           0     // Remove if output is different format
@@ -74,6 +75,7 @@
 #define CMDL_LIBRARY_ADDMEMBER       2     // Add object file to library
 #define CMDL_LIBRARY_EXTRACTMEM  0x100     // Extract specified object file(s) from library
 #define CMDL_LIBRARY_EXTRACTALL  0x110     // Extract all object files from library
+#define CMDL_LIBRARY_FINDSYMBOL  0x200     // Find library members that define specified symbols
 
 // Constants for file input/output options
 #define CMDL_FILE_INPUT              1     // Input file required
@@ -104,6 +106,26 @@
 #define SYMA_ADD_MEMBER         0x1001     // Add member to library
 #define SYMA_DELETE_MEMBER      0x1002     // Remove member from library
 #define SYMA_EXTRACT_MEMBER     0x1004     // Extract member from library
+#define SYMA_FIND_SYMBOL        0x1008     // Find library member that defines symbol
+
+// Timers for -stats option. The first timers measure phases of the conversion
+#define STAT_READ                    0     // Read input file
+#define STAT_PARSE                   1     // Parse file headers
+#define STAT_SYMBOLS                 2     // Make symbol and relocation tables for disassembler
+#define STAT_PASS1                   3     // Disassembler pass 1
+#define STAT_PASS2                   4     // Disassembler pass 2
+#define STAT_WRITE                   5     // Write output file
+#define STAT_PHASES                  6     // Number of phase timers. Timers for converter classes follow
+#define STAT_MAXTIMERS              48     // Maximum number of timers
+
+// Timer for -stats option
+struct SStatTimer {
+   char const * Name;                      // Name of phase or converter class
+   double Total;                           // Total time, seconds
+   double Start;                           // Time when started
+   uint32 Count;                           // Number of times started
+   int    Running;                         // Timer has been started and not stopped
+};
 
 // Structure for specifying desired change of a specific symbol
 struct SSymbolChange {
@@ -113,6 +135,13 @@ struct SSymbolChange {
    int    Done;                            // Count how many times this has been done
 };
 
+// Edge in the prefix and suffix tries that index SymbolList. Stored in a hash table
+struct SSymbolTrieEdge {
+   uint32 Node;                            // Parent node
+   uint32 Char;                            // Character
+   uint32 Child;                           // Child node. 0 = vacant entry in hash table
+};
+
 // Class for interpreting command line
 class CCommandLineInterpreter {
 public:
@@ -126,7 +155,17 @@ public:
    void CountDebugRemoved();                 // Increment CountDebugSectionsRemoved
    void CountExceptionRemoved();             // Increment CountExceptionSectionsRemoved
    void CountSymbolsHidden();                // Increment CountUnusedSymbolsHidden
+   uint32 NumStatistics();                   // Number of statistics counters, including Done counters in SymbolList
+   int &  Statistic(uint32 i);               // Access statistics counter number i
+   void CountDisassembly(uint32 Instructions, uint32 Symbols, uint32 Relocations); // Add to disassembly counters for -stats
+   uint32 FindTimer(char const * Name);      // Find or make timer for converter class
+   void StartTimer(uint32 Timer);            // Start timer for -stats option
+   void StopTimer(uint32 Timer);             // Stop timer and add time
+   double GetTime(uint32 Timer);             // Get total time of timer
+   void AddTime(uint32 Timer, double t);     // Add time measured by worker process to timer
+   void ReportTimes();                       // Report time and counters for -stats option
    SSymbolChange const * GetMemberToAdd();   // Get names of object files to add to library
+   char const * GetSymbolToFind(uint32 n);   // Get name of n'th symbol to find in library
    void CheckExtractSuccess();               // Check if library members to extract were found
    void CheckSymbolModifySuccess();          // Check if symbols to modify were found
    char * InputFile;                         // Input file name
@@ -146,6 +185,14 @@ public:
    uint32 LibrarySubtype;                    // Options for manipulating library
    uint32 FileOptions;                       // Options for input and output files
    uint32 ImageBase;                         // Specified image base
+   uint32 Threads;                           // Number of worker processes for disassembly or library conversion. 0 or 1 = none
+   uint32 Benchmark;                         // Measure speed of instruction decoding after disassembly
+   char * BatchFile;                         // File listing input and output files for batch mode
+   uint32 StreamOutput;                      // Write disassembly to output file in chunks during disassembly
+   uint32 OutputStreamed;                    // Output written by streaming to StreamFileName. Main renames it to the output file
+   char   StreamFileName[MAXFILENAMELENGTH+8]; // Temporary file name used by -stream
+   char * CacheDirectory;                    // Directory for disassembly cache files, or 0
+   uint32 Stats;                             // Report time used by each phase and converter class
    int    ShowHelp;                          // Help screen printed
 protected:
    int  libmode;                             // -lib option has been encountered
@@ -162,6 +209,9 @@ protected:
    void InterpretSymbolNameChangeOption(char *);  // Interpret various options for changing symbol names
    void InterpretLibraryOption(char *);      // Interpret options for manipulating library/archive files
    void InterpretImagebaseOption(char *);    // Interpret image base option
+   void InterpretThreadsOption(char *);      // Interpret number of threads option
+   void InterpretBatchOption(char *);        // Interpret batch file option
+   void InterpretCacheOption(char *);        // Interpret disassembly cache option
    void AddObjectToLibrary(char * filename, char * membername); // Add object file to library
    void Help();                              // Print help message
    CArrayBuf<CFileBuffer> ResponseFiles;     // Array of up to 10 response file buffers
@@ -171,6 +221,15 @@ protected:
    CMemoryBuffer MemberNames;                // Buffer containing truncated member names
    uint32 MemberNamesAllocated;              // Size of buffer in MemberNames
    uint32 CurrentSymbol;                     // Pointer into SymbolList
+   // Index for searching SymbolList in time proportional to the length of the name
+   CSList<uint32> NameHash;                  // Hash table of names in SymbolList. Value is index + 1. 0 = vacant
+   CSList<uint32> TrieEntry;                 // Index + 1 of first prefix or suffix entry ending at each trie node
+   CSList<SSymbolTrieEdge> TrieEdges;        // Hash table of edges in prefix trie (root node 0) and reversed suffix trie (root node 1)
+   uint32 SymbolIndexNum;                    // Number of SymbolList entries in index
+   void UpdateSymbolIndex();                 // Add new SymbolList entries to index
+   int  FindSymbolName(char const * name);   // Find SymbolList entry with this name. Returns index or -1
+   int  FindSymbolEntry(char const * name);  // Find first SymbolList entry that matches name, prefix or suffix. Returns index or -1
+   uint32 TrieChild(uint32 node, uint32 c, int insert); // Find or insert child node in trie
    // Statistics counters
    int CountUnderscoreConversions;           // Count number of times symbol leading underscores are changed
    int CountSectionDotConversions;           // Count number of times leading character is changed on section names
@@ -181,8 +240,32 @@ protected:
    int CountUnusedSymbolsHidden;             // Count number of times unused symbols are hidden
    int CountDebugSectionsRemoved;            // Count number of debug sections removed
    int CountExceptionSectionsRemoved;        // Count number of exception handler sections removed
+   int CountInstructions;                    // Count number of instructions decoded by disassembler
+   int CountSymbols;                         // Count number of symbols in disassembler symbol tables
+   int CountRelocations;                     // Count number of relocations in disassembler relocation tables
+   SStatTimer Timers[STAT_MAXTIMERS];        // Timers for -stats option
+   uint32 NumTimers;                         // Number of timers for converter classes used, including phases
 };
 
 extern CCommandLineInterpreter cmd;          // Command line interpreter
 
+// Measures the time from construction to destruction with one of the timers in cmd 
+// if the -stats option is specified
+class CStatTimer {
+public:
+   CStatTimer(uint32 t) {                    // Start phase timer
+      Timer = t;
+      if (cmd.Stats) cmd.StartTimer(Timer);
+   }
+   CStatTimer(char const * ClassName) {      // Start timer for converter class
+      Timer = cmd.Stats ? cmd.FindTimer(ClassName) : 0;
+      if (cmd.Stats) cmd.StartTimer(Timer);
+   }
+   ~CStatTimer() {                           // Stop timer
+      if (cmd.Stats) cmd.StopTimer(Timer);
+   }
+protected:
+   uint32 Timer;                             // Timer index
+};
+
 #endif // #ifndef CMDLINE_H
@@ -1,7 +1,7 @@
 /****************************  cof2asm.cpp   ********************************
 * Author:        Agner Fog
 * Date created:  2007-02-25
-* Last modified: 2009-12-20
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        cof2asm.cpp
 * Description:
@@ -17,6 +17,7 @@ CCOF2ASM::CCOF2ASM () {
 
 void CCOF2ASM::Convert() {
    // Do the conversion
+   if (cmd.Stats) cmd.StartTimer(STAT_SYMBOLS);  // Time until Disasm.Go() begins pass 1
    if (ImageBase) Disasm.Init(2, ImageBase);     // Executable file or DLL. Set image base
    MakeSectionList();                            // Make Sections list and Relocations list in Disasm
    MakeSymbolList();                             // Make Symbols list in Disasm
@@ -1,7 +1,7 @@
 /****************************   coff.cpp   ***********************************
 * Author:        Agner Fog
 * Date created:  2006-07-15
-* Last modified: 2009-01-22
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        coff.cpp
 * Description:
@@ -170,6 +170,7 @@ CCOFF::CCOFF() {
 
 void CCOFF::ParseFile(){
    // Load and parse file buffer
+   CStatTimer Timer(STAT_PARSE);       // Measure time if -stats option
    // Get offset to file header
    uint32 FileHeaderOffset = 0;
    if ((Get<uint16>(0) & 0xFFF9) == 0x5A49) {
@@ -244,6 +245,10 @@ void CCOFF::ParseFile(){
 void CCOFF::Dump(int options) {
    uint32 i, j;
 
+   if (options & DUMP_JSON) {
+      DumpJson(options);  return;      // Machine-readable dump
+   }
+
    if (options & DUMP_FILEHDR) {
       // File header
       printf("\nDump of PE/COFF file %s", FileName);
@@ -415,6 +420,152 @@ void CCOFF::Dump(int options) {
 }
 
 
+void CCOFF::DumpJson(int options) {
+   // Dump file as JSON Lines records, one record per line.
+   // Field names are the names of the COFF structure fields in coff.h.
+   // Fields ending in _name are the same texts as in the text dump
+   CJsonLineWriter json;
+   uint32 i, j;
+
+   if (options & DUMP_FILEHDR) {
+      // File header
+      json.Begin("header");
+      json.UInt("Machine", FileHeader->Machine);
+      json.Str("Machine_name", Lookup(COFFMachineNames, FileHeader->Machine));
+      json.UInt("TimeDateStamp", FileHeader->TimeDateStamp);
+      json.UInt("NumberOfSections", FileHeader->NumberOfSections);
+      json.UInt("NumberOfSymbols", FileHeader->NumberOfSymbols);
+      json.UInt("PSymbolTable", FileHeader->PSymbolTable);
+      json.UInt("SizeOfOptionalHeader", FileHeader->SizeOfOptionalHeader);
+      json.UInt("Flags", FileHeader->Flags);
+      json.End();
+
+      if (OptionalHeader) {
+         // Optional header of executable file
+         json.Begin("optional_header");
+         if (OptionalHeader->h32.Magic != COFF_Magic_PE64) {
+            json.UInt("Magic", OptionalHeader->h32.Magic);
+            json.UInt("SizeOfCode", OptionalHeader->h32.SizeOfCode);
+            json.UInt("AddressOfEntryPoint", OptionalHeader->h32.AddressOfEntryPoint);
+            json.UInt("BaseOfCode", OptionalHeader->h32.BaseOfCode);
+            json.UInt("ImageBase", OptionalHeader->h32.ImageBase);
+            json.UInt("SectionAlignment", OptionalHeader->h32.SectionAlignment);
+            json.UInt("FileAlignment", OptionalHeader->h32.FileAlignment);
+            json.UInt("SizeOfImage", OptionalHeader->h32.SizeOfImage);
+            json.UInt("SizeOfHeaders", OptionalHeader->h32.SizeOfHeaders);
+            json.UInt("DllCharacteristics", OptionalHeader->h32.DllCharacteristics);
+         }
+         else {
+            json.UInt("Magic", OptionalHeader->h64.Magic);
+            json.UInt("SizeOfCode", OptionalHeader->h64.SizeOfCode);
+            json.UInt("AddressOfEntryPoint", OptionalHeader->h64.AddressOfEntryPoint);
+            json.UInt("BaseOfCode", OptionalHeader->h64.BaseOfCode);
+            json.UInt("ImageBase", OptionalHeader->h64.ImageBase);
+            json.UInt("SectionAlignment", OptionalHeader->h64.SectionAlignment);
+            json.UInt("FileAlignment", OptionalHeader->h64.FileAlignment);
+            json.UInt("SizeOfImage", OptionalHeader->h64.SizeOfImage);
+            json.UInt("SizeOfHeaders", OptionalHeader->h64.SizeOfHeaders);
+            json.UInt("DllCharacteristics", OptionalHeader->h64.DllCharacteristics);
+         }
+         json.End();
+
+         // Data directories
+         SCOFF_ImageDirAddress dir;
+         for (i = 0; i < NumImageDirs; i++) {
+            if (GetImageDir(i, &dir)) {
+               json.Begin("directory");
+               json.Int("index", i);
+               json.Str("name", dir.Name);
+               json.UInt("VirtualAddress", dir.VirtualAddress);
+               json.UInt("Size", dir.Size);
+               json.Int("section", dir.Section);
+               json.UInt("offset", dir.SectionOffset);
+               json.End();
+            }
+         }
+      }
+   }
+
+   if ((options & DUMP_STRINGTB) && FileHeader->PSymbolTable && StringTableSize > 4) {
+      // String table. Offsets are relative to the start of the table
+      uint32 len;
+      for (i = 4; i < StringTableSize; i += len + 1) {
+         len = (uint32)strnlen(StringTable + i, StringTableSize - i);
+         json.Begin("string");
+         json.UInt("offset", i);
+         json.Str("value", StringTable + i, len);
+         json.End();
+      }
+   }
+
+   if ((options & DUMP_SYMTAB) && NumberOfSymbols) {
+      // Symbol table. Auxiliary entries are counted in the index but not dumped
+      SCOFF_SymTableEntry * sym;
+      for (i = 0; i < (uint32)NumberOfSymbols; i += 1 + sym->s.NumAuxSymbols) {
+         sym = (SCOFF_SymTableEntry*)((int8*)SymbolTable + i * SIZE_SCOFF_SymTableEntry);
+         json.Begin("symbol");
+         json.Int("index", i);
+         json.Str("name", GetSymbolName(sym->s.Name));
+         json.UInt("Value", sym->s.Value);
+         json.Int("SectionNumber", sym->s.SectionNumber);
+         json.UInt("Type", sym->s.Type);
+         json.UInt("StorageClass", sym->s.StorageClass);
+         json.Str("StorageClass_name", GetStorageClassName(sym->s.StorageClass));
+         json.UInt("NumAuxSymbols", sym->s.NumAuxSymbols);
+         if (sym->s.StorageClass == COFF_CLASS_FILE && sym->s.NumAuxSymbols > 0) {
+            json.Str("file", GetFileName(sym));
+         }
+         json.End();
+      }
+   }
+
+   if (options & (DUMP_SECTHDR | DUMP_RELTAB)) {
+      // Section headers and relocations
+      for (j = 0; j < (uint32)NSections; j++) {
+         SCOFF_SectionHeader * SectionHeader = &SectionHeaders[j];
+         if (options & DUMP_SECTHDR) {
+            json.Begin("section");
+            json.Int("index", j+1);
+            json.Str("name", GetSectionName(SectionHeader->Name));
+            json.UInt("VirtualSize", SectionHeader->VirtualSize);
+            json.UInt("VirtualAddress", SectionHeader->VirtualAddress);
+            json.UInt("SizeOfRawData", SectionHeader->SizeOfRawData);
+            json.UInt("PRawData", SectionHeader->PRawData);
+            json.UInt("PRelocations", SectionHeader->PRelocations);
+            json.UInt("NRelocations", SectionHeader->NRelocations);
+            json.UInt("PLineNumbers", SectionHeader->PLineNumbers);
+            json.UInt("NLineNumbers", SectionHeader->NLineNumbers);
+            json.UInt("Flags", SectionHeader->Flags);
+            json.End();
+         }
+         if ((options & DUMP_RELTAB) && SectionHeader->NRelocations > 0) {
+            if (SectionHeader->PRelocations + (uint32)SectionHeader->NRelocations * SIZE_SCOFF_Relocation > GetDataSize()) {
+               err.submit(2035);  continue;
+            }
+            for (i = 0; i < SectionHeader->NRelocations; i++) {
+               SCOFF_Relocation * Reloc = (SCOFF_Relocation*)(Buf() + SectionHeader->PRelocations + i * SIZE_SCOFF_Relocation);
+               json.Begin("relocation");
+               json.Int("section", j+1);
+               json.Int("index", i);
+               json.UInt("VirtualAddress", Reloc->VirtualAddress);
+               json.UInt("SymbolTableIndex", Reloc->SymbolTableIndex);
+               if (Reloc->SymbolTableIndex < (uint32)NumberOfSymbols) {
+                  json.Str("symbol", GetSymbolName(((SCOFF_SymTableEntry*)((int8*)SymbolTable + Reloc->SymbolTableIndex * SIZE_SCOFF_SymTableEntry))->s.Name));
+               }
+               json.UInt("Type", Reloc->Type);
+               json.Str("Type_name", (WordSize == 32) ? Lookup(COFF32RelNames, Reloc->Type) : Lookup(COFF64RelNames, Reloc->Type));
+               if (Reloc->Type < COFF32_RELOC_SEG12 
+               && (uint64)SectionHeader->PRawData + Reloc->VirtualAddress + 4 <= GetDataSize()) {
+                  json.Int("inline_addend", Get<int32>(SectionHeader->PRawData + Reloc->VirtualAddress));
+               }
+               json.End();
+            }
+         }
+      }
+   }
+}
+
+
 char const * CCOFF::GetSymbolName(int8* Symbol) {
    // Get symbol name from 8 byte entry
    static char text[16];
@@ -1,7 +1,7 @@
 /****************************  containers.cpp  **********************************
 * Author:        Agner Fog
 * Date created:  2006-07-15
-* Last modified: 2016-07-07
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        containers.cpp
 * Description:
@@ -38,10 +38,13 @@ SIntTxt FileFormatNames[] = {
 
 
 // Members of class CMemoryBuffer
+SMemoryStatistics CMemoryBuffer::Statistics;     // Allocation statistics for all buffers
+
 CMemoryBuffer::CMemoryBuffer() {  
     // Constructor
     buffer = 0;
-    NumEntries = DataSize = BufferSize = 0;
+    NumEntries = DataSize = BufferSize = ZeroedSize = 0;
+    Mapped = 0;
 }
 
 CMemoryBuffer::~CMemoryBuffer() {
@@ -57,33 +60,76 @@ void CMemoryBuffer::SetSize(uint32 size) {
     // Setting size = 0 will discard all data and de-allocate the buffer.
     if (size == 0) {
         // Deallocate
-        if (buffer) delete[] buffer;     // De-allocate buffer
-        buffer = 0;
-        NumEntries = DataSize = BufferSize = 0;
+        Deallocate();                    // De-allocate buffer
+        NumEntries = DataSize = BufferSize = ZeroedSize = 0;
         return;
     }
     if (size < DataSize) {
         // Request to delete some data
         DataSize = size;
+        if (ZeroedSize > size) ZeroedSize = size;
         return;
     }
-    if (size <= BufferSize) {
-        // Request to reduce size but not delete it
-        return;                          // Ignore
+    if (size > BufferSize) {
+        // Allocate more
+        if (!Grow(size)) return;
     }
-//  size = (size + 15) & uint32(-16);   // Round up size to value divisible by 16
-    size = (size + BufferSize + 15) & uint32(-16);   // Double size and round up to value divisible by 16
-    int8 * buffer2 = 0;                 // New buffer
-    buffer2 = new int8[size];           // Allocate new buffer
-    if (buffer2 == 0) {err.submit(9006); return;} // Error can't allocate
-    memset (buffer2, 0, size);          // Initialize to all zeroes
-    if (buffer) {
-        // A smaller buffer is previously allocated
-        memcpy (buffer2, buffer, BufferSize); // Copy contents of old buffer into new
-        delete[] buffer;                 // De-allocate old buffer
+    ZeroFill(size);                      // Space up to size must be zero
+}
+
+int CMemoryBuffer::Grow(uint32 MinSize) {
+    // Make the buffer at least MinSize bytes, keeping the contents.
+    // The size is at least doubled each time the buffer grows, so that the 
+    // total amount of copying is proportional to the final size.
+    // Heap buffers are extended with realloc, which can often extend the 
+    // buffer in place or move a large buffer by remapping its pages rather
+    // than copying it. The new space is not initialized. It is filled with
+    // zeroes by ZeroFill only where needed.
+    // Returns 0 if out of memory.
+    uint64 NewSize = (uint64)BufferSize * 2 + 1024;   // Geometric growth
+    if (NewSize < MinSize) NewSize = MinSize;
+    NewSize = (NewSize + 15) & ~(uint64)15;            // Round up to value divisible by 16
+    if (NewSize > 0xFFFFFFF0u) NewSize = 0xFFFFFFF0u;  // Size must fit into 32 bits
+    if (NewSize < MinSize) {err.submit(9006); return 0;} // Error can't allocate
+
+    int8 * buffer2;                      // New buffer
+    if (buffer && !Mapped) {
+        // Extend heap buffer
+        buffer2 = (int8*)realloc(buffer, (size_t)NewSize);
+        if (buffer2 == 0) {err.submit(9006); return 0;} // Error can't allocate. Old buffer is still valid
+        if (buffer2 != buffer) {
+            Statistics.NumMoved++;
+            Statistics.BytesCopied += BufferSize;  // Upper limit. realloc may remap pages instead
+        }
+    }
+    else {
+        // No buffer yet, or a memory-mapped file that must be copied to the heap
+        buffer2 = (int8*)malloc((size_t)NewSize);
+        if (buffer2 == 0) {err.submit(9006); return 0;} // Error can't allocate
+        if (buffer) {
+            // Copy contents of old buffer into new
+            memcpy(buffer2, buffer, BufferSize);
+            Statistics.NumMoved++;
+            Statistics.BytesCopied += BufferSize;
+            Deallocate();                 // De-allocate old buffer
+        }
     }
-    buffer = buffer2;                   // Save pointer to buffer
-    BufferSize = size;                  // Save size
+    Statistics.NumAllocations++;
+    Statistics.BytesAllocated += NewSize - BufferSize;
+    buffer = buffer2;                    // Save pointer to buffer
+    BufferSize = (uint32)NewSize;        // Save size
+    return 1;
+}
+
+void CMemoryBuffer::ZeroFill(uint32 End) {
+    // Make sure the space from DataSize to End contains zeroes.
+    // The space from DataSize to ZeroedSize is known to be zero already
+    uint32 Begin = ZeroedSize > DataSize ? ZeroedSize : DataSize;
+    if (End > Begin) {
+        memset(buffer + Begin, 0, End - Begin);
+        Statistics.BytesZeroed += End - Begin;
+    }
+    if (End > ZeroedSize) ZeroedSize = End;
 }
 
 uint32 CMemoryBuffer::Push(void const * obj, uint32 size) {
@@ -98,45 +144,33 @@ uint32 CMemoryBuffer::Push(void const * obj, uint32 size) {
     // New data size will be old data size plus size of new object
     uint32 NewOffset = DataSize + size;
 
+    int8 * temp = 0;                     // Temporary copy of object
+
     if (NewOffset > BufferSize) {
         // Buffer too small, allocate more space.
-        // We can use SetSize for this only if it is certain that obj is not 
-        // pointing to an object previously allocated in the old buffer
-        // because it would be deallocated before copied into the new buffer:
-        // SetSize (NewOffset + NewOffset / 2 + 1024);
-
-        // Allocate more space without using SetSize:
-        // Double the size + 1 kB, and round up size to value divisible by 16
-        uint32 NewSize = (NewOffset * 2 + 1024 + 15) & uint32(-16);
-        int8 * buffer2 = 0;                        // New buffer
-        // Allocate new buffer
-        buffer2 = new int8[NewSize];
-        if (buffer2 == 0) {
-            // Error can't allocate
-            err.submit(9006);  return 0;
+        // obj may point to an object in the old buffer, which is freed when the 
+        // buffer grows. Remember its position relative to the buffer in this case
+        size_t ObjOffset = (size_t)obj - (size_t)buffer;
+        int    ObjInside = obj && buffer && ObjOffset < BufferSize;
+        if (ObjInside && Mapped) {
+            // A mapped file is unmapped rather than moved. Save a copy of the object
+            temp = (int8*)malloc(size);
+            if (temp == 0) {err.submit(9006); return 0;}
+            memcpy(temp, obj, size);  obj = temp;  ObjInside = 0;
         }
-        // Initialize to all zeroes
-        memset (buffer2, 0, NewSize);
-        if (buffer) {
-            // A smaller buffer is previously allocated
-            // Copy contents of old buffer into new
-            memcpy (buffer2, buffer, BufferSize);
+        if (!Grow(NewOffset)) {
+            free(temp);  return 0;
         }
-        BufferSize = NewSize;                      // Save size
-        if (obj && size) {                         
-            // Copy object to new buffer
-            memcpy (buffer2 + OldOffset, obj, size);
-            obj = 0;                                // Prevent copying once more
-        }
-        // Delete old buffer after copying object
-        if (buffer) delete[] buffer;
-
-        // Save pointer to new buffer
-        buffer = buffer2;
+        if (ObjInside) obj = buffer + ObjOffset;
     }
-    // Copy object to buffer if nonzero
     if (obj && size) {
+        // Copy object to buffer
         memcpy (buffer + OldOffset, obj, size);
+        free(temp);
+    }
+    else {
+        // Fill with zeroes
+        ZeroFill(NewOffset);
     }
     if (size) {
         // Adjust new offset
@@ -147,6 +181,57 @@ uint32 CMemoryBuffer::Push(void const * obj, uint32 size) {
     return OldOffset;
 }
 
+void CMemoryBuffer::Deallocate() {
+    // Free buffer. Does not change DataSize or BufferSize
+    if (buffer) {
+#ifdef MAPPED_FILES_SUPPORTED
+        if (Mapped) munmap(buffer, BufferSize);  // Unmap memory-mapped file
+        else
+#endif
+        free(buffer);                    // De-allocate buffer
+    }
+    buffer = 0;
+    Mapped = 0;
+}
+
+int CMemoryBuffer::MapFile(int fh, uint32 size) {
+    // Map an open file into buffer, read-write, copy-on-write.
+    // The mapping is followed by at least 2 kB of zeroes, like the buffer 
+    // made by CFileBuffer::Read, so that reading a little past the end of
+    // a truncated file is harmless.
+    // Returns 1 if success, 0 if the file cannot be mapped. 
+#ifdef MAPPED_FILES_SUPPORTED
+    uint32 PageSize = (uint32)sysconf(_SC_PAGESIZE);
+    uint64 MapSize = ((uint64)size + 2048 + PageSize - 1) / PageSize * PageSize;
+    if (size == 0 || MapSize >= 0xFFFFFFFF) return 0;
+    // Reserve zero-filled address space for the file plus extra zeroes
+    void * p = mmap(0, (size_t)MapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) return 0;
+    // Map file over the beginning of this space. 
+    // The rest of the last page of the file is zero-filled by the system
+    if (mmap(p, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fh, 0) == MAP_FAILED) {
+        munmap(p, (size_t)MapSize);
+        return 0;
+    }
+    SetSize(0);                          // Discard any previous buffer
+    buffer = (int8*)p;
+    BufferSize = (uint32)MapSize;
+    DataSize = size;
+    ZeroedSize = BufferSize;             // The mapping is zero-filled after the end of the file
+    Mapped = 1;
+    return 1;
+#else
+    return 0;                            // Not supported on this platform
+#endif
+}
+
+void CMemoryBuffer::ReportStatistics() {
+    // Print allocation statistics for all buffers
+    printf("\nMemory buffers: %.0f allocations, %.0f moved, %.0f bytes allocated, %.0f bytes copied, %.0f bytes zeroed",
+        (double)Statistics.NumAllocations, (double)Statistics.NumMoved, (double)Statistics.BytesAllocated,
+        (double)Statistics.BytesCopied, (double)Statistics.BytesZeroed);
+}
+
 uint32 CMemoryBuffer::PushString(char const * s) {
     // Add ASCIIZ string to buffer, return offset
     return Push (s, uint32(strlen(s))+1);
@@ -164,6 +249,7 @@ void CMemoryBuffer::Align(uint32 a) {
         // Allocate more space
         SetSize (NewOffset + 2048);
     }
+    ZeroFill(NewOffset);                // Alignment space must be zero
     // Set DataSize to after alignment space
     DataSize = NewOffset;
 }
@@ -233,6 +319,25 @@ void CFileBuffer::Read(int IgnoreError) {
 #endif
 }
 
+void CFileBuffer::ReadMapped(int IgnoreError) {
+    // Map file into buffer instead of reading it, if possible.
+    // Use only when the input file will not be overwritten while the buffer
+    // is in use. The data can be modified without changing the file.
+#ifdef MAPPED_FILES_SUPPORTED
+    int fh = open(FileName, O_RDONLY);
+    if (fh != -1) {
+        struct stat st;
+        int success = fstat(fh, &st) == 0 && S_ISREG(st.st_mode)
+            && st.st_size > 0 && (uint64)st.st_size < 0xFFFFF000u
+            && MapFile(fh, (uint32)st.st_size);
+        close(fh);                       // The mapping stays valid after closing file
+        if (success) return;
+    }
+#endif
+    // Mapping not possible. Read file the ordinary way
+    Read(IgnoreError);
+}
+
 void CFileBuffer::Write() {                  
     // Write buffer to file:
     if (OutputFileName) FileName = OutputFileName;
@@ -489,11 +594,14 @@ void operator >> (CFileBuffer & a, CFileBuffer & b) {
     // Transfer ownership of buffer and other properties from a to b
     b.SetSize(0);                            // De-allocate old buffer from target if it has one
     b.buffer = a.buffer;                     // Transfer buffer
+    b.Mapped = a.Mapped;                     // Buffer is memory-mapped
     a.buffer = 0;                            // Remove buffer from source, so that buffer has only one owner
+    a.Mapped = 0;
 
     // Copy properties
     b.DataSize   = a.GetDataSize();          // Size of data, offset to vacant space
     b.BufferSize = a.GetBufferSize();        // Size of allocated buffer
+    b.ZeroedSize = a.ZeroedSize;             // End of space known to be zero
     b.NumEntries = a.GetNumEntries();        // Number of objects pushed
     b.Executable = a.Executable;             // File is executable
     if (a.WordSize) b.WordSize = a.WordSize; // Segment word size (16, 32, 64)
@@ -558,67 +666,96 @@ void CFileBuffer::GetOMFWordSize() {
 // Constructor
 CTextFileBuffer::CTextFileBuffer() {
     column = 0;
+    Stream = 0;
+    StreamedSize = 0;
     // Use UNIX linefeeds only if GASM output
     LineType = (cmd.SubType == SUBTYPE_GASM) ? 1 : 0;
 }
 
 void CTextFileBuffer::Put(const char * text) {
     // Write text string to buffer
-    uint32 len = (uint32)strlen(text);            // Length of text
-    Push(text, len);                              // Add to buffer without terminating zero
-    column += len;                                // Update column
-}
-
-void CTextFileBuffer::Put(const char character) {
-    // Write single character to buffer
-    Push(&character, 1);                          // Add to buffer
-    column ++;                                    // Update column
+    Put(text, (uint32)strlen(text));              // Add to buffer without terminating zero
 }
 
 void CTextFileBuffer::NewLine() {
     // Add linefeed
     if (LineType == 0) {
-        Push("\r\n", 2);                           // DOS/Windows style linefeed
+        Put("\r\n", 2);                            // DOS/Windows style linefeed
     }
     else {
-        Push("\n", 1);                             // UNIX style linefeed
+        Put("\n", 1);                              // UNIX style linefeed
     }
     column = 0;                                   // Reset column
+    // Write a chunk to the stream file when enough text has been collected.
+    // Only whole lines are written so that text already put on the current 
+    // line is never split from the rest of the line
+    if (Stream && DataSize >= TEXT_STREAM_CHUNK) FlushStream();
+}
+
+int CTextFileBuffer::FlushStream() {
+    // Write buffered text to stream file and empty buffer.
+    // The buffer is kept allocated for the next chunk
+    if (Stream == 0 || DataSize == 0) return 1;   // Nothing to do
+    uint32 Size = DataSize;
+    uint32 Written = (uint32)fwrite(Buf(), 1, Size, Stream);
+    StreamedSize += Written;
+    DataSize = 0;  NumEntries = 0;
+    ZeroedSize = 0;                               // Used part is not zero. Push(0, size) must clear it
+    return Written == Size;
 }
 
 void CTextFileBuffer::Tabulate(uint32 i) {
     // Insert spaces until column i
-    uint32 j;
-    if (i > column) {                             // Only insert spaces if we are not already past i
-        for (j = column; j < i; j++) Push(" ", 1); // Insert i - column spaces
-        column = i;                                // Update column
+    static const char Spaces[] = "                                ";  // 32 spaces
+    while (i > column) {                          // Only insert spaces if we are not already past i
+        uint32 n = i - column;                     // Number of spaces needed
+        if (n > sizeof(Spaces) - 1) n = sizeof(Spaces) - 1;
+        Put(Spaces, n);                            // Put updates column
     }
 }
 
 void CTextFileBuffer::PutDecimal(int32 x, int IsSigned) {
     // Write decimal number to buffer, unsigned or signed
     char text[16];
-    sprintf(text, IsSigned ? "%i" : "%u", x);
-    Put(text);
+    char * p = text + sizeof(text);               // Digits are generated backwards from end of text
+    uint32 u = (uint32)x;
+    if (IsSigned && x < 0) u = 0u - u;            // Absolute value
+    do {
+        *--p = char('0' + u % 10);  u /= 10;
+    } while (u);
+    if (IsSigned && x < 0) *--p = '-';
+    Put(p, uint32(text + sizeof(text) - p));
+}
+
+void CTextFileBuffer::PutHexDigits(uint64 x, uint32 MinDigits, int MasmForm) {
+    // Write hexadecimal number with at least MinDigits digits.
+    // MasmForm = 0: digits only.
+    // MasmForm > 0: 0x prefix for GAS, or H suffix for MASM and NASM with 
+    // a leading zero if the number would otherwise begin with a letter
+    static const char HexDigits[] = "0123456789ABCDEF";
+    char text[24];
+    uint32 NumDigits = 1, n = 0, i;
+    for (uint64 y = x >> 4; y; y >>= 4) NumDigits++; // Count significant digits
+    if (NumDigits < MinDigits) NumDigits = MinDigits;
+    if (MasmForm && cmd.SubType == SUBTYPE_GASM) {
+        text[n++] = '0';  text[n++] = 'x';         // Needs 0x prefix
+    }
+    else if (MasmForm && (x >> (NumDigits-1)*4) >= 10) {
+        text[n++] = '0';                           // Make sure it doesn't begin with a letter
+    }
+    for (i = NumDigits; i > 0; i--) {             // Digits, most significant first
+        text[n + i - 1] = HexDigits[x & 0xF];  x >>= 4;
+    }
+    n += NumDigits;
+    if (MasmForm && cmd.SubType != SUBTYPE_GASM) text[n++] = 'H';
+    Put(text, n);
 }
 
 void CTextFileBuffer::PutHex(uint8 x, int MasmForm) {
     // Write hexadecimal 8 bit number to buffer
     // If MasmForm >= 1 then the function will write the number in a
     // way that can be read by the assembler, e.g. 0FFH or 0xFF
-    char text[16];
-    if (MasmForm && cmd.SubType == SUBTYPE_GASM) {
-        // Needs 0x prefix
-        sprintf(text, "0x%02X", x);
-        Put(text);
-        return;
-    }
-    if (MasmForm && x >= 0xA0) {
-        Put("0");                                  // Make sure it doesn't begin with a letter
-    }
-    sprintf(text, "%02X", x);
-    Put(text);
-    if (MasmForm) Put("H");
+    PutHexDigits(x, 2, MasmForm);
 }
 
 void CTextFileBuffer::PutHex(uint16 x, int MasmForm) {
@@ -626,20 +763,7 @@ void CTextFileBuffer::PutHex(uint16 x, int MasmForm) {
     // If MasmForm >= 1 then the function will write the number in a
     // way that can be read by the assembler, e.g. 0FFH or 0xFF
     // If MasmForm == 2 then leading zeroes are stripped
-    char text[16];
-    if (MasmForm && cmd.SubType == SUBTYPE_GASM) {
-        // Needs 0x prefix
-        sprintf(text, MasmForm==1 ? "0x%04X" : "0x%X", x);
-        Put(text);
-        return;
-    }
-    sprintf(text, (MasmForm < 2) ? "%04X" : "%X", x);
-    // Check if leading zero needed
-    if (MasmForm && text[0] > '9') {
-        Put("0");                                  // Leading zero needed
-    }
-    Put(text);
-    if (MasmForm) Put("H");
+    PutHexDigits(x, (MasmForm < 2) ? 4 : 1, MasmForm);
 }
 
 void CTextFileBuffer::PutHex(uint32 x, int MasmForm) {
@@ -647,21 +771,7 @@ void CTextFileBuffer::PutHex(uint32 x, int MasmForm) {
     // If MasmForm >= 1 then the function will write the number in a
     // way that can be read by the assembler, e.g. 0FFH or 0xFF
     // If MasmForm == 2 then leading zeroes are stripped
-    char text[16];
-    if (MasmForm && cmd.SubType == SUBTYPE_GASM) {
-        // Needs 0x prefix
-        sprintf(text, MasmForm==1 ? "0x%08X" : "0x%X", x);
-        Put(text);
-        return;
-    }
-
-    sprintf(text, (MasmForm < 2) ? "%08X" : "%X", x);
-    // Check if leading zero needed
-    if (MasmForm && text[0] > '9') {
-        Put("0");                                  // Leading zero needed
-    }
-    Put(text);
-    if (MasmForm) Put("H");
+    PutHexDigits(x, (MasmForm < 2) ? 8 : 1, MasmForm);
 }
 
 void CTextFileBuffer::PutHex(uint64 x, int MasmForm) {
@@ -669,35 +779,7 @@ void CTextFileBuffer::PutHex(uint64 x, int MasmForm) {
     // If MasmForm >= 1 then the function will write the number in a
     // way that can be read by the assembler, e.g. 0FFH or 0xFF
     // If MasmForm == 2 then leading zeroes are stripped
-    char text[32];
-    if (MasmForm < 2) {  // Print all digits
-        sprintf(text, "%08X%08X", HighDWord(x), uint32(x));
-    }
-    else { // Skip leading zeroes
-        if (HighDWord(x)) {
-            sprintf(text, "%X%08X", HighDWord(x), uint32(x));
-        }
-        else {
-            sprintf(text, "%X", uint32(x));
-        }
-    }
-    if (MasmForm) {
-        if (cmd.SubType == SUBTYPE_GASM) {
-            // Needs 0x prefix
-            Put("0x");
-            Put(text);
-        }
-        else {
-            // use 0FFH form
-            if (text[0] > '9')  Put("0");           // Leading zero needed
-            Put(text);
-            Put("H");
-        }
-    }
-    else {
-        // write hexadecimal number only
-        Put(text);
-    }
+    PutHexDigits(x, (MasmForm < 2) ? 16 : 1, MasmForm);
 }
 
 void CTextFileBuffer::PutFloat(float x) {
@@ -713,3 +795,102 @@ void CTextFileBuffer::PutFloat(double x) {
     sprintf(text, "%.16G", x);
     Put(text);
 }
+
+
+// Members of class CJsonLineWriter
+CJsonLineWriter::CJsonLineWriter() {
+    // Constructor
+    LineType = 1;                                 // JSON Lines always use UNIX linefeeds
+    SetStream(stdout);                            // Write to console output
+}
+
+CJsonLineWriter::~CJsonLineWriter() {
+    // Destructor. Write remaining text
+    FlushStream();
+    fflush(stdout);
+}
+
+void CJsonLineWriter::Begin(const char * RecordType) {
+    // Start new record. Every record begins with its type
+    Put("{\"type\":\"", 9);
+    Put(RecordType);
+    Put('"');
+}
+
+void CJsonLineWriter::End() {
+    // Finish record. One record per line
+    Put('}');
+    NewLine();
+}
+
+void CJsonLineWriter::PutKey(const char * Key) {
+    // Write field name. Key names never need escaping
+    Put(",\"", 2);
+    Put(Key);
+    Put("\":", 2);
+}
+
+void CJsonLineWriter::PutEscaped(const char * s, uint32 MaxLen) {
+    // Write string with JSON escape sequences, max MaxLen characters.
+    // Control characters and bytes above 0x7E are written as \u00XX so that
+    // the output is always valid ASCII, even for names with odd encodings
+    static const char HexDigits[] = "0123456789abcdef";
+    char esc[6] = {'\\', 'u', '0', '0', 0, 0};
+    Put('"');
+    if (s) {
+        for (uint32 i = 0; i < MaxLen && s[i]; i++) {
+            uint8 c = (uint8)s[i];
+            if (c == '"' || c == '\\') {
+                Put('\\');  Put((char)c);          // \" or \\ .
+                continue;
+            }
+            if (c < 0x20 || c > 0x7E) {
+                esc[4] = HexDigits[c >> 4];  esc[5] = HexDigits[c & 0xF];
+                Put(esc, 6);
+                continue;
+            }
+            Put((char)c);
+        }
+    }
+    Put('"');
+}
+
+void CJsonLineWriter::PutUnsigned(uint64 x) {
+    // Write 64-bit decimal number
+    char text[24];
+    char * p = text + sizeof(text);               // Digits are generated backwards from end of text
+    do {
+        *--p = char('0' + x % 10);  x /= 10;
+    } while (x);
+    Put(p, uint32(text + sizeof(text) - p));
+}
+
+void CJsonLineWriter::Str(const char * Key, const char * Value) {
+    // Add string field
+    PutKey(Key);  PutEscaped(Value, 0xFFFFFFFF);
+}
+
+void CJsonLineWriter::Str(const char * Key, const char * Value, uint32 MaxLen) {
+    // Add string field of limited length, for names in fixed-size fields
+    PutKey(Key);  PutEscaped(Value, MaxLen);
+}
+
+void CJsonLineWriter::Int(const char * Key, int64 Value) {
+    // Add signed integer field
+    PutKey(Key);
+    if (Value < 0) {
+        Put('-');  PutUnsigned(0 - (uint64)Value);
+    }
+    else PutUnsigned((uint64)Value);
+}
+
+void CJsonLineWriter::UInt(const char * Key, uint64 Value) {
+    // Add unsigned integer field
+    PutKey(Key);  PutUnsigned(Value);
+}
+
+void CJsonLineWriter::Bool(const char * Key, int Value) {
+    // Add true/false field
+    PutKey(Key);
+    if (Value) Put("true", 4); else Put("false", 5);
+}
@@ -1,7 +1,7 @@
 /****************************  containers.h   ********************************
 * Author:        Agner Fog
 * Date created:  2006-07-15
-* Last modified: 2007-02-01
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        containers.h
 * Description:
@@ -38,6 +38,13 @@ after the A >> B operation. This makes sure that a memory buffer is always
 owned by one, and only one, object. The opposite operator B << A does the 
 same thing.
 
+An input file can be memory-mapped instead of read into a heap buffer by
+CFileBuffer::ReadMapped(). The mapping is private (copy-on-write), so the
+converters may still modify the data in place. Only the pages that are
+actually written to are copied by the operating system. A mapped buffer is
+copied to the heap when it needs to grow. This is used for operations that
+only read the input file, such as dump and disassembly.
+
 The >> operator is used whenever we want to do something to a file buffer
 that requires a specialized class. The file buffer is transferred from the
 object that owns it to an object of the specialized class and transferred
@@ -86,6 +93,15 @@ class CFileBuffer;                               // Declared below
 
 void operator >> (CFileBuffer & a, CFileBuffer & b); // Transfer ownership of buffer and other properties
 
+// Statistics of memory allocation in all CMemoryBuffer objects. Used for diagnostics
+struct SMemoryStatistics {
+   uint64 NumAllocations;                        // Number of buffers allocated or grown
+   uint64 NumMoved;                              // Number of times a growing buffer could not be extended in place
+   uint64 BytesAllocated;                        // Total size of new and grown buffers
+   uint64 BytesCopied;                           // Bytes copied from an old buffer to a new one
+   uint64 BytesZeroed;                           // Bytes filled with zeroes
+};
+
 // Class CMemoryBuffer makes a dynamic array which can grow as new data are
 // added. Used for storage of files, file sections, tables, etc.
 class CMemoryBuffer {
@@ -104,13 +120,21 @@ public:
    template <class TX> TX & Get(uint32 Offset) { // Get object of arbitrary type from buffer
       if (Offset >= DataSize) {err.submit(2016); Offset = 0;} // Offset out of range
       return *(TX*)(buffer + Offset);}
+   static SMemoryStatistics Statistics;          // Allocation statistics for all buffers
+   static void ReportStatistics();               // Print allocation statistics
 private:
    CMemoryBuffer(CMemoryBuffer&);                // Make private copy constructor to prevent copying
    int8 * buffer;                                // Buffer containing binary data. To be modified only by SetSize and operator >>
    uint32 BufferSize;                            // Size of allocated buffer ( > DataSize)
+   int    Mapped;                                // Buffer is a memory-mapped file rather than allocated with malloc
+   void   Deallocate();                          // Free buffer, whether allocated or mapped
+   int    Grow(uint32 MinSize);                  // Make buffer bigger without initializing new space. Returns 0 if out of memory
 protected:
+   int MapFile(int fh, uint32 size);             // Map open file into buffer. Returns 0 if failed
    uint32 NumEntries;                            // Number of objects pushed
    uint32 DataSize;                              // Size of data, offset to vacant space
+   uint32 ZeroedSize;                            // Space from DataSize to ZeroedSize is known to contain zeroes
+   void   ZeroFill(uint32 End);                  // Make sure space from DataSize to End contains zeroes
    friend void operator >> (CFileBuffer & a, CFileBuffer & b); // Transfer ownership of buffer and other properties
 };
 
@@ -123,6 +147,7 @@ public:
    CFileBuffer();                                // Default constructor
    CFileBuffer(char const * filename);           // Constructor
    void Read(int IgnoreError = 0);               // Read file into buffer
+   void ReadMapped(int IgnoreError = 0);         // Map file into buffer, or read if mapping not possible
    void Write();                                 // Write buffer to file
    int  GetFileType();                           // Get file format type
    void SetFileType(int type);                   // Set file format type
@@ -140,12 +165,26 @@ protected:
 };
 
 
-// Class CTextFileBuffer is used for building text files
+// Class CTextFileBuffer is used for building text files.
+// If a stream file is set then the text is written to the file in chunks of
+// approximately TEXT_STREAM_CHUNK bytes rather than kept in memory
+#define TEXT_STREAM_CHUNK  0x100000              // Size of chunks written to stream file
+
 class CTextFileBuffer : public CFileBuffer {
 public:
    CTextFileBuffer();                            // Constructor
    void Put(const char * text);                  // Write text string to buffer
-   void Put(const char character);               // Write single character to buffer
+   void Put(const char * text, uint32 len) {     // Write text of known length to buffer
+      if (DataSize + len <= GetBufferSize() && len) {
+         // Fast path: append directly when there is room in buffer
+         memcpy(Buf() + DataSize, text, len);  DataSize += len;  NumEntries++;
+      }
+      else Push(text, len);                      // Buffer must grow
+      column += len;                             // Update column
+   }
+   void Put(const char character) {              // Write single character to buffer
+      Put(&character, 1);
+   }
    void NewLine();                               // Add linefeed
    void Tabulate(uint32 i);                      // Insert spaces until column i
    int  LineType;                                // 0 = DOS/Windows linefeeds, 1 = UNIX linefeeds
@@ -157,13 +196,44 @@ public:
    void PutFloat(float x);                       // Write floating point number to buffer
    void PutFloat(double x);                      // Write floating point number to buffer
    uint32 GetColumn() {return column;}           // Get column number
+   void SetColumn(uint32 c) {column = c;}        // Set column number after adding text with Push
+   void SetStream(FILE * f) {Stream = f;}        // Write text to file f in chunks as lines are completed. 0 = keep all text in buffer
+   FILE * GetStream() {return Stream;}           // Get file set by SetStream
+   int  FlushStream();                           // Write buffered text to stream file and empty buffer. Returns 0 if error
+   uint64 GetStreamedSize() {return StreamedSize;} // Number of bytes written to stream file so far
 protected:
    uint32 column;                                // Current column
+   FILE * Stream;                                // File to write text to during output, or 0
+   uint64 StreamedSize;                          // Number of bytes written to Stream
+   void PutHexDigits(uint64 x, uint32 MinDigits, int MasmForm); // Common code for PutHex functions
 private:
    uint32 PushString(char const * s){return 0;}; // Make PushString private to prevent using it
 };
 
 
+// Class CJsonLineWriter is used for the machine-readable dump (-dj).
+// Each record is written as one JSON object on a single line. The first field
+// of every record is "type", which tells what kind of record it is. Text is
+// streamed to stdout in chunks, and the remaining text is written when the
+// object is destroyed
+class CJsonLineWriter : public CTextFileBuffer {
+public:
+   CJsonLineWriter();                            // Constructor
+   ~CJsonLineWriter();                           // Destructor. Writes remaining text
+   void Begin(const char * RecordType);          // Start new record
+   void End();                                   // Finish record
+   void Str(const char * Key, const char * Value); // Add string field
+   void Str(const char * Key, const char * Value, uint32 MaxLen); // Add string field of limited length
+   void Int(const char * Key, int64 Value);      // Add signed integer field
+   void UInt(const char * Key, uint64 Value);    // Add unsigned integer field
+   void Bool(const char * Key, int Value);       // Add true/false field
+protected:
+   void PutKey(const char * Key);                // Write field name
+   void PutEscaped(const char * s, uint32 MaxLen); // Write string with JSON escape sequences
+   void PutUnsigned(uint64 x);                   // Write 64-bit decimal number
+};
+
+
 // Class CArrayBuf<RecordType> is used for dynamic arrays.
 // The size of the array can be set only once.
 // Use CArrayBuf rather than one of the other container classes if RecordType
@@ -231,6 +301,9 @@ public:
 //    list.PushSort(x);
 //    The list will be kept sorted in ascending order, provided that it
 //    was sorted before the call to PushSort.
+//    Many records can be added more efficiently with list.Push(x) followed 
+//    by a single call to list.MergeNew(n), where n is the number of entries
+//    that were in the sorted list before the first Push.
 // 5. The list can be kept sorted at all times and without duplicates if 
 //    records are added with list.PushUnique(x);
 //    The list will be sorted and without duplicates after PushUnique if
@@ -287,19 +360,79 @@ public:
    void Sort() {                                 
       // Sort list by ascending RecordType items
       // Operator < must be defined for RecordType
-      // Simple Bubble sort:
-      int32 i, j;
-      RecordType temp, * p1, * p2;
-      for (i = 0; i < (int32)NumEntries; i++) {
-         for (j = 0; j < (int32)NumEntries - i - 1; j++) {
-            p1 = (RecordType*)(Buf() + j * sizeof(RecordType));
-            p2 = (RecordType*)(Buf() + (j+1) * sizeof(RecordType));
-            if (*p2 < *p1) {                     
-               // Swap records
-               temp = *p1;  *p1 = *p2;  *p2 = temp;
+      SortRange(0, NumEntries);
+   }
+   void SortRange(uint32 first, uint32 num) {
+      // Sort num records from index first by ascending RecordType items.
+      // Merge sort. The sort is stable: records that are equal keep their
+      // relative order, as they did with the bubble sort used previously.
+      const uint32 RunLength = 16;               // Length of runs to sort by insertion sort
+      uint32 i, j, k, width;
+      RecordType temp;
+      if (first + num > NumEntries || num < 2) return;
+      RecordType * a = (RecordType*)Buf() + first;
+      // Sort short runs by insertion sort
+      for (i = 0; i < num; i += RunLength) {
+         uint32 end = i + RunLength < num ? i + RunLength : num;
+         for (j = i + 1; j < end; j++) {
+            if (!(a[j] < a[j-1])) continue;
+            temp = a[j];
+            for (k = j; k > i && temp < a[k-1]; k--) a[k] = a[k-1];
+            a[k] = temp;
+         }
+      }
+      if (num <= RunLength) return;
+      // Merge runs of increasing width, alternating between a and a temporary buffer
+      int8 * TempBuffer = new int8[num * sizeof(RecordType)];
+      if (TempBuffer == 0) {err.submit(9006); return;}
+      RecordType * src = a, * dst = (RecordType*)TempBuffer, * swap;
+      for (width = RunLength; width < num; width *= 2) {
+         for (i = 0; i < num; i += 2 * width) {
+            uint32 mid = i + width < num ? i + width : num;
+            uint32 end = i + 2 * width < num ? i + 2 * width : num;
+            j = i;  k = mid;
+            uint32 d = i;
+            while (j < mid && k < end) {
+               // Take from left run if equal to keep the sort stable
+               if (src[k] < src[j]) dst[d++] = src[k++]; else dst[d++] = src[j++];
             }
+            while (j < mid) dst[d++] = src[j++];
+            while (k < end) dst[d++] = src[k++];
          }
+         swap = src;  src = dst;  dst = swap;
+      }
+      if (src != a) memcpy(a, src, num * sizeof(RecordType));
+      delete[] TempBuffer;
+   }
+   void MergeNew(uint32 FirstNew) {
+      // Sort entries that have been added with Push() from index FirstNew 
+      // and up, and merge them into the sorted entries below FirstNew.
+      // This gives the same result as adding the new entries with PushSort(),
+      // including the order of equal entries, but it takes O(n log n) time 
+      // rather than O(n^2). Use this for adding many entries in bulk.
+      uint32 i, j, d, NumNew;
+      if (FirstNew >= NumEntries) return;        // Nothing new
+      NumNew = NumEntries - FirstNew;
+      RecordType * a = (RecordType*)Buf();
+      // PushSort inserts a record before any existing equal records, so equal
+      // new records end up in reverse order. Reverse them before a stable sort
+      for (i = FirstNew, j = NumEntries - 1; i < j; i++, j--) {
+         RecordType temp = a[i];  a[i] = a[j];  a[j] = temp;
+      }
+      SortRange(FirstNew, NumNew);
+      if (FirstNew == 0 || a[FirstNew-1] < a[FirstNew]) return; // Already in order
+      // Merge. Copy old records to temporary buffer and merge from the front
+      int8 * TempBuffer = new int8[FirstNew * sizeof(RecordType)];
+      if (TempBuffer == 0) {err.submit(9006); return;}
+      RecordType * old = (RecordType*)TempBuffer;
+      memcpy(old, a, FirstNew * sizeof(RecordType));
+      i = 0;  j = FirstNew;  d = 0;
+      while (i < FirstNew && j < NumEntries) {
+         // New record goes before an equal old record
+         if (old[i] < a[j]) a[d++] = old[i++]; else a[d++] = a[j++];
       }
+      while (i < FirstNew) a[d++] = old[i++];
+      delete[] TempBuffer;
    }
    int32 FindFirst(RecordType const & x) {
       // Returns index to first record >= x.
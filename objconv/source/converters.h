@@ -1,7 +1,7 @@
 /****************************  converters.h   ********************************
 * Author:        Agner Fog
 * Date created:  2006-07-15
-* Last modified: 2008-05-25
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        converters.h
 * Description:
@@ -42,12 +42,23 @@ public:
 };
 
 
+// Structure for input and output file names of one job in batch mode
+struct SBatchJob {
+   char * InputFile;                   // Input file name
+   char * OutputFile;                  // Output file name, or 0 for default name
+};
+
+
 // Class for deciding what to do with input file
 // Its memory buffer contains the input file and later the output file
 class CMain : public CFileBuffer {
 public:
    CMain();                            // Constructor
    void Go();                          // Do whatever the command line parameters say
+protected:
+   void GoFile();                      // Convert, dump or modify file after it has been read
+   void GoBatch();                     // Convert all files listed in batch file
+   void ReadBatchFile(CFileBuffer & BatchFile, CSList<SBatchJob> & Jobs); // Read list of files from batch file
 };
 
 
@@ -83,6 +94,7 @@ public:
    CCOFF();                                      // Default constructor
    void ParseFile();                             // Parse file buffer
    void Dump(int options);                       // Dump file
+   void DumpJson(int options);                   // Dump file as JSON Lines records
    void PrintSymbolTable(int symnum);            // Dump symbol table entries
    void PrintImportExport();                     // Print imported and exported symbols
    static void PrintSegmentCharacteristics(uint32 flags); // Print segment characteristics
@@ -116,6 +128,7 @@ public:
    CELF();                                       // Default constructor
    void ParseFile();                             // Parse file buffer
    void Dump(int options);                       // Dump file
+   void DumpJson(int options);                   // Dump file as JSON Lines records
    void PublicNames(CMemoryBuffer * Strings, CSList<SStringEntry> * Index, int m); // Make list of public names
 protected:
    const char * SymbolName(uint32 index);        // Get name of symbol
@@ -130,6 +143,8 @@ protected:
    uint32 SymbolTableEntries;                    // Number of symbols
    uint32 SymbolStringTableOffset;               // Offset to symbol string table
    uint32 SymbolStringTableSize;                 // Size of symbol string table
+   CArrayBuf<uint32> RelocationSections;         // Relocation sections ordered by the section they apply to
+   CArrayBuf<uint32> RelocationSectionsStart;    // Index into RelocationSections for each section. NSections+1 entries
 };
 
 
@@ -139,6 +154,7 @@ public:
    COMF();                                       // Default constructor
    void ParseFile();                             // Parse file buffer
    void Dump(int options);                       // Dump file
+   void DumpJson(int options);                   // Dump file as JSON Lines records
    void PublicNames(CMemoryBuffer * Strings, CSList<SStringEntry> * Index, int m); // Make list of public names
 protected:
    uint32 NumRecords;                            // Number of records
@@ -169,6 +185,7 @@ public:
    CMACHO();                                     // Default constructor
    void ParseFile();                             // Parse file buffer
    void Dump(int options);                       // Dump file
+   void DumpJson(int options);                   // Dump file as JSON Lines records
    void PublicNames(CMemoryBuffer * Strings, CSList<SStringEntry> * Index, int m); // Make list of public names
 protected:
    TMAC_header FileHeader;                       // Copy of file header
@@ -1,7 +1,7 @@
 /****************************  disasm.h   **********************************
 * Author:        Agner Fog
 * Date created:  2007-02-21
-* Last modified: 2014-12-06
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        disasm.h
 * Description:
@@ -551,6 +551,21 @@ struct SASymbol {
       return Section < y.Section || (Section == y.Section && Offset < y.Offset);}
 };
 
+// Copy of a symbol record with its new index. Used for symbols modified by a
+// worker process in parallel pass 2, and for symbols saved before they are
+// used by a section that may be written to the disassembly cache
+struct SPass2Symbol {
+   uint32   Index;                               // New index of symbol
+   SASymbol Symbol;                              // Symbol record
+};
+
+// Structure for remembering the address of a symbol by its old index
+struct SOldIndexAddress {
+   int32   Section;                              // Section number
+   uint32  Offset;                               // Offset into section
+   uint32  Status;                               // 0 = unused, 1 = one symbol, 2 = more than one symbol with this old index
+};
+
 // Define class CSymbolTable
 class CSymbolTable {
 public:
@@ -565,6 +580,8 @@ public:
    uint32 FindByAddress(int32 Section, uint32 Offset); // Find symbols by address
    uint32 Old2NewIndex(uint32 OldIndex);         // Translate old symbol index to new index
    SASymbol & operator [](uint32 NewIndex) {     // Access symbol by new index
+      if (NumSorted != List.GetNumEntries()) SortNew();
+      if (NewIndex < AccessLogSize) LogAccess(NewIndex);
       return List[NewIndex];}
    const char * HasName(uint32 symo);            // Ask if symbol has a name, input = old index, output = name or 0
    const char * GetName(uint32 symi);            // Get symbol name by new index. (Assign a name if none)
@@ -573,6 +590,12 @@ public:
    void   AssignName(uint32 symi, const char *name); // Give symbol a specific name
    uint32 GetLimit() {return OldNum;}            // Get highest old symbol number + 1
    uint32 GetNumEntries() {return List.GetNumEntries();}// Get highest new symbol number + 1
+   void   SortNew();                             // Sort symbols added by AddSymbol into List
+   uint64 Checksum(uint64 h);                    // Make checksum of number of symbols and names
+   uint64 SymbolChecksum(uint64 h, uint32 symi); // Make checksum of symbol address, type and names
+   uint64 SectionChecksum(uint64 h, int32 Section); // Make checksum of all symbols in section
+   uint32 FindSection(int32 Section, uint32 * Num); // Find first symbol and number of symbols in section
+   void   LogSection(int32 Section);             // Mark all symbols in section as accessed
 protected:
    CSList<SASymbol> List;                        // List of symbols, sorted by address
    CMemoryBuffer    SymbolNameBuffer;            // String buffer for names of symbols
@@ -580,11 +603,82 @@ protected:
    void UpdateIndex();                           // Update TranslateOldIndex
    uint32 OldNum;                                // = 1 + max OldIndex
    uint32 NewNum;                                // Number of entries in List
+   uint32 NumSorted;                             // Number of entries in List that are sorted. Entries above are unsorted
+   uint32 TranslateNum;                          // Number of entries in List when TranslateOldIndex was updated
+   uint32 TranslateStale;                        // Number of lookups since TranslateOldIndex was out of date
+   CSList<SOldIndexAddress> OldIndexAddress;     // Address of each symbol, by old index. Addresses never change
+   CSList<uint32>   AddressHash;                 // Hash table of new index of first symbol at each address. 0 = vacant
+   uint32 AddressHashNum;                        // Number of entries in List when AddressHash was made
+   uint32 AddressHashStale;                      // Number of lookups since AddressHash was out of date
+   uint32 LastFound;                             // Result of last search by address
+   void   SetOldIndexAddress(uint32 OldIndex, int32 Section, uint32 Offset); // Remember address of symbol
+   uint32 FindByOldIndex(uint32 OldIndex);       // Find symbol by address of old index. Returns 0 if not found
+   uint32 FindFirstByAddress(SASymbol const & sym); // Find first symbol with address >= sym
+   void   MakeAddressHash();                     // Make AddressHash
    uint32 UnnamedNum;                            // Number of unnamed symbols
+   void   LogAccess(uint32 NewIndex);            // Mark symbol as accessed
 public:
    const char * UnnamedSymbolsPrefix;            // Prefix for names of unnamed symbols
    const char * UnnamedSymFormat;                // Format string for giving names to unnamed symbols
    const char * ImportTablePrefix;               // Prefix for pointers in import table
+   uint8 * AccessLog;                            // Symbols accessed are marked here. 1 = accessed, 2 = copied to AccessCopy
+   uint32 AccessLogSize;                         // Size of AccessLog. 0 = no logging
+   CSList<SPass2Symbol> * AccessCopy;            // Symbols are copied here before first access, if not 0
+   CSList<int32> * SectionLog;                   // Sections searched by FindByAddress are listed here, if not 0
+};
+
+
+// Structure for saving the state of pass 2 at a boundary between function
+// blocks or labels. Used for dividing pass 2 between worker processes
+struct SPass2State {
+   SOpcodeProp s;                                // Properties of last opcode
+   SATracer t;                                   // Trace of register contents
+   uint32  Section;                              // Current section
+   uint32  IBegin;                               // Begin of current instruction
+   uint32  IEnd;                                 // End of current instruction
+   uint32  IFunction;                            // Index into FunctionList
+   uint32  FunctionEnd;                          // End address of current function
+   uint32  LabelBegin;                           // Address of nearest preceding label
+   uint32  LabelEnd;                             // Address of next label
+   uint32  LabelInaccessible;                    // Address of inaccessible code
+   uint32  CodeMode;                             // 1 = code, 2 = dubious, 4 = data
+   uint32  DataType;                             // Type of current data
+   uint32  DataSize;                             // Size of current data
+   uint32  FlagPrevious;                         // Flags for previous instruction
+   uint32  CountErrors;                          // Number of errors since last label
+   uint16  Opcodei;                              // Map number and index in opcodes.cpp
+   uint16  OpcodeOptions;                        // Option flags for opcode
+   uint16  PreviousOpcodei;                      // Opcode for previous instruction
+   uint16  PreviousOpcodeOptions;                // Option flags for previous instruction
+   uint32  Column;                               // Column of OutFile
+   uint32  Stop;                                 // Return value from Pass2Blocks. 1 = before function block, 2 = at label
+};
+
+// Structure for the position where a chunk begins in parallel pass 2
+struct SPass2Position {
+   uint32  Section;                              // Section index
+   uint32  Block;                                // Index into FunctionList. 0 = beginning of section
+   uint32  Label;                                // Address of label in function block. 0 = beginning of function block
+   uint32  Warmup;                               // Address of preceding label in same function block if Label > 0
+};
+
+// Structure for the state at the start of a section that may be written to
+// the disassembly cache. See explanation of disassembly cache in disasm1.cpp
+struct SCacheSection {
+   uint64  Key;                                  // Key of section in disassembly cache
+   uint64  Content;                              // Checksum of section contents, relocations, functions and symbols
+   uint64  SymbolCheck;                          // Checksum of number of symbols and names
+   uint32  NumSymbols;                           // Number of symbols
+   uint32  NumRelocations;                       // Number of relocations
+   uint32  NumFunctions;                         // Number of function records
+   int     NumMessages;                          // Number of error and warning messages
+   uint32  OutStart;                             // Size of OutFile at start of section
+   uint32  MasmOptions;                          // MasmOptions before section
+   uint8   InstructionSetMax;                    // InstructionSetMax before section
+   uint8   InstructionSetAMDMAX;                 // InstructionSetAMDMAX before section
+   uint16  InstructionSetOR;                     // InstructionSetOR before section
+   FILE *  Stream;                               // Stream file of OutFile
+   int     OwnLog;                               // Symbols.AccessLog is CacheAccessLog
 };
 
 
@@ -646,13 +740,14 @@ public:
       const char * Name,                         // Name of group
       int32 MemberSegment);                      // Group member. Repeat for multiple members. 0 if none.
    static void CountInstructions();              // Count total number of instructions defined in opcodes.cpp
+   static void MakeFlatOpcodeTables();           // Make flattened opcode maps for fast lookup in FindMapEntry
    const char * CommentSeparator;                // "; " or "# " Start of comment string
    const char * HereOperator;                    // "$" or "." indicating current position
    CTextFileBuffer   OutFile;                    // Output file
 protected:
    CSymbolTable Symbols;                         // Table of symbols
    CSList<SASection> Sections;                   // List of sections. First is 0
-   CSList<SARelocation> Relocations;             // List of cross references. First is 0
+   CSList<SARelocation> Relocations;             // List of cross references. First is 0. Unsorted until Go()
    CMemoryBuffer NameBuffer;                     // String buffer for names of sections. First is 0.
    CSList<SFunctionRecord> FunctionList;         // List of functions 
    int64   ImageBase;                            // Image base for executable files
@@ -697,8 +792,35 @@ protected:
                                                  // 0x100: 16 bit segments, 0x200: 32 bit segments, 0x400: 64 bit segments
    uint32  NamesChanged;                         // Symbol names containing invalid characters changed
    int32   Assumes[6];                           // Assumed value of segment register es, cs, ss, ds, fs, gs. See CDisassembler::WriteSectionName for values
+   uint32  AssumesRead;                          // Bit n = 1 if Assumes[n] has been used before it was changed (for parallel pass 2)
+   uint32  AssumesChanged;                       // Bit n = 1 if Assumes[n] has been changed (for parallel pass 2)
+   uint32  Pass2Stop;                            // Where Pass2Blocks stopped. 0 = end of section, 1 = before function block, 2 = at label
+   uint32  InstructionsDecoded;                  // Number of instructions written in pass 2. Reported by -stats option
+   uint64  CacheLayout;                          // Checksum of options and section table for disassembly cache keys
+   int     CacheWriteFailed;                     // Disassembly cache file could not be written
+   CSList<uint8> CacheAccessLog;                 // Symbols.AccessLog for disassembly cache when not in a worker process
+   CSList<SPass2Symbol> CacheAccessed;           // Symbols used by current section, before first access
+   CSList<int32> CacheSections;                  // Sections searched for symbols by current section
+   CSList<uint64> CacheChecksums;                // Checksum of symbols in section - CACHE_FIRST_SECTION. 0 = not known
+   uint32  CacheChecksumsNum;                    // Number of symbols when CacheChecksums was made
    void    Pass1();                              // Pass 1: Find symbols types and unnamed symbols
    void    Pass2();                              // Pass 2: Write output file
+   int     Pass2Section();                       // Pass 2 for one section
+   void    Pass2SectionInit();                   // Initialize pass 2 for current section
+   int     Pass2Blocks(uint32 BlockStop, uint32 LabelStop, int Continue); // Pass 2 for function blocks in current section
+   void    Pass2Chunk(SPass2Position const & Begin, SPass2Position const & End, uint32 * Skipped); // Pass 2 for a range of sections, function blocks and labels
+   void    Pass2Parallel();                      // Pass 2 divided between worker processes
+   uint64  Pass2Checksum();                      // Checksum of tables that pass 2 must not change in worker process
+   void    GetPass2State(SPass2State & State);   // Save state at boundary between function blocks
+   void    SetPass2State(SPass2State & State);   // Restore state saved by GetPass2State
+   void    CacheInit();                          // Make CacheLayout before pass 2
+   uint64  CacheContent();                       // Make checksum of current section for disassembly cache
+   int     CacheRead(SCacheSection & Cache);     // Replay current section from disassembly cache. Return 0 if not found
+   void    CacheBegin(SCacheSection & Cache);    // Start logging for writing current section to disassembly cache
+   void    CacheWrite(SCacheSection & Cache);    // Write current section to disassembly cache if possible
+   uint64  CacheSectionChecksum(int32 Section);  // Checksum of all symbols in section, remembered until symbols change
+   void    CacheForget();                        // Forget CacheChecksums after symbols have been modified
+   void    CacheForgetSection(int32 Section);    // Forget CacheChecksums entry for one section
    int     NextFunction2();                      // Loop through function blocks in pass 2. Return 0 if finished
    int     NextLabel();                          // Loop through labels. (Pass 2)
    int     NextInstruction1();                   // Go to next instruction. Return 0 if none. (Pass 1)
@@ -707,6 +829,7 @@ protected:
    void    ScanPrefixes();                       // Scan prefixes
    void    StorePrefix(uint32 Category, uint8 Byte);// Store prefix according to category
    void    FindMapEntry();                       // Find entry in opcode maps
+   void    DecodeBenchmark();                    // Measure speed of instruction decoding
    void    FindOperands();                       // Interpret mod/reg/rm and SIB bytes and find operand fields
    void    FindOperandTypes();                   // Determine the types of each operand
    void    FindBroadcast();                      // Find broadcast and offset multiplier for EVEX code
@@ -1,7 +1,7 @@
 /****************************  disasm1.cpp   ********************************
 * Author:        Agner Fog
 * Date created:  2007-02-25
-* Last modified: 2016-11-09
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        disasm1.cpp
 * Description:
@@ -23,6 +23,9 @@ of symbols is kept sorted by address at all times. Named symbols from the
 original file are added to the list with AddSymbol(). New symbols for jump 
 targets and code blocks that do not have a name are added during pass 1 by
 NewSymbol(). AssignNames() assigns names to these unnamed symbols.
+Symbols with an OldIndex that are added with AddSymbol() are appended to the 
+list unsorted, and sorted in one operation by SortNew() the next time the 
+list is accessed. This makes it fast to add a large number of symbols.
 
 A symbol in the list can be found in three different ways: By its address,
 by its old index, and by its new index. The new index is monotonous, so that
@@ -41,12 +44,25 @@ To access a symbol by its old index, you have to translate it with Old2NewIndex
 To access a symbol by its new index, use operator [].
 To find a symbol by its address, use FindByAddress().
 
+Searching by address uses a hash table, AddressHash, when the list has not
+changed since the hash table was made. Old2NewIndex uses the table 
+TranslateOldIndex when the list has not changed since the table was made.
+Otherwise, it finds the symbol by the address of the old index, which never
+changes. The two tables are remade when they have been out of date for more
+lookups than there are symbols, so that the cost of remaking them is 
+proportional to the number of lookups rather than the number of symbols 
+added.
+
 ******************************************************************************/
 
 CSymbolTable::CSymbolTable() {
     // Constructor
     OldNum = 1;
-    NewNum = 0;                                   // Initialize
+    NewNum = NumSorted = 0;                       // Initialize
+    TranslateNum = TranslateStale = 0;
+    AddressHashNum = AddressHashStale = LastFound = 0;
+    AccessLog = 0;  AccessLogSize = 0;            // No logging of symbol access
+    AccessCopy = 0;  SectionLog = 0;
     UnnamedNum = 0;                               // Number of unnamed symbols
     UnnamedSymFormat = 0;                         // Format string for giving names to unnamed symbols
     UnnamedSymbolsPrefix = cmd.SubType == SUBTYPE_GASM ? "$_" : "?_";// Prefix to add to unnamed symbols
@@ -57,6 +73,7 @@ CSymbolTable::CSymbolTable() {
     sym0.Reset();
     sym0.Section = 0x80000000;                    // Lowest possible address
     List.PushSort(sym0);                          // Put into Symbols list
+    NumSorted = 1;
 
     SymbolNameBuffer.Push(0, 1);                  // Make string 0 empty
 }
@@ -108,8 +125,9 @@ uint32 Type, uint32 Scope, uint32 OldIndex, const char * Name, const char * DLLN
         OldIndex = List[NewIndex].OldIndex;
     }
     else {
-        // Make unique entry
-        List.PushSort(NewSym);
+        // Make unique entry. Sorted later by SortNew
+        List.Push(NewSym);
+        SetOldIndexAddress(OldIndex, Section, Offset);
     }
 
     // Set OldNum to 1 + maximum OldIndex
@@ -129,7 +147,8 @@ uint32 CSymbolTable::NewSymbol(SASymbol & sym) {
     // has no name.
 
     // Find new index of any existing symbol with same address
-    int32 SIndex = FindByAddress(sym.Section, sym.Offset);
+    int32 SIndex = FindByAddress(sym.Section, sym.Offset);   // (This calls SortNew if necessary)
+    if ((uint32)SIndex < AccessLogSize) LogAccess(SIndex); // Log access in parallel pass 2
 
     if (SIndex > 0 && !(List[SIndex].Type & 0x80000000)
         && !(sym.Name && List[SIndex].Name)) {
@@ -158,6 +177,8 @@ uint32 CSymbolTable::NewSymbol(SASymbol & sym) {
         if (sym.OldIndex == 0) sym.OldIndex = OldNum++;
 
         SIndex = List.PushSort(sym);
+        NumSorted++;
+        SetOldIndexAddress(sym.OldIndex, sym.Section, sym.Offset);
     }
 
     // Return new index
@@ -255,8 +276,17 @@ uint32 CSymbolTable::FindByAddress(int32 Section, uint32 Offset, uint32 * Last,
     sym.Section = Section;
     sym.Offset  = Offset;
 
+    // Sort any new symbols
+    if (NumSorted != List.GetNumEntries()) SortNew();
+
+    // Remember which sections have been searched, for disassembly cache
+    if (SectionLog && (SectionLog->GetNumEntries() == 0 
+        || (*SectionLog)[SectionLog->GetNumEntries()-1] != Section)) {
+            SectionLog->Push(Section);
+    }
+
     // Search List by address
-    i1 = List.FindFirst(sym);
+    i1 = FindFirstByAddress(sym);
 
     if (i1 == 0 || i1 >= List.GetNumEntries()) {
         // No symbol found at this address or later. Return 0
@@ -321,17 +351,29 @@ uint32 CSymbolTable::FindByAddress(int32 Section, uint32 Offset) {
 
 uint32 CSymbolTable::Old2NewIndex(uint32 OldIndex) {
     // Translate old symbol index to new symbol index
+    uint32 NewIndex;
+
+    // Sort any new symbols
+    if (NumSorted != List.GetNumEntries()) SortNew();
+    NewNum = List.GetNumEntries();
 
     // Check if TranslateOldIndex is up to date
-    if (NewNum != List.GetNumEntries()) {
-        // New entries have been added since last update. Update TranslateOldIndex
+    if (TranslateNum != NewNum) {
+        // New entries have been added since last update. 
+        // Find symbol by its address rather than updating TranslateOldIndex,
+        // unless TranslateOldIndex has been out of date for many lookups
+        if (++TranslateStale <= NewNum) {
+            NewIndex = FindByOldIndex(OldIndex);
+            if (NewIndex) return NewIndex;
+        }
+        // Update TranslateOldIndex
         UpdateIndex();
     }
     // Check if valid
     if (OldIndex >= OldNum) OldIndex = 0;
 
     // Translate old index to new index
-    uint32 NewIndex = TranslateOldIndex[OldIndex];
+    NewIndex = TranslateOldIndex[OldIndex];
 
     // Check limit
     if (NewIndex >= NewNum) NewIndex = 0;
@@ -340,6 +382,97 @@ uint32 CSymbolTable::Old2NewIndex(uint32 OldIndex) {
     return NewIndex;
 }
 
+void CSymbolTable::SetOldIndexAddress(uint32 OldIndex, int32 Section, uint32 Offset) {
+    // Remember address of symbol with this old index
+    if (OldIndex == 0) return;
+    if (OldIndex >= OldIndexAddress.GetNumEntries()) {
+        // Make space. New entries are zero
+        OldIndexAddress.SetNum(OldIndex + 1);
+    }
+    SOldIndexAddress & a = OldIndexAddress[OldIndex];
+    if (a.Status) {
+        // More than one symbol with this old index. Must use TranslateOldIndex
+        a.Status = 2;
+    }
+    else {
+        a.Section = Section;  a.Offset = Offset;  a.Status = 1;
+    }
+}
+
+uint32 CSymbolTable::FindByOldIndex(uint32 OldIndex) {
+    // Find new index of symbol by the address of its old index.
+    // Returns 0 if not found. Use Old2NewIndex instead of calling this directly.
+    uint32 i, Last = 0;
+    if (OldIndex == 0 || OldIndex >= OldNum || OldIndex >= OldIndexAddress.GetNumEntries()
+        || OldIndexAddress[OldIndex].Status != 1) {
+        return 0;                                  // Unknown or ambiguous
+    }
+    // Find all symbols at this address
+    i = FindByAddress(OldIndexAddress[OldIndex].Section, OldIndexAddress[OldIndex].Offset, &Last);
+    // Search for the one with this old index
+    for (; i && i <= Last; i++) {
+        if (List[i].OldIndex == OldIndex) return i;
+    }
+    return 0;                                     // Not found
+}
+
+static inline uint32 AddressHashKey(int32 Section, uint32 Offset) {
+    // Hash function for AddressHash
+    uint32 h = (uint32)Section * 0x9E3779B1u ^ Offset * 0x85EBCA77u;
+    return h ^ (h >> 15);
+}
+
+void CSymbolTable::MakeAddressHash() {
+    // Make hash table for finding the first symbol at each address
+    uint32 i, h, Mask;
+    uint32 n = List.GetNumEntries();              // Number of symbols
+    uint32 HashSize = 16;                         // Size of hash table. Must be a power of 2
+    while (HashSize < n * 2) HashSize <<= 1;
+    AddressHash.SetNum(HashSize);
+    memset(&AddressHash[0], 0, HashSize * sizeof(uint32));
+    Mask = HashSize - 1;
+    // Insert first symbol at each address. Symbol 0 is a dummy
+    for (i = 1; i < n; i++) {
+        if (!(List[i-1] < List[i])) continue;      // Same address as previous
+        h = AddressHashKey(List[i].Section, List[i].Offset) & Mask;
+        while (AddressHash[h]) h = (h + 1) & Mask; // Linear probing
+        AddressHash[h] = i;
+    }
+    AddressHashNum = n;
+    AddressHashStale = 0;
+}
+
+uint32 CSymbolTable::FindFirstByAddress(SASymbol const & sym) {
+    // Find new index of first symbol with address >= the address of sym.
+    // Gives the same result as List.FindFirst(sym), but uses AddressHash if
+    // it is up to date, or the result of the previous search if that fits.
+    uint32 i, h, Mask;
+    uint32 n = List.GetNumEntries();              // Number of symbols
+
+    if (AddressHashNum != n) {
+        // Symbols have been added. Remake hash table if it has missed many lookups
+        if (++AddressHashStale > n) MakeAddressHash();
+    }
+    if (AddressHashNum == n) {
+        // Hash table is up to date. Look for symbol at this exact address
+        Mask = AddressHash.GetNumEntries() - 1;
+        h = AddressHashKey(sym.Section, sym.Offset) & Mask;
+        while ((i = AddressHash[h]) != 0) {
+            if (List[i].Section == sym.Section && List[i].Offset == sym.Offset) {
+                return LastFound = i;               // Found
+            }
+            h = (h + 1) & Mask;
+        }
+    }
+    // Consecutive searches are often for nearby addresses. 
+    // Check if the result is the same as last time
+    if (LastFound < n && !(List[LastFound] < sym) && (LastFound == 0 || List[LastFound-1] < sym)) {
+        return LastFound;
+    }
+    // Binary search
+    return LastFound = List.FindFirst(sym);
+}
+
 const char * CSymbolTable::HasName(uint32 symo) {
     // Ask if symbol has a name, input = old index, output = name or 0
     // Returns 0 if symbol has no name yet.
@@ -417,10 +550,54 @@ void CSymbolTable::AssignName(uint32 symi, const char *name) {
     (*this)[symi].Name = SymbolNameBuffer.PushString(name);
 }
 
+void CSymbolTable::LogAccess(uint32 NewIndex) {
+    // Mark symbol as accessed. Called from operator [] when AccessLogSize > 0.
+    // The first time a symbol is accessed, it is copied to AccessCopy so that
+    // the disassembly cache can see if it has been modified
+    if (AccessCopy && !(AccessLog[NewIndex] & 2)) {
+        SPass2Symbol Copy;
+        Copy.Index = NewIndex;
+        Copy.Symbol = List[NewIndex];
+        AccessCopy->Push(Copy);
+        AccessLog[NewIndex] |= 2;
+    }
+    AccessLog[NewIndex] |= 1;
+}
+
+void CSymbolTable::LogSection(int32 Section) {
+    // Mark all symbols in section as accessed
+    uint32 i, Num = 0;
+    uint32 First = FindSection(Section, &Num);
+    for (i = First; i < First + Num && i < AccessLogSize; i++) AccessLog[i] |= 1;
+}
+
+uint32 CSymbolTable::FindSection(int32 Section, uint32 * Num) {
+    // Find the new index of the first symbol in section.
+    // Num receives the number of symbols in the section
+    SASymbol sym;
+    sym.Reset();
+    sym.Section = Section;
+    if (NumSorted != List.GetNumEntries()) SortNew();
+    uint32 i, First = FindFirstByAddress(sym);
+    for (i = First; i < List.GetNumEntries() && List[i].Section == Section; i++);
+    *Num = i - First;
+    return First;
+}
+
+void CSymbolTable::SortNew() {
+    // Sort symbols that have been added unsorted by AddSymbol, 
+    // and merge them into the sorted list
+    List.MergeNew(NumSorted);
+    NumSorted = List.GetNumEntries();
+}
+
 void CSymbolTable::UpdateIndex() {
     // Update TranslateOldIndex
     uint32 i;                                     // New index
 
+    // Sort any new symbols
+    if (NumSorted != List.GetNumEntries()) SortNew();
+
     // Allocate array with sufficient size
     TranslateOldIndex.SetNum(OldNum);
 
@@ -437,7 +614,8 @@ void CSymbolTable::UpdateIndex() {
             List[i].OldIndex = 0;                   // Reset index that was out of range
         }
     }
-    NewNum = List.GetNumEntries();
+    NewNum = TranslateNum = List.GetNumEntries();
+    TranslateStale = 0;
 }
 
 
@@ -456,7 +634,11 @@ CDisassembler::CDisassembler() {
     Buffer = 0;
     InstructionSetMax = InstructionSetAMDMAX = 0;
     InstructionSetOR = FlagPrevious = NamesChanged = 0;
+    AssumesRead = AssumesChanged = 0;
+    Pass2Stop = InstructionsDecoded = 0;
+    MakeFlatOpcodeTables();                       // Make flattened opcode maps if not already made
     WordSize = MasmOptions = RelocationsInSource = ExeType = 0;
+    Pass = 0;                                     // Go() not started yet
     ImageBase = 0;
     Syntax = cmd.SubType;                         // Assembly syntax dialect
     if (Syntax == SUBTYPE_GASM) {
@@ -644,7 +826,14 @@ uint32 ReferenceIndex) {                      // Symbol index of reference point
         RelRec.RefOldIndex = ReferenceIndex;
 
         // Save relocation record
-        Relocations.PushSort(RelRec);
+        if (Pass) {
+            // Relocation found during disassembly. Keep list sorted
+            Relocations.PushSort(RelRec);
+        }
+        else {
+            // Relocation from original file. Relocations are sorted in Go()
+            Relocations.Push(RelRec);
+        }
     }
     else {
         // Make entry in procedure linkage table
@@ -665,14 +854,20 @@ uint32 ReferenceIndex) {                      // Symbol index of reference point
 
 void CDisassembler::Go() {
     // Do the disassembly
+    CStatTimer Timer("CDisassembler");           // Measure time if -stats option
+
+    // Sort relocations added by AddRelocation. Same order as if sorted one by one
+    Relocations.MergeNew(1);
 
     // Check for illegal entries in relocations table
     InitialErrorCheck();
 
     // Find missing relocation target addresses
     FixRelocationTargetAddresses();
+    if (cmd.Stats) cmd.StopTimer(STAT_SYMBOLS);  // Started by converter
 
     // Pass 1: Find symbols types and unnamed symbols
+    if (cmd.Stats) cmd.StartTimer(STAT_PASS1);
     Pass = 1;
     Pass1();
     Pass = 2;
@@ -691,6 +886,7 @@ void CDisassembler::Go() {
 
     // Fix invalid characters in symbol and section names
     CheckNamesValid();
+    if (cmd.Stats) cmd.StopTimer(STAT_PASS1);
 
 #if 0 //
     // Show function list. For debugging only
@@ -718,18 +914,48 @@ void CDisassembler::Go() {
     }
 #endif
 
+    // Write output file in chunks during pass 2 rather than keeping
+    // all the text in memory if requested. The text goes to a temporary
+    // file which main renames to the output file if there are no errors,
+    // so that an existing output file is not overwritten by incomplete output
+    FILE * StreamFile = 0;
+    if (cmd.StreamOutput && cmd.OutputFile && (cmd.FileOptions & CMDL_FILE_OUTPUT)
+    && strlen(cmd.OutputFile) <= MAXFILENAMELENGTH) {
+        sprintf(cmd.StreamFileName, "%s.tmp", cmd.OutputFile);
+        StreamFile = fopen(cmd.StreamFileName, "wb");
+        // If the file cannot be opened then the text is kept in memory and written by main
+        OutFile.SetStream(StreamFile);
+    }
+
     // Begin writing output file
     WriteFileBegin();
 
     // Pass 2: Write all sections to output file
+    if (cmd.Stats) cmd.StartTimer(STAT_PASS2);
     Pass = 0x10;
     Pass2();
+    if (cmd.Stats) cmd.StopTimer(STAT_PASS2);
 
     // Check for illegal entries in symbol table and relocations table
     FinalErrorCheck();
 
     // Finish writing output file
     WriteFileEnd();
+
+    if (StreamFile) {
+        // Write the rest of the text and close file
+        int Success = OutFile.FlushStream();
+        OutFile.SetStream(0);
+        if (fclose(StreamFile) != 0) Success = 0;
+        if (!Success) err.submit(2104, cmd.StreamFileName); // Error writing file
+        cmd.OutputStreamed = 1;              // Tell main to rename the file rather than write the empty buffer
+    }
+
+    // Count for -stats option. Entry 0 in the tables is a dummy
+    cmd.CountDisassembly(InstructionsDecoded, Symbols.GetNumEntries() - 1, Relocations.GetNumEntries() - 1);
+
+    // Measure decoding speed if requested
+    if (cmd.Benchmark) DecodeBenchmark();
 };
 
 void CDisassembler::Pass1() {
@@ -1278,97 +1504,1171 @@ void CDisassembler::Pass2() {
     to produce identical code.
     */
 
+    // Prepare disassembly cache, if any
+    if (cmd.CacheDirectory) CacheInit();
+
+    if (cmd.Threads > 1) {
+        // Divide the work between worker processes
+        Pass2Parallel();
+        return;
+    }
+
     // Loop through sections, pass 2
     for (Section = 1; Section < Sections.GetNumEntries(); Section++) {
+        Pass2Section();
+    }
+}
 
-        // Get section type
-        SectionType = Sections[Section].Type;
-        if (SectionType & 0x800) continue;         // This is a group
 
-        if (((SectionType & 0xFF) == 0x10) && cmd.DebugInfo == CMDL_DEBUG_STRIP) {
-            // Skip debug section
-            cmd.CountDebugRemoved();
-            continue;
-        }
-        if (((SectionType & 0xFF) == 0x11) && cmd.ExeptionInfo == CMDL_EXCEPTION_STRIP) {
-            // Skip exception section
-            cmd.CountExceptionRemoved();
-            continue;
-        }
-        // Is this code or data?
-        CodeMode = ((SectionType & 0xFF) == 1) ? 1 : 4;
+int CDisassembler::Pass2Section() {
+    // Pass 2 for one section. Section = index into Sections
+    // Return value: 0 = written or group, 1 = debug section skipped, 2 = exception section skipped
 
-        // Initialize
-        LabelBegin = FlagPrevious = CountErrors = 0;
-        Buffer = Sections[Section].Start;
-        SectionEnd = Sections[Section].TotalSize;
-        LabelInaccessible = Sections[Section].InitSize;
-        WordSize = Sections[Section].WordSize;
-        SectionAddress = Sections[Section].SectionAddress;
+    // Get section type
+    SectionType = Sections[Section].Type;
+    if (SectionType & 0x800) return 0;         // This is a group
+
+    if (((SectionType & 0xFF) == 0x10) && cmd.DebugInfo == CMDL_DEBUG_STRIP) {
+        // Skip debug section
+        cmd.CountDebugRemoved();
+        return 1;
+    }
+    if (((SectionType & 0xFF) == 0x11) && cmd.ExeptionInfo == CMDL_EXCEPTION_STRIP) {
+        // Skip exception section
+        cmd.CountExceptionRemoved();
+        return 2;
+    }
+    // Initialize
+    Pass2SectionInit();
+
+    // Replay section from disassembly cache if possible
+    SCacheSection Cache;
+    if (cmd.CacheDirectory) {
+        if (CacheRead(Cache)) return 0;
+        CacheBegin(Cache);
+    }
+
+    // Write segment directive
+    WriteSegmentBegin();
+
+    // Loop through function blocks in this section
+    Pass2Blocks(0, 0, 0);
+
+    // Write end of segment
+    WriteSegmentEnd();
+
+    // Save section in disassembly cache
+    if (cmd.CacheDirectory) CacheWrite(Cache);
+    return 0;
+}
+
+void CDisassembler::Pass2SectionInit() {
+    // Initialize pass 2 for beginning of current section
+    SectionType = Sections[Section].Type;
 
-        // Write segment directive
-        WriteSegmentBegin();
+    // Is this code or data?
+    CodeMode = ((SectionType & 0xFF) == 1) ? 1 : 4;
 
-        IBegin = IEnd = LabelEnd = IFunction = DataType = DataSize = 0;
+    // Initialize
+    LabelBegin = FlagPrevious = CountErrors = 0;
+    Buffer = Sections[Section].Start;
+    SectionEnd = Sections[Section].TotalSize;
+    LabelInaccessible = Sections[Section].InitSize;
+    WordSize = Sections[Section].WordSize;
+    SectionAddress = Sections[Section].SectionAddress;
+
+    IBegin = IEnd = LabelEnd = IFunction = DataType = DataSize = 0;
+}
 
-        // Loop through function blocks in this section
-        while (NextFunction2()) {
+int CDisassembler::Pass2Blocks(uint32 BlockStop, uint32 LabelStop, int Continue) {
+    // Loop through function blocks in current section, pass 2.
+    // BlockStop: Stop in this function block (index into FunctionList). 0 = continue to end of section.
+    // LabelStop: Stop at the first label at this address or later in function block BlockStop.
+    //            0 = stop before function block BlockStop.
+    // Continue:  0 = begin with the function block after IFunction (normally start of section).
+    //            1 = continue after stop before function block IFunction.
+    //            2 = continue after stop at label.
+    //            3 = begin at label IEnd in function block IFunction without writing function begin.
+    // Return value: 0 = end of section, 1 = stopped before function block, 2 = stopped at label.
+    // The return value is also saved in Pass2Stop
+    int LabelContinue;                            // Continue at label without calling NextLabel
+
+    // Loop through function blocks in this section
+    while (Continue || NextFunction2()) {
+
+        LabelContinue = Continue == 2;
+        if (Continue < 2) {
+            // Check if end of range
+            if (BlockStop && (IFunction > BlockStop || (IFunction == BlockStop && LabelStop == 0))) {
+                return Pass2Stop = 1;
+            }
 
             // Check CodeMode from label
             NextLabel();
 
             // Write begin function
             if (CodeMode & 3) WriteFunctionBegin();
+        }
+        Continue = 0;
 
-            // Loop through labels
-            while (NextLabel()) {
+        // Loop through labels
+        while (LabelContinue || NextLabel()) {
 
-                // Loop through code
-                while (NextInstruction2()) {
+            if (LabelContinue) {
+                LabelContinue = 0;
+            }
+            else if (LabelStop && IFunction == BlockStop && IBegin >= LabelStop) {
+                // End of range
+                return Pass2Stop = 2;
+            }
 
-                    if (CodeMode & 3) {
-                        // Interpret this as code
+            // Loop through code
+            while (NextInstruction2()) {
 
-                        // Write label if any
-                        CheckLabel();
+                if (CodeMode & 3) {
+                    // Interpret this as code
 
-                        // Parse instruction
-                        ParseInstruction();
+                    // Write label if any
+                    CheckLabel();
 
-                        // Check for filling space
-                        if (((s.Warnings1 & 0x10000000) || s.Warnings1 == 0x1000000) && WriteFillers()) {
-                            // Code is inaccessible fillers. Has been written by CheckForFillers()
-                            continue;
-                        }
+                    // Parse instruction
+                    ParseInstruction();
 
-                        // Write any error and warning messages to OutFile
-                        WriteErrorsAndWarnings();
+                    // Check for filling space
+                    if (((s.Warnings1 & 0x10000000) || s.Warnings1 == 0x1000000) && WriteFillers()) {
+                        // Code is inaccessible fillers. Has been written by CheckForFillers()
+                        continue;
+                    }
 
-                        // Write instruction to OutFile
-                        WriteInstruction();
+                    InstructionsDecoded++;        // Count for -stats option
 
-                        // Write hex code as comment after instruction
-                        WriteCodeComment();
-                    }
-                    if (CodeMode & 6) {
+                    // Write any error and warning messages to OutFile
+                    WriteErrorsAndWarnings();
 
-                        // Interpret this as data
-                        WriteDataItems();
-                    }
-                    if (IEnd <= IBegin) {
+                    // Write instruction to OutFile
+                    WriteInstruction();
+
+                    // Write hex code as comment after instruction
+                    WriteCodeComment();
+                }
+                if (CodeMode & 6) {
+
+                    // Interpret this as data
+                    WriteDataItems();
+                }
+                if (IEnd <= IBegin) {
+
+                    // Prevent infinite loop
+                    IEnd++;
+                    break;
+                }
+            }
+        }
+        // Write end of function, if any
+        if (CodeMode & 3) WriteFunctionEnd();         // End function
+    }
+    return Pass2Stop = 0;
+}
+
+void CDisassembler::Pass2Chunk(SPass2Position const & Begin, SPass2Position const & End, uint32 * Skipped) {
+    // Pass 2 from position Begin to position End.
+    // Begin.Block > 0: Continue with the current state in the middle of Begin.Section.
+    // End.Block > 0: Stop in the middle of End.Section and leave Section unchanged.
+    // Skipped: Counts of return values from Pass2Section
+    int Stop;                                     // Chunk ends in this section
+    for (Section = Begin.Section; Section < End.Section || (Section == End.Section && End.Block); Section++) {
+        Stop = Section == End.Section;
+        // Symbols modified in part of a section are not tracked by the disassembly cache
+        if ((Section == Begin.Section && Begin.Block) || Stop) CacheForget();
+        if (Section == Begin.Section && Begin.Block) {
+            // Continue in the middle of section, unless the section was finished
+            if (Pass2Stop) {
+                if (Pass2Blocks(Stop ? End.Block : 0, Stop ? End.Label : 0, Pass2Stop)) return;
+                WriteSegmentEnd();
+            }
+        }
+        else if (Stop) {
+            // Begin section and stop in the middle
+            Pass2SectionInit();
+            WriteSegmentBegin();
+            if (Pass2Blocks(End.Block, End.Label, 0)) return;
+            WriteSegmentEnd();
+        }
+        else {
+            // Whole section
+            Skipped[Pass2Section()]++;
+        }
+        // Stop position not reached because the section ended first
+        if (Stop) return;
+    }
+}
+
+void CDisassembler::GetPass2State(SPass2State & State) {
+    // Save state at boundary between function blocks in pass 2
+    memset(&State, 0, sizeof(State));
+    State.s = s;
+    State.t = t;
+    for (int i = 0; i < 16; i++) {
+        // Values of unused tracer registers do not matter
+        if (t.Regist[i] == 0) State.t.Value[i] = 0;
+    }
+    State.Section = Section;
+    State.IBegin = IBegin;
+    State.IEnd = IEnd;
+    State.IFunction = IFunction;
+    State.FunctionEnd = FunctionEnd;
+    State.LabelBegin = LabelBegin;
+    State.LabelEnd = LabelEnd;
+    // LabelInaccessible has no effect when it is outside the rest of the section
+    State.LabelInaccessible = (LabelInaccessible >= IBegin && LabelInaccessible < SectionEnd) ? LabelInaccessible : SectionEnd;
+    State.CodeMode = CodeMode;
+    State.DataType = DataType;
+    State.DataSize = DataSize;
+    State.FlagPrevious = FlagPrevious;
+    State.CountErrors = CountErrors;
+    State.Opcodei = Opcodei;
+    State.OpcodeOptions = OpcodeOptions;
+    State.PreviousOpcodei = PreviousOpcodei;
+    State.PreviousOpcodeOptions = PreviousOpcodeOptions;
+    State.Column = OutFile.GetColumn();
+    State.Stop = Pass2Stop;
+}
+
+void CDisassembler::SetPass2State(SPass2State & State) {
+    // Restore state saved by GetPass2State
+    Section = State.Section;
+    Pass2SectionInit();
+    s = State.s;
+    t = State.t;
+    IBegin = State.IBegin;
+    IEnd = State.IEnd;
+    IFunction = State.IFunction;
+    FunctionEnd = State.FunctionEnd;
+    LabelBegin = State.LabelBegin;
+    LabelEnd = State.LabelEnd;
+    LabelInaccessible = State.LabelInaccessible;
+    CodeMode = State.CodeMode;
+    DataType = State.DataType;
+    DataSize = State.DataSize;
+    FlagPrevious = State.FlagPrevious;
+    CountErrors = State.CountErrors;
+    Opcodei = State.Opcodei;
+    OpcodeOptions = State.OpcodeOptions;
+    PreviousOpcodei = State.PreviousOpcodei;
+    PreviousOpcodeOptions = State.PreviousOpcodeOptions;
+    OutFile.SetColumn(State.Column);
+    Pass2Stop = State.Stop;
+}
+
+/********************  Explanation of parallel pass 2:  ********************
+
+Pass 2 takes most of the time when disassembling a big file. The option
+-threads:N divides the code into N chunks of similar size and disassembles
+each chunk in a separate worker process. A chunk begins at the start of a
+section, at a function block in a code section, or at a label inside a big
+function block, so that a big code section can be divided. A process is used rather than a thread because the
+disassembler keeps all its state in member variables and in the global cmd
+and err objects, and because pass 2 may modify the symbol table. The worker
+inherits a copy of everything from fork() so that the tables in the main
+process are left untouched.
+
+A worker that begins in the middle of a section cannot know the state that
+pass 2 has at this point. It disassembles the preceding function block or
+the code from the preceding label first in order to get the state, and
+discards the output from this part. The state
+at the boundary is saved in a SPass2State record.
+
+Each worker writes a SPass2Result record to a temporary file, followed by a
+table of the symbols it has accessed, the symbols it has modified, and the
+text it has added to OutFile. The main process collects the results in
+order. The result of a worker is used only if:
+
+1.  The worker has not added any symbols, changed any names, relocations,
+    sections or functions, and has not given any error or warning messages.
+
+2.  The worker has not accessed any symbol that has been modified by a
+    previous chunk. The "written" flag (Scope bit 0x100) is not counted as
+    a modification because it is read only for symbols in the current
+    section.
+
+3.  The state at the end of the previous chunk is the same as the state
+    that the worker started with. This applies to the column of OutFile,
+    to the SPass2State record if the chunk begins in the middle of a
+    section, and to those Assumes that the worker has used before changing
+    them (MASM syntax only).
+
+A chunk for which the result cannot be used is disassembled again by the
+main process in the ordinary way, starting with the state at the end of the
+previous chunk. If this changes the tables, then the rest is done by the
+main process as well. The output is therefore the same as with a single
+process in all cases.
+
+*****************************************************************************/
+
+// Record written by worker process in parallel pass 2
+struct SPass2Result {
+   uint32 Status;                                // 1 = result can be used. 2 = shared tables changed
+   SPass2State BeginState;                       // State at start of chunk
+   SPass2State EndState;                         // State at end of chunk
+   int32  BeginAssumes[6];                       // Assumed segment registers at start of chunk
+   int32  EndAssumes[6];                         // Assumed segment registers at end of chunk
+   uint32 AssumesRead;                           // Bit n = 1 if initial value of Assumes[n] was used
+   uint32 AssumesChanged;                        // Bit n = 1 if Assumes[n] was changed
+   uint32 MasmOptions;                           // MasmOptions at end of chunk
+   uint32 InstructionSetMax;                     // InstructionSetMax at end of chunk
+   uint32 InstructionSetAMDMAX;                  // InstructionSetAMDMAX at end of chunk
+   uint32 InstructionSetOR;                      // InstructionSetOR at end of chunk
+   uint32 Skipped[3];                            // Number of sections written, debug sections skipped, exception sections skipped
+   uint32 NumSymbols;                            // Size of table of accessed symbols following this record
+   uint32 NumModified;                           // Number of SPass2Symbol records following
+   uint32 OutputSize;                            // Size of text following the symbol records
+   uint32 Instructions;                          // Number of instructions written by worker
+};
+
+// Add bytes to 64-bit FNV-1a checksum
+static uint64 Checksum64(uint64 h, const void * p, uint32 n) {
+   const uint8 * q = (const uint8 *)p;
+   while (n--) {
+      h = (h ^ *q++) * 0x100000001B3ULL;
+   }
+   return h;
+}
 
-                        // Prevent infinite loop
-                        IEnd++;
-                        break;
+uint64 CSymbolTable::Checksum(uint64 h) {
+    // Make checksum of the number of symbols and names.
+    // Modifications of existing symbols are not included
+    uint32 Sizes[4] = {List.GetNumEntries(), SymbolNameBuffer.GetDataSize(), OldNum, UnnamedNum};
+    return Checksum64(h, Sizes, sizeof(Sizes));
+}
+
+uint64 CSymbolTable::SymbolChecksum(uint64 h, uint32 symi) {
+    // Make checksum of symbol address, size, type, scope and names.
+    // The "written" flag and the old index are not included.
+    // No name is assigned if the symbol has none
+    if (symi >= List.GetNumEntries()) symi = 0;
+    SASymbol & sym = List[symi];
+    uint32 Rec[5] = {(uint32)sym.Section, sym.Offset, sym.Size, sym.Type, sym.Scope & ~0x100};
+    h = Checksum64(h, Rec, sizeof(Rec));
+    const char * Name = sym.Name < SymbolNameBuffer.GetDataSize() ? SymbolNameBuffer.Buf() + sym.Name : "";
+    h = Checksum64(h, Name, (uint32)strlen(Name) + 1);
+    Name = sym.DLLName < SymbolNameBuffer.GetDataSize() ? SymbolNameBuffer.Buf() + sym.DLLName : "";
+    return Checksum64(h, Name, (uint32)strlen(Name) + 1);
+}
+
+uint64 CSymbolTable::SectionChecksum(uint64 h, int32 Section) {
+    // Make checksum of all symbols in section
+    uint32 i, Num = 0;
+    uint32 First = FindSection(Section, &Num);
+    for (i = First; i < First + Num; i++) h = SymbolChecksum(h, i);
+    return h;
+}
+
+uint64 CDisassembler::Pass2Checksum() {
+    // Make checksum of the tables that must not be changed by a worker process in parallel pass 2
+    uint64 h = Symbols.Checksum(0xCBF29CE484222325ULL);
+    if (Relocations.GetNumEntries()) {
+        h = Checksum64(h, &Relocations[0], Relocations.GetNumEntries() * sizeof(SARelocation));
+    }
+    if (Sections.GetNumEntries()) {
+        h = Checksum64(h, &Sections[0], Sections.GetNumEntries() * sizeof(SASection));
+    }
+    if (FunctionList.GetNumEntries()) {
+        h = Checksum64(h, &FunctionList[0], FunctionList.GetNumEntries() * sizeof(SFunctionRecord));
+    }
+    uint32 Size = NameBuffer.GetDataSize();
+    return Checksum64(h, &Size, sizeof(Size));
+}
+
+void CDisassembler::Pass2Parallel() {
+    // Pass 2 divided between worker processes. See explanation above
+    uint32 NumSections = Sections.GetNumEntries();
+    uint32 Skipped[3] = {0, 0, 0};               // Sections skipped
+#ifdef WORKER_PROCESSES_SUPPORTED
+    uint32 NumChunks = cmd.Threads;              // Number of chunks
+    uint32 NumSymbols = Symbols.GetNumEntries(); // Number of symbols before pass 2
+    uint32 Total = 0;                            // Total size of all sections
+    uint32 Sum = 0;                              // Size of sections and blocks so far
+    uint32 Size;                                 // Size of section or function block
+    uint32 Begin, End;                           // Start and end of function block
+    uint32 Block, Next;                          // Function block index
+    uint32 First;                                // First function block in section
+    uint32 Label;                                // Address of label where a chunk begins
+    uint32 sym, sym2, sym3;                      // Symbol indices
+    uint64 Target;                               // Desired position of next chunk
+    uint32 i, k;                                 // Loop counters
+    int    Count;                                // 0 = count sizes, 1 = make chunks
+    SFunctionRecord Fun;                         // Function record for searching
+    memset(&Fun, 0, sizeof(Fun));
+    SPass2Position Pos;                          // Position where a chunk begins
+    CSList<SPass2Position> Chunks;               // Start of each chunk. Last entry is end of last chunk
+
+    // Divide sections, function blocks and big function blocks into contiguous chunks of similar size
+    for (Count = 0; Count < 2; Count++) {
+        for (Section = 1; Section < NumSections; Section++) {
+            if (Sections[Section].Type & 0x800) continue;  // Group
+            Size = Sections[Section].InitSize;
+            Fun.Section = Section;  Fun.Start = 0;
+            First = Block = FunctionList.FindFirst(Fun);
+            if ((Sections[Section].Type & 0xFF) != 1 || Block == 0 || Block >= FunctionList.GetNumEntries()
+            || FunctionList[Block].Section != (int32)Section) {
+                // Not a code section with function blocks. Use whole section
+                First = Block = 0;
+            }
+            do {
+                // Get size of function block or section
+                Next = 0;
+                if (Block && Block + 1 < FunctionList.GetNumEntries() && FunctionList[Block+1].Section == (int32)Section) {
+                    Next = Block + 1;
+                }
+                Begin = Block > First ? FunctionList[Block].Start : 0;
+                End = Next ? FunctionList[Next].Start : Size;
+                if (End < Begin) End = Begin;
+                Pos.Section = Section;  Pos.Block = Block > First ? Block : 0;
+                Pos.Label = Pos.Warmup = 0;
+                if (Count && Chunks.GetNumEntries() < NumChunks
+                && (uint64)Sum * NumChunks >= (uint64)Total * Chunks.GetNumEntries()) {
+                    // Start a new chunk here
+                    Chunks.Push(Pos);
+                }
+                // A big function block can be divided at labels
+                Label = Block ? FunctionList[Block].Start : 0;
+                while (Count && Block && Chunks.GetNumEntries() < NumChunks) {
+                    Target = ((uint64)Total * Chunks.GetNumEntries() + NumChunks - 1) / NumChunks;
+                    if (Target >= (uint64)Sum + (End - Begin)) break;
+                    // Find first label at or after the desired position
+                    sym = Symbols.FindByAddress(Section, Begin + (uint32)(Target > Sum ? Target - Sum : 0), &sym2, &sym3);
+                    if (sym == 0) sym = sym3;
+                    if (sym < 2 || sym >= Symbols.GetNumEntries() || Symbols[sym].Section != (int32)Section
+                    || Symbols[sym].Offset <= Label || Symbols[sym].Offset >= End
+                    || Symbols[sym-1].Section != (int32)Section || Symbols[sym-1].Offset < FunctionList[Block].Start) {
+                        break;                   // No suitable label
                     }
+                    // The worker begins disassembling at the preceding label to get the state
+                    Pos.Block = Block;
+                    Pos.Label = Label = Symbols[sym].Offset;
+                    Pos.Warmup = Symbols[sym-1].Offset;
+                    Chunks.Push(Pos);
                 }
+                Sum += (End - Begin) + 16;
+                Block = Next;
+            } while (Block);
+        }
+        Total = Sum;  Sum = 0;
+    }
+    NumChunks = Chunks.GetNumEntries();
+    Pos.Section = NumSections;  Pos.Block = Pos.Label = Pos.Warmup = 0;
+    Chunks.Push(Pos);
+
+    if (NumChunks < 2) {
+        // Nothing to divide
+        Pass2Chunk(Chunks[0], Chunks[NumChunks], Skipped);
+        return;
+    }
+
+    // State at start of pass 2. Every worker starts with this
+    SPass2State StartState;
+    int32  StartAssumes[6];
+    uint32 StartMasmOptions = MasmOptions;
+    uint8  StartInstructionSetMax = InstructionSetMax;
+    uint8  StartInstructionSetAMDMAX = InstructionSetAMDMAX;
+    uint16 StartInstructionSetOR = InstructionSetOR;
+    GetPass2State(StartState);
+    memcpy(StartAssumes, Assumes, sizeof(Assumes));
+
+    CArrayBuf<FILE*> ResultFiles;                // Temporary file for result of each worker
+    CArrayBuf<int> Workers;                      // Process id of each worker. -1 if failed
+    CArrayBuf<int> Succeeded;                    // 1 if worker finished normally
+    CArrayBuf<uint8> Accessed;                   // Symbols accessed by a worker
+    CSList<SASymbol> OldSymbols;                 // Copy of symbol table before chunk
+    ResultFiles.SetNum(NumChunks);
+    Workers.SetNum(NumChunks);
+    Succeeded.SetNum(NumChunks);
+    Accessed.SetNum(NumSymbols);
+    OldSymbols.SetNum(NumSymbols);
+
+    // Make sure buffered output is not written twice
+    fflush(stdout);  fflush(stderr);
+
+    // Start worker processes
+    for (k = 0; k < NumChunks; k++) {
+        ResultFiles[k] = tmpfile();
+        Workers[k] = ResultFiles[k] ? fork() : -1;
+        if (Workers[k] != 0) continue;
+
+        // This is the worker process. Messages are repeated by the main process if necessary
+        OutFile.SetStream(0);                      // Text goes to result file, not to output file
+        freopen("/dev/null", "w", stdout);
+        freopen("/dev/null", "w", stderr);
+        FILE * f = ResultFiles[k];
+        SPass2Result Result;
+        memset(&Result, 0, sizeof(Result));
+        uint64 Check = Pass2Checksum();
+        int    NumMessages = err.NumMessages();
+        int    Usable = 1;
+        for (i = 0; i < NumSymbols; i++) OldSymbols[i] = Symbols[i];
+
+        if (Chunks[k].Block) {
+            // Chunk begins in the middle of a section. Disassemble the preceding
+            // function block or label to get the state at the boundary. Discard the output
+            Section = Chunks[k].Section;
+            Pass2SectionInit();
+            if (Chunks[k].Label) {
+                // Begin at preceding label in same function block
+                IFunction = Chunks[k].Block - 1;
+                IBegin = FunctionList[Chunks[k].Block].Start;
+                NextFunction2();
+                IBegin = IEnd = Chunks[k].Warmup;
+                Usable = Pass2Blocks(Chunks[k].Block, Chunks[k].Label, 3) == 2;
+            }
+            else {
+                // Begin at preceding function block
+                IFunction = Chunks[k].Block - 2;
+                IBegin = IEnd = FunctionList[Chunks[k].Block - 1].Start;
+                Usable = Pass2Blocks(Chunks[k].Block, 0, 0) == 1;
+            }
+            // Symbols modified here must not be used in the rest of the chunk
+            CacheForget();
+            for (i = 0; i < NumSymbols; i++) {
+                Accessed[i] = memcmp(&OldSymbols[i], &Symbols[i], sizeof(SASymbol)) != 0;
+                OldSymbols[i] = Symbols[i];
+            }
+            // Accumulate from here
+            MasmOptions = StartMasmOptions;
+            InstructionSetMax = StartInstructionSetMax;
+            InstructionSetAMDMAX = StartInstructionSetAMDMAX;
+            InstructionSetOR = StartInstructionSetOR;
+        }
+        uint32 OutStart = OutFile.GetDataSize();
+        uint32 Decoded = InstructionsDecoded;    // Instructions counted before chunk, including discarded warmup
+        GetPass2State(Result.BeginState);
+        memcpy(Result.BeginAssumes, Assumes, sizeof(Assumes));
+        CArrayBuf<uint8> WarmupModified;         // Symbols modified before start of chunk
+        WarmupModified.SetNum(NumSymbols);
+        for (i = 0; i < NumSymbols; i++) {
+            WarmupModified[i] = Accessed[i];  Accessed[i] = 0;
+        }
+
+        // Disassemble chunk while logging the use of symbols and Assumes
+        Symbols.AccessLog = &Accessed[0];
+        Symbols.AccessLogSize = NumSymbols;
+        AssumesRead = AssumesChanged = 0;
+        Pass2Chunk(Chunks[k], Chunks[k+1], Result.Skipped);
+        Symbols.AccessLogSize = 0;               // Stop logging
+
+        for (i = 0; i < NumSymbols; i++) {
+            if (Accessed[i] & WarmupModified[i]) Usable = 0;
+        }
+        if (!Usable || Symbols.GetNumEntries() != NumSymbols || Pass2Checksum() != Check
+        || err.NumMessages() != NumMessages) {
+            // Result cannot be used. The main process must do this chunk
+            Result.Status = 2;
+            fwrite(&Result, sizeof(Result), 1, f);
+            _exit(fflush(f) == 0 ? 0 : 1);
+        }
+        Result.Status = 1;
+        GetPass2State(Result.EndState);
+        memcpy(Result.EndAssumes, Assumes, sizeof(Assumes));
+        Result.AssumesRead = AssumesRead;
+        Result.AssumesChanged = AssumesChanged;
+        Result.MasmOptions = MasmOptions;
+        Result.InstructionSetMax = InstructionSetMax;
+        Result.InstructionSetAMDMAX = InstructionSetAMDMAX;
+        Result.InstructionSetOR = InstructionSetOR;
+        Result.NumSymbols = NumSymbols;
+        Result.OutputSize = OutFile.GetDataSize() - OutStart;
+        Result.Instructions = InstructionsDecoded - Decoded;
+        // Find modified symbols
+        CSList<SPass2Symbol> ModifiedList;       // Symbols modified by this worker
+        SPass2Symbol ModSym;
+        for (i = 0; i < NumSymbols; i++) {
+            if (memcmp(&OldSymbols[i], &Symbols[i], sizeof(SASymbol))) {
+                memset(&ModSym, 0, sizeof(ModSym));
+                ModSym.Index = i;
+                ModSym.Symbol = Symbols[i];
+                ModifiedList.Push(ModSym);
+            }
+        }
+        Result.NumModified = ModifiedList.GetNumEntries();
+        fwrite(&Result, sizeof(Result), 1, f);
+        fwrite(&Accessed[0], 1, NumSymbols, f);
+        if (Result.NumModified) {
+            fwrite(&ModifiedList[0], sizeof(SPass2Symbol), Result.NumModified, f);
+        }
+        if (Result.OutputSize) {
+            fwrite(OutFile.Buf() + OutStart, 1, Result.OutputSize, f);
+        }
+        _exit(fflush(f) == 0 && !ferror(f) ? 0 : 1);
+    }
+
+    // Wait for all workers to finish
+    for (k = 0; k < NumChunks; k++) {
+        int WaitStatus = 0;
+        Succeeded[k] = Workers[k] > 0 && waitpid(Workers[k], &WaitStatus, 0) == Workers[k]
+            && WIFEXITED(WaitStatus) && WEXITSTATUS(WaitStatus) == 0;
+    }
+
+    // Collect results in order
+    SPass2Result Result;                         // Result of current chunk
+    SPass2Symbol ModSym;                         // Modified symbol
+    SPass2State EndState = StartState;           // State at end of previous chunk
+    int32  EndAssumes[6];                        // Assumes at end of previous chunk
+    CArrayBuf<uint8> Modified;                   // Symbols modified by previous chunks
+    Modified.SetNum(NumSymbols);
+    memcpy(EndAssumes, StartAssumes, sizeof(Assumes));
+    uint64 Check = Pass2Checksum();              // Checksum of tables that workers started with
+    int    Accept;                               // Result of worker can be used
+
+    for (k = 0; k < NumChunks; k++) {
+        FILE * f = ResultFiles[k];
+        Accept = Succeeded[k];
+        if (Accept) {
+            rewind(f);
+            Accept = fread(&Result, sizeof(Result), 1, f) == 1 && Result.Status == 1 && Result.NumSymbols == NumSymbols;
+        }
+        if (Accept) {
+            // Worker must have started with the state at end of previous chunk
+            if (Chunks[k].Block) {
+                Accept = memcmp(&Result.BeginState, &EndState, sizeof(SPass2State)) == 0;
+            }
+            else {
+                Accept = Result.BeginState.Column == EndState.Column;
+            }
+            for (i = 0; i < 6; i++) {
+                if ((Result.AssumesRead & (1 << i)) && EndAssumes[i] != Result.BeginAssumes[i]) Accept = 0;
+            }
+        }
+        if (Accept) {
+            // Check that the file is complete before anything is changed
+            Accept = fseek(f, 0, SEEK_END) == 0 && (uint64)ftell(f) == sizeof(Result) + (uint64)NumSymbols
+                + (uint64)Result.NumModified * sizeof(SPass2Symbol) + Result.OutputSize;
+            fseek(f, sizeof(Result), SEEK_SET);
+        }
+        if (Accept) {
+            // Check that no symbol used by this chunk has been modified by a previous chunk
+            Accept = fread(&Accessed[0], 1, NumSymbols, f) == NumSymbols;
+            for (i = 0; i < NumSymbols && Accept; i++) {
+                if (Accessed[i] & Modified[i]) Accept = 0;
+            }
+        }
+        if (!Accept) {
+            // Disassemble this chunk in this process, continuing from the end of previous chunk
+            if (Chunks[k].Block) SetPass2State(EndState);
+            OutFile.SetColumn(EndState.Column);
+            memcpy(Assumes, EndAssumes, sizeof(Assumes));
+            for (i = 0; i < NumSymbols; i++) OldSymbols[i] = Symbols[i];
+            Pass2Chunk(Chunks[k], Chunks[k+1], Skipped);
+            GetPass2State(EndState);
+            memcpy(EndAssumes, Assumes, sizeof(Assumes));
+            if (Symbols.GetNumEntries() != NumSymbols || Pass2Checksum() != Check) {
+                // Tables have changed. The remaining workers have used the old tables.
+                // Do the rest in this process
+                Pass2Chunk(Chunks[k+1], Chunks[NumChunks], Skipped);
+                GetPass2State(EndState);
+                memcpy(EndAssumes, Assumes, sizeof(Assumes));
+                break;
             }
-            // Write end of function, if any
-            if (CodeMode & 3) WriteFunctionEnd();         // End function
+            // Remember which symbols have been modified
+            for (i = 0; i < NumSymbols; i++) {
+                SASymbol & sym = Symbols[i];
+                OldSymbols[i].Scope |= sym.Scope & 0x100;
+                if (memcmp(&OldSymbols[i], &sym, sizeof(SASymbol))) Modified[i] = 1;
+            }
+            continue;
         }
-        // Write end of segment
-        WriteSegmentEnd();
+
+        // Use result of worker. Copy modified symbols
+        for (i = 0; i < Result.NumModified; i++) {
+            if (fread(&ModSym, sizeof(ModSym), 1, f) != 1 || ModSym.Index >= NumSymbols) continue;
+            SASymbol & sym = Symbols[ModSym.Index];
+            // "written" flag may have been set by this or a previous chunk
+            ModSym.Symbol.Scope |= sym.Scope & 0x100;
+            sym.Scope |= ModSym.Symbol.Scope & 0x100;
+            if (memcmp(&sym, &ModSym.Symbol, sizeof(SASymbol))) {
+                // Modified other than "written" flag
+                sym = ModSym.Symbol;
+                Modified[ModSym.Index] = 1;
+                CacheForget();
+            }
+        }
+        // Append output text
+        uint32 OutPos = OutFile.Push(0, Result.OutputSize);
+        if (fread(OutFile.Buf() + OutPos, 1, Result.OutputSize, f) != Result.OutputSize) {
+            err.submit(2103, "(temporary file)"); // Read failed
+        }
+        // Merge state accumulated over all sections
+        MasmOptions |= Result.MasmOptions;
+        if (Result.InstructionSetMax > InstructionSetMax) InstructionSetMax = (uint8)Result.InstructionSetMax;
+        if (Result.InstructionSetAMDMAX > InstructionSetAMDMAX) InstructionSetAMDMAX = (uint8)Result.InstructionSetAMDMAX;
+        InstructionSetOR |= (uint16)Result.InstructionSetOR;
+        for (i = 0; i < Result.Skipped[1]; i++) cmd.CountDebugRemoved();
+        for (i = 0; i < Result.Skipped[2]; i++) cmd.CountExceptionRemoved();
+        InstructionsDecoded += Result.Instructions;
+        // Remember state at end of chunk
+        EndState = Result.EndState;
+        for (i = 0; i < 6; i++) {
+            if (Result.AssumesChanged & (1 << i)) EndAssumes[i] = Result.EndAssumes[i];
+        }
+    }
+    for (k = 0; k < NumChunks; k++) {
+        if (ResultFiles[k]) fclose(ResultFiles[k]);
+    }
+    // Set state at end of last chunk
+    OutFile.SetColumn(EndState.Column);
+    memcpy(Assumes, EndAssumes, sizeof(Assumes));
+    Section = NumSections;
+#else
+    // Worker processes not supported on this platform
+    SPass2Position Begin = {1, 0, 0, 0}, End = {NumSections, 0, 0, 0};
+    Pass2Chunk(Begin, End, Skipped);
+#endif
+}
+
+/********************  Explanation of disassembly cache:  ********************
+
+The option -cache:DIR keeps the disassembly of each section in a file in the
+directory DIR, so that a file that is disassembled again after a small change
+can reuse the text of the sections that have not changed. Pass 1 is always
+done for the whole file because it finds symbols, jump targets and function
+boundaries across sections. Pass 2 is done only for the sections that are not
+found in the cache.
+
+The name of the cache file is a 64-bit key made from:
+
+1.  The objconv version and build, the syntax and debug/exception options,
+    the file type, the image base and the names, types, word sizes and
+    addresses of all sections.
+
+2.  The raw data and size of the section, its relocations and function
+    records, and all symbols in the section.
+
+3.  The state at the start of the section: the column of OutFile, the MASM
+    options and the assumed segment registers.
+
+Symbols and relocation targets are identified by their address and name
+rather than by their old or new index, because the indices change when
+symbols are added elsewhere in the file.
+
+The text of a section may also depend on symbols in other sections, e.g. the
+names of relocation targets. The symbols used and the sections searched for
+symbols by address are logged while the section is disassembled. The cache
+file contains a checksum of all symbols in each of these sections, and the
+cache file is used only if these checksums match the current symbol table.
+
+Pass 2 may change the type, size and scope of symbols, e.g. the target of a
+jump table. Such changes are saved in the cache file and repeated when the
+cache file is used, so that the following sections see the same symbol table.
+A section is written to the cache only if pass 2 has not added symbols, has
+not changed relocations, function records or the names and addresses of
+symbols, and has not given any error or warning messages. The checksums are
+made from the symbols as they were before the section was disassembled.
+
+The cache file contains the text, the state at the end of the section, the
+MASM options and instruction sets found in the section, the changes to
+symbols, and the "written" flags (Scope bit 0x100) of the symbols in the
+section.
+
+Cache files are written to a temporary name and then renamed so that several
+processes can use the same directory. objconv never deletes cache files.
+
+*****************************************************************************/
+
+// Record at the beginning of a disassembly cache file
+struct SCacheHeader {
+   uint32 Magic;                                 // CACHE_MAGIC
+   uint32 HeaderSize;                            // sizeof(SCacheHeader)
+   uint64 Key;                                   // Key of section. Same as file name
+   uint32 NumDepend;                             // Number of SCacheDepend records following this record
+   uint32 NumModified;                           // Number of SCacheModified records following the SCacheDepend records
+   uint32 NumSymbols;                            // Number of symbols in section. Bitmap of "written" flags follows the SCacheModified records
+   uint32 TextSize;                              // Size of text following the bitmap
+   uint32 Column;                                // Column of OutFile at end of section
+   int32  Assumes[6];                            // Assumed segment registers at end of section
+   uint32 MasmOptions;                           // MASM options found in section
+   uint32 InstructionSetMax;                     // Highest instruction set in section
+   uint32 InstructionSetAMDMAX;                  // Highest AMD-specific instruction set in section
+   uint32 InstructionSetOR;                      // Bitwise OR of instruction sets in section
+};
+
+// Record in disassembly cache file for another section that the text depends on
+struct SCacheDepend {
+   int32  Section;                               // Section number
+   uint32 Unused;                                // Alignment
+   uint64 Checksum;                              // Checksum of all symbols in section
+};
+
+// Record in disassembly cache file for a symbol modified by pass 2 of the section
+struct SCacheModified {
+   int32  Section;                               // Section of symbol
+   uint32 Position;                              // Position of symbol among the symbols in the section
+   uint32 Type;                                  // New symbol type
+   uint32 Size;                                  // New symbol size
+   uint32 Scope;                                 // New symbol scope, except "written" flag
+   uint32 Unused;                                // Alignment
+};
+
+#define CACHE_MAGIC  0x3143444F                  // "ODC1"
+#define CACHE_FIRST_SECTION  (-16)               // Lowest section number in CacheChecksums
+
+static void CacheFileName(CArrayBuf<char> & Name, uint64 Key, int Temporary) {
+   // Make name of disassembly cache file from key.
+   // Temporary = 1 gives a name for writing the file before it is renamed
+   Name.SetNum((uint32)strlen(cmd.CacheDirectory) + 48);
+   uint32 Process = 0;
+#ifdef WORKER_PROCESSES_SUPPORTED
+   Process = (uint32)getpid();
+#endif
+   if (Temporary) {
+      sprintf(&Name[0], "%s/%08X%08X.%u.tmp", cmd.CacheDirectory, HighDWord(Key), uint32(Key), Process);
+   }
+   else {
+      sprintf(&Name[0], "%s/%08X%08X", cmd.CacheDirectory, HighDWord(Key), uint32(Key));
+   }
+}
+
+void CDisassembler::CacheInit() {
+    // Make checksum of the options and tables that the disassembly of any
+    // section depends on. The date and time of compilation is included so
+    // that a new build of objconv does not use cache files from an old build
+    uint32 i;
+    const char * Build = "objconv " __DATE__ " " __TIME__;
+    uint64 h = Checksum64(0xCBF29CE484222325ULL, Build, (uint32)strlen(Build));
+    uint32 Options[10] = {uint32(OBJCONV_VERSION * 100 + 0.5), (uint32)cmd.SubType, (uint32)cmd.OutputType, 
+        cmd.DebugInfo, cmd.ExeptionInfo, ExeType, Syntax, Sections.GetNumEntries(), 
+        uint32(ImageBase), HighDWord(ImageBase)};
+    h = Checksum64(h, Options, sizeof(Options));
+    for (i = 1; i < Sections.GetNumEntries(); i++) {
+        SASection & Sec = Sections[i];
+        uint32 Rec[5] = {Sec.Type, Sec.Align, Sec.WordSize, (uint32)Sec.Group, Sec.SectionAddress};
+        h = Checksum64(h, Rec, sizeof(Rec));
+        const char * Name = Sec.Name < NameBuffer.GetDataSize() ? NameBuffer.Buf() + Sec.Name : "";
+        h = Checksum64(h, Name, (uint32)strlen(Name) + 1);
+    }
+    CacheLayout = h;
+    CacheWriteFailed = 0;
+    CacheForget();
+}
+
+uint64 CDisassembler::CacheSectionChecksum(int32 Section) {
+    // Make checksum of all symbols in section. The checksum is remembered
+    // until the number of symbols changes or CacheForget is called
+    uint32 i = (uint32)(Section - CACHE_FIRST_SECTION);
+    if (Section < CACHE_FIRST_SECTION || i >= CacheChecksums.GetNumEntries()) {
+        // Not in table
+        return Symbols.SectionChecksum(0xCBF29CE484222325ULL, Section);
+    }
+    if (CacheChecksumsNum != Symbols.GetNumEntries()) CacheForget();
+    if (CacheChecksums[i] == 0) {
+        CacheChecksums[i] = Symbols.SectionChecksum(0xCBF29CE484222325ULL, Section);
+    }
+    return CacheChecksums[i];
+}
+
+void CDisassembler::CacheForget() {
+    // Forget remembered checksums of sections after symbols have been modified
+    if (!cmd.CacheDirectory) return;
+    CacheChecksums.SetNum(0);
+    CacheChecksums.SetNum(Sections.GetNumEntries() - CACHE_FIRST_SECTION);
+    CacheChecksumsNum = Symbols.GetNumEntries();
+}
+
+void CDisassembler::CacheForgetSection(int32 Section) {
+    // Forget remembered checksum of one section after symbols in it have been modified
+    uint32 i = (uint32)(Section - CACHE_FIRST_SECTION);
+    if (Section >= CACHE_FIRST_SECTION && i < CacheChecksums.GetNumEntries()) CacheChecksums[i] = 0;
+}
+
+uint64 CDisassembler::CacheContent() {
+    // Make checksum of current section for the disassembly cache:
+    // Raw data, size, relocations, function records and symbols.
+    // Relocation targets are identified by address and name
+    uint32 i;
+    SASection & Sec = Sections[Section];
+    uint32 Rec[3] = {Section, Sec.InitSize, Sec.TotalSize};
+    uint64 h = Checksum64(CacheLayout, Rec, sizeof(Rec));
+    if (Sec.Start && Sec.InitSize) h = Checksum64(h, Sec.Start, Sec.InitSize);
+
+    // Relocations with source in this section
+    SARelocation Rel;
+    memset(&Rel, 0, sizeof(Rel));
+    Rel.Section = Section;
+    for (i = Relocations.FindFirst(Rel); i < Relocations.GetNumEntries() && Relocations[i].Section == (int32)Section; i++) {
+        SARelocation & r = Relocations[i];
+        uint32 RelRec[5] = {r.Offset, r.Type, r.Size, (uint32)r.Addend, r.RefOldIndex};
+        h = Checksum64(h, RelRec, sizeof(RelRec));
+        h = Symbols.SymbolChecksum(h, Symbols.Old2NewIndex(r.TargetOldIndex));
+    }
+
+    // Function records in this section
+    SFunctionRecord Fun;
+    memset(&Fun, 0, sizeof(Fun));
+    Fun.Section = Section;
+    for (i = FunctionList.FindFirst(Fun); i < FunctionList.GetNumEntries() && FunctionList[i].Section == (int32)Section; i++) {
+        uint32 FunRec[3] = {FunctionList[i].Start, FunctionList[i].End, FunctionList[i].Scope};
+        h = Checksum64(h, FunRec, sizeof(FunRec));
     }
+
+    // Symbols in this section
+    return Symbols.SectionChecksum(h, Section);
+}
+
+int CDisassembler::CacheRead(SCacheSection & Cache) {
+    // Look for current section in the disassembly cache. See explanation above.
+    // Replay the text, the changes to symbols and the state at the end of the section if found.
+    // Return value: 1 = found, 0 = not found. Cache.Key and Cache.Content are set in both cases
+    uint32 i;                                     // Loop counter
+    uint32 First, Num = 0;                        // Symbols in section
+
+    // Make key from section contents and state at start of section
+    Cache.Content = CacheContent();
+    uint32 Start[2] = {OutFile.GetColumn(), MasmOptions & ~7};
+    Cache.Key = Checksum64(Checksum64(Cache.Content, Start, sizeof(Start)), Assumes, sizeof(Assumes));
+
+    // Read cache file, if it exists
+    CArrayBuf<char> Name;
+    CacheFileName(Name, Cache.Key, 0);
+    CFileBuffer File;
+    File.FileName = &Name[0];
+    File.ReadMapped(1);
+
+    // Check file
+    if (File.GetDataSize() < sizeof(SCacheHeader)) return 0;
+    SCacheHeader & Head = *(SCacheHeader*)File.Buf();
+    uint32 BitmapSize = (Head.NumSymbols + 7) / 8;
+    if (Head.Magic != CACHE_MAGIC || Head.HeaderSize != sizeof(SCacheHeader) || Head.Key != Cache.Key
+    || (uint64)sizeof(SCacheHeader) + (uint64)Head.NumDepend * sizeof(SCacheDepend) 
+    + (uint64)Head.NumModified * sizeof(SCacheModified) + BitmapSize + Head.TextSize != File.GetDataSize()) {
+        return 0;                                 // Wrong format or truncated
+    }
+    First = Symbols.FindSection(Section, &Num);
+    if (Num != Head.NumSymbols) return 0;
+
+    // Symbols in other sections that the text depends on must be unchanged
+    SCacheDepend * Depend = (SCacheDepend*)(File.Buf() + sizeof(SCacheHeader));
+    for (i = 0; i < Head.NumDepend; i++) {
+        if (CacheSectionChecksum(Depend[i].Section) != Depend[i].Checksum) return 0;
+    }
+    SCacheModified * Modified = (SCacheModified*)(Depend + Head.NumDepend);
+    CArrayBuf<uint32> ModifiedIndex;              // New index of each modified symbol
+    ModifiedIndex.SetNum(Head.NumModified + 1);
+    for (i = 0; i < Head.NumModified; i++) {
+        ModifiedIndex[i] = Symbols.FindSection(Modified[i].Section, &Num) + Modified[i].Position;
+        if (Modified[i].Position >= Num) return 0;
+    }
+
+    // Use cache file. Repeat changes to symbols
+    for (i = 0; i < Head.NumModified; i++) {
+        SASymbol & sym = Symbols[ModifiedIndex[i]];
+        sym.Type = Modified[i].Type;
+        sym.Size = Modified[i].Size;
+        sym.Scope = (Modified[i].Scope & ~0x100) | (sym.Scope & 0x100);
+        CacheForgetSection(Modified[i].Section);
+    }
+    // Set "written" flags
+    uint8 * Bitmap = (uint8*)(Modified + Head.NumModified);
+    for (i = 0; i < Head.NumSymbols; i++) {
+        if (Bitmap[i >> 3] & (1 << (i & 7))) Symbols[First + i].Scope |= 0x100;
+    }
+    // Append text
+    if (Head.TextSize) OutFile.Push(Bitmap + BitmapSize, Head.TextSize);
+    OutFile.SetColumn(Head.Column);
+    memcpy(Assumes, Head.Assumes, sizeof(Assumes));
+    // Merge state accumulated over all sections
+    MasmOptions |= Head.MasmOptions;
+    if (Head.InstructionSetMax > InstructionSetMax) InstructionSetMax = (uint8)Head.InstructionSetMax;
+    if (Head.InstructionSetAMDMAX > InstructionSetAMDMAX) InstructionSetAMDMAX = (uint8)Head.InstructionSetAMDMAX;
+    InstructionSetOR |= (uint16)Head.InstructionSetOR;
+
+    if (Symbols.AccessLogSize) {
+        // This is a worker process in parallel pass 2. Log everything the text depends on
+        Symbols.LogSection(Section);
+        for (i = 0; i < Head.NumDepend; i++) Symbols.LogSection(Depend[i].Section);
+        AssumesRead |= 0x3F & ~AssumesChanged;
+        AssumesChanged = 0x3F;
+    }
+    return 1;
+}
+
+void CDisassembler::CacheBegin(SCacheSection & Cache) {
+    // Remember the state at the start of current section and start logging the use
+    // of symbols, so that CacheWrite can tell if the section can be saved in the cache
+    Cache.SymbolCheck = Symbols.Checksum(0);
+    Cache.NumSymbols = Symbols.GetNumEntries();
+    Cache.NumRelocations = Relocations.GetNumEntries();
+    Cache.NumFunctions = FunctionList.GetNumEntries();
+    Cache.NumMessages = err.NumMessages();
+
+    // Keep the text of this section in OutFile rather than writing it to the stream file
+    Cache.Stream = OutFile.GetStream();
+    OutFile.SetStream(0);
+    Cache.OutStart = OutFile.GetDataSize();
+
+    // Accumulate MASM options and instruction sets for this section only
+    Cache.MasmOptions = MasmOptions;
+    Cache.InstructionSetMax = InstructionSetMax;
+    Cache.InstructionSetAMDMAX = InstructionSetAMDMAX;
+    Cache.InstructionSetOR = InstructionSetOR;
+    MasmOptions &= ~7;
+    InstructionSetMax = InstructionSetAMDMAX = 0;
+    InstructionSetOR = 0;
+
+    // Log the use of symbols. A worker process in parallel pass 2 has a log already
+    Cache.OwnLog = Symbols.AccessLogSize == 0;
+    if (Cache.OwnLog) {
+        if (CacheAccessLog.GetNumEntries() < Cache.NumSymbols) CacheAccessLog.SetNum(Cache.NumSymbols);
+        Symbols.AccessLog = &CacheAccessLog[0];
+        Symbols.AccessLogSize = Cache.NumSymbols;
+    }
+    CacheAccessed.SetNum(0);
+    CacheSections.SetNum(0);
+    Symbols.AccessCopy = &CacheAccessed;
+    Symbols.SectionLog = &CacheSections;
+}
+
+void CDisassembler::CacheWrite(SCacheSection & Cache) {
+    // Write current section to the disassembly cache if the text depends only on
+    // what is covered by the key and the checksums of other sections. See explanation above
+    uint32 i;                                     // Loop counter
+    uint32 First, Num = 0;                        // Symbols in section
+    int    Usable;                                // Section can be saved
+    SCacheHeader Head;                            // Header of cache file
+    memset(&Head, 0, sizeof(Head));
+
+    // Stop logging
+    Symbols.AccessCopy = 0;
+    Symbols.SectionLog = 0;
+
+    // Restore output stream and accumulated state
+    OutFile.SetStream(Cache.Stream);
+    Head.MasmOptions = MasmOptions & 7;
+    Head.InstructionSetMax = InstructionSetMax;
+    Head.InstructionSetAMDMAX = InstructionSetAMDMAX;
+    Head.InstructionSetOR = InstructionSetOR;
+    MasmOptions |= Cache.MasmOptions;
+    if (Cache.InstructionSetMax > InstructionSetMax) InstructionSetMax = Cache.InstructionSetMax;
+    if (Cache.InstructionSetAMDMAX > InstructionSetAMDMAX) InstructionSetAMDMAX = Cache.InstructionSetAMDMAX;
+    InstructionSetOR |= Cache.InstructionSetOR;
+
+    // Shared tables must be unchanged
+    Usable = Symbols.GetNumEntries() == Cache.NumSymbols && Symbols.Checksum(0) == Cache.SymbolCheck
+        && Relocations.GetNumEntries() == Cache.NumRelocations && FunctionList.GetNumEntries() == Cache.NumFunctions;
+
+    // Find symbols modified by this section. Only type, size and scope can be saved,
+    // and the "written" flag only in this section.
+    // Make list of other sections that the text depends on
+    CSList<int32> Depend;                         // Sections used
+    CSList<SPass2Symbol> Modified;                // Modified symbols before modification
+    for (i = 0; i < CacheAccessed.GetNumEntries(); i++) {
+        SPass2Symbol & Old = CacheAccessed[i];
+        if (Old.Index < Symbols.AccessLogSize) Symbols.AccessLog[Old.Index] &= ~2;
+        if (!Usable) continue;
+        SASymbol sym = Symbols[Old.Index];
+        if (Old.Symbol.Section == (int32)Section) {
+            sym.Scope = (sym.Scope & ~0x100) | (Old.Symbol.Scope & 0x100);
+        }
+        else {
+            Depend.Push(Old.Symbol.Section);
+        }
+        if (memcmp(&sym, &Old.Symbol, sizeof(SASymbol)) == 0) continue;
+        if (sym.Section != Old.Symbol.Section || sym.Offset != Old.Symbol.Offset || sym.Name != Old.Symbol.Name
+        || sym.DLLName != Old.Symbol.DLLName || sym.OldIndex != Old.Symbol.OldIndex || ((sym.Scope ^ Old.Symbol.Scope) & 0x100)) {
+            Usable = 0;
+        }
+        Modified.Push(Old);
+    }
+    CacheAccessed.SetNum(0);
+    if (Cache.OwnLog) Symbols.AccessLogSize = 0;
+    for (i = 0; i < CacheSections.GetNumEntries(); i++) {
+        if (CacheSections[i] != (int32)Section) Depend.Push(CacheSections[i]);
+    }
+    CacheSections.SetNum(0);
+
+    // Remembered checksums are invalid for sections with modified symbols
+    if (!Usable) CacheForget();
+    for (i = 0; i < Modified.GetNumEntries(); i++) CacheForgetSection(Modified[i].Symbol.Section);
+
+    // There must be no error messages
+    if (!Usable || CacheWriteFailed || err.NumMessages() != Cache.NumMessages) return;
+
+    // Make records of modified symbols
+    CSList<SCacheModified> ModifiedRecords;
+    SCacheModified Mod;
+    memset(&Mod, 0, sizeof(Mod));
+    for (i = 0; i < Modified.GetNumEntries(); i++) {
+        SASymbol & sym = Symbols[Modified[i].Index];
+        Mod.Section = sym.Section;
+        Mod.Position = Modified[i].Index - Symbols.FindSection(sym.Section, &Num);
+        Mod.Type = sym.Type;
+        Mod.Size = sym.Size;
+        Mod.Scope = sym.Scope & ~0x100;
+        ModifiedRecords.Push(Mod);
+    }
+
+    // Make bitmap of "written" flags
+    First = Symbols.FindSection(Section, &Num);
+    CArrayBuf<uint8> Bitmap;
+    Bitmap.SetNum((Num + 7) / 8 + 1);
+    for (i = 0; i < Num; i++) {
+        if (Symbols[First + i].Scope & 0x100) Bitmap[i >> 3] |= 1 << (i & 7);
+    }
+
+    // The checksums must be made from the symbols as they were before this section.
+    // Swap the modified symbols with the saved records while making checksums
+    CSList<SCacheDepend> DependRecords;
+    SCacheDepend Dep;
+    memset(&Dep, 0, sizeof(Dep));
+    int Pass;
+    uint64 Content = 0;
+    for (Pass = 0; Pass < 2; Pass++) {
+        for (i = 0; i < Modified.GetNumEntries(); i++) {
+            SASymbol Temp = Symbols[Modified[i].Index];
+            Symbols[Modified[i].Index] = Modified[i].Symbol;
+            Modified[i].Symbol = Temp;
+            CacheForgetSection(Temp.Section);
+        }
+        if (Pass) break;
+        // Section contents, relocations, functions and symbols must be unchanged
+        Content = CacheContent();
+        // Make checksums of other sections used
+        Depend.Sort();
+        for (i = 0; i < Depend.GetNumEntries(); i++) {
+            if (i > 0 && Depend[i] == Depend[i-1]) continue;
+            Dep.Section = Depend[i];
+            Dep.Checksum = CacheSectionChecksum(Dep.Section);
+            DependRecords.Push(Dep);
+        }
+    }
+    if (Content != Cache.Content) return;
+
+    // Make header
+    Head.Magic = CACHE_MAGIC;
+    Head.HeaderSize = sizeof(SCacheHeader);
+    Head.Key = Cache.Key;
+    Head.NumDepend = DependRecords.GetNumEntries();
+    Head.NumModified = ModifiedRecords.GetNumEntries();
+    Head.NumSymbols = Num;
+    Head.TextSize = OutFile.GetDataSize() - Cache.OutStart;
+    Head.Column = OutFile.GetColumn();
+    memcpy(Head.Assumes, Assumes, sizeof(Assumes));
+
+    // Write file with temporary name and rename it
+    CArrayBuf<char> Name, TempName;
+    CacheFileName(Name, Cache.Key, 0);
+    CacheFileName(TempName, Cache.Key, 1);
+    FILE * f = fopen(&TempName[0], "wb");
+    if (f == 0) {
+        // Directory does not exist or is not writable. Give up writing the cache
+        CacheWriteFailed = 1;
+        err.submit(1160, cmd.CacheDirectory);
+        return;
+    }
+    fwrite(&Head, sizeof(Head), 1, f);
+    if (Head.NumDepend) fwrite(&DependRecords[0], sizeof(SCacheDepend), Head.NumDepend, f);
+    if (Head.NumModified) fwrite(&ModifiedRecords[0], sizeof(SCacheModified), Head.NumModified, f);
+    fwrite(&Bitmap[0], 1, (Num + 7) / 8, f);
+    if (Head.TextSize) fwrite(OutFile.Buf() + Cache.OutStart, 1, Head.TextSize, f);
+    int Success = !ferror(f);
+    if (fclose(f)) Success = 0;
+    if (!Success || rename(&TempName[0], &Name[0]) != 0) remove(&TempName[0]);
 }
 
 /********************  Explanation of tracer:  ***************************
@@ -2588,6 +3888,143 @@ void CDisassembler::StorePrefix(uint32 Category, uint8 Byte) {
 }
 
 
+/****************  Explanation of flattened opcode maps:  *****************
+
+FindMapEntry follows a tree of opcode maps defined in opcodes.cpp, where a
+map entry with TableLink != 0 points to another map. Many entries for the
+common legacy and 0F maps, and for the VEX/EVEX maps, are followed by one or
+more links that depend only on the mod/reg/rm byte (TableLink = 2 - 5). The
+whole chain of such links is resolved in advance by MakeFlatOpcodeTables
+for each of the 128 possible combinations of mod == 3, reg and rm, so that
+the chain can be replaced by a single table lookup. Links that depend on
+prefixes, mode, etc. are still followed one by one by FindMapEntry.
+
+*****************************************************************************/
+
+// Result of chain of links through opcode maps for one value of mod/reg/rm
+struct SOpcodeFlat {
+   SOpcodeDef const * MapEntry;                  // Map entry at end of chain
+   uint16 MapNumber;                             // Map number of MapEntry
+   uint16 Index;                                 // Index of MapEntry in map
+};
+
+static CArrayBuf<uint32> FlatOpcodeMapStart;     // Index into FlatOpcodeIndex for start of each map
+static CArrayBuf<uint32> FlatOpcodeIndex;        // 1 + group number in FlatOpcodeList for each map entry. 0 if not flattened
+static CSList<SOpcodeFlat> FlatOpcodeList;       // Groups of 128 records, indexed by mod == 3, reg and rm
+static int UseFlatOpcodeTables = 1;              // Set to 0 for comparing with map tree search
+
+void CDisassembler::MakeFlatOpcodeTables() {
+    // Make flattened opcode maps for fast lookup in FindMapEntry. Done only once
+    uint32 map, index;                            // Map number and index into map
+    uint32 m, b;                                  // Map number and index after following links
+    uint32 k;                                     // Combination of mod == 3, reg and rm
+    uint32 n;                                     // Number of links followed
+    uint32 NumEntries = 0;                        // Total number of map entries
+    uint8  ModRegRM;                              // mod/reg/rm byte
+    SOpcodeDef const * MapEntry;                  // Map entry
+    SOpcodeFlat Group[128];                       // Records for one map entry
+
+    if (FlatOpcodeMapStart.GetNumEntries()) return; // Already made
+
+    FlatOpcodeMapStart.SetNum(NumOpcodeTables1 + 1);
+    for (map = 0; map < NumOpcodeTables1; map++) {
+        FlatOpcodeMapStart[map] = NumEntries;
+        if (OpcodeTables[map]) NumEntries += OpcodeTableLength[map];
+    }
+    FlatOpcodeMapStart[NumOpcodeTables1] = NumEntries;
+    FlatOpcodeIndex.SetNum(NumEntries + 1);
+
+    // Loop through all maps
+    for (map = 0; map < NumOpcodeTables1; map++) {
+        if (OpcodeTables[map] == 0) continue;
+        // Loop through each map
+        for (index = 0; index < OpcodeTableLength[map]; index++) {
+            if (OpcodeTables[map][index].TableLink < 2 || OpcodeTables[map][index].TableLink > 5) continue;
+            // This entry links to another map by mod/reg/rm. Follow links for all values of mod/reg/rm
+            for (k = 0; k < 128; k++) {
+                ModRegRM = (uint8)((k & 0x3F) | ((k & 0x40) ? 0xC0 : 0));
+                m = map;  b = index;
+                MapEntry = OpcodeTables[m] + b;
+                for (n = 0; MapEntry->TableLink >= 2 && MapEntry->TableLink <= 5 && n < 16; n++) {
+                    switch (MapEntry->TableLink) {
+                    case 2:      // Use reg field of mod/reg/rm byte as index into next table
+                        b = (ModRegRM >> 3) & 7;  break;
+                    case 3:      // Use mod < 3 vs. mod == 3 as index into next table
+                        b = (ModRegRM & 0xC0) == 0xC0;  break;
+                    case 4:      // Use mod and reg fields of mod/reg/rm byte as index into next table
+                        b = ((ModRegRM >> 3) & 7) + ((ModRegRM & 0xC0) == 0xC0 ? 8 : 0);  break;
+                    case 5:      // Use rm bits of mod/reg/rm byte as index into next table
+                        b = ModRegRM & 7;  break;
+                    }
+                    m = MapEntry->InstructionSet;
+                    if (m >= NumOpcodeTables1 || OpcodeTableLength[m] == 0 || OpcodeTables[m] == 0) break;
+                    if (b >= OpcodeTableLength[m]) b = OpcodeTableLength[m] - 1;
+                    MapEntry = OpcodeTables[m] + b;
+                }
+                if (MapEntry->TableLink >= 2 && MapEntry->TableLink <= 5) break; // Error in map tree. Let FindMapEntry report it
+                Group[k].MapEntry = MapEntry;
+                Group[k].MapNumber = (uint16)m;
+                Group[k].Index = (uint16)b;
+            }
+            if (k < 128) continue;                // Not flattened
+            // Save group of 128 records
+            FlatOpcodeIndex[FlatOpcodeMapStart[map] + index] = FlatOpcodeList.GetNumEntries() / 128 + 1;
+            for (k = 0; k < 128; k++) FlatOpcodeList.Push(Group[k]);
+        }
+    }
+}
+
+void CDisassembler::DecodeBenchmark() {
+    // Measure the speed of instruction decoding in all code sections, with and
+    // without the flattened opcode maps. Called after the disassembly is finished.
+    // The code sections are decoded sequentially from start to end without regard
+    // to labels and data, and repeated for at least one second
+    uint32 NumSections = Sections.GetNumEntries();// Number of sections
+    uint32 NumInstructions[2] = {0, 0};           // Number of instructions decoded
+    uint32 Repetitions[2] = {0, 0};               // Number of times all code sections are decoded
+    double Seconds[2] = {0., 0.};                 // Time used
+    clock_t StartTime;                            // Clock at start
+    int    Flat;                                  // 1 = use flattened opcode maps
+
+    for (Flat = 1; Flat >= 0; Flat--) {
+        UseFlatOpcodeTables = Flat;
+        StartTime = clock();
+        do {
+            for (Section = 1; Section < NumSections; Section++) {
+                if ((Sections[Section].Type & 0x8FF) != 1 || Sections[Section].Start == 0) continue;
+                // Code section
+                Buffer = Sections[Section].Start;
+                SectionEnd = FunctionEnd = LabelEnd = Sections[Section].InitSize;
+                WordSize = Sections[Section].WordSize;
+                IBegin = IEnd = 0;
+                while (IEnd < SectionEnd) {
+                    // Decode one instruction
+                    IBegin = IEnd;
+                    s.Reset();
+                    s.OpcodeStart1 = IBegin;
+                    ScanPrefixes();
+                    FindMapEntry();
+                    if (s.OpcodeDef) FindOperands();
+                    if (IEnd <= IBegin) IEnd = IBegin + 1;
+                    NumInstructions[Flat]++;
+                }
+            }
+            Repetitions[Flat]++;
+        } while (clock() - StartTime < CLOCKS_PER_SEC && NumInstructions[Flat]);
+        Seconds[Flat] = (double)(clock() - StartTime) / CLOCKS_PER_SEC;
+    }
+    UseFlatOpcodeTables = 1;
+    Section = NumSections;
+
+    printf("\n\nDecoding benchmark: %u instructions in code sections", 
+        Repetitions[1] ? NumInstructions[1] / Repetitions[1] : 0);
+    for (Flat = 1; Flat >= 0; Flat--) {
+        printf("\n%s %10.0f instructions per second",
+            Flat ? "Flattened opcode maps:" : "Map tree search:      ",
+            Seconds[Flat] > 0. ? NumInstructions[Flat] / Seconds[Flat] : 0.);
+    }
+}
+
 void CDisassembler::FindMapEntry() {
     // Find entry in opcode maps
     uint32 i = s.OpcodeStart1;                    // Index to current byte
@@ -2596,6 +4033,8 @@ void CDisassembler::FindMapEntry() {
     uint32 MapNumber = 0;                         // Map number in opcodes.cpp
     uint32 StartPage;                             // Index to start page in opcode map
     uint32 MapNumber0 = 0;                        // Fallback start page if no map entry found in StartPage
+    uint32 Flat;                                  // Index into flattened opcode maps
+    uint8  ModRegRM;                              // mod/reg/rm byte
     SOpcodeDef const * MapEntry;                  // Point to current opcode map entry
 
     // Get start page from VEX.mmmm or XOP.mmmm bits if any
@@ -2652,6 +4091,17 @@ void CDisassembler::FindMapEntry() {
         // Check if MapEntry has a link to another map
         Link = MapEntry->TableLink;
 
+        if (Link >= 2 && Link <= 5 && UseFlatOpcodeTables && MapNumber < NumOpcodeTables1
+        && MapEntry == OpcodeTables[MapNumber] + Byte && (Flat = FlatOpcodeIndex[FlatOpcodeMapStart[MapNumber] + Byte]) != 0) {
+            // Links depending on mod/reg/rm have been resolved in advance by MakeFlatOpcodeTables
+            ModRegRM = Buffer[i+1];
+            SOpcodeFlat & FlatEntry = FlatOpcodeList[(Flat - 1) * 128 + ((ModRegRM & 0x3F) | ((ModRegRM & 0xC0) == 0xC0 ? 0x40 : 0))];
+            MapEntry  = FlatEntry.MapEntry;
+            MapNumber = FlatEntry.MapNumber;
+            Byte      = (uint8)FlatEntry.Index;
+            continue;
+        }
+
         switch (Link) {
         case 0:      // No link
             // Final map entry found
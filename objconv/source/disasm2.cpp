@@ -1,7 +1,7 @@
 /****************************  disasm2.cpp   ********************************
 * Author:        Agner Fog
 * Date created:  2007-02-25
-* Last modified: 2016-11-27
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        disasm2.cpp
 * Description:
@@ -3091,6 +3091,7 @@ void CDisassembler::WriteSegmentBeginMASM() {
         }
         OutFile.NewLine();
         Assumes[1] = Section;
+        AssumesChanged |= 1 << 1;
     }
 }
 
@@ -3619,6 +3620,9 @@ void CDisassembler::WriteAssume() {
             SegReg = PrefixSeg;
         }
     }
+    // Remember if assumed value is used before it is changed (for parallel pass 2)
+    if (!(AssumesChanged & (1 << SegReg))) AssumesRead |= 1 << SegReg;
+
     // Default target segment is none
     TargetSegment = TargetGroup = 0;
 
@@ -3655,6 +3659,7 @@ void CDisassembler::WriteAssume() {
             WriteSectionName(TargetSegment);        // Name of segment or group referenced
             OutFile.NewLine();
             Assumes[SegReg] = TargetSegment;
+            AssumesChanged |= 1 << SegReg;
         }
     }
     else {
@@ -3667,6 +3672,7 @@ void CDisassembler::WriteAssume() {
             OutFile.Put(":NOTHING");
             OutFile.NewLine();
             Assumes[SegReg] = ASM_SEGMENT_NOTHING;
+            AssumesChanged |= 1 << SegReg;
         }
     }
 }
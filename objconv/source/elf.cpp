@@ -1,7 +1,7 @@
 /****************************    elf.cpp    *********************************
 * Author:        Agner Fog
 * Date created:  2006-07-18
-* Last modified: 2017-10-18
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        elf.cpp
 * Description:
@@ -234,6 +234,7 @@ CELF<ELFSTRUCTURES>::CELF() {
 template <class TELF_Header, class TELF_SectionHeader, class TELF_Symbol, class TELF_Relocation>
 void CELF<ELFSTRUCTURES>::ParseFile(){
    // Load and parse file buffer
+   CStatTimer Timer(STAT_PARSE);       // Measure time if -stats option
    uint32 i;
    FileHeader = *(TELF_Header*)Buf();   // Copy file header
    NSections = FileHeader.e_shnum;
@@ -265,6 +266,32 @@ void CELF<ELFSTRUCTURES>::ParseFile(){
       }
    }
 
+   // Make index of relocation sections by the section they apply to (sh_info).
+   // The relocation sections for section i are RelocationSections[j] for
+   // RelocationSectionsStart[i] <= j < RelocationSectionsStart[i+1], in ascending order
+   RelocationSectionsStart.SetNum(NSections + 1);
+   for (i = 1; i < NSections; i++) {
+      if ((SectionHeaders[i].sh_type == SHT_REL || SectionHeaders[i].sh_type == SHT_RELA)
+      && SectionHeaders[i].sh_info < NSections) {
+         RelocationSectionsStart[SectionHeaders[i].sh_info + 1]++;
+      }
+   }
+   for (i = 0; i < NSections; i++) {
+      RelocationSectionsStart[i+1] += RelocationSectionsStart[i];
+   }
+   if (RelocationSectionsStart[NSections]) {
+      CArrayBuf<uint32> Next;               // Next vacant position for each section
+      Next.SetNum(NSections);
+      RelocationSections.SetNum(RelocationSectionsStart[NSections]);
+      for (i = 1; i < NSections; i++) {
+         if ((SectionHeaders[i].sh_type == SHT_REL || SectionHeaders[i].sh_type == SHT_RELA)
+         && SectionHeaders[i].sh_info < NSections) {
+            uint32 target = SectionHeaders[i].sh_info;
+            RelocationSections[RelocationSectionsStart[target] + Next[target]++] = i;
+         }
+      }
+   }
+
    // if (Buf() && GetNumEntries()) {
    if (Buf() && GetDataSize()) {
        SecStringTable = Buf() + uint32(SectionHeaders[FileHeader.e_shstrndx].sh_offset);
@@ -296,6 +323,9 @@ void CELF<ELFSTRUCTURES>::ParseFile(){
 template <class TELF_Header, class TELF_SectionHeader, class TELF_Symbol, class TELF_Relocation>
 void CELF<ELFSTRUCTURES>::Dump(int options) {
    uint32 i;
+   if (options & DUMP_JSON) {
+      DumpJson(options);  return;      // Machine-readable dump
+   }
    if (options & DUMP_FILEHDR) {
       // File header
       printf("\nDump of ELF file %s", FileName);
@@ -501,6 +531,181 @@ void CELF<ELFSTRUCTURES>::Dump(int options) {
 }
 
 
+// DumpJson
+template <class TELF_Header, class TELF_SectionHeader, class TELF_Symbol, class TELF_Relocation>
+void CELF<ELFSTRUCTURES>::DumpJson(int options) {
+   // Dump file as JSON Lines records, one record per line.
+   // Field names are the names of the ELF structure fields.
+   // Fields ending in _name are the same texts as in the text dump
+   CJsonLineWriter json;
+   uint32 i, sc;
+
+   if (options & DUMP_FILEHDR) {
+      // File header
+      json.Begin("header");
+      json.Int("ei_class", FileHeader.e_ident[EI_CLASS]);
+      json.Int("ei_data", FileHeader.e_ident[EI_DATA]);
+      json.Int("ei_osabi", FileHeader.e_ident[EI_OSABI]);
+      json.Str("ei_osabi_name", Lookup(ELFABINames, FileHeader.e_ident[EI_OSABI]));
+      json.Int("ei_abiversion", FileHeader.e_ident[EI_ABIVERSION]);
+      json.Int("e_type", FileHeader.e_type);
+      json.Str("e_type_name", Lookup(ELFFileTypeNames, FileHeader.e_type));
+      json.Int("e_machine", FileHeader.e_machine);
+      json.Str("e_machine_name", Lookup(ELFMachineNames, FileHeader.e_machine));
+      json.UInt("e_version", FileHeader.e_version);
+      json.UInt("e_entry", uint64(FileHeader.e_entry));
+      json.UInt("e_flags", FileHeader.e_flags);
+      json.Int("e_phnum", FileHeader.e_phnum);
+      json.Int("e_shnum", NSections);
+      json.End();
+   }
+
+   if ((options & DUMP_SECTHDR) && FileHeader.e_phnum) {
+      // Program headers
+      uint32 programHeaderSize = FileHeader.e_phentsize;
+      uint32 programHeaderOffset = (uint32)FileHeader.e_phoff;
+      Elf64_Phdr pHeader;
+      if (programHeaderSize == 0) err.submit(2033);
+      for (i = 0; i < FileHeader.e_phnum && programHeaderSize; i++, programHeaderOffset += programHeaderSize) {
+         if (WordSize == 32) {
+            Elf32_Phdr pHeader32 = Get<Elf32_Phdr>(programHeaderOffset);
+            pHeader.p_type = pHeader32.p_type;
+            pHeader.p_offset = pHeader32.p_offset;
+            pHeader.p_vaddr = pHeader32.p_vaddr;
+            pHeader.p_paddr = pHeader32.p_paddr;
+            pHeader.p_filesz = pHeader32.p_filesz;
+            pHeader.p_memsz = pHeader32.p_memsz;
+            pHeader.p_flags = pHeader32.p_flags;
+            pHeader.p_align = pHeader32.p_align;
+         }
+         else {
+            pHeader = Get<Elf64_Phdr>(programHeaderOffset);
+         }
+         json.Begin("program_header");
+         json.Int("index", i);
+         json.UInt("p_type", pHeader.p_type);
+         json.Str("p_type_name", Lookup(ELFPTypeNames, (uint32)pHeader.p_type));
+         json.UInt("p_flags", pHeader.p_flags);
+         json.UInt("p_offset", pHeader.p_offset);
+         json.UInt("p_vaddr", pHeader.p_vaddr);
+         json.UInt("p_paddr", pHeader.p_paddr);
+         json.UInt("p_filesz", pHeader.p_filesz);
+         json.UInt("p_memsz", pHeader.p_memsz);
+         json.UInt("p_align", pHeader.p_align);
+         json.End();
+      }
+   }
+
+   // Loop through sections
+   for (sc = 0; sc < NSections; sc++) {
+      TELF_SectionHeader sheader = SectionHeaders[sc];
+      uint32 entrysize = (uint32)(sheader.sh_entsize);
+      uint32 namei = sheader.sh_name;
+      if (namei >= SecStringTableLen) {err.submit(2112); break;}
+      // Skip tables that point outside the file
+      int InFile = sheader.sh_type != SHT_NOBITS && uint64(sheader.sh_offset) + uint64(sheader.sh_size) <= GetDataSize();
+
+      if (options & DUMP_SECTHDR) {
+         // Section header
+         json.Begin("section");
+         json.Int("index", sc);
+         json.Str("name", SecStringTable + namei);
+         json.UInt("sh_type", sheader.sh_type);
+         json.Str("sh_type_name", Lookup(ELFSectionTypeNames, sheader.sh_type));
+         json.UInt("sh_flags", uint64(sheader.sh_flags));
+         json.UInt("sh_addr", uint64(sheader.sh_addr));
+         json.UInt("sh_offset", uint64(sheader.sh_offset));
+         json.UInt("sh_size", uint64(sheader.sh_size));
+         json.UInt("sh_addralign", uint64(sheader.sh_addralign));
+         json.UInt("sh_entsize", uint64(sheader.sh_entsize));
+         json.UInt("sh_link", sheader.sh_link);
+         json.UInt("sh_info", sheader.sh_info);
+         json.End();
+      }
+
+      if (sheader.sh_type == SHT_STRTAB && (options & DUMP_STRINGTB) && InFile) {
+         // String table. Offsets are relative to the start of the table
+         char * p = Buf() + uint32(sheader.sh_offset);
+         uint32 size = uint32(sheader.sh_size), len;
+         for (i = 1; i < size; i += len + 1) {
+            len = (uint32)strnlen(p + i, size - i);
+            json.Begin("string");
+            json.Int("section", sc);
+            json.UInt("offset", i);
+            json.Str("value", p + i, len);
+            json.End();
+         }
+      }
+
+      if ((sheader.sh_type == SHT_SYMTAB || sheader.sh_type == SHT_DYNSYM) && (options & DUMP_SYMTAB) && InFile) {
+         // Symbol table
+         if (sheader.sh_link >= NSections) {err.submit(2035); sheader.sh_link = 0;}
+         TELF_SectionHeader & strheader = SectionHeaders[sheader.sh_link];
+         int8 * strtab = Buf() + uint32(strheader.sh_offset);
+         uint32 strtabsize = uint32(strheader.sh_size);
+         if (uint64(strheader.sh_offset) + strtabsize > GetDataSize()) strtabsize = 0;
+         if (entrysize < sizeof(TELF_Symbol)) {err.submit(2033); entrysize = sizeof(TELF_Symbol);}
+         int8 * symtab = Buf() + uint32(sheader.sh_offset);
+         uint32 nsym = uint32(sheader.sh_size) / entrysize;
+
+         for (i = 0; i < nsym; i++) {
+            TELF_Symbol sym = *(TELF_Symbol*)(symtab + i * entrysize);
+            json.Begin("symbol");
+            json.Int("table", sc);
+            json.Int("index", i);
+            if (sym.st_name < strtabsize) {
+               json.Str("name", strtab + sym.st_name, strtabsize - sym.st_name);
+            }
+            else json.Str("name", "");
+            json.UInt("st_value", uint64(sym.st_value));
+            json.UInt("st_size", uint64(sym.st_size));
+            json.UInt("st_shndx", uint16(sym.st_shndx));
+            json.Int("st_type", sym.st_type);
+            json.Str("st_type_name", Lookup(ELFSymbolTypeNames, sym.st_type));
+            json.Int("st_bind", sym.st_bind);
+            json.Str("st_bind_name", Lookup(ELFSymbolBindingNames, sym.st_bind));
+            json.Int("st_other", sym.st_other);
+            json.End();
+         }
+      }
+
+      if ((sheader.sh_type == SHT_REL || sheader.sh_type == SHT_RELA) && (options & DUMP_RELTAB) && InFile) {
+         // Relocation table
+         uint32 expectedentrysize = sheader.sh_type == SHT_RELA ? 
+            sizeof(TELF_Relocation) :              // Elf32_Rela, Elf64_Rela
+            sizeof(TELF_Relocation) - WordSize/8;  // Elf32_Rel,  Elf64_Rel
+         if (entrysize < expectedentrysize) {err.submit(2033); entrysize = expectedentrysize;}
+         int8 * reltab = Buf() + uint32(sheader.sh_offset);
+         uint32 nrel = uint32(sheader.sh_size) / entrysize;
+         // Section that relocations apply to, for finding inline addends
+         uint32 relsoffset = 0;
+         if (sheader.sh_info < NSections) relsoffset = uint32(SectionHeaders[sheader.sh_info].sh_offset);
+
+         for (i = 0; i < nrel; i++) {
+            TELF_Relocation rel;  rel.r_addend = 0;
+            memcpy(&rel, reltab + i * entrysize, expectedentrysize);
+            json.Begin("relocation");
+            json.Int("table", sc);
+            json.UInt("section", sheader.sh_info);
+            json.Int("index", i);
+            json.UInt("r_offset", uint64(rel.r_offset));
+            json.UInt("r_sym", rel.r_sym);
+            json.Str("symbol", SymbolName(rel.r_sym));
+            json.UInt("r_type", rel.r_type);
+            json.Str("r_type_name", (WordSize == 32) ?
+               Lookup(ELF32RelocationNames, rel.r_type) :
+               Lookup(ELF64RelocationNames, rel.r_type));
+            if (sheader.sh_type == SHT_RELA) json.Int("r_addend", int64(rel.r_addend));
+            if (relsoffset && uint64(relsoffset) + uint64(rel.r_offset) + 4 <= GetDataSize()) {
+               json.Int("inline_addend", Get<int32>(relsoffset + uint32(rel.r_offset)));
+            }
+            json.End();
+         }
+      }
+   }
+}
+
+
 // PublicNames
 template <class TELF_Header, class TELF_SectionHeader, class TELF_Symbol, class TELF_Relocation>
 void CELF<ELFSTRUCTURES>::PublicNames(CMemoryBuffer * Strings, CSList<SStringEntry> * Index, int m) {
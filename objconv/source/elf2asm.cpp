@@ -1,7 +1,7 @@
 /****************************  elf2asm.cpp   *********************************
 * Author:        Agner Fog
 * Date created:  2007-04-22
-* Last modified: 2016-11-06
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        elf2asm.cpp
 * Description:
@@ -62,6 +62,7 @@ void CELF2ASM<ELFSTRUCTURES>::FindImageBase() {
 template <class TELF_Header, class TELF_SectionHeader, class TELF_Symbol, class TELF_Relocation>
 void CELF2ASM<ELFSTRUCTURES>::Convert() {
    // Do the conversion
+   if (cmd.Stats) cmd.StartTimer(STAT_SYMBOLS);  // Time until Disasm.Go() begins pass 1
 
    // Find image base and executable type
    FindImageBase();
@@ -1,7 +1,7 @@
 /****************************  elf2cof.cpp   *********************************
 * Author:        Agner Fog
 * Date created:  2006-08-19
-* Last modified: 2013-11-27
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        elf2cof.cpp
 * Description:
@@ -188,8 +188,9 @@ void CELF2COF<ELFSTRUCTURES>::MakeSections() {
          if (NewAlign > 14) NewAlign = 14;   // limit for highest alignment
          NewHeader.Flags |= PE_SCN_ALIGN_1 * NewAlign;
 
-         // Find relocation table for this section by searching through all sections
-         for (relsec = 1; relsec < this->NSections; relsec++) {
+         // Find relocation tables for this section in index made by ParseFile
+         for (uint32 r = this->RelocationSectionsStart[oldsec]; r < this->RelocationSectionsStart[oldsec+1]; r++) {
+            relsec = this->RelocationSections[r];
 
             // Get section header
             OldRelHeader = this->SectionHeaders[relsec];
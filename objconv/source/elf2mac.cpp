@@ -1,7 +1,7 @@
 /****************************  elf2mac.cpp   *********************************
 * Author:        Agner Fog
 * Date created:  2007-01-10
-* Last modified: 2012-05-05
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        elf2mac.cpp
 * Description:
@@ -922,8 +922,9 @@ void CELF2MAC<ELFSTRUCTURES,MACSTRUCTURES>::MakeSections() {
          NewHeader.addr = NewVirtualAddress; 
          NewVirtualAddress += (uint32)OldHeader.sh_size;
 
-         // Find relocation table for this section by searching through all sections
-         for (relsec = 1; relsec < this->NSections; relsec++) {
+         // Find relocation tables for this section in index made by ParseFile
+         for (uint32 r = this->RelocationSectionsStart[oldsec]; r < this->RelocationSectionsStart[oldsec+1]; r++) {
+            relsec = this->RelocationSections[r];
 
             // Get section header
             OldRelHeader = this->SectionHeaders[relsec];            
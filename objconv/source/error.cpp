@@ -1,7 +1,7 @@
 /****************************   error.cpp   **********************************
 * Author:        Agner Fog
 * Date created:  2006-07-15
-* Last modified: 2017-10-18
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        error.cpp
 * Description:
@@ -65,8 +65,10 @@ SErrorText ErrorTexts[] = {
    {1107, 1, "Name of library member %s should have extension .o or .obj"},
    {1108, 1, "Name of library member %s too long. Truncating to 15 characters"},
    {1109, 1, "Library member %s has unknown type. Possibly alias record without code"},
+   {1110, 1, "Symbol %s not found in library"},
    {1150, 1, "Universal binary contains more than one component that can be converted. Specify desired word size or use lipo to extract desired component"},
    {1151, 1, "Skipping component with wordsize %i"},
+   {1160, 1, "Cannot write disassembly cache file in directory %s"},
 
    {1202, 1, "OMF Record checksum error"},
    {1203, 1, "Unrecognized data in OMF subrecord"},
@@ -132,6 +134,9 @@ SErrorText ErrorTexts[] = {
    {2104, 2, "Cannot write output file %s"},
    {2105, 2, "Wrong size of file %s"},
    {2107, 2, "Too many response files"},
+   {2108, 2, "Conversion of file %s failed"},
+   {2109, 2, "Input and output file names must be in batch file, not on command line"},
+   {2111, 2, "More than two file names in line of batch file: %s"},
    {2110, 2, "COFF file section table corrupt"},
    {2112, 2, "String table corrupt"},
    {2114, 2, "This is an intermediate file for whole-program-optimization in Intel compiler"},
@@ -180,6 +185,7 @@ SErrorText ErrorTexts[] = {
    {2610, 2, "Library end record not found"},
    {2620, 2, "You need to extract library members before disassembling"},
    {2621, 2, "Wrong output file type"},
+   {2622, 2, "Library has no symbol index. Use -d to list symbols by member"},
 
    {2701, 2, "Wrong number of members in universal binary (%i)"},
 
@@ -319,6 +325,11 @@ int CErrorReporter::Number() {
    return NumErrors;
 }
 
+int CErrorReporter::NumMessages() {
+   // Get number of errors and warnings
+   return NumErrors + NumWarnings;
+}
+
 int CErrorReporter::GetWorstError() {
    // Get highest warning or error number encountered
    return WorstError;
@@ -1,7 +1,7 @@
 /****************************   error.h   ************************************
 * Author:        Agner Fog
 * Date created:  2006-07-15
-* Last modified: 2006-07-15
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        error.h
 * Description:
@@ -32,6 +32,7 @@ public:
    void submit(int ErrorNumber, char const *, char const *); // Print error message with two extra text fields inserted
    void submit(int ErrorNumber, int, char const *); // Print error message with two extra text fields inserted
    int Number();        // Get number of errors
+   int NumMessages();   // Get number of errors and warnings
    int GetWorstError(); // Get highest warning or error number encountered
    void ClearError(int ErrorNumber); // Ignore further occurrences of this error
 protected:
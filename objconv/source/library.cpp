@@ -1,7 +1,7 @@
 /****************************  library.cpp  **********************************
 * Author:        Agner Fog
 * Date created:  2006-08-27
-* Last modified: 2017-07-27
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        library.cpp
 * Description:
@@ -30,6 +30,9 @@ CLibrary::CLibrary() {
     MemberFileType = 0;
     RepressWarnings = 0;
     PageSize = 16;
+    SymbolIndex = SymbolIndexSize = SymbolIndexType = 0;
+    NumWorkers = CurrentWorker = 0;
+    ResultPending = 0;
 }
 
 
@@ -40,6 +43,7 @@ void CLibrary::Go() {
     int action = 0;                // Action to take on member
     int FileType1 = 0;             // File type of current member
     int WordSize1 = 0;             // Word size of current member
+    uint32 MemberNum = 0;          // Number of current member
 
     if (cmd.DumpOptions && !(cmd.LibraryOptions & CMDL_LIBRARY_EXTRACTMEM)) {
         // Dump library, but not its members
@@ -47,6 +51,13 @@ void CLibrary::Go() {
         return;
     }
 
+    if (cmd.LibraryOptions == CMDL_LIBRARY_FINDSYMBOL) {
+        // Find members that define specified symbols. No output file
+        FindSymbols();
+        OutputFileName = 0;
+        return;
+    }
+
     // Remove path form member names and check member type before extracting or adding members
     AlignBy = 2;
     if (GetDataSize()) FixNames();    
@@ -139,10 +150,15 @@ void CLibrary::Go() {
     }
 
     // Convert library or extract or add or dump all members
+    if (!(cmd.LibraryOptions & (CMDL_LIBRARY_EXTRACTMEM | CMDL_LIBRARY_ADDMEMBER))) {
+        // Converting all members. Let worker processes do the conversions if -threads specified
+        StartConversionWorkers();
+    }
     StartExtracting();                           // Initialize before ExtractMember()
 
     // Loop through input library
     while ((MemberName1 = ExtractMember(&MemberBuffer)) != 0) {
+        MemberNum++;
 
         // Check if any specific action required for this member
         action = cmd.SymbolChange(MemberName1, &MemberName2, SYMT_LIBRARYMEMBER);
@@ -178,7 +194,10 @@ void CLibrary::Go() {
                 // Check file type before conversion
                 int FileType0 = MemberBuffer.GetFileType();
                 // Conversion or name change requested
-                MemberBuffer.Go();                   // Do required conversion
+                if (!GetConvertedMember(MemberNum)) {
+                    // Not converted by worker process
+                    MemberBuffer.Go();               // Do required conversion
+                }
                 if (err.Number()) break;             // Stop if error
                 // Check type again after conversion
                 FileType1 = MemberBuffer.GetFileType();
@@ -207,7 +226,7 @@ void CLibrary::Go() {
                 // Extract this member
                 if (cmd.DumpOptions == 0 && cmd.OutputType != CMDL_OUTPUT_DUMP) {
                     // Write this member to file
-                    if (err.Number()) return; // Check first if error
+                    if (err.Number()) break;  // Check first if error
 
                     if (cmd.SymbolChangesRequested() || FileType1 != cmd.OutputType) {
                         // Conversion or name change requested
@@ -215,7 +234,7 @@ void CLibrary::Go() {
                         // Check type before conversion
                         int FileType0 = MemberBuffer.GetFileType();
                         MemberBuffer.Go();
-                        if (err.Number()) return; // Stop if error
+                        if (err.Number()) break;  // Stop if error
                         // Check type after conversion
                         FileType1 = MemberBuffer.GetFileType();
                         if (MemberBuffer.OutputFileName == 0 /*|| FileType1 != FileType0*/) {
@@ -259,6 +278,7 @@ void CLibrary::Go() {
             InsertMember(&MemberBuffer);
         }
     } // End of loop through library
+    StopConversionWorkers();
     // Stop if error
     if (err.Number()) return; 
 
@@ -540,6 +560,267 @@ void CLibrary::StripMemberNamesUNIX() {
 }
 
 
+// Conversion of library members in worker processes.
+// When -threads:N is specified, the members of a library that is converted are
+// divided into N contiguous ranges of approximately equal size. A worker process
+// for each range converts its members and writes them to a temporary file.
+// The loop in Go() takes the converted members from these files in the original
+// order. A member that a worker could not convert without any message is 
+// converted in the main process so that all messages come in the right order.
+
+void CLibrary::GetConversionState(SConversionState & s) {
+    // Save options in cmd that CConverter::Go() can change
+    s.InputType       = cmd.InputType;
+    s.DesiredWordSize = cmd.DesiredWordSize;
+    s.Underscore      = cmd.Underscore;
+    s.SegmentDot      = cmd.SegmentDot;
+    s.DebugInfo       = cmd.DebugInfo;
+    s.ExeptionInfo    = cmd.ExeptionInfo;
+}
+
+void CLibrary::SetConversionState(SConversionState const & s) {
+    // Restore options in cmd that CConverter::Go() can change
+    cmd.InputType       = s.InputType;
+    cmd.DesiredWordSize = s.DesiredWordSize;
+    cmd.Underscore      = s.Underscore;
+    cmd.SegmentDot      = s.SegmentDot;
+    cmd.DebugInfo       = s.DebugInfo;
+    cmd.ExeptionInfo    = s.ExeptionInfo;
+}
+
+void CLibrary::StartConversionWorkers() {
+    // Start worker processes for converting members
+#ifdef WORKER_PROCESSES_SUPPORTED
+    uint32 k;                                    // Worker index
+    if (cmd.Threads < 2 || cmd.DumpOptions) return;
+    if (cmd.OutputType == FILETYPE_MACHO_LE || cmd.OutputType == FILETYPE_OMF 
+    || cmd.InputType == FILETYPE_OMFLIBRARY || cmd.MemberType == FILETYPE_OMF) {
+        // Conversion to Mach-O remembers the image base symbol, and conversion to or 
+        // from OMF enumerates truncated module names, from one member to the next.
+        // The members must be converted in order in the same process
+        return;
+    }
+    NumWorkers = cmd.Threads;
+    ResultFiles.SetNum(NumWorkers);
+    MessageFiles.SetNum(NumWorkers);
+    Workers.SetNum(NumWorkers);
+    CurrentWorker = 0;  ResultPending = 0;
+
+    for (k = 0; k < NumWorkers; k++) {
+        fflush(stdout);  fflush(stderr);
+        ResultFiles[k] = tmpfile();
+        MessageFiles[k] = tmpfile();
+        Workers[k] = (ResultFiles[k] && MessageFiles[k]) ? fork() : -1;
+        if (Workers[k] == 0) {
+            // This is the worker process
+            ConvertMembersWorker(k);             // Does not return
+        }
+        // Workers[k] = -1 if failed. The main process will do these members
+    }
+#endif
+}
+
+void CLibrary::ConvertMembersWorker(uint32 k) {
+    // Worker process number k. Converts a range of members and writes the results
+    // to ResultFiles[k]. Each converted member is written as an SMemberConversion
+    // record followed by the changes in statistics counters and the member data.
+    // The worker stops at the first member that gives an error or warning.
+#ifdef WORKER_PROCESSES_SUPPORTED
+    FILE * f = ResultFiles[k];                   // Output file
+    char const * MemberName1;                    // Name of library member
+    char const * MemberName2;                    // Modified name of library member
+    uint32 MemberNum;                            // Member number
+    uint32 Offset;                               // Offset of member
+    uint64 TotalSize = 0;                        // Total size of members
+    uint64 Position = 0;                         // Size of members before current
+    uint32 FirstMember = 0;                      // First member in range of this worker
+    uint32 LastMember = 0;                       // Last member in range of this worker
+    uint32 i;                                    // Loop counter
+    int    NumMessages;                          // Number of messages before conversion
+    int    FileType1;                            // File type of member
+    SMemberConversion Rec;                       // Record for converted member
+    CSList<uint32> MemberSizes;                  // Size of each member
+
+    // Messages from this worker are not used
+    freopen("/dev/null", "w", stderr);
+    // Text printed to stdout by conversion of a member is saved in MessageFiles[k]
+    dup2(fileno(MessageFiles[k]), fileno(stdout));
+
+    // Find the sizes of all members
+    StartExtracting();
+    Offset = CurrentOffset;
+    while (ExtractMember(0)) {
+        uint32 End = (CurrentOffset > Offset) ? CurrentOffset : GetDataSize();
+        MemberSizes.Push(End - Offset);
+        TotalSize += End - Offset;
+        Offset = CurrentOffset;
+    }
+    // Find range of members for this worker. Member numbers start at 1
+    for (i = 0; i < MemberSizes.GetNumEntries(); i++) {
+        uint64 Part = Position * NumWorkers / (TotalSize ? TotalSize : 1); // Worker that gets this member
+        if (Part < k) FirstMember = i + 2;
+        if (Part <= k) LastMember = i + 1;
+        Position += MemberSizes[i];
+    }
+    if (err.Number()) LastMember = 0;
+
+    // Statistics counters before and after conversion
+    uint32 NumStatistics = cmd.NumStatistics();
+    CArrayBuf<int> Statistics;
+    Statistics.SetNum(NumStatistics + 1);
+
+    // Loop through library in the same way as Go()
+    StartExtracting();
+    MemberNum = 0;
+    while (MemberNum < LastMember && (MemberName1 = ExtractMember(&MemberBuffer)) != 0) {
+        MemberNum++;
+        if (MemberNum + 1 < FirstMember) continue;
+        MemberName2 = 0;
+        int action = cmd.SymbolChange(MemberName1, &MemberName2, SYMT_LIBRARYMEMBER);
+        MemberBuffer.FileName = MemberName1;
+        MemberBuffer.OutputFileName = MemberName2 ? MemberName2 : MemberName1;
+        if (action == SYMA_DELETE_MEMBER || action == SYMA_ADD_MEMBER) continue;
+        FileType1 = MemberBuffer.GetFileType();
+        if (FileType1 == 0) continue;
+        if (!(cmd.SymbolChangesRequested() || FileType1 != cmd.OutputType)) continue;
+        if (MemberNum < FirstMember) {
+            // Convert the member before the range without saving it. This sets the 
+            // options in cmd the same way as in the main process
+            MemberBuffer.Go();
+            if (err.Number()) break;
+            continue;
+        }
+
+        // Convert member
+        memset(&Rec, 0, sizeof(Rec));
+        Rec.Member = MemberNum;
+        GetConversionState(Rec.Before);
+        for (i = 0; i < NumStatistics; i++) Statistics[i] = cmd.Statistic(i);
+        NumMessages = err.NumMessages();
+        fflush(stdout);
+        Rec.MessageStart = (uint32)ftell(stdout);
+
+        MemberBuffer.Go();
+
+        if (err.Number() || err.NumMessages() != NumMessages) break; // The main process must do the rest
+        fflush(stdout);
+        Rec.MessageSize = (uint32)ftell(stdout) - Rec.MessageStart;
+        GetConversionState(Rec.After);
+        Rec.DataSize = MemberBuffer.GetDataSize();
+        Rec.FileType = MemberBuffer.GetFileType();
+        Rec.WordSize = MemberBuffer.WordSize;
+        Rec.Executable = MemberBuffer.Executable;
+        Rec.NumStatistics = NumStatistics;
+        for (i = 0; i < NumStatistics; i++) Statistics[i] = cmd.Statistic(i) - Statistics[i];
+        fwrite(&Rec, sizeof(Rec), 1, f);
+        fwrite(&Statistics[0], sizeof(int), NumStatistics, f);
+        fwrite(MemberBuffer.Buf(), 1, Rec.DataSize, f);
+    }
+    fflush(stdout);
+    _exit(fflush(f) == 0 && !ferror(f) ? 0 : 1);
+#endif
+}
+
+int CLibrary::GetConvertedMember(uint32 Member) {
+    // Get member converted by a worker process into MemberBuffer.
+    // Returns 0 if the member must be converted by the main process
+#ifdef WORKER_PROCESSES_SUPPORTED
+    FILE * f;                                    // Result file of current worker
+    uint32 i;                                    // Loop counter
+    SConversionState State;                      // Current options in cmd
+    char Text[1024];                             // Buffer for copying messages
+
+    // Find the record for this member. The members are in order
+    while (CurrentWorker < NumWorkers) {
+        f = ResultFiles[CurrentWorker];
+        if (Workers[CurrentWorker] > 0) {
+            // Wait for this worker to finish before reading its results
+            int WaitStatus = 0;
+            int Success = waitpid(Workers[CurrentWorker], &WaitStatus, 0) == Workers[CurrentWorker]
+                && WIFEXITED(WaitStatus) && WEXITSTATUS(WaitStatus) == 0;
+            Workers[CurrentWorker] = Success ? 0 : -1; // Ignore results of failed worker
+            rewind(f);
+        }
+        if (Workers[CurrentWorker] < 0) {
+            CurrentWorker++;  continue;          // No results from this worker
+        }
+        if (!ResultPending) {
+            if (fread(&Result, sizeof(Result), 1, f) != 1 || Result.NumStatistics != cmd.NumStatistics()) {
+                // No more results from this worker
+                Workers[CurrentWorker++] = -1;  continue;
+            }
+            ResultPending = 1;
+        }
+        if (Result.Member >= Member) break;
+        // Skip record of member not used
+        fseek(f, Result.NumStatistics * sizeof(int) + Result.DataSize, SEEK_CUR);
+        ResultPending = 0;
+    }
+    if (CurrentWorker >= NumWorkers || Result.Member != Member) return 0;
+    ResultPending = 0;
+
+    // The worker may have started with different options if preceding members have
+    // changed them in a different way
+    GetConversionState(State);
+    if (memcmp(&State, &Result.Before, sizeof(State))) {
+        fseek(f, Result.NumStatistics * sizeof(int) + Result.DataSize, SEEK_CUR);
+        return 0;
+    }
+    // Read statistics and converted member
+    CArrayBuf<int> Statistics;
+    CFileBuffer Converted;
+    Statistics.SetNum(Result.NumStatistics + 1);
+    Converted.Push(0, Result.DataSize);
+    if (fread(&Statistics[0], sizeof(int), Result.NumStatistics, f) != Result.NumStatistics
+    || fread(Converted.Buf(), 1, Result.DataSize, f) != Result.DataSize) {
+        // Should not occur. Ignore the rest of the results from this worker
+        Workers[CurrentWorker++] = -1;  
+        return 0;
+    }
+    for (i = 0; i < Result.NumStatistics; i++) cmd.Statistic(i) += Statistics[i];
+    SetConversionState(Result.After);
+    Converted.FileType = Result.FileType;
+    Converted.WordSize = Result.WordSize;
+    Converted.Executable = Result.Executable;
+    Converted >> MemberBuffer;               // Replace unconverted member
+
+    // Print the text that the conversion has printed
+    if (Result.MessageSize) {
+        FILE * m = MessageFiles[CurrentWorker];
+        uint32 n;                                // Number of bytes to copy
+        fseek(m, Result.MessageStart, SEEK_SET);
+        for (i = 0; i < Result.MessageSize; i += n) {
+            n = Result.MessageSize - i;
+            if (n > sizeof(Text)) n = sizeof(Text);
+            n = (uint32)fread(Text, 1, n, m);
+            if (n == 0) break;
+            fwrite(Text, 1, n, stdout);
+        }
+    }
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+void CLibrary::StopConversionWorkers() {
+    // Wait for worker processes to finish and delete temporary files
+#ifdef WORKER_PROCESSES_SUPPORTED
+    for (uint32 k = 0; k < NumWorkers; k++) {
+        if (Workers[k] > 0) {
+            int WaitStatus;
+            waitpid(Workers[k], &WaitStatus, 0);
+            Workers[k] = 0;
+        }
+        if (ResultFiles[k]) fclose(ResultFiles[k]);
+        if (MessageFiles[k]) fclose(MessageFiles[k]);
+        ResultFiles[k] = MessageFiles[k] = 0;
+    }
+    NumWorkers = 0;
+#endif
+}
+
+
 void CLibrary::Dump() {
     // Print contents of library
 
@@ -572,13 +853,16 @@ void CLibrary::DumpOMF() {
     CMemoryBuffer Strings;                        // Local string buffer
     CSList<SStringEntry> MemberIndex;             // Local member index buffer
     COMF Member;                                  // Local buffer for member
+    int Json = cmd.DumpOptions & DUMP_JSON;       // Machine-readable dump
+    CJsonLineWriter json;                         // Used only if Json
 
     DictionaryOffset = GetDataSize();             // Loop end. This value is changed when library header is read
     rec.Start(Buf(), 0, DictionaryOffset);        // Initialize record pointer
 
     PageSize = 0;
+    MemberName = 0;
 
-    printf("\nDump of library %s\nExported symbols by member:\n", cmd.InputFile);
+    if (!Json) printf("\nDump of library %s\nExported symbols by member:\n", cmd.InputFile);
 
     // Loop through the records of all OMF modules
     do {
@@ -604,14 +888,32 @@ void CLibrary::DumpOMF() {
             rec.FileEnd = DictionaryOffset;
 
             // Print values from LIBHEAD
-            printf("\nOMF Library. Page size %i. %s.",
+            if (Json) {
+                json.Begin("library");
+                json.Str("name", cmd.InputFile);
+                json.Str("format", GetFileFormatName(FILETYPE_OMFLIBRARY));
+                json.UInt("page_size", PageSize);
+                json.UInt("flags", Flags);
+                json.Str("flags_name", Lookup(OMFLibraryFlags, Flags));
+                json.UInt("dictionary_offset", DictionaryOffset);
+                json.UInt("dictionary_size", DictionarySize);
+                json.End();
+            }
+            else printf("\nOMF Library. Page size %i. %s.",
                 PageSize, Lookup(OMFLibraryFlags, Flags));
             break;
 
         case OMF_THEADR: // Module header. Member starts here
             MemberName = rec.GetString();           // Get name
             MemberStart = rec.FileOffset;           // Get start address
-            printf("\nMember %s Offset 0x%X", MemberName, MemberStart);// Print member name
+            if (Json) {
+                json.Begin("member");
+                json.Int("index", MemberNum + 1);
+                json.Str("name", MemberName);
+                json.UInt("offset", MemberStart);
+                json.End();
+            }
+            else printf("\nMember %s Offset 0x%X", MemberName, MemberStart);// Print member name
             break;
 
         case OMF_MODEND: // Member ends here.
@@ -629,7 +931,13 @@ void CLibrary::DumpOMF() {
             // Print public names
             for (i = FirstPublic; i < MemberIndex.GetNumEntries(); i++) {
                 SymbolName = Strings.Buf() + MemberIndex[i].String;
-                printf("\n  %s", SymbolName);
+                if (Json) {
+                    json.Begin("public");
+                    json.Str("member", MemberName);
+                    json.Str("name", SymbolName);
+                    json.End();
+                }
+                else printf("\n  %s", SymbolName);
             }
             // Align next member by PageSize;
             MemberEnd = (MemberEnd + PageSize - 1) & - (int32)PageSize;
@@ -645,6 +953,7 @@ void CLibrary::DumpOMF() {
     while (rec.GetNext());                        // End of loop through records
 
     // Check hash table integrity
+    json.FlushStream();                           // Keep records in order
     CheckOMFHash(Strings, MemberIndex);
 
     // Check if there is an extended library dictionary
@@ -657,19 +966,31 @@ void CLibrary::DumpOMF() {
         // Library contains extended dictionary
         uint32 ExtendedDictionarySize = GetDataSize() - ExtendedDictionaryOffset;
         uint8 DictionaryType = Get<uint8>(ExtendedDictionaryOffset); // Read first byte of extended dictionary
+        const char * DictionaryFormat;            // Name of format
         if (DictionaryType == OMF_LIBEXT) {
             // Extended dictionary in the official format
-            printf("\nExtended dictionary IBM/MS format. size %i", ExtendedDictionarySize);
+            DictionaryFormat = "IBM/MS";
+            if (!Json) printf("\nExtended dictionary IBM/MS format. size %i", ExtendedDictionarySize);
         }
         else if (ExtendedDictionarySize >= 10 && (DictionaryType == 0xAD || Get<uint16>(ExtendedDictionaryOffset + 2) == MemberNum)) {
             // Extended dictionary in the proprietary Borland format, documented only in US Patent 5408665, 1995
-            printf("\nExtended dictionary Borland format. size %i", ExtendedDictionarySize);
+            DictionaryFormat = "Borland";
+            if (!Json) printf("\nExtended dictionary Borland format. size %i", ExtendedDictionarySize);
         }
         else {
             // Unknown format
-            printf("\nExtended dictionary size %i, unknown type 0x%02X", 
+            DictionaryFormat = "unknown";
+            if (!Json) printf("\nExtended dictionary size %i, unknown type 0x%02X", 
                 ExtendedDictionarySize, DictionaryType);
         }
+        if (Json) {
+            json.Begin("extended_dictionary");
+            json.Str("format", DictionaryFormat);
+            json.UInt("offset", ExtendedDictionaryOffset);
+            json.UInt("size", ExtendedDictionarySize);
+            json.UInt("first_byte", DictionaryType);
+            json.End();
+        }
     }
 }
 
@@ -678,8 +999,17 @@ void CLibrary::DumpUNIX() {
 
     const char * MemberName = 0;
     CurrentOffset = 8;  CurrentNumber = 0;
+    int Json = cmd.DumpOptions & DUMP_JSON;       // Machine-readable dump
+    CJsonLineWriter json;                         // Used only if Json
+    uint32 MemberNum = 0;                         // Member number
 
-    printf("\nDump of library %s", cmd.InputFile);
+    if (Json) {
+        json.Begin("library");
+        json.Str("name", cmd.InputFile);
+        json.Str("format", GetFileFormatName(FILETYPE_LIBRARY));
+        json.End();
+    }
+    else printf("\nDump of library %s", cmd.InputFile);
 
     if (cmd.DumpOptions & DUMP_SECTHDR) {
         // dump headers
@@ -708,18 +1038,22 @@ void CLibrary::DumpUNIX() {
             }
             if (i == 16) Name[i] = 0;
 
+            const char * Kind = 0;          // Kind of special member
             if (strncmp(Name, "//", 2) == 0) {
                 // This is the long names member. 
-                printf("\nLongnames header \"%s\". Offset 0x%X, size 0x%X", Name,
+                Kind = "longnames";
+                if (!Json) printf("\nLongnames header \"%s\". Offset 0x%X, size 0x%X", Name,
                     CurrentOffset + (uint32)sizeof(SUNIXLibraryHeader), MemberSize);
             }
             else if (Name[0] == '/' && Name[1] <= ' ') {
                 // Symbol index
-                printf("\nSymbol index %i, \"%s\"", ++symindex, Name);
+                Kind = "symbol_index";
+                if (!Json) printf("\nSymbol index %i, \"%s\"", ++symindex, Name);
             }
             else if (strncmp(Name, "__.SYMDEF", 9) == 0) {
                 // Mac/BSD Symbol index
-                printf("\nSymbol index %i, \"%s\"", ++symindex, Name);
+                Kind = "symbol_index";
+                if (!Json) printf("\nSymbol index %i, \"%s\"", ++symindex, Name);
             }
             else if (strncmp(Name, "#1/", 3) == 0) {
                 // Name refers to long name after the header
@@ -728,17 +1062,26 @@ void CLibrary::DumpUNIX() {
                 Name += sizeof(SUNIXLibraryHeader);
                 if (strncmp(Name, "__.SYMDEF", 9) == 0) {
                     // Symbol table "__.SYMDEF SORTED" as long name
-                    printf("\nSymbol index %i, \"%s\"", ++symindex, Name);
+                    Kind = "symbol_index";
+                    if (!Json) printf("\nSymbol index %i, \"%s\"", ++symindex, Name);
                 }
             }
             else break;
+            if (Json && Kind) {
+                json.Begin("library_header");
+                json.Str("kind", Kind);
+                json.Str("name", Name);
+                json.UInt("offset", CurrentOffset + (uint32)sizeof(SUNIXLibraryHeader));
+                json.UInt("size", MemberSize);
+                json.End();
+            }
             // Point to next member
             CurrentOffset = NextHeader(CurrentOffset);
         }
         CurrentOffset = 8;  CurrentNumber = 0; 
     }
 
-    printf("\n\nExported symbols by member:\n");
+    if (!Json) printf("\n\nExported symbols by member:\n");
 
     // Loop through library
     while (CurrentOffset + sizeof(SUNIXLibraryHeader) < DataSize) {
@@ -751,19 +1094,30 @@ void CLibrary::DumpUNIX() {
         // Get member name
         MemberName = ExtractMember(&MemberBuffer);
         if (MemberName == 0) break;
-        printf("\nMember %s", MemberName);
         MemberBuffer.FileName = MemberName;
 
         // Detect file type of member
         MemberFileType = MemberBuffer.GetFileType();
 
         WordSize = MemberBuffer.WordSize;
-        printf (" - %s", GetFileFormatName(MemberFileType));
-        if (WordSize) {
-            printf("-%i", MemberBuffer.WordSize);
+        if (Json) {
+            json.Begin("member");
+            json.Int("index", ++MemberNum);
+            json.Str("name", MemberName);
+            json.Str("format", GetFileFormatName(MemberFileType));
+            json.Int("wordsize", WordSize);
+            json.UInt("size", MemberBuffer.GetDataSize());
+            json.End();
         }
         else {
-            printf(". Type not specified. Possibly alias record");
+            printf("\nMember %s", MemberName);
+            printf (" - %s", GetFileFormatName(MemberFileType));
+            if (WordSize) {
+                printf("-%i", MemberBuffer.WordSize);
+            }
+            else {
+                printf(". Type not specified. Possibly alias record");
+            }
         }
 
         // Get symbol table for specific file type
@@ -809,18 +1163,31 @@ void CLibrary::DumpUNIX() {
         case IMPORT_LIBRARY_MEMBER: {
             // This is an import library
             char * name1 = MemberBuffer.Buf() + 20;
-            printf("\n  Import %s from %s", name1, name1 + strlen(name1) + 1);
+            if (Json) {
+                json.Begin("import");
+                json.Str("member", MemberName);
+                json.Str("name", name1);
+                json.Str("dll", name1 + strlen(name1) + 1);
+                json.End();
+            }
+            else printf("\n  Import %s from %s", name1, name1 + strlen(name1) + 1);
             break;} 
 
         default:
-            printf("\n   Cannot extract symbol names from this file type");
+            if (!Json) printf("\n   Cannot extract symbol names from this file type");
             break;
         }
 
         // Loop through table of public names
         for (uint32 i = 0; i < StringEntries.GetNumEntries(); i++) {
             uint32 j = StringEntries[i].String;
-            printf("\n   %s", StringBuffer.Buf() + j);
+            if (Json) {
+                json.Begin("public");
+                json.Str("member", MemberName);
+                json.Str("name", StringBuffer.Buf() + j);
+                json.End();
+            }
+            else printf("\n   %s", StringBuffer.Buf() + j);
         }
     }
 }
@@ -1556,6 +1923,14 @@ int CLibrary::MemberNameExistsUNIX(char * name) {
 }*/
 
 
+// Record used by SortStringTable for sorting string table entries by name
+struct SStringSortEntry {
+    const char * s;                      // Pointer to string
+    SStringEntry e;                      // String table entry
+    int operator < (SStringSortEntry const & y) const {
+        return strcmp(s, y.s) < 0;}
+};
+
 void CLibrary::SortStringTable() {
     // Sort the string table in ASCII order
 
@@ -1567,23 +1942,18 @@ void CLibrary::SortStringTable() {
     SStringEntry * Table = &StringEntries[0];
     // String pointers
     char * s1, * s2;
-    // Temporary record for swapping
-    SStringEntry temp;
-
-    // Simple Bubble sort:
     int32 i, j;
+
+    // Sort. The sort is stable, so symbols with same name keep their order
+    CSList<SStringSortEntry> SortList;
+    SortList.SetNum(n);
     for (i = 0; i < n; i++) {
-        for (j = 0; j < n - i - 1; j++) {
-            s1 = StringBuffer.Buf() + Table[j].String;
-            s2 = StringBuffer.Buf() + Table[j+1].String;
-            if (strcmp(s1, s2) > 0) {
-                // Swap records
-                temp = Table[j];
-                Table[j] = Table[j+1];
-                Table[j+1] = temp;
-            }
-        }
+        SortList[i].s = StringBuffer.Buf() + Table[i].String;
+        SortList[i].e = Table[i];
     }
+    SortList.Sort();
+    for (i = 0; i < n; i++) Table[i] = SortList[i].e;
+
     // Now StringEntries has been sorted. Reorder StringBuffer to the sort order.
     CMemoryBuffer SortedStringBuffer;    // Temporary buffer for strings in sort order
     for (i = 0; i < n; i++) {
@@ -2044,6 +2414,16 @@ void CLibrary::CheckOMFHash(CMemoryBuffer &stringbuf, CSList<SStringEntry> &inde
 
         //printf("\n%i occurence of %s, module offset %i", NString, Name, Module);
     }
+    if (cmd.DumpOptions & DUMP_JSON) {
+        CJsonLineWriter json;
+        json.Begin("hash_table");
+        json.UInt("blocks", DictionarySize);
+        json.UInt("offset", DictionaryOffset);
+        json.UInt("conflicts", ConfSum);
+        json.UInt("entries", index.GetNumEntries());
+        json.End();
+        return;
+    }
     printf("\n\nHash table %i blocks x 37 buckets at offet 0x%X.\n Efficiency: %i conflicts for %i entries",
         DictionarySize, DictionaryOffset, ConfSum, index.GetNumEntries());
 }
@@ -2103,3 +2483,235 @@ const char * CLibrary::GetModuleName(uint32 Index) {
     // Error
     return "?";
 }
+
+
+void CLibrary::FindSymbols() {
+    // Find which library members define the symbols specified with -lf options.
+    // The symbol index of a UNIX style library or the dictionary of an OMF
+    // library is searched so that no members need to be read or extracted
+    char const * Name;                            // Symbol name to search for
+    uint32 i;                                     // Loop counter
+    int Found;                                    // Number of members found
+
+    if (cmd.Verbose) printf("\nSearching library %s", FileName);
+
+    if (cmd.InputType != FILETYPE_OMFLIBRARY) {
+        FindSymbolIndexUNIX();
+        if (SymbolIndexType == 0) {
+            err.submit(2622);  return;              // No symbol index
+        }
+    }
+    else {
+        StartExtracting();                         // Read OMF library header
+        if (err.Number()) return;
+        if (DictionarySize == 0 || (uint64)DictionaryOffset + DictionarySize * OMFBlockSize > GetDataSize()) {
+            err.submit(2622);  return;              // No dictionary
+        }
+    }
+
+    // Loop through symbol names specified on command line
+    for (i = 0; (Name = cmd.GetSymbolToFind(i)) != 0; i++) {
+        if (cmd.InputType == FILETYPE_OMFLIBRARY) {
+            Found = FindSymbolOMF(Name);
+        }
+        else {
+            Found = FindSymbolUNIX(Name);
+        }
+        if (err.Number()) return;
+        if (Found == 0) err.submit(1110, Name);     // Warning: symbol not found
+    }
+}
+
+void CLibrary::FindSymbolIndexUNIX() {
+    // Find symbol index and longnames members of UNIX style library.
+    // These members come before the object file members
+    SUNIXLibraryHeader * Header;                  // Member header
+    char * Name;                                  // Member name
+    uint32 MemberSize;                            // Size of member
+    uint32 NameLength;                            // Length of name after header
+    uint32 Data;                                  // Offset to member data
+    uint32 Offset = 8;                            // Offset to first member header
+
+    while (Offset && Offset + sizeof(SUNIXLibraryHeader) < GetDataSize()) {
+        Header = &Get<SUNIXLibraryHeader>(Offset);
+        Name = Header->Name;
+        MemberSize = (uint32)atoi(Header->FileSize);
+        Data = Offset + (uint32)sizeof(SUNIXLibraryHeader);
+        if ((uint64)Data + MemberSize > GetDataSize()) {
+            err.submit(2500);  return;              // Points outside file
+        }
+        if (strncmp(Name, "// ", 3) == 0) {
+            // Longnames member
+            LongNames = Data;  LongNamesSize = MemberSize;
+        }
+        else if (strncmp(Name, "/ ", 2) == 0) {
+            // COFF or ELF symbol index. A COFF library has a second symbol 
+            // index with the same name. Only the first one is used
+            if (SymbolIndexType == 0) {
+                SymbolIndexType = 1;  SymbolIndex = Data;  SymbolIndexSize = MemberSize;
+            }
+        }
+        else if (strncmp(Name, "/SYM64/ ", 8) == 0) {
+            // ELF symbol index with 64-bit offsets
+            if (SymbolIndexType == 0) {
+                SymbolIndexType = 2;  SymbolIndex = Data;  SymbolIndexSize = MemberSize;
+            }
+        }
+        else if (strncmp(Name, "__.SYMDEF", 9) == 0) {
+            // BSD or Mac symbol index, short name. "__.SYMDEF_64" is skipped
+            if (IsSymdefName(Name, sizeof(Header->Name))) {
+                SymbolIndexType = 3;  SymbolIndex = Data;  SymbolIndexSize = MemberSize;
+            }
+        }
+        else if (strncmp(Name, "#1/", 3) == 0) {
+            // Long name after header. Check if it is "__.SYMDEF SORTED"
+            NameLength = (uint32)atoi(Name + 3);
+            if (NameLength < 9 || NameLength > MemberSize || strncmp(Buf() + Data, "__.SYMDEF", 9) != 0) break;
+            if (IsSymdefName(Buf() + Data, NameLength)) {
+                SymbolIndexType = 3;  SymbolIndex = Data + NameLength;  SymbolIndexSize = MemberSize - NameLength;
+            }
+        }
+        else {
+            break;                                 // First object file member. No more index members
+        }
+        Offset = NextHeader(Offset);
+    }
+}
+
+int CLibrary::IsSymdefName(char const * s, uint32 len) {
+    // Check if member name s of length len is "__.SYMDEF" or "__.SYMDEF SORTED", 
+    // padded with spaces or zeroes. The 64-bit versions "__.SYMDEF_64" and 
+    // "__.SYMDEF_64 SORTED" have 8-byte entries which are not supported.
+    // Returns 1 if 32-bit BSD/Mac symbol index
+    uint32 n = 9;                                 // Length of "__.SYMDEF"
+    if (len < n || strncmp(s, "__.SYMDEF", n) != 0) return 0;
+    if (len >= 16 && strncmp(s + n, " SORTED", 7) == 0) n = 16;
+    for (; n < len; n++) {
+        if (s[n] != ' ' && s[n] != 0) return 0;
+    }
+    return 1;
+}
+
+int CLibrary::FindSymbolUNIX(char const * name) {
+    // Find members that define symbol in UNIX style library.
+    // Prints the name of each member found and returns the number found
+    uint32 NumSymbols;                            // Number of entries in symbol index
+    uint32 EntrySize;                             // Size of each member offset
+    uint32 Strings;                               // Offset to string table
+    uint32 StringsEnd;                            // End of string table
+    uint32 MemberOffset = 0;                      // Offset of member header
+    uint32 LastFound = 0;                         // Offset of last member found
+    uint32 NameLength = (uint32)strlen(name) + 1; // Length of name including terminating zero
+    uint32 IndexEnd = SymbolIndex + SymbolIndexSize; // End of symbol index
+    uint32 i;                                     // Loop counter
+    int Found = 0;                                // Number of members found
+
+    if (SymbolIndexType == 3) {
+        // BSD/Mac symbol index: size of array, array of (string offset, member offset), 
+        // size of string table, string table
+        if (SymbolIndexSize < 8) {err.submit(2500); return 0;}
+        uint32 ArraySize = Get<uint32>(SymbolIndex);
+        if ((uint64)ArraySize + 8 > SymbolIndexSize) {err.submit(2500); return 0;}
+        NumSymbols = ArraySize / sizeof(SStringEntry);
+        Strings = SymbolIndex + 8 + ArraySize;
+        StringsEnd = Strings + Get<uint32>(Strings - 4);
+        if (StringsEnd > IndexEnd || StringsEnd < Strings) StringsEnd = IndexEnd;
+
+        for (i = 0; i < NumSymbols; i++) {
+            SStringEntry & Entry = Get<SStringEntry>(SymbolIndex + 4 + i * sizeof(SStringEntry));
+            if (Entry.String < StringsEnd - Strings && NameLength <= StringsEnd - Strings - Entry.String
+            && memcmp(Buf() + Strings + Entry.String, name, NameLength) == 0) {
+                // Symbol found
+                MemberOffset = Entry.Member;
+                if (MemberOffset != LastFound) {
+                    printf("\nSymbol %s defined in member %s", name, MemberNameUNIX(MemberOffset));
+                    LastFound = MemberOffset;  Found++;
+                }
+            }
+        }
+        return Found;
+    }
+
+    // COFF and ELF symbol index: number of symbols, big-endian member offsets, strings
+    EntrySize = (SymbolIndexType == 2) ? 8 : 4;
+    if (SymbolIndexSize < EntrySize) {err.submit(2500); return 0;}
+    // Read number of symbols. A 64-bit number is read as its low half
+    NumSymbols = EndianChange(Get<uint32>(SymbolIndex + EntrySize - 4));
+    if ((uint64)NumSymbols * EntrySize + EntrySize > SymbolIndexSize) {err.submit(2500); return 0;}
+    Strings = SymbolIndex + EntrySize + NumSymbols * EntrySize;
+    char * p = Buf() + Strings;                   // Current string
+    char * pEnd = Buf() + IndexEnd;               // End of strings
+
+    for (i = 0; i < NumSymbols && p < pEnd; i++) {
+        // Get length of string, limited by end of index
+        char * pz = (char*)memchr(p, 0, pEnd - p);
+        if (pz == 0) break;
+        if (uint32(pz - p) + 1 == NameLength && memcmp(p, name, NameLength) == 0) {
+            // Symbol found. Get member offset
+            MemberOffset = EndianChange(Get<uint32>(SymbolIndex + EntrySize + i * EntrySize + EntrySize - 4));
+            if (MemberOffset != LastFound) {
+                printf("\nSymbol %s defined in member %s", name, MemberNameUNIX(MemberOffset));
+                LastFound = MemberOffset;  Found++;
+            }
+        }
+        p = pz + 1;
+    }
+    return Found;
+}
+
+char const * CLibrary::MemberNameUNIX(uint32 Offset) {
+    // Get name of UNIX library member from offset of header.
+    // The library buffer is not modified
+    static char Name[256];                        // Buffer for name
+    uint32 i;                                     // Loop counter
+    if ((uint64)Offset + sizeof(SUNIXLibraryHeader) > GetDataSize()) return "?";
+    SUNIXLibraryHeader & Header = Get<SUNIXLibraryHeader>(Offset);
+    char const * p = Header.Name;                 // Name in header
+    uint32 MaxLength = sizeof(Header.Name);       // Maximum length of name
+
+    if (p[0] == '/' && p[1] >= '0' && p[1] <= '9' && LongNames) {
+        // Name is in longnames member
+        uint32 NameIndex = (uint32)atoi(p + 1);
+        if (NameIndex >= LongNamesSize) return "?";
+        p = Buf() + LongNames + NameIndex;
+        MaxLength = LongNamesSize - NameIndex;
+    }
+    else if (strncmp(p, "#1/", 3) == 0) {
+        // Name follows header
+        MaxLength = (uint32)atoi(p + 3);
+        p = Buf() + Offset + sizeof(SUNIXLibraryHeader);
+        if ((uint64)Offset + sizeof(SUNIXLibraryHeader) + MaxLength > GetDataSize()) return "?";
+    }
+    // Copy name. It may be terminated by zero, linefeed, "/" or space, depending on system
+    if (MaxLength > sizeof(Name) - 1) MaxLength = sizeof(Name) - 1;
+    for (i = 0; i < MaxLength && p[i] && p[i] != '\n'; i++) Name[i] = p[i];
+    while (i > 0 && (Name[i-1] == '/' || Name[i-1] == ' ')) i--;
+    Name[i] = 0;
+    return Name;
+}
+
+int CLibrary::FindSymbolOMF(char const * name) {
+    // Find member that defines symbol in OMF style library, using the dictionary.
+    // Prints the name of the member found and returns the number of occurrences
+    char Name[256];                               // Copy of name. MakeHash may truncate it
+    COMFHashTable HashTab;                        // OMF hash table interpreter
+    uint32 ModulePage = 0;                        // Page number of member
+    uint32 Conflicts;                             // Number of conflicting entries
+    int    Found;                                 // Number of occurrences
+
+    strncpy(Name, name, sizeof(Name) - 1);  Name[sizeof(Name) - 1] = 0;
+    HashTab.Init(&Get<SOMFHashBlock>(DictionaryOffset), DictionarySize);
+    HashTab.MakeHash(Name);
+    Found = HashTab.FindString(ModulePage, Conflicts);
+    if (Found) {
+        // Get member name from THEADR record at start of member
+        char const * MemberName = "?";
+        if ((uint64)ModulePage * PageSize < DictionaryOffset) {
+            SOMFRecordPointer rec;                 // Record pointer
+            rec.Start(Buf(), ModulePage * PageSize, DictionaryOffset);
+            if (rec.Type2 == OMF_THEADR) MemberName = rec.GetString();
+        }
+        printf("\nSymbol %s defined in member %s", name, MemberName);
+    }
+    return Found;
+}
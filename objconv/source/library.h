@@ -1,7 +1,7 @@
 /****************************  library.h   ********************************
 * Author:        Agner Fog
 * Date created:  2006-07-15
-* Last modified: 2013-08-22
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        library.h
 * Description:
@@ -31,6 +31,32 @@ struct SUNIXLibraryHeader {
 };
 
 
+// Options in cmd that are resolved by CConverter::Go() when converting a library member
+struct SConversionState {
+    int    InputType;                   // cmd.InputType
+    int    DesiredWordSize;             // cmd.DesiredWordSize
+    uint32 Underscore;                  // cmd.Underscore
+    uint32 SegmentDot;                  // cmd.SegmentDot
+    uint32 DebugInfo;                   // cmd.DebugInfo
+    uint32 ExeptionInfo;                // cmd.ExeptionInfo
+};
+
+
+// Record describing a library member converted by a worker process
+struct SMemberConversion {
+    uint32 Member;                      // Member number
+    uint32 DataSize;                    // Size of converted member
+    int    FileType;                    // File type after conversion
+    int    WordSize;                    // Word size after conversion
+    int    Executable;                  // Executable flag after conversion
+    uint32 MessageStart;                // Position of text printed during conversion in message file
+    uint32 MessageSize;                 // Size of text printed during conversion
+    uint32 NumStatistics;               // Number of statistics counters that follow this record
+    SConversionState Before;            // Options in cmd before conversion
+    SConversionState After;             // Options in cmd after conversion
+};
+
+
 // Class for extracting members from library or building a library
 class CLibrary : public CFileBuffer {
 public:
@@ -52,7 +78,18 @@ protected:
     uint32 DictionaryOffset;            // Offset to hash table
     uint32 DictionarySize;              // Dictionary size, in 512 bytes blocks
 
+    // Properties for searching the symbol index of UNIX input libraries
+    uint32 SymbolIndex;                 // Offset to symbol index member data
+    uint32 SymbolIndexSize;             // Size of symbol index member
+    uint32 SymbolIndexType;             // 0 = none, 1 = "/" 32 bit big-endian, 2 = "/SYM64/" 64 bit big-endian, 3 = "__.SYMDEF" BSD/Mac
+
     // Methods and properties for reading library:
+    void FindSymbols();                 // Find members that define symbols specified with -lf option
+    int  FindSymbolUNIX(char const * name); // Find members that define symbol in UNIX style library. Returns number found
+    int  FindSymbolOMF(char const * name);  // Find member that defines symbol in OMF style library. Returns number found
+    void FindSymbolIndexUNIX();         // Find symbol index and longnames members of UNIX style library
+    static int IsSymdefName(char const * s, uint32 len); // Check if member name is "__.SYMDEF" or "__.SYMDEF SORTED"
+    char const * MemberNameUNIX(uint32 Offset); // Get name of UNIX library member from offset of header
     void DumpUNIX();                    // Print contents of UNIX style library
     void DumpOMF();                     // Print contents of OMF style library
     void CheckOMFHash(CMemoryBuffer &stringbuf, CSList<SStringEntry> &index);// Check if OMF library hash table has correct entries for all symbol names
@@ -65,6 +102,20 @@ protected:
     uint32 CurrentOffset;               // Offset to current member
     uint32 CurrentNumber;               // Number of current member
     int  MemberFileType;                // File type of members
+    // Methods and properties for converting members in worker processes
+    void StartConversionWorkers();      // Start worker processes for converting members
+    void ConvertMembersWorker(uint32 k);// Worker process number k. Converts a range of members
+    int  GetConvertedMember(uint32 Member); // Get member converted by a worker into MemberBuffer
+    void StopConversionWorkers();       // Wait for worker processes to finish
+    static void GetConversionState(SConversionState & s); // Save options that conversion can change
+    static void SetConversionState(SConversionState const & s); // Restore options that conversion can change
+    CArrayBuf<FILE*> ResultFiles;       // Temporary file with converted members from each worker
+    CArrayBuf<FILE*> MessageFiles;      // Temporary file with text printed by each worker
+    CArrayBuf<int> Workers;             // Process id of each worker. 0 when finished, -1 if no results
+    uint32 NumWorkers;                  // Number of worker processes
+    uint32 CurrentWorker;               // Worker whose results are currently being read
+    int    ResultPending;               // Record in Result has been read, but not used yet
+    SMemberConversion Result;           // Current record from worker
     // Methods and properties for modifying or writing library
     void FixNames();                    // Calls StripMemberNamesUNIX or RebuildOMF
     void StripMemberNamesUNIX();        // Remove path from member names
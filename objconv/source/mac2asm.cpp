@@ -1,7 +1,7 @@
 /****************************  mac2asm.cpp   *********************************
 * Author:        Agner Fog
 * Date created:  2007-05-24
-* Last modified: 2008-05-12
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        mac2asm.cpp
 * Description:
@@ -20,6 +20,7 @@ CMAC2ASM<MACSTRUCTURES>::CMAC2ASM() {
 template <class TMAC_header, class TMAC_segment_command, class TMAC_section, class TMAC_nlist, class MInt>
 void CMAC2ASM<MACSTRUCTURES>::Convert() {
    // Do the conversion
+   if (cmd.Stats) cmd.StartTimer(STAT_SYMBOLS);  // Time until Disasm.Go() begins pass 1
 
    // Check cpu type
    switch (this->FileHeader.cputype) {
@@ -1,7 +1,7 @@
 /****************************    macho.cpp    *******************************
 * Author:        Agner Fog
 * Date created:  2007-01-06
-* Last modified: 2008-06-02
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        macho.cpp
 * Description:
@@ -135,6 +135,7 @@ CMACHO<MACSTRUCTURES>::CMACHO() {
 template <class TMAC_header, class TMAC_segment_command, class TMAC_section, class TMAC_nlist, class MInt>
 void CMACHO<MACSTRUCTURES>::ParseFile(){
    // Load and parse file buffer
+   CStatTimer Timer(STAT_PARSE);       // Measure time if -stats option
    FileHeader = *(TMAC_header*)Buf();   // Copy file header
 
    // Loop through file commands
@@ -201,6 +202,10 @@ void CMACHO<MACSTRUCTURES>::Dump(int options) {
    int32  isec2;                       // Section index global
    int32  nsect;                        // Number of sections in segment
 
+   if (options & DUMP_JSON) {
+      DumpJson(options);  return;      // Machine-readable dump
+   }
+
    if (options & DUMP_FILEHDR) {
       // File header
       printf("\nDump of Mach-O file %s", FileName);
@@ -523,6 +528,199 @@ void CMACHO<MACSTRUCTURES>::Dump(int options) {
 
 }
 
+template <class TMAC_header, class TMAC_segment_command, class TMAC_section, class TMAC_nlist, class MInt>
+void CMACHO<MACSTRUCTURES>::DumpJson(int options) {
+   // Dump file as JSON Lines records, one record per line.
+   // Field names are the names of the Mach-O structure fields in macho.h.
+   // Fields ending in _name are the same texts as in the text dump
+   CJsonLineWriter json;
+   uint32 icmd, cmd, cmdsize, i;
+   uint32 isec = 0;                    // Section index, 1-based
+   uint32 SegmentCommand = (WordSize == 32) ? MAC_LC_SEGMENT : MAC_LC_SEGMENT_64;
+   uint32 currentoffset = sizeof(TMAC_header);
+
+   // Check that symbol table and string table are inside file
+   int SymbolsInFile = (uint64)SymTabOffset + (uint64)SymTabNumber * sizeof(TMAC_nlist) <= this->GetDataSize()
+      && (uint64)StringTabOffset + StringTabSize <= this->GetDataSize();
+   if (!SymbolsInFile) err.submit(2035);
+
+   if (options & DUMP_FILEHDR) {
+      // File header
+      json.Begin("header");
+      json.UInt("cputype", FileHeader.cputype);
+      json.Str("cputype_name", Lookup(MacMachineNames, FileHeader.cputype));
+      json.UInt("cpusubtype", FileHeader.cpusubtype);
+      json.UInt("filetype", FileHeader.filetype);
+      json.Str("filetype_name", Lookup(MacFileTypeNames, FileHeader.filetype));
+      json.UInt("ncmds", FileHeader.ncmds);
+      json.UInt("sizeofcmds", FileHeader.sizeofcmds);
+      json.UInt("flags", FileHeader.flags);
+      json.End();
+   }
+
+   // Loop through load commands
+   for (icmd = 1; icmd <= FileHeader.ncmds; icmd++) {
+      if (currentoffset + sizeof(MAC_load_command) > this->GetDataSize()) {
+         err.submit(2016);  break;
+      }
+      uint8 * currentp = (uint8*)(Buf() + currentoffset);
+      cmd     = ((MAC_load_command*)currentp) -> cmd;
+      cmdsize = ((MAC_load_command*)currentp) -> cmdsize;
+
+      if (options & DUMP_SECTHDR) {
+         // Load command
+         json.Begin("load_command");
+         json.Int("index", icmd);
+         json.UInt("cmd", cmd);
+         json.Str("cmd_name", Lookup(MacCommandTypeNames, cmd));
+         json.UInt("cmdsize", cmdsize);
+         if (cmd == SegmentCommand) {
+            TMAC_segment_command * sh = (TMAC_segment_command*)currentp;
+            json.Str("segname", sh->segname, 16);
+            json.UInt("vmaddr", sh->vmaddr);
+            json.UInt("vmsize", sh->vmsize);
+            json.UInt("fileoff", sh->fileoff);
+            json.UInt("filesize", sh->filesize);
+            json.UInt("maxprot", sh->maxprot);
+            json.UInt("initprot", sh->initprot);
+            json.UInt("nsects", sh->nsects);
+            json.UInt("flags", sh->flags);
+         }
+         else if (cmd == MAC_LC_SYMTAB) {
+            MAC_symtab_command * sh = (MAC_symtab_command*)currentp;
+            json.UInt("symoff", sh->symoff);
+            json.UInt("nsyms", sh->nsyms);
+            json.UInt("stroff", sh->stroff);
+            json.UInt("strsize", sh->strsize);
+         }
+         else if (cmd == MAC_LC_DYSYMTAB) {
+            MAC_dysymtab_command * sh = (MAC_dysymtab_command*)currentp;
+            json.UInt("ilocalsym", sh->ilocalsym);
+            json.UInt("nlocalsym", sh->nlocalsym);
+            json.UInt("iextdefsym", sh->iextdefsym);
+            json.UInt("nextdefsym", sh->nextdefsym);
+            json.UInt("iundefsym", sh->iundefsym);
+            json.UInt("nundefsym", sh->nundefsym);
+            json.UInt("indirectsymoff", sh->indirectsymoff);
+            json.UInt("nindirectsyms", sh->nindirectsyms);
+            json.UInt("extreloff", sh->extreloff);
+            json.UInt("nextrel", sh->nextrel);
+            json.UInt("locreloff", sh->locreloff);
+            json.UInt("nlocrel", sh->nlocrel);
+         }
+         json.End();
+      }
+
+      if (cmd == SegmentCommand && (options & (DUMP_SECTHDR | DUMP_RELTAB))) {
+         // Loop through section headers in segment
+         uint32 nsect = ((TMAC_segment_command*)currentp) -> nsects;
+         TMAC_section * sectp = (TMAC_section*)(currentp + sizeof(TMAC_segment_command));
+         for (uint32 isec1 = 0; isec1 < nsect; isec1++, sectp++) {
+            isec++;
+            if (options & DUMP_SECTHDR) {
+               json.Begin("section");
+               json.Int("index", isec);
+               json.Str("sectname", sectp->sectname, 16);
+               json.Str("segname", sectp->segname, 16);
+               json.UInt("addr", sectp->addr);
+               json.UInt("size", sectp->size);
+               json.UInt("offset", sectp->offset);
+               json.UInt("align", sectp->align);
+               json.UInt("reloff", sectp->reloff);
+               json.UInt("nreloc", sectp->nreloc);
+               json.UInt("flags", sectp->flags);
+               json.UInt("reserved1", sectp->reserved1);
+               json.UInt("reserved2", sectp->reserved2);
+               json.End();
+            }
+            if ((options & DUMP_RELTAB) && sectp->nreloc) {
+               // Relocations of this section
+               if ((uint64)sectp->reloff + (uint64)sectp->nreloc * sizeof(MAC_relocation_info) > this->GetDataSize()) {
+                  err.submit(2035);  continue;
+               }
+               MAC_relocation_info * relp = (MAC_relocation_info*)(Buf() + sectp->reloff);
+               for (uint32 r = 0; r < sectp->nreloc; r++, relp++) {
+                  json.Begin("relocation");
+                  json.Int("section", isec);
+                  json.Int("index", r);
+                  if (relp->r_address & R_SCATTERED) {
+                     // Scattered relocation
+                     MAC_scattered_relocation_info * scatp = (MAC_scattered_relocation_info*)relp;
+                     json.Bool("r_scattered", 1);
+                     json.UInt("r_address", scatp->r_address);
+                     json.Int("r_value", scatp->r_value);
+                     json.Int("r_pcrel", scatp->r_pcrel);
+                     json.Int("r_length", scatp->r_length);
+                     json.UInt("r_type", scatp->r_type);
+                     json.Str("r_type_name", (WordSize == 32) ? Lookup(Mac32RelocationTypeNames, scatp->r_type) : Lookup(Mac64RelocationTypeNames, scatp->r_type));
+                  }
+                  else {
+                     // Non-scattered relocation
+                     json.Bool("r_scattered", 0);
+                     json.UInt("r_address", relp->r_address);
+                     json.UInt("r_symbolnum", relp->r_symbolnum);
+                     json.Int("r_extern", relp->r_extern);
+                     json.Int("r_pcrel", relp->r_pcrel);
+                     json.Int("r_length", relp->r_length);
+                     json.UInt("r_type", relp->r_type);
+                     json.Str("r_type_name", (WordSize == 32) ? Lookup(Mac32RelocationTypeNames, relp->r_type) : Lookup(Mac64RelocationTypeNames, relp->r_type));
+                     if (relp->r_extern && relp->r_symbolnum < SymTabNumber && SymbolsInFile) {
+                        TMAC_nlist * symp = (TMAC_nlist*)(Buf() + SymTabOffset) + relp->r_symbolnum;
+                        if (symp->n_strx < StringTabSize) {
+                           json.Str("symbol", Buf() + StringTabOffset + symp->n_strx, StringTabSize - symp->n_strx);
+                        }
+                     }
+                     if (relp->r_address + (1u << relp->r_length) <= sectp->size && relp->r_length >= 2) {
+                        // Inline addend, 4 or 8 bytes
+                        uint32 pos = sectp->offset + relp->r_address;
+                        if (relp->r_length == 3) json.Int("inline_addend", Get<int64>(pos));
+                        else json.Int("inline_addend", Get<int32>(pos));
+                     }
+                  }
+                  json.End();
+               }
+            }
+         }
+      }
+      currentoffset += cmdsize;
+   }
+
+   if ((options & DUMP_SYMTAB) && SymTabNumber && SymbolsInFile) {
+      // Symbol table
+      char * strtab = (char*)(Buf() + StringTabOffset);
+      TMAC_nlist * symp = (TMAC_nlist*)(Buf() + SymTabOffset);
+      for (i = 0; i < SymTabNumber; i++, symp++) {
+         json.Begin("symbol");
+         json.Int("index", i);
+         if (symp->n_strx < StringTabSize) json.Str("name", strtab + symp->n_strx, StringTabSize - symp->n_strx);
+         else json.Str("name", "");
+         // Category given by the dysymtab command
+         if (i >= iextdefsym && i < iextdefsym + nextdefsym) json.Str("category", "public");
+         else if (i >= iundefsym && i < iundefsym + nundefsym) json.Str("category", "external");
+         else json.Str("category", "local");
+         json.UInt("n_type", symp->n_type);
+         if (!(symp->n_type & MAC_N_STAB)) json.Str("n_type_name", Lookup(MacSymbolTypeNames, symp->n_type & MAC_N_TYPE));
+         json.UInt("n_sect", symp->n_sect);
+         json.UInt("n_desc", (uint16)symp->n_desc);
+         json.UInt("n_value", symp->n_value);
+         json.End();
+      }
+   }
+
+   if ((options & DUMP_STRINGTB) && StringTabSize && SymbolsInFile) {
+      // String table. Offsets are relative to the start of the table
+      char * strtab = (char*)(Buf() + StringTabOffset);
+      uint32 len;
+      for (i = 0; i < StringTabSize; i += len + 1) {
+         len = (uint32)strnlen(strtab + i, StringTabSize - i);
+         json.Begin("string");
+         json.UInt("offset", i);
+         json.Str("value", strtab + i, len);
+         json.End();
+      }
+   }
+}
+
 template <class TMAC_header, class TMAC_segment_command, class TMAC_section, class TMAC_nlist, class MInt>
 void CMACHO<MACSTRUCTURES>::PublicNames(CMemoryBuffer * Strings, CSList<SStringEntry> * Index, int m) {
    // Make list of public names
@@ -708,17 +906,27 @@ void CMACUNIV::Go(int options) {
       ComponentBuffer.Reset();
       ComponentBuffer.Push(Buf() + ComponentOffset, ComponentSize);
 
-      // Indicate component
-      printf("\n\n\nComponent file number %i:\n", i + 1);
-
       // Check type
       uint32 ComponentType = ComponentBuffer.GetFileType();
+
+      // Indicate component
+      if (cmd.DumpOptions & DUMP_JSON) {
+         CJsonLineWriter json;
+         json.Begin("component");
+         json.Int("index", i + 1);
+         json.Str("format", GetFileFormatName(ComponentType));
+         json.Int("wordsize", ComponentBuffer.WordSize);
+         json.UInt("offset", ComponentOffset);
+         json.UInt("size", ComponentSize);
+         json.End();
+      }
+      else printf("\n\n\nComponent file number %i:\n", i + 1);
       if (DesiredWordSize && DesiredWordSize != ComponentBuffer.WordSize) {
          err.submit(1151, ComponentBuffer.WordSize);
       }
       else if (ComponentType != FILETYPE_MACHO_LE) {
          // Format not supported
-         printf("  Format not supported: %s", GetFileFormatName(ComponentType));
+         if (!(cmd.DumpOptions & DUMP_JSON)) printf("  Format not supported: %s", GetFileFormatName(ComponentType));
       }
       else {
          // Format OK. Handle component
@@ -1,7 +1,7 @@
 /****************************   main.cpp   **********************************
 * Author:        Agner Fog
 * Date created:  2006-07-26
-* Last modified: 2011-10-28
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        main.cpp
 * Description:
@@ -107,10 +107,27 @@ CMain::CMain() : CFileBuffer() {
 
 void CMain::Go() {
    // Do whatever the command line parameters say
+   if (cmd.BatchFile) {
+      // Batch mode. Convert all files listed in batch file
+      GoBatch();
+      return;
+   }
    FileName = cmd.InputFile;           // Get input file name from command line
+   memset(&CMemoryBuffer::Statistics, 0, sizeof(SMemoryStatistics)); // Count memory allocations for this file only
    // Ignore nonexisting filename when building library
    int IgnoreError = (cmd.FileOptions & CMDL_FILE_IN_IF_EXISTS) && !cmd.OutputFile;
-   Read(IgnoreError);                  // Read input file
+   if (cmd.Stats) cmd.StartTimer(STAT_READ);
+   if (((cmd.OutputType == CMDL_OUTPUT_DUMP || cmd.OutputType == FILETYPE_ASM) 
+   && !(cmd.FileOptions & CMDL_FILE_IN_OUT_SAME) && !cmd.LibraryOptions)
+   || cmd.LibraryOptions == CMDL_LIBRARY_FINDSYMBOL) {
+      // Input file is only read, not rewritten. Map file into memory rather than copying it.
+      // Searching a library index touches only the pages of the index and the member headers
+      ReadMapped(IgnoreError);
+   }
+   else {
+      Read(IgnoreError);               // Read input file
+   }
+   if (cmd.Stats) cmd.StopTimer(STAT_READ);
    GetFileType();                      // Determine file type
    cmd.InputType = FileType;           // Save input file type in cmd for access from other modules
    if (cmd.OutputType == 0) {
@@ -120,11 +137,18 @@ void CMain::Go() {
    if (err.Number()) return;           // Return if error
    CheckOutputFileName();              // Construct output file name with default extension
    if (err.Number()) return;
+   GoFile();                           // Convert, dump or modify file
+   if (cmd.Stats) cmd.ReportTimes();   // Report time and counters
+}
+
+void CMain::GoFile() {
+   // Convert, dump or modify file after it has been read
 
    if ((FileType & (FILETYPE_LIBRARY | FILETYPE_OMFLIBRARY)) 
    || (cmd.LibraryOptions & CMDL_LIBRARY_ADDMEMBER)) {
       // Input file is a library or we are building a library
       CLibrary lib;                    // Library handler object
+      CStatTimer Timer("CLibrary");    // Measure time if -stats option
       *this >> lib;                    // Transfer my file buffer to lib
       lib.Go();                        // Do conversion or dump
       *this << lib;                    // Get file buffer back
@@ -139,11 +163,189 @@ void CMain::Go() {
    if ((cmd.FileOptions & CMDL_FILE_OUTPUT) && OutputFileName) {
       // There is an output file to write
       cmd.CheckSymbolModifySuccess();  // Check if symbols to modify were found
-      if (err.Number()) return;        // Return if error
+      if (err.Number()) {
+         // Return if error. Remove temporary file written during disassembly. The output file is unchanged
+         if (cmd.OutputStreamed) remove(cmd.StreamFileName);
+         cmd.OutputStreamed = 0;
+         return;
+      }
       FileName = OutputFileName;       // Output file name
-      Write();                         // Write output file
+      if (cmd.OutputStreamed) {
+         // Output has been written to temporary file by -stream. Replace output file with it.
+         // rename does not replace an existing file in Windows
+         cmd.OutputStreamed = 0;
+         if (rename(cmd.StreamFileName, OutputFileName) != 0) {
+            remove(OutputFileName);
+            if (rename(cmd.StreamFileName, OutputFileName) != 0) err.submit(2104, OutputFileName);
+         }
+      }
+      else {
+         CStatTimer Timer(STAT_WRITE); // Measure time if -stats option
+         Write();                      // Write output file
+      }
       if (cmd.Verbose) cmd.ReportStatistics(); // Report statistics
    }
+   if (cmd.Verbose >= CMDL_VERBOSE_DIAGNOSTICS) CMemoryBuffer::ReportStatistics(); // Report memory allocation statistics
+}
+
+void CMain::ReadBatchFile(CFileBuffer & BatchFile, CSList<SBatchJob> & Jobs) {
+   // Read list of files from batch file.
+   // Each line contains an input file name and optionally an output file name.
+   // File names containing spaces must be enclosed in double quotes.
+   // Lines beginning with '#' or '//' are comments
+   char * p;                           // Current character in batch file
+   char * Names[3];                    // File names in one line
+   int    n;                           // Number of file names in line
+   SBatchJob Job;                      // Job record
+
+   BatchFile.FileName = cmd.BatchFile;
+   BatchFile.Read();
+   if (err.Number() || BatchFile.Buf() == 0) return;
+   p = BatchFile.Buf();
+   p[BatchFile.GetDataSize()] = 0;     // Make sure text is terminated. Buffer has extra space
+
+   while (*p) {
+      // Loop through lines
+      n = 0;
+      while (*p && *p != '\n') {
+         // Loop through file names in line
+         if (uint8(*p) <= uint8(' ')) {
+            p++;  continue;            // Skip whitespace
+         }
+         if (n == 0 && (*p == '#' || (p[0] == '/' && p[1] == '/'))) {
+            // Comment. Skip to end of line
+            while (*p && *p != '\n') p++;
+            break;
+         }
+         if (*p == '"') {
+            // Name in quotes
+            Names[n < 3 ? n : 2] = ++p;
+            while (*p && *p != '"' && *p != '\n') p++;
+         }
+         else {
+            Names[n < 3 ? n : 2] = p;
+            while (uint8(*p) > uint8(' ')) p++;
+         }
+         n++;
+         if (*p == '\n') {
+            *p = 0;  break;            // Terminate name and end line
+         }
+         if (*p) *p++ = 0;             // Terminate name
+      }
+      if (*p == '\n' || (*p == 0 && p < BatchFile.Buf() + BatchFile.GetDataSize())) p++; // Next line
+      if (n > 2) {
+         err.submit(2111, Names[0]);  // Too many names in line
+         continue;
+      }
+      if (n) {
+         Job.InputFile = Names[0];
+         Job.OutputFile = n > 1 ? Names[1] : 0;
+         Jobs.Push(Job);
+      }
+   }
+}
+
+void CMain::GoBatch() {
+   // Convert all files listed in batch file with the same command line options.
+   // The jobs are done by up to cmd.Threads worker processes at a time. Each worker
+   // process gets its own copy of the cmd and err objects so that there can be
+   // no interference between jobs. Messages from each job are printed in order
+   CFileBuffer BatchFile;              // Batch file. Contains the file names
+   CSList<SBatchJob> Jobs;             // List of jobs
+   uint32 NumJobs;                     // Number of jobs
+   uint32 k;                           // Job index
+
+   ReadBatchFile(BatchFile, Jobs);
+   if (err.Number()) return;
+   NumJobs = Jobs.GetNumEntries();
+   cmd.BatchFile = 0;                  // Each job converts one file
+
+#ifdef WORKER_PROCESSES_SUPPORTED
+   uint32 NumWorkers = cmd.Threads > 1 ? cmd.Threads : 1; // Maximum number of workers at a time
+   uint32 Running = 0;                 // Number of workers running
+   uint32 Next = 0;                    // Next job to start
+   uint32 Print = 0;                   // Next job to print messages from
+   int    WaitStatus;                  // Status from waitpid
+   int    pid;                         // Process id
+   char   Text[1024];                  // Buffer for copying messages
+   size_t n;                           // Number of bytes copied
+   CArrayBuf<FILE*> Messages;          // Temporary file for messages from each job
+   CArrayBuf<int> Workers;             // Process id of each worker. -1 if failed
+   CArrayBuf<int> Finished;            // 1 if job finished, 2 if finished successfully
+   if (NumJobs == 0) return;
+   Messages.SetNum(NumJobs);
+   Workers.SetNum(NumJobs);
+   Finished.SetNum(NumJobs);
+   cmd.Threads = 0;                    // Do not divide disassembly of each file between more processes
+
+   while (Print < NumJobs) {
+      // Start more jobs if there are free workers
+      while (Running < NumWorkers && Next < NumJobs) {
+         k = Next++;
+         fflush(stdout);  fflush(stderr);
+         Messages[k] = tmpfile();
+         Workers[k] = Messages[k] ? fork() : -1;
+         if (Workers[k] < 0) {
+            // Failed. Close the message file if tmpfile succeeded and fork failed
+            if (Messages[k]) fclose(Messages[k]);
+            Messages[k] = 0;
+            Finished[k] = 1;
+            continue;
+         }
+         if (Workers[k] > 0) {
+            Running++;  continue;      // Main process
+         }
+         // This is the worker process. Write messages to temporary file
+         dup2(fileno(Messages[k]), fileno(stdout));
+         dup2(fileno(Messages[k]), fileno(stderr));
+         setvbuf(stdout, 0, _IONBF, 0); // Keep messages to stdout and stderr in order
+         cmd.InputFile = Jobs[k].InputFile;
+         cmd.OutputFile = Jobs[k].OutputFile;
+         CMain Job;                    // Object for converting this file
+         Job.Go();
+         if (cmd.Verbose) printf("\n");
+         fflush(stdout);  fflush(stderr);
+         _exit(err.Number() ? 1 : 0);
+      }
+      if (!Finished[Print]) {
+         // Wait for any worker to finish
+         pid = waitpid(-1, &WaitStatus, 0);
+         if (pid <= 0) break;          // Should not occur
+         for (k = Print; k < Next; k++) {
+            if (Workers[k] == pid) {
+               Finished[k] = (WIFEXITED(WaitStatus) && WEXITSTATUS(WaitStatus) == 0) ? 2 : 1;
+               Running--;
+            }
+         }
+         continue;
+      }
+      // Copy messages from next job in order
+      if (Messages[Print]) {
+         rewind(Messages[Print]);
+         while ((n = fread(Text, 1, sizeof(Text), Messages[Print])) > 0) {
+            fwrite(Text, 1, n, stdout);
+         }
+         fclose(Messages[Print]);
+         fflush(stdout);
+      }
+      if (Finished[Print] != 2) err.submit(2108, Jobs[Print].InputFile);
+      Print++;
+   }
+#else
+   // Worker processes not supported on this platform. Do the jobs one by one
+   int    OutputType = cmd.OutputType; // Output type may be changed by conversion
+   int    NumErrors;                   // Number of errors before job
+   for (k = 0; k < NumJobs; k++) {
+      cmd.InputFile = Jobs[k].InputFile;
+      cmd.OutputFile = Jobs[k].OutputFile;
+      cmd.OutputType = OutputType;
+      NumErrors = err.Number();
+      CMain Job;                       // Object for converting this file
+      Job.Go();
+      if (cmd.Verbose) printf("\n");
+      if (err.Number() != NumErrors) err.submit(2108, Jobs[k].InputFile);
+   }
+#endif
 }
 
 CConverter::CConverter() {
@@ -152,6 +354,7 @@ CConverter::CConverter() {
 
 void CConverter::DumpCOF() {
    // Dump COFF file
+   CStatTimer Timer("CCOFF");          // Measure time if -stats option
    CCOFF cof;                          // Make object for interpreting COFF file
    *this >> cof;                       // Give it my buffer
    cof.ParseFile();                    // Parse file buffer
@@ -162,6 +365,7 @@ void CConverter::DumpCOF() {
 
 void CConverter::DumpELF() {
    // Dump ELF file
+   CStatTimer Timer("CELF");           // Measure time if -stats option
    if (WordSize == 32) {
       // Make object for interpreting 32 bit ELF file
       CELF<ELF32STRUCTURES> elf;
@@ -184,6 +388,7 @@ void CConverter::DumpELF() {
 
 void CConverter::DumpMACHO() {
    // Dump Mach-O file
+   CStatTimer Timer("CMACHO");            // Measure time if -stats option
    if (WordSize == 32) {
       // Make object for interpreting 32 bit Mach-O file
       CMACHO<MAC32STRUCTURES> macho;
@@ -206,6 +411,7 @@ void CConverter::DumpMACHO() {
 
 void CConverter::ParseMACUnivBin() {
    // Dump Mac universal binary
+   CStatTimer Timer("CMACUNIV");       // Measure time if -stats option
    CMACUNIV macuniv;                   // Make object for interpreting Mac universal binary file
    *this >> macuniv;                   // Give it my buffer
    macuniv.Go(cmd.DumpOptions);        // Dump file components
@@ -214,6 +420,7 @@ void CConverter::ParseMACUnivBin() {
 
 void CConverter::DumpOMF() {
    // Dump OMF file
+   CStatTimer Timer("COMF");           // Measure time if -stats option
    COMF omf;                           // Make object for interpreting OMF file
    *this >> omf;                       // Give it my buffer
    omf.ParseFile();                    // Parse file buffer
@@ -224,6 +431,7 @@ void CConverter::DumpOMF() {
 
 void CConverter::COF2ELF() {
    // Convert COFF to ELF file
+   CStatTimer Timer("CCOF2ELF");       // Measure time if -stats option
    if (WordSize == 32) {
       // Make instance of converter, 32 bit template
       CCOF2ELF<ELF32STRUCTURES> conv;  // Make object for conversion 
@@ -246,6 +454,7 @@ void CConverter::COF2ELF() {
 
 void CConverter::COF2OMF() {
    // Convert COFF to OMF file
+   CStatTimer Timer("CCOF2OMF");       // Measure time if -stats option
    CCOF2OMF conv;                      // Make object for conversion 
    *this >> conv;                      // Give it my buffer
    conv.ParseFile();                   // Parse file buffer
@@ -256,6 +465,7 @@ void CConverter::COF2OMF() {
 
 void CConverter::OMF2COF() {
    // Convert OMF to COFF file 
+   CStatTimer Timer("COMF2COF");       // Measure time if -stats option
    COMF2COF conv;                      // Make object for conversion 
    *this >> conv;                      // Give it my buffer
    conv.ParseFile();                   // Parse file buffer
@@ -266,6 +476,7 @@ void CConverter::OMF2COF() {
 
 void CConverter::ELF2COF() {
    // Convert ELF to COFF file
+   CStatTimer Timer("CELF2COF");       // Measure time if -stats option
    if (WordSize == 32) {
       // Make instance of converter, 32 bit template
       CELF2COF<ELF32STRUCTURES> conv;
@@ -288,6 +499,7 @@ void CConverter::ELF2COF() {
 
 void CConverter::ELF2MAC() {
    // Convert ELF to Mach-O file
+   CStatTimer Timer("CELF2MAC");          // Measure time if -stats option
    if (WordSize == 32) {
       // Make instance of converter, 32 bit template
       CELF2MAC<ELF32STRUCTURES,MAC32STRUCTURES> conv;
@@ -310,6 +522,7 @@ void CConverter::ELF2MAC() {
 
 void CConverter::MAC2ELF() {
    // Convert Mach-O file to ELF file
+   CStatTimer Timer("CMAC2ELF");          // Measure time if -stats option
    if (WordSize == 32) {
       // Make instance of converter, 32 bit template
       CMAC2ELF<MAC32STRUCTURES,ELF32STRUCTURES> conv;
@@ -332,6 +545,7 @@ void CConverter::MAC2ELF() {
 
 void CConverter::COF2ASM() {
    // Disassemble COFF file
+   CStatTimer Timer("CCOF2ASM");       // Measure time if -stats option
    CCOF2ASM conv;                      // Make object for conversion 
    *this >> conv;                      // Give it my buffer
    conv.ParseFile();                   // Parse file buffer
@@ -342,6 +556,7 @@ void CConverter::COF2ASM() {
 
 void CConverter::ELF2ASM() {
    // Disassemble ELF file
+   CStatTimer Timer("CELF2ASM");          // Measure time if -stats option
    if (WordSize == 32) {
       // Make instance of converter, 32 bit template
       CELF2ASM<ELF32STRUCTURES> conv;
@@ -364,6 +579,7 @@ void CConverter::ELF2ASM() {
 
 void CConverter::MAC2ASM() {
    // Disassemble Mach-O file
+   CStatTimer Timer("CMAC2ASM");          // Measure time if -stats option
    if (WordSize == 32) {
       // Make instance of converter, 32 bit template
       CMAC2ASM<MAC32STRUCTURES> conv;
@@ -386,6 +602,7 @@ void CConverter::MAC2ASM() {
 
 void CConverter::OMF2ASM() {
    // Disassemble OMF file
+   CStatTimer Timer("COMF2ASM");       // Measure time if -stats option
    COMF2ASM conv;                      // Make object for conversion 
    *this >> conv;                      // Give it my buffer
    conv.ParseFile();                   // Parse file buffer
@@ -396,6 +613,7 @@ void CConverter::OMF2ASM() {
 
 void CConverter::COF2COF() {
    // Make changes in COFF file
+   CStatTimer Timer("CCOF2COF");       // Measure time if -stats option
    CCOF2COF conv;                      // Make instance of converter
    *this >> conv;                      // Give it my buffer
    conv.ParseFile();                   // Parse file buffer
@@ -406,6 +624,7 @@ void CConverter::COF2COF() {
 
 void CConverter::ELF2ELF() {
    // Make changes in ELF file
+   CStatTimer Timer("CELF2ELF");       // Measure time if -stats option
    if (WordSize == 32) {
       // Make instance of converter, 32 bit template
       CELF2ELF<ELF32STRUCTURES> conv;
@@ -428,6 +647,7 @@ void CConverter::ELF2ELF() {
 
 void CConverter::MAC2MAC() {
    // Make changes in Mach-O file
+   CStatTimer Timer("CMAC2MAC");       // Measure time if -stats option
    if (WordSize == 32) {
       // Make instance of converter, 32 bit template
       CMAC2MAC<MAC32STRUCTURES> conv;
@@ -456,7 +676,18 @@ void CConverter::Go() {
 
    if (cmd.OutputType == CMDL_OUTPUT_DUMP) {
       // File dump requested
-      if (cmd.Verbose > 0) {
+      if (cmd.DumpOptions & DUMP_JSON) {
+         // Start with a record telling which file the following records belong to
+         CJsonLineWriter json;
+         json.Begin("file");
+         json.Str("name", FileName);
+         json.Str("format", GetFileFormatName(FileType));
+         json.Int("wordsize", WordSize);
+         json.UInt("size", GetDataSize());
+         json.Bool("executable", Executable);
+         json.End();
+      }
+      else if (cmd.Verbose > 0) {
          // Tell what we are doing:
          printf("\nDump of file: %s, type: %s%i", FileName, GetFileFormatName(FileType), WordSize);
       }
@@ -480,7 +711,7 @@ void CConverter::Go() {
       default:
          err.submit(2010, GetFileFormatName(FileType));  // Dump of this file type not supported
       }
-      printf("\n");                              // New line
+      if (!(cmd.DumpOptions & DUMP_JSON)) printf("\n"); // New line
    }
    else {
       // File conversion requested
@@ -1,7 +1,7 @@
 /****************************    omf.cpp    *********************************
 * Author:        Agner Fog
 * Date created:  2007-01-29
-* Last modified: 2009-07-17
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        omf.cpp
 * Description:
@@ -93,6 +93,7 @@ COMF::COMF() {
 
 void COMF::ParseFile() {
    // Parse file buffer
+   CStatTimer Timer(STAT_PARSE);                 // Measure time if -stats option
    //uint8  RecordType;                            // Type of current record
    uint32 Checksum;                              // Record checksum
    uint32 ChecksumZero = 0;                      // Count number of records with zero checksum
@@ -203,6 +204,10 @@ void COMF::ParseFile() {
 
 void COMF::Dump(int options) {
    // Dump file
+   if (options & DUMP_JSON) {
+      DumpJson(options);  return;      // Machine-readable dump
+   }
+
    if (options & DUMP_FILEHDR) DumpRecordTypes(); // Dump summary of record types
 
    if (options & DUMP_STRINGTB) DumpNames(); // Dump names records
@@ -642,6 +647,271 @@ void COMF::DumpComments() {
 }
 
 
+void COMF::DumpJson(int options) {
+   // Dump file as JSON Lines records, one record per line.
+   // The records are emitted in file order. Each record has the index of
+   // the OMF record it comes from. Comment records are not included
+   CJsonLineWriter json;
+   uint32 i;                           // Record index
+   uint32 ln = 0;                      // Local name index
+   uint32 xn = 0;                      // External name index
+   uint32 SegNum = 0;                  // Segment number
+   uint32 Segment, Group, Offset, TypeIndex, NameIndex;
+   uint32 LastOffset = 0;              // Offset of last LEDATA, LIDATA or COMDAT record
+   OMF_SAttrib Attributes;             // SEGDEF attributes
+   OMF_SLocat Locat;                   // First two bytes of FIXUP subrecord, swapped
+   OMF_SFixData FixData;               // FixData field of FIXUP subrecord
+   OMF_STrdDat TrdDat;                 // Thread Data field of THREAD subrecord
+
+   for (i = 0; i < NumRecords; i++) {
+      SOMFRecordPointer & rec = Records[i];
+      rec.Index = 3;                   // Start of record contents
+
+      if (options & DUMP_FILEHDR) {
+         // Summary of records
+         json.Begin("record");
+         json.Int("index", i);
+         json.UInt("Type", rec.Type);
+         json.Str("Type_name", Lookup(OMFRecordTypeNames, rec.Type2));
+         json.UInt("FileOffset", rec.FileOffset);
+         json.UInt("length", rec.End + 1);
+         json.End();
+      }
+
+      switch (rec.Type2) {
+      case OMF_THEADR: case OMF_LHEADR:
+         if (options & DUMP_STRINGTB) {
+            json.Begin("module");
+            json.Int("record", i);
+            json.Str("name", rec.GetString());
+            json.End();
+         }
+         break;
+
+      case OMF_LNAMES:
+         // Local names
+         while (rec.Index < rec.End) {
+            char * name = rec.GetString();
+            ln++;
+            if (options & DUMP_STRINGTB) {
+               json.Begin("lname");
+               json.Int("record", i);
+               json.Int("index", ln);
+               json.Str("name", name);
+               json.End();
+            }
+         }
+         break;
+
+      case OMF_EXTDEF:
+         // External names
+         while (rec.Index < rec.End) {
+            char * name = rec.GetString();
+            TypeIndex = rec.GetIndex();
+            xn++;
+            if (options & DUMP_SYMTAB) {
+               json.Begin("symbol");
+               json.Int("record", i);
+               json.Str("kind", "external");
+               json.Int("index", xn);
+               json.Str("name", name);
+               json.UInt("type_index", TypeIndex);
+               json.End();
+            }
+         }
+         break;
+
+      case OMF_CEXTDEF:
+         // Communal names that refer to local names
+         while (rec.Index < rec.End) {
+            NameIndex = rec.GetIndex();
+            TypeIndex = rec.GetIndex();
+            xn++;
+            if (options & DUMP_SYMTAB) {
+               json.Begin("symbol");
+               json.Int("record", i);
+               json.Str("kind", "communal");
+               json.Int("index", xn);
+               json.Str("name", GetLocalName(NameIndex));
+               json.UInt("type_index", TypeIndex);
+               json.End();
+            }
+         }
+         break;
+
+      case OMF_PUBDEF:
+         // Public names
+         if (!(options & DUMP_SYMTAB)) break;
+         Group = rec.GetIndex();
+         Segment = rec.GetIndex();
+         {
+            uint32 BaseFrame = 0;
+            if (Segment == 0) BaseFrame = rec.GetWord();
+            while (rec.Index < rec.End) {
+               char * name = rec.GetString();
+               Offset = rec.GetNumeric();
+               TypeIndex = rec.GetIndex();
+               json.Begin("symbol");
+               json.Int("record", i);
+               json.Str("kind", "public");
+               json.Str("name", name);
+               json.Str("segment", GetSegmentName(Segment));
+               json.Str("group", GetGroupName(Group));
+               json.UInt("offset", Offset);
+               json.UInt("type_index", TypeIndex);
+               if (BaseFrame) json.UInt("frame", BaseFrame);
+               json.End();
+            }
+         }
+         break;
+
+      case OMF_SEGDEF:
+         // Segment definition
+         while (rec.Index < rec.End) {
+            uint32 Frame = 0, FrameOffset = 0;
+            Attributes.b = rec.GetByte();
+            if (Attributes.u.A == 0) {
+               Frame = rec.GetWord();  FrameOffset = rec.GetByte();
+            }
+            uint32 SegLength = rec.GetNumeric();
+            NameIndex = rec.GetIndex();
+            uint32 ClassIndex = rec.GetIndex();
+            uint32 OverlayIndex = rec.GetIndex();
+            SegNum++;
+            if (options & DUMP_SECTHDR) {
+               json.Begin("segment");
+               json.Int("record", i);
+               json.Int("index", SegNum);
+               json.Str("name", GetLocalName(NameIndex));
+               json.Str("class", GetLocalName(ClassIndex));
+               json.UInt("align", OMFAlignTranslate[Attributes.u.A]);
+               json.UInt("combine", Attributes.u.C);
+               json.Str("combine_name", Lookup(OMFSegmentCombinationNames, Attributes.u.C));
+               json.Int("wordsize", Attributes.u.P ? 32 : 16);
+               json.Bool("big", Attributes.u.B);
+               if (Attributes.u.A == 0) {
+                  json.UInt("frame", Frame);  json.UInt("frame_offset", FrameOffset);
+               }
+               json.UInt("length", SegLength);
+               if (OverlayIndex) json.UInt("overlay", OverlayIndex);
+               json.End();
+            }
+         }
+         break;
+
+      case OMF_GRPDEF:
+         // Group definition
+         if (!(options & DUMP_SECTHDR)) break;
+         NameIndex = rec.GetIndex();
+         while (rec.Index < rec.End) {
+            uint8 Type = rec.GetByte();
+            Segment = rec.GetIndex();
+            json.Begin("group");
+            json.Int("record", i);
+            json.Str("name", GetLocalName(NameIndex));
+            json.Str("segment", GetSegmentName(Segment));
+            if (Type != 0xFF) json.UInt("component_type", Type);
+            json.End();
+         }
+         break;
+
+      case OMF_LEDATA: case OMF_LIDATA:
+         // Data record. Fixups that follow are relative to this offset
+         Segment = rec.GetIndex();
+         LastOffset = rec.GetNumeric();
+         if (options & DUMP_RELTAB) {
+            json.Begin("data");
+            json.Int("record", i);
+            json.Str("kind", rec.Type2 == OMF_LEDATA ? "LEDATA" : "LIDATA");
+            if (Segment < 0x4000) json.Str("segment", GetSegmentName(Segment));
+            else json.UInt("communal", Segment & ~0x4000);    // Undocumented Borland communal section
+            json.UInt("offset", LastOffset);
+            json.UInt("size", rec.End - rec.Index);      // Size before expansion of repeat blocks
+            json.End();
+         }
+         break;
+
+      case OMF_COMDAT: {
+         // COMDAT record
+         uint32 Attrib = rec.GetByte();
+         uint32 Align = rec.GetByte();
+         LastOffset = rec.GetNumeric();
+         TypeIndex = rec.GetIndex();
+         uint32 Base = 0;
+         if ((Attrib & 0x0F) == 0) Base = rec.GetIndex();
+         NameIndex = rec.GetIndex();
+         if (options & DUMP_RELTAB) {
+            json.Begin("data");
+            json.Int("record", i);
+            json.Str("kind", "COMDAT");
+            json.Str("name", GetLocalName(NameIndex));
+            json.UInt("offset", LastOffset);
+            json.UInt("size", rec.End - rec.Index);
+            json.UInt("attributes", Attrib);
+            json.UInt("align", Align);
+            json.UInt("type_index", TypeIndex);
+            json.UInt("base", Base);
+            json.End();
+         }
+         break;}
+
+      case OMF_FIXUPP:
+         // Fixup subrecords
+         if (!(options & DUMP_RELTAB)) break;
+         while (rec.Index < rec.End) {
+            uint8 byte1 = rec.GetByte();
+            if (byte1 & 0x80) {
+               // FIXUP subrecord
+               Locat.bytes[1] = byte1;
+               Locat.bytes[0] = rec.GetByte();
+               FixData.b = rec.GetByte();
+               json.Begin("fixup");
+               json.Int("record", i);
+               json.UInt("offset", Locat.s.Offset + LastOffset);
+               json.UInt("mode", Locat.s.M);
+               json.Str("mode_name", Lookup(OMFRelocationModeNames, Locat.s.M));
+               json.UInt("location", Locat.s.Location);
+               json.Str("location_name", Lookup(OMFFixupLocationNames, Locat.s.Location));
+               if (FixData.s.F == 0) {
+                  json.UInt("frame_method", FixData.s.Frame);
+                  if (FixData.s.Frame < 4) json.UInt("frame", rec.GetIndex());
+               }
+               else json.UInt("frame_thread", FixData.s.Frame);
+               if (FixData.s.T == 0) {
+                  uint32 Target = rec.GetIndex();
+                  json.UInt("target_method", FixData.s.Target + FixData.s.P * 4);
+                  json.UInt("target", Target);
+                  switch (FixData.s.Target) {
+                  case 0: case 1:  // Target = segment or group
+                     json.Str("target_segment", GetSegmentName(Target));  break;
+                  case 2:          // Target = external symbol
+                     json.Str("symbol", GetSymbolName(Target));  break;
+                  }
+               }
+               else json.UInt("target_thread", FixData.s.Target);
+               if (FixData.s.P == 0) json.Int("displacement", (int32)rec.GetNumeric());
+               json.End();
+            }
+            else {
+               // THREAD subrecord
+               TrdDat.b = byte1;
+               uint32 Index = 0;
+               if (TrdDat.s.Method < 4) Index = rec.GetIndex();
+               json.Begin("fixup_thread");
+               json.Int("record", i);
+               json.Str("kind", TrdDat.s.D ? "frame" : "target");
+               json.UInt("thread", TrdDat.s.Thread);
+               json.UInt("method", TrdDat.s.Method);
+               json.UInt("index", Index);
+               json.End();
+            }
+         }
+         break;
+      }
+   }
+}
+
+
 void COMF::PublicNames(CMemoryBuffer * Strings, CSList<SStringEntry> * Index, int m) {
    // Make list of public names
    // Strings will receive ASCIIZ strings
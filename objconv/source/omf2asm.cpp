@@ -1,7 +1,7 @@
 /****************************  omf2asm.cpp   *********************************
 * Author:        Agner Fog, modified by Don Clugston
 * Date created:  2007-05-27
-* Last modified: 2014-05-32
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        omf2asm.cpp
 * Description:
@@ -20,6 +20,7 @@ COMF2ASM::COMF2ASM() {
 // Convert
 void COMF2ASM::Convert() {
    // Do the conversion
+   if (cmd.Stats) cmd.StartTimer(STAT_SYMBOLS);  // Time until Disasm.Go() begins pass 1
    
    // Tell disassembler
    Disasm.Init(0, 0);
@@ -1,7 +1,7 @@
 /****************************   stdafx.h    **********************************
 * Author:        Agner Fog
 * Date created:  2006-07-15
-* Last modified: 2006-07-15
+* Last modified: 2026-10-16
 * Project:       objconv
 * Module:        stdafx.h
 * Description:
@@ -28,6 +28,15 @@
 #else                            // For Gnu and other compilers:
   #define stricmp  strcasecmp    // Alternative function names
   #define strnicmp strncasecmp
+  #if defined(__unix__) || defined(__APPLE__) // Memory-mapped files and worker processes
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/stat.h>
+    #include <sys/mman.h>
+    #include <sys/wait.h>
+    #define MAPPED_FILES_SUPPORTED 1
+    #define WORKER_PROCESSES_SUPPORTED 1
+  #endif
 #endif
 
 // Project header files. The order of these files is not arbitrary.
@@ -1,4 +1,4 @@
-//                       PMCTestA.cpp                2018-04-09 Agner Fog
+//                       PMCTestA.cpp                2026-10-16 Agner Fog
 //
 //          Multithread PMC Test program for Windows and Linux
 //
@@ -11,6 +11,9 @@
 // In 64-bit Windows: Run as administrator, with driver signature enforcement
 // off.
 //
+// In Linux, the perf_event_open system call is used if the driver MSRdrv is
+// not installed.
+//
 // See PMCTest.txt for further instructions.
 //
 // To turn on counters for use in another program, run with command line option
@@ -18,12 +21,29 @@
 // To turn counters off again, use command line option 
 //     stopcounters
 //
+// To get a summary with median, percentiles etc. instead of all repetitions,
+// use command line options:
+//     summary, csv or json     output format
+//     ci=0.01                  repeat until 95% confidence interval of median
+//                              clock count is within 1% of median
+//     maxruns=n                maximum number of runs of the test loop
+//     outliers=3.5             reject repetitions with clock count more than
+//                              3.5 standard deviations above median
+//
+// To choose which processors the threads run on, use command line option
+//     placement=smt            threads on the same core as thread 0 (hyperthreads)
+//     placement=core           threads on different cores in the same socket
+//     placement=socket         threads alternately on different sockets
+//     placement=0,2,4          threads on the listed processor numbers
+// To print the results of all threads side by side, use command line option
+//     sidebyside
+//
 //  2000-2018 GNU General Public License v. 3. www.gnu.org/licenses
 //////////////////////////////////////////////////////////////////////////////
 
 #include "PMCTest.h"
 
-// #include <math.h> // for warmup only
+#include <math.h>
 
 int diagnostics = 0; // 1 for output of CPU model and PMC scheme
 
@@ -53,9 +73,18 @@ double clockFactor[MAXTHREADS] = {0};
 // number of repetitions in each thread
 int repetitions;
 
+// thread placement from command line: smt, core, socket or list of processor numbers
+const char * Placement = 0;
+
+// print results of all threads side by side
+int SideBySide = 0;
+
 // Create CCounters instance
 CCounters MSRCounters;
 
+// Results of all runs
+CStatistics Statistics;
+
 
 //////////////////////////////////////////////////////////////////////
 //
@@ -161,6 +190,14 @@ int setcounters(int argc, char* argv[]) {
     int e = MSRCounters.StartDriver();
     if (e) return e;
 
+#ifdef PERF_EVENTS_SUPPORTED
+    if (MSRCounters.UsePerf) {
+        // perf events are closed when the program exits
+        printf("\nstartcounters and stopcounters require the driver %s\n", MSRCounters.msr.GetDriverName());
+        return 1;
+    }
+#endif
+
     // Start MSR counters
     for (thread = 0; thread < NumThreads; thread++) {
         if (ProcNum[thread] >= 0) {
@@ -202,6 +239,133 @@ int setcounters(int argc, char* argv[]) {
 }
 
 
+//////////////////////////////////////////////////////////////////////
+//
+//        Thread placement
+//
+//////////////////////////////////////////////////////////////////////
+
+// Choose processor numbers for all threads from command line option
+// placement=smt, core, socket or a list of processor numbers.
+// Return value is nonzero on error
+int PlaceThreads(const char * mode, SyS::ProcMaskType & mask, int maxProc) {
+    int t, u, p, k;
+    int package[64], core[64], avail[64];
+    int packages[64], numPackages = 0;       // list of packages in order of first appearance
+
+    if (mode[0] >= '0' && mode[0] <= '9') {
+        // list of processor numbers
+        const char * s = mode;
+        for (t = 0; t < NumThreads; t++) {
+            if (*s < '0' || *s > '9') {
+                printf("\nplacement needs %i processor numbers\n", NumThreads);
+                return 1;
+            }
+            p = atoi(s);
+            if (p >= maxProc || !SyS::TestProcessMask(p, &mask)) {
+                printf("\nProcessor %i not available\n", p);
+                return 1;
+            }
+            ProcNum[t] = p;
+            while (*s >= '0' && *s <= '9') s++;
+            if (*s == ',') s++;
+        }
+        return 0;
+    }
+    if (strcmp(mode, "smt") && strcmp(mode, "core") && strcmp(mode, "socket")) {
+        printf("\nUnknown placement %s. Use smt, core, socket or list of processor numbers\n", mode);
+        return 1;
+    }
+
+    // get topology of available processors
+    for (p = 0; p < maxProc; p++) {
+        avail[p] = SyS::TestProcessMask(p, &mask) && SyS::GetTopology(p, &package[p], &core[p]);
+        if (avail[p]) {
+            for (k = 0; k < numPackages && packages[k] != package[p]; k++) {}
+            if (k == numPackages) packages[numPackages++] = package[p];
+        }
+    }
+    if (numPackages == 0) {
+        printf("\nProcessor topology not available\n");
+        return 1;
+    }
+
+    for (t = 0; t < NumThreads; t++) {
+        for (p = 0; p < maxProc; p++) {
+            if (!avail[p]) continue;
+            if (t == 0) break;                   // first thread on first available processor
+            if (mode[1] == 'm') {
+                // smt: same core as first thread
+                if (package[p] == package[ProcNum[0]] && core[p] == core[ProcNum[0]]) break;
+                continue;
+            }
+            // core: same package as first thread. socket: next package in turn
+            k = mode[0] == 'c' ? package[ProcNum[0]] : packages[t % numPackages];
+            if (package[p] != k) continue;
+            // core must not be used by a previous thread
+            for (u = 0; u < t; u++) {
+                if (package[ProcNum[u]] == package[p] && core[ProcNum[u]] == core[p]) break;
+            }
+            if (u == t) break;
+        }
+        if (p >= maxProc) {
+            printf("\nNot enough processors for %i threads with placement=%s\n", NumThreads, mode);
+            return 1;
+        }
+        ProcNum[t] = p;
+        avail[p] = 0;
+    }
+    return 0;
+}
+
+
+//////////////////////////////////////////////////////////////////////
+//
+//        Print results of all threads side by side
+//
+//////////////////////////////////////////////////////////////////////
+void PrintSideBySide() {
+    int t, i, repi;
+    int ClockOS = ClockResultsOS / sizeof(int);
+    int PMCOS   = PMCResultsOS / sizeof(int);
+    int corrected = UsePMC && MSRCounters.MScheme == S_AMD2;
+    int columns = 1 + corrected + (UsePMC ? NumCounters : 0);
+
+    // print column headings
+    printf("\n");
+    for (t = 0; t < NumThreads; t++) {
+        printf("Proc %-*i", columns * 11 - 5, ProcNum[t]);
+    }
+    printf("\n");
+    for (t = 0; t < NumThreads; t++) {
+        printf("%10s ", "Clock");
+        if (corrected) printf("%10s ", "Corrected");
+        if (UsePMC) {
+            for (i = 0; i < NumCounters; i++) {
+                printf("%10s ", MSRCounters.CounterNames[i]);
+            }
+        }
+    }
+
+    // print counter outputs, one line for each repetition
+    for (repi = 0; repi < repetitions; repi++) {
+        printf("\n");
+        for (t = 0; t < NumThreads; t++) {
+            int TOffset = t * (ThreadDataSize / sizeof(int));
+            int tscClock = PThreadData[repi+TOffset+ClockOS];
+            printf("%10i ", tscClock);
+            if (corrected) printf("%10i ", int(tscClock * clockFactor[t] + 0.5)); // Calculated core clock count
+            if (UsePMC) {
+                for (i = 0; i < NumCounters; i++) {
+                    printf("%10i ", PThreadData[repi+i*repetitions+TOffset+PMCOS]);
+                }
+            }
+        }
+    }
+    printf("\n");
+}
+
+
 //////////////////////////////////////////////////////////////////////
 //
 //        Main
@@ -214,15 +378,17 @@ int main(int argc, char* argv[]) {
     int e;                              // error number
     int procthreads;                    // number of threads supported by processor
 
-    if (argc > 1) {
+    if (argc > 1 && strstr(argv[1], "counters")) {
+        // not running test. setting or resetting PMC counters        
+        return setcounters(argc, argv);
+    }
+    for (i = 1; i < argc; i++) {
         // Interpret command line parameters
-        if (strstr(argv[1], "diagnostics")) diagnostics = 1;
-        else if (strstr(argv[1], "counters")) {
-            // not running test. setting or resetting PMC counters        
-            return setcounters(argc, argv);
-        }
-        else {
-            printf("\nUnknown command line parameter %s\n", argv[1]);
+        if (strstr(argv[i], "diagnostics")) diagnostics = 1;
+        else if (strncmp(argv[i], "placement=", 10) == 0) Placement = argv[i] + 10;
+        else if (strcmp(argv[i], "sidebyside") == 0) SideBySide = 1;
+        else if (!Statistics.Interpret(argv[i])) {
+            printf("\nUnknown command line parameter %s\n", argv[i]);
             return 1;
         }
     }
@@ -244,7 +410,11 @@ int main(int argc, char* argv[]) {
     }
 
     // Fix a processornumber for each thread
-    for (t = 0, i = NumThreads-1; t < NumThreads; t++, i--) {
+    if (Placement) {
+        // placement specified on command line
+        if (PlaceThreads(Placement, ProcessAffMask, maxProcThreads)) return 1;
+    }
+    else for (t = 0, i = NumThreads-1; t < NumThreads; t++, i--) {
         // make processornumbers different, and last thread = MainThreadProcNum:
         // ProcNum[t] = MainThreadProcNum ^ i;
         if (procthreads < 4) {        
@@ -288,18 +458,40 @@ int main(int argc, char* argv[]) {
     // Set high priority to minimize risk of interrupts during test
     SyS::SetProcessPriorityHigh();
 
-    // Make multiple threads
-    ThreadHandler Threads;
-    Threads.Start(NumThreads);
+    do {
+        // Reset thread synchronizer
+        TSync.allflags = 0;
+
+        // Make multiple threads
+        ThreadHandler Threads;
+        Threads.Start(NumThreads);
+
+        // Stop threads
+        Threads.Stop();
 
-    // Stop threads
-    Threads.Stop();
+        // Clean up
+        MSRCounters.CleanUp();
+
+        // Save results for summary
+        if (Statistics.OutputFormat) Statistics.Collect();
+
+        // Repeat until confidence interval is narrow enough
+    } while (Statistics.OutputFormat && !Statistics.Finished());
 
     // Set priority back normal
     SyS::SetProcessPriorityNormal();
 
-    // Clean up
-    MSRCounters.CleanUp();
+    if (Statistics.OutputFormat) {
+        // Print summary of all runs instead of all repetitions
+        Statistics.Print();
+        return 0;
+    }
+
+    if (SideBySide) {
+        // Print all threads in the same lines
+        PrintSideBySide();
+        return 0;
+    }
 
     // Print results
     for (t = 0; t < NumThreads; t++) {
@@ -459,6 +651,9 @@ CCounters::CCounters() {
     NumFixedPMCs = 0;
     ProcessorNumber = 0;
     for (int i = 0; i < MAXCOUNTERS; i++) CounterNames[i] = 0;
+#ifdef PERF_EVENTS_SUPPORTED
+    UsePerf = 0;
+#endif
 }
 
 void CCounters::QueueCounters() {
@@ -496,6 +691,10 @@ void CCounters::QueueCounters() {
                 queue2[thread].put(MSR_READ, rCoreCounter, thread);
                 //queue2[thread].put(MSR_READ, rMPERF, 0);
             }
+#ifdef PERF_EVENTS_SUPPORTED
+            // APERF is not available with perf_event_open. Count core clock cycles instead
+            perf.DefineClock();
+#endif
         }
     }
 }
@@ -526,8 +725,22 @@ int CCounters::StartDriver() {
     int ErrNo = 0;
 
     if (UsePMC && !diagnostics) {
+#ifdef PERF_EVENTS_SUPPORTED
+        if (access(msr.GetDriverName(), F_OK) != 0) {
+            // Driver is not installed. Use perf_event_open instead if it works.
+            // Open the events once in this thread to check that perf_event_open 
+            // and rdpmc are allowed, and put the register numbers in Counters[]
+            if (perf.Start(0, Counters) == 0) {
+                perf.Stop(0);
+                UsePerf = 1;
+                return 0;
+            }
+            printf("\nperf_event_open cannot be used instead of driver");
+        }
+#endif
         // Load driver
         ErrNo = msr.LoadDriver();
+        fflush(stdout);
     }
 
     return ErrNo;
@@ -536,6 +749,28 @@ int CCounters::StartDriver() {
 void CCounters::CleanUp() {
     // Things to do after measuring
 
+#ifdef PERF_EVENTS_SUPPORTED
+    if (UsePerf) {
+        // All threads must have the same register numbers as found by StartDriver, 
+        // because TestLoop uses Counters[]
+        for (int thread = 0; thread < NumThreads; thread++) {
+            for (int i = 0; i < NumCounters; i++) {
+                if (perf.GetIndex(thread, i) != Counters[i]) {
+                    printf("\nWarning: counter %i has different register numbers in different threads", i+1);
+                    thread = NumThreads;  break;
+                }
+            }
+        }
+        if (MScheme == S_AMD2) {
+            // Calculate clock correction factors for AMD Zen from perf cycles event
+            for (int thread = 0; thread < NumThreads; thread++) {
+                clockFactor[thread] = perf.GetClockFactor(thread);
+            }
+        }
+        return;
+    }
+#endif
+
     if (MScheme == S_AMD2) {
         // Calculate clock correction factors for AMD Zen
         for (int thread = 0; thread < NumThreads; thread++) {
@@ -594,6 +829,18 @@ long long CCounters::read2(unsigned int register_number, int thread) {
 // Start counting
 void CCounters::StartCounters(int ThreadNum) {
     if (UsePMC) {
+#ifdef PERF_EVENTS_SUPPORTED
+        if (UsePerf) {
+            // Open perf events for this thread. Counters[] has been set by StartDriver
+            if (perf.Start(ThreadNum, 0)) {
+                // TestLoop cannot read the counters with rdpmc without perf events
+                printf("\nCannot start perf events in thread %i\n", ThreadNum);
+                fflush(stdout);
+                exit(1);
+            }
+            return;
+        }
+#endif
         msr.AccessRegisters(queue1[ThreadNum]);
     }
 }
@@ -601,6 +848,12 @@ void CCounters::StartCounters(int ThreadNum) {
 // Stop and reset counters
 void CCounters::StopCounters(int ThreadNum) {
     if (UsePMC) {
+#ifdef PERF_EVENTS_SUPPORTED
+        if (UsePerf) {
+            perf.Stop(ThreadNum);
+            return;
+        }
+#endif
         msr.AccessRegisters(queue2[ThreadNum]);
     }
 }
@@ -968,6 +1221,32 @@ const char * CCounters::DefineCounter(SCounterDefinition & CDef) {
         return "No counters defined for present microprocessor family";
     }
 
+#ifdef PERF_EVENTS_SUPPORTED
+    // Make the same event with perf_event_open, used if the driver is not installed
+    switch (MScheme) {
+    case S_ID2: case S_ID3: case S_ID4:
+        if (counternr & 0x40000000) {
+            // Fixed function counter. Use the generic event that the kernel puts in this counter
+            static const unsigned int FixedEvents[3] = {
+                PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_REF_CPU_CYCLES};
+            i = counternr & 0xFF;
+            if (i < 3) perf.Define(NumCounters, PERF_TYPE_HARDWARE, FixedEvents[i]);
+            else perf.Define(NumCounters, PERF_TYPE_UNSUPPORTED, 0);
+            break;
+        }
+        // All other counters continue in next case:
+    case S_P2: case S_ID1: case S_AMD: case S_AMD2:
+        perf.Define(NumCounters, PERF_TYPE_RAW, CDef.Event | (CDef.EventMask << 8));
+        break;
+    case S_VIA:
+        perf.Define(NumCounters, PERF_TYPE_RAW, CDef.Event);
+        break;
+    default:
+        // Pentium 1 and Pentium 4 have different event select formats
+        perf.Define(NumCounters, PERF_TYPE_UNSUPPORTED, 0);
+    }
+#endif
+
     // Save counter register number in Counters list
     Counters[NumCounters++] = counternr;
 
@@ -1004,6 +1283,267 @@ int CCounters::GetP4EventSelectRegAddress(int CounterNr, int EventSelectNo) {
 }
 
 
+//////////////////////////////////////////////////////////////////////////////
+//
+//        CStatistics class member functions
+//
+//////////////////////////////////////////////////////////////////////////////
+
+// compare function for qsort
+static int CompareInt(const void * a, const void * b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static int CompareDouble(const void * a, const void * b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// percentile p (0 - 1) of sorted list, interpolated
+static double Percentile(const int * list, int n, double p) {
+    if (n <= 0) return 0.;
+    double pos = p * (n - 1);
+    int i = (int)pos;
+    if (i >= n - 1) return list[n-1];
+    return list[i] + (pos - i) * (list[i+1] - list[i]);
+}
+
+// median of sorted list of doubles
+static double Median(const double * list, int n) {
+    if (n <= 0) return 0.;
+    return (n & 1) ? list[n/2] : 0.5 * (list[n/2-1] + list[n/2]);
+}
+
+// Constructor
+CStatistics::CStatistics() {
+    OutputFormat = 0;
+    MaxRuns = 0;
+    TargetWidth = 0.;
+    OutlierLimit = 3.5;
+    Runs = NumColumns = Capacity = NumSamples = 0;
+    for (int t = 0; t < MAXTHREADS; t++) Samples[t] = 0;
+    for (int c = 0; c < MAXCOUNTERS+2; c++) ColumnNames[c] = 0;
+}
+
+// Destructor
+CStatistics::~CStatistics() {
+    for (int t = 0; t < MAXTHREADS; t++) {
+        if (Samples[t]) delete[] Samples[t];
+    }
+}
+
+// Interpret command line option. Return 0 if not recognized
+int CStatistics::Interpret(const char * option) {
+    if (strcmp(option, "summary") == 0) OutputFormat = 1;
+    else if (strcmp(option, "csv") == 0) OutputFormat = 2;
+    else if (strcmp(option, "json") == 0) OutputFormat = 3;
+    else if (strncmp(option, "ci=", 3) == 0) TargetWidth = atof(option+3);
+    else if (strncmp(option, "maxruns=", 8) == 0) MaxRuns = atoi(option+8);
+    else if (strncmp(option, "outliers=", 9) == 0) OutlierLimit = atof(option+9);
+    else return 0;
+
+    // Multiple runs are only shown in summary
+    if ((TargetWidth > 0. || MaxRuns > 1) && OutputFormat == 0) OutputFormat = 1;
+    return 1;
+}
+
+// Add results of last run
+void CStatistics::Collect() {
+    int t, c, i, repi;
+    int corrected = UsePMC && MSRCounters.MScheme == S_AMD2;
+
+    if (Runs == 0) {
+        // First run. Allocate space for all runs
+        if (MaxRuns < 1) MaxRuns = TargetWidth > 0. ? 50 : 1;
+        NumColumns = 0;
+        ColumnNames[NumColumns++] = "Clock";
+        if (corrected) ColumnNames[NumColumns++] = "Corrected";
+        if (UsePMC) {
+            for (i = 0; i < NumCounters; i++) ColumnNames[NumColumns++] = MSRCounters.CounterNames[i];
+        }
+        Capacity = MaxRuns * repetitions;
+        for (t = 0; t < NumThreads; t++) Samples[t] = new int[NumColumns * Capacity];
+    }
+    if (NumSamples + repetitions > Capacity) return;
+
+    for (t = 0; t < NumThreads; t++) {
+        // calculate offsets into ThreadData[]
+        int TOffset = t * (ThreadDataSize / sizeof(int));
+        int ClockOS = ClockResultsOS / sizeof(int);
+        int PMCOS   = PMCResultsOS / sizeof(int);
+
+        for (repi = 0; repi < repetitions; repi++) {
+            int * s = Samples[t] + NumSamples + repi;
+            int tscClock = PThreadData[repi+TOffset+ClockOS];
+            c = 0;
+            s[c++ * Capacity] = tscClock;
+            if (corrected) s[c++ * Capacity] = int(tscClock * clockFactor[t] + 0.5); // Calculated core clock count
+            for (i = 0; c < NumColumns; i++) {
+                s[c++ * Capacity] = PThreadData[repi+i*repetitions+TOffset+PMCOS];
+            }
+        }
+    }
+    NumSamples += repetitions;
+    Runs++;
+}
+
+// Mark repetitions disturbed by interrupts etc. in keep[].
+// An interrupt makes the clock count higher, so only high values are rejected.
+// Return number of rejected repetitions
+int CStatistics::Reject(int thread, char * keep) {
+    int i, rejected = 0;
+    for (i = 0; i < NumSamples; i++) keep[i] = 1;
+    if (OutlierLimit <= 0. || NumSamples < 3) return 0;
+
+    // find median and median absolute deviation of clock counts
+    double * list = new double[NumSamples];
+    for (i = 0; i < NumSamples; i++) list[i] = Samples[thread][i];
+    qsort(list, NumSamples, sizeof(double), CompareDouble);
+    double median = Median(list, NumSamples);
+    for (i = 0; i < NumSamples; i++) list[i] = fabs(Samples[thread][i] - median);
+    qsort(list, NumSamples, sizeof(double), CompareDouble);
+    // 1.4826 * MAD = standard deviation for normal distribution
+    double sigma = 1.4826 * Median(list, NumSamples);
+    if (sigma < 1.) sigma = 1.;           // counts are integers
+    delete[] list;
+
+    for (i = 0; i < NumSamples; i++) {
+        if (Samples[thread][i] > median + OutlierLimit * sigma) {
+            keep[i] = 0;  rejected++;
+        }
+    }
+    return rejected;
+}
+
+// Calculate statistics for one column of kept samples
+void CStatistics::Summarize(int thread, int column, const char * keep, SSummary & s) {
+    int i, n = 0;
+    int * list = new int[NumSamples + 1];
+    double * dev = new double[NumSamples + 1];
+    double sum = 0.;
+
+    for (i = 0; i < NumSamples; i++) {
+        if (keep[i]) {
+            list[n++] = Samples[thread][column * Capacity + i];
+            sum += list[n-1];
+        }
+    }
+    qsort(list, n, sizeof(int), CompareInt);
+    memset(&s, 0, sizeof(s));
+    s.Samples = n;
+    if (n > 0) {
+        s.Min = list[0];  s.Max = list[n-1];
+        s.Mean = sum / n;
+        s.Median = Percentile(list, n, 0.5);
+        s.P10 = Percentile(list, n, 0.10);
+        s.P25 = Percentile(list, n, 0.25);
+        s.P75 = Percentile(list, n, 0.75);
+        s.P90 = Percentile(list, n, 0.90);
+        for (i = 0; i < n; i++) dev[i] = fabs(list[i] - s.Median);
+        qsort(dev, n, sizeof(double), CompareDouble);
+        s.MAD = Median(dev, n);
+        // Distribution-free 95% confidence interval of median from order statistics
+        int k = (int)floor((n - 1.96 * sqrt((double)n)) / 2.);
+        if (k < 0) k = 0;
+        s.CILow = list[k];  s.CIHigh = list[n-1-k];
+    }
+    delete[] list;
+    delete[] dev;
+}
+
+// Check if enough runs have been made.
+// Continue until the confidence interval of the median clock count is narrow enough
+int CStatistics::Finished() {
+    if (Runs >= MaxRuns) return 1;
+    if (TargetWidth <= 0.) return 0;
+    int finished = 1;
+    char * keep = new char[NumSamples + 1];
+    for (int t = 0; t < NumThreads && finished; t++) {
+        SSummary s;
+        Reject(t, keep);
+        Summarize(t, 0, keep, s);
+        if (s.Samples < 6 || s.CIHigh - s.CILow > TargetWidth * fabs(s.Median)) finished = 0;
+    }
+    delete[] keep;
+    return finished;
+}
+
+// print string with quotes for CSV or JSON
+static void PrintQuoted(const char * text, int json) {
+    putchar('"');
+    for (const char * p = text ? text : ""; *p; p++) {
+        if (*p == '"') putchar(json ? '\\' : '"');
+        else if (*p == '\\' && json) putchar('\\');
+        putchar(*p);
+    }
+    putchar('"');
+}
+
+// Reject outliers and print summary
+void CStatistics::Print() {
+    int t, c, row, rejected;
+    char * keep = new char[NumSamples + 1];
+    SSummary s, columns[MAXCOUNTERS+2];
+    static const char * RowNames[11] = {"min", "10%", "25%", "median", "75%", "90%", "max", "mean", "MAD", "CI low", "CI high"};
+
+    if (OutputFormat == 2) {
+        printf("processor,counter,samples,rejected,min,p10,p25,median,p75,p90,max,mean,mad,ci_low,ci_high\n");
+    }
+    if (OutputFormat == 3) {
+        printf("{\"runs\":%i,\"repetitions\":%i,\"threads\":[", Runs, NumSamples);
+    }
+    for (t = 0; t < NumThreads; t++) {
+        rejected = Reject(t, keep);
+
+        switch (OutputFormat) {
+        case 1:    // text summary. one column for each counter
+            printf("\nProcessor %i: %i runs, %i repetitions, %i rejected", ProcNum[t], Runs, NumSamples, rejected);
+            printf("\n%-8s", "");
+            for (c = 0; c < NumColumns; c++) {
+                printf("%10s ", ColumnNames[c]);
+                Summarize(t, c, keep, columns[c]);
+            }
+            for (row = 0; row < 11; row++) {
+                printf("\n%-8s", RowNames[row]);
+                for (c = 0; c < NumColumns; c++) {
+                    SSummary & x = columns[c];
+                    double v[11] = {(double)x.Min, x.P10, x.P25, x.Median, x.P75, x.P90, (double)x.Max, x.Mean, x.MAD, x.CILow, x.CIHigh};
+                    printf("%10.1f ", v[row]);
+                }
+            }
+            break;
+
+        case 2:    // CSV. one line for each counter
+            for (c = 0; c < NumColumns; c++) {
+                Summarize(t, c, keep, s);
+                printf("%i,", ProcNum[t]);
+                PrintQuoted(ColumnNames[c], 0);
+                printf(",%i,%i,%i,%.6g,%.6g,%.6g,%.6g,%.6g,%i,%.6g,%.6g,%.6g,%.6g\n", 
+                    s.Samples, rejected, s.Min, s.P10, s.P25, s.Median, s.P75, s.P90, s.Max, s.Mean, s.MAD, s.CILow, s.CIHigh);
+            }
+            break;
+
+        case 3:    // JSON. one object for each thread with one object for each counter
+            printf("%s\n{\"processor\":%i,\"rejected\":%i,\"counters\":[", t ? "," : "", ProcNum[t], rejected);
+            for (c = 0; c < NumColumns; c++) {
+                Summarize(t, c, keep, s);
+                printf("%s\n{\"name\":", c ? "," : "");
+                PrintQuoted(ColumnNames[c], 1);
+                printf(",\"samples\":%i,\"min\":%i,\"p10\":%.6g,\"p25\":%.6g,\"median\":%.6g,\"p75\":%.6g,\"p90\":%.6g,"
+                    "\"max\":%i,\"mean\":%.6g,\"mad\":%.6g,\"ci_low\":%.6g,\"ci_high\":%.6g}",
+                    s.Samples, s.Min, s.P10, s.P25, s.Median, s.P75, s.P90, s.Max, s.Mean, s.MAD, s.CILow, s.CIHigh);
+            }
+            printf("]}");
+            break;
+        }
+    }
+    if (OutputFormat == 1) printf("\n");
+    if (OutputFormat == 3) printf("]}\n");
+    delete[] keep;
+}
+
+
 //////////////////////////////////////////////////////////////////////////////
 //
 //             list of counter definitions
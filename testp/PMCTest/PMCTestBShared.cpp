@@ -0,0 +1,353 @@
+//                       PMCTestBShared.cpp              2026-10-16 agent
+//
+//          Multithread PMC Test program for Windows and Linux
+//          Test of data shared between threads
+//
+// This is an alternative to PMCTestB.cpp for measuring the cost of sharing
+// data between threads running on different cores, such as cache line
+// transfers, false sharing, atomic operations, locks and queues.
+// All threads run the test code at the same time on shared data. The pattern
+// of sharing is selected with SHARING_PATTERN.
+// All sections that can be modified by the user are marked with ###########.
+//
+// Use the command line option placement=smt, core or socket to choose whether
+// the threads run on the same core, different cores or different sockets, and
+// the option sidebyside to see the results of all threads together.
+//
+// Compile: g++ -O2 PMCTestA.cpp PMCTestBShared.cpp -lpthread
+//
+// See PMCTest.txt for instructions.
+//
+//  2000-2026 GNU General Public License www.gnu.org/licences
+//////////////////////////////////////////////////////////////////////////////
+
+#include "PMCTest.h"
+#include <atomic>
+
+
+/*############################################################################
+#
+#        Define constants
+#
+############################################################################*/
+
+// number of repetitions of test. You may change this up to MAXREPEAT
+#define REPETITIONS  8
+
+// Number of threads
+#define NUM_THREADS  2
+
+// Use performance monitor counters. Set to 0 if not used
+#define USE_PERFORMANCE_COUNTERS  1
+
+// Subtract overhead from counts (0 if not)
+#define SUBTRACT_OVERHEAD 1
+
+// Number of repetitions in loop to find overhead
+#define OVERHEAD_REPETITIONS  5
+
+// Cache line size (for preventing threads using same cache lines)
+#define CACHELINESIZE  64
+
+// Sharing pattern:
+// 0: Each thread increments its own counter in its own cache line (no sharing)
+// 1: False sharing. Each thread increments its own counter, all in the same cache line
+// 2: Ping-pong. A token is passed from thread to thread through a shared variable
+// 3: Lock handoff. All threads increment a shared counter protected by a spin lock
+// 4: Producer/consumer. Thread 2k writes to a ring buffer, thread 2k+1 reads it
+#define SHARING_PATTERN  2
+
+// Number of operations in each repetition
+#define OPERATIONS  100
+
+// Number of entries in each ring buffer for producer/consumer (power of 2)
+#define RINGSIZE  64
+
+
+/*############################################################################
+#
+#        list of desired counter types
+#
+############################################################################*/
+//
+// Here you can select which performance monitor counters you want for your test.
+// Select id numbers from the table CounterDefinitions[] in PMCTestA.cpp.
+// The maximum number of counters you can have is MAXCOUNTERS.
+// Insert zeroes if you have less than MAXCOUNTERS counters.
+
+extern "C" {
+    int CounterTypesDesired[MAXCOUNTERS] = {
+        1,      // core clock cycles (Intel Core 2 and later)
+        9,      // instructions (not P4)
+      100,    // micro-operations
+      311     // data cache mises
+    };
+}
+
+
+/*############################################################################
+#
+#        Thread data
+#
+############################################################################*/
+// Align SThreadData structure by cache line size to avoid multiple threads
+// writing to the same cache line
+ALIGNEDSTRUCTURE(SThreadData, CACHELINESIZE) {
+    // Data for each thread
+    int CountTemp[MAXCOUNTERS+1];      // temporary storage of clock counts and PMC counts
+    int CountOverhead[MAXCOUNTERS+1];  // temporary storage of count overhead
+    int ClockResults[REPETITIONS];     // clock count results
+    int PMCResults[REPETITIONS*MAXCOUNTERS]; // PMC count results
+};
+
+extern "C" {
+    SThreadData ThreadData[NUM_THREADS];// Results for all threads
+    int NumThreads = NUM_THREADS;       // Number of threads
+    int NumCounters = 0;                // Number of valid PMC counters in Counters[]
+    int MaxNumCounters = MAXCOUNTERS;   // Maximum number of PMC counters
+    int UsePMC = USE_PERFORMANCE_COUNTERS;// 0 if no PMC counters used
+    int *PThreadData = (int*)ThreadData;// Pointer to measured data for all threads
+    int ThreadDataSize = sizeof(SThreadData);// Size of per-thread counter data block (bytes)
+    // offset of clock results of first thread into ThreadData (bytes)
+    int ClockResultsOS = int(ThreadData[0].ClockResults-ThreadData[0].CountTemp)*sizeof(int);
+    // offset of PMC results of first thread into ThreadData (bytes)
+    int PMCResultsOS = int(ThreadData[0].PMCResults-ThreadData[0].CountTemp)*sizeof(int);
+    // counter register numbers used
+    int Counters[MAXCOUNTERS] = {0};
+    int EventRegistersUsed[MAXCOUNTERS] = {0};
+    // optional extra output
+    int RatioOut[4] = {0};              // See PMCTest.h for explanation
+    int TempOut = 0;                    // See PMCTest.h for explanation
+    const char * RatioOutTitle = "?";   // Column heading for optional extra output of ratio
+    const char * TempOutTitle = "?";    // Column heading for optional arbitrary output
+}
+
+
+/*############################################################################
+#
+#        Shared data
+#
+############################################################################*/
+
+// Each variable has its own cache line unless sharing a cache line is intended
+
+// One cache line of counters
+ALIGNEDSTRUCTURE(SCounterLine, CACHELINESIZE) {
+    volatile int Count[CACHELINESIZE/sizeof(int)];
+};
+
+// One cache line with an atomic variable
+ALIGNEDSTRUCTURE(SAtomicLine, CACHELINESIZE) {
+    std::atomic<int> Value;
+};
+
+// Spin lock and the counter it protects, in the same cache line
+ALIGNEDSTRUCTURE(SLockLine, CACHELINESIZE) {
+    std::atomic<int> Lock;
+    volatile int Count;
+};
+
+// Ring buffer for one producer and one consumer
+ALIGNEDSTRUCTURE(SRing, CACHELINESIZE) {
+    int Data[RINGSIZE];                 // entries
+    SAtomicLine Head;                   // number of entries written. Written by producer
+    SAtomicLine Tail;                   // number of entries read. Written by consumer
+};
+
+SCounterLine PrivateLines[NUM_THREADS]; // pattern 0: one cache line for each thread
+SCounterLine SharedLine;                // pattern 1: one cache line for all threads
+SAtomicLine  Token;                     // pattern 2: number of thread that has the token
+SLockLine    SpinLock;                  // pattern 3: lock and counter
+SRing        Rings[(NUM_THREADS+1)/2];  // pattern 4: one ring for each pair of threads
+
+// Sum of data read by consumers. Prevents the compiler from optimizing away the reads
+int UserData[NUM_THREADS][CACHELINESIZE/sizeof(int)];
+
+
+//////////////////////////////////////////////////////////////////////////////
+//    Test Loop
+//////////////////////////////////////////////////////////////////////////////
+
+int TestLoop (int thread) {
+    // this function runs the code to test REPETITIONS times
+    // and reads the counters before and after each run:
+    int i;                        // counter index
+    int repi;                     // repetition index
+    int k;                        // operation index
+
+    for (i = 0; i < MAXCOUNTERS+1; i++) {
+        ThreadData[thread].CountOverhead[i] = 0x7FFFFFFF;
+    }
+
+    /*############################################################################
+    #
+    #        Initializations
+    #
+    ############################################################################*/
+
+#if SHARING_PATTERN == 4
+    // Producer/consumer pairs. The last thread has no partner if the number of threads is odd
+    SRing & ring = Rings[thread / 2];
+    int producer = (thread & 1) == 0;
+    int haspartner = (thread | 1) < NumThreads;
+    // head for producer, tail for consumer. The ring keeps its state from the previous
+    // run when the threads are run again. Head and Tail are equal when a run has finished
+    int position = producer ? ring.Head.Value.load() : ring.Tail.Value.load();
+#endif
+
+    /*############################################################################
+    #
+    #        Initializations end
+    #
+    ############################################################################*/
+
+    // first test loop.
+    // Measure overhead = the test count produced by the test program itself
+    for (repi = 0; repi < OVERHEAD_REPETITIONS; repi++) {
+
+        Serialize();
+
+#if USE_PERFORMANCE_COUNTERS
+        // Read counters
+        for (i = 0; i < MAXCOUNTERS; i++) {
+            ThreadData[thread].CountTemp[i+1] = (int)Readpmc(Counters[i]);
+        }
+#endif
+
+        Serialize();
+        ThreadData[thread].CountTemp[0] = (int)Readtsc();
+        Serialize();
+
+        // no test code here
+
+        Serialize();
+        ThreadData[thread].CountTemp[0] -= (int)Readtsc();
+        Serialize();
+
+#if USE_PERFORMANCE_COUNTERS
+        // Read counters
+        for (i = 0; i < MAXCOUNTERS; i++) {
+            ThreadData[thread].CountTemp[i+1] -= (int)Readpmc(Counters[i]);
+        }
+#endif
+        Serialize();
+
+        // find minimum counts
+        for (i = 0; i < MAXCOUNTERS+1; i++) {
+            if (-ThreadData[thread].CountTemp[i] < ThreadData[thread].CountOverhead[i]) {
+                ThreadData[thread].CountOverhead[i] = -ThreadData[thread].CountTemp[i];
+            }
+        }
+    }
+
+
+    // Second test loop. Includes code to test.
+    // This must be identical to first test loop, except for the test code
+    for (repi = 0; repi < REPETITIONS; repi++) {
+
+        Serialize();
+
+#if USE_PERFORMANCE_COUNTERS
+        // Read counters
+        for (i = 0; i < MAXCOUNTERS; i++) {
+            ThreadData[thread].CountTemp[i+1] = (int)Readpmc(Counters[i]);
+        }
+#endif
+
+        Serialize();
+        ThreadData[thread].CountTemp[0] = (int)Readtsc();
+        Serialize();
+
+
+        /*############################################################################
+        #
+        #        Test code start
+        #
+        ############################################################################*/
+
+        // All threads do the same number of operations in each repetition,
+        // so that no thread waits forever for another thread
+
+#if SHARING_PATTERN == 0
+        // own cache line
+        for (k = 0; k < OPERATIONS; k++) {
+            PrivateLines[thread].Count[0]++;
+        }
+
+#elif SHARING_PATTERN == 1
+        // false sharing: own counter in shared cache line
+        for (k = 0; k < OPERATIONS; k++) {
+            SharedLine.Count[thread]++;
+        }
+
+#elif SHARING_PATTERN == 2
+        // ping-pong: wait for the token and pass it to the next thread
+        for (k = 0; k < OPERATIONS; k++) {
+            while (Token.Value.load(std::memory_order_acquire) != thread) {}
+            Token.Value.store((thread + 1) % NumThreads, std::memory_order_release);
+        }
+
+#elif SHARING_PATTERN == 3
+        // lock handoff: spin lock with test and test-and-set
+        for (k = 0; k < OPERATIONS; k++) {
+            while (SpinLock.Lock.exchange(1, std::memory_order_acquire)) {
+                while (SpinLock.Lock.load(std::memory_order_relaxed)) {}
+            }
+            SpinLock.Count++;
+            SpinLock.Lock.store(0, std::memory_order_release);
+        }
+
+#elif SHARING_PATTERN == 4
+        // producer/consumer ring buffer
+        if (haspartner && producer) {
+            for (k = 0; k < OPERATIONS; k++) {
+                // wait while ring is full
+                while (position - ring.Tail.Value.load(std::memory_order_acquire) >= RINGSIZE) {}
+                ring.Data[position & (RINGSIZE-1)] = k;
+                position++;
+                ring.Head.Value.store(position, std::memory_order_release);
+            }
+        }
+        else if (haspartner) {
+            for (k = 0; k < OPERATIONS; k++) {
+                // wait while ring is empty
+                while (ring.Head.Value.load(std::memory_order_acquire) == position) {}
+                UserData[thread][0] += ring.Data[position & (RINGSIZE-1)];
+                position++;
+                ring.Tail.Value.store(position, std::memory_order_release);
+            }
+        }
+
+#else
+#error Unknown SHARING_PATTERN
+#endif
+
+
+        /*############################################################################
+        #
+        #        Test code end
+        #
+        ############################################################################*/
+
+        Serialize();
+        ThreadData[thread].CountTemp[0] -= (int)Readtsc();
+        Serialize();
+
+#if USE_PERFORMANCE_COUNTERS
+        // Read counters
+        for (i = 0; i < MAXCOUNTERS; i++) {
+            ThreadData[thread].CountTemp[i+1] -= (int)Readpmc(Counters[i]);
+        }
+#endif
+        Serialize();
+
+        // subtract overhead
+        ThreadData[thread].ClockResults[repi] = -ThreadData[thread].CountTemp[0] - ThreadData[thread].CountOverhead[0];
+        for (i = 0; i < MAXCOUNTERS; i++) {
+            ThreadData[thread].PMCResults[repi+i*REPETITIONS] = -ThreadData[thread].CountTemp[i+1] - ThreadData[thread].CountOverhead[i+1];
+        }
+    }
+
+    // return
+    return REPETITIONS;
+}
@@ -1,4 +1,4 @@
-//                       PMCTestWin.h                    2014-09-30 Agner Fog
+//                       PMCTestWin.h                    2026-10-16 Agner Fog
 //
 //          Multithread PMC Test program
 //          System-specific definitions for Windows
@@ -172,6 +172,29 @@ namespace SyS {  // system-specific process and thread functions
         return ((ProcMaskType)1 << p) & *m;
     }
 
+    // Get package (socket) and core number of processor p. Return 0 if not known
+    static inline int GetTopology(int p, int * package, int * core) {
+        SYSTEM_LOGICAL_PROCESSOR_INFORMATION info[256];
+        DWORD len = sizeof(info);
+        int n = 0, c = 0, k = 0;
+        if (!GetLogicalProcessorInformation(info, &len)) return 0;
+        for (DWORD i = 0; i < len / sizeof(info[0]); i++) {
+            if (info[i].Relationship == RelationProcessorCore) {
+                if (info[i].ProcessorMask & ((ULONG_PTR)1 << p)) {
+                    *core = c;  n++;
+                }
+                c++;
+            }
+            else if (info[i].Relationship == RelationProcessorPackage) {
+                if (info[i].ProcessorMask & ((ULONG_PTR)1 << p)) {
+                    *package = k;  n++;
+                }
+                k++;
+            }
+        }
+        return n == 2;
+    }
+
     // MainThreadProcNum = GetCurrentProcessorNumber(); // only available in Vista and above
 
     // Sleep for the rest of current timeslice
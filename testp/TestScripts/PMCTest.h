@@ -133,6 +133,10 @@ public:
     void StopCounters (int ThreadNum);       // stop and reset counters
     void CleanUp();                          // Any required cleanup of driver etc
     CMSRDriver msr;                          // interface to MSR access driver
+#ifdef PERF_EVENTS_SUPPORTED
+    CPerfEvents perf;                        // interface to perf_event_open, used if driver is not installed
+    int UsePerf;                             // 1 if perf_event_open is used instead of driver
+#endif
     char * CounterNames[MAXCOUNTERS];        // name of each counter
     void Put1 (int num_threads,              // put record into multiple start queues
         EMSR_COMMAND msr_command, unsigned int register_number,
@@ -163,6 +167,43 @@ protected:
 };
 
 
+// summary of one column of results
+struct SSummary {
+    int    Samples;                          // number of samples after rejection of outliers
+    int    Min, Max;                         // minimum and maximum
+    double Median;                           // median
+    double MAD;                              // median absolute deviation from median
+    double Mean;                             // arithmetic mean
+    double P10, P25, P75, P90;               // percentiles
+    double CILow, CIHigh;                    // 95% confidence interval of median
+};
+
+// class CStatistics collects the results of multiple runs of TestLoop and
+// makes a summary with robust statistics for each counter
+class CStatistics {
+public:
+    CStatistics();                           // constructor
+    ~CStatistics();                          // destructor
+    int  Interpret(const char * option);     // interpret command line option. Return 0 if not recognized
+    void Collect();                          // add results of last run
+    int  Finished();                         // check if enough runs have been made
+    void Print();                            // reject outliers and print summary
+    int  OutputFormat;                       // 0 = table of all repetitions, 1 = summary, 2 = CSV, 3 = JSON
+    int  MaxRuns;                            // maximum number of runs
+    double TargetWidth;                      // target width of confidence interval of median clock count, relative to median
+    double OutlierLimit;                     // reject repetitions with clock count > median + OutlierLimit * sigma. 0 = no rejection
+protected:
+    int  Reject(int thread, char * keep);    // mark outliers in keep[]. Return number of rejected repetitions
+    void Summarize(int thread, int column, const char * keep, SSummary & s); // calculate statistics for one column
+    int  Runs;                               // number of runs collected
+    int  NumColumns;                         // number of columns: clock, corrected clock, counters
+    int  Capacity;                           // maximum number of samples per column
+    int  NumSamples;                         // number of samples per column per thread
+    int * Samples[MAXTHREADS];               // Samples[thread][column*Capacity+sample]
+    const char * ColumnNames[MAXCOUNTERS+2]; // name of each column
+};
+
+
 extern "C" {
 
     // Link to PMCTestB.cpp, PMCTestB32.asm or PMCTestB64.asm:
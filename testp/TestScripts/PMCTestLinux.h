@@ -1,4 +1,4 @@
-//                     PMCTestLinux.h                     2012-03-02 Agner Fog
+//                     PMCTestLinux.h                     2026-10-16 Agner Fog
 //
 //          Multithread PMC Test program
 //          System-specific definitions for Linux
@@ -20,6 +20,9 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <linux/perf_event.h>
 
 #include "MSRdrvL.h" // shared with driver
 
@@ -131,6 +134,25 @@ namespace SyS {  // system-specific interface functions
         return CPU_ISSET(p, m);
     }
 
+    // Get package (socket) and core number of processor p. Return 0 if not known
+    static inline int GetTopology(int p, int * package, int * core) {
+        char name[100];
+        int n = 0;
+        sprintf(name, "/sys/devices/system/cpu/cpu%i/topology/physical_package_id", p);
+        FILE * f = fopen(name, "r");
+        if (f) {
+            n += fscanf(f, "%i", package) == 1;
+            fclose(f);
+        }
+        sprintf(name, "/sys/devices/system/cpu/cpu%i/topology/core_id", p);
+        f = fopen(name, "r");
+        if (f) {
+            n += fscanf(f, "%i", core) == 1;
+            fclose(f);
+        }
+        return n == 2;
+    }
+
     // Sleep for the rest of current timeslice
     static inline void Sleep0() {
         sched_yield();
@@ -313,3 +335,206 @@ protected:
     const char* DriverFileName;
     int DriverHandle;
 };
+
+
+//////////////////////////////////////////////////////////////////////
+//
+//                         class CPerfEvents
+//
+// This class sets up the performance monitor counters through the
+// perf_event_open system call. It is used instead of CMSRDriver when
+// the driver /dev/MSRdrv is not installed.
+// Each thread opens its own group of events. The kernel tells in the
+// mmap page of each event which counter register it has assigned, so
+// that the test loop can read the counters with rdpmc in the same way
+// as with the driver.
+//
+//////////////////////////////////////////////////////////////////////
+
+#define PERF_EVENTS_SUPPORTED                 // CPerfEvents can be used
+#define PERF_TYPE_UNSUPPORTED  0xFFFFFFFF     // event cannot be made with perf_event_open
+
+class CPerfEvents {
+public:
+    CPerfEvents() {            // constructor
+        NumEvents = 0;
+        UseClock = 0;
+        for (int t = 0; t < MAXTHREADS; t++) {
+            for (int i = 0; i < MAXCOUNTERS; i++) {
+                Fd[t][i] = -1;
+                Page[t][i] = 0;
+                Index[t][i] = 0;
+            }
+            ClockFd[t] = -1;
+            TscCount[t] = ClockCount[t] = 0;
+        }
+    }
+
+    ~CPerfEvents() {           // destructor
+        for (int t = 0; t < MAXTHREADS; t++) Close(t);
+    }
+
+    // define event for counter number i
+    void Define(int i, unsigned int type, uint64 config) {
+        if (i < 0 || i >= MAXCOUNTERS) return;
+        Type[i] = type;
+        Config[i] = config;
+        if (i >= NumEvents) NumEvents = i + 1;
+    }
+
+    // count core clock cycles outside the group, for calculating clock factor
+    void DefineClock() {
+        UseClock = 1;
+    }
+
+    // open events for the calling thread, start counting and get the 
+    // register numbers for rdpmc. CounterIndex may be 0 if the register
+    // numbers are already known. Return value is nonzero on error
+    int Start(int thread, int * CounterIndex) {
+        int i, leader = -1;
+        if (thread < 0 || thread >= MAXTHREADS) return -1;
+        if (NumEvents == 0) {
+            // rdpmc is only allowed while the process has perf events mapped
+            printf("\nNo counters defined for perf_event_open");
+            return 1;
+        }
+
+        for (i = 0; i < NumEvents; i++) {
+            if (Type[i] == PERF_TYPE_UNSUPPORTED) {
+                printf("\nCounter %i is not supported by perf_event_open", i+1);
+                Close(thread);  return 1;
+            }
+            // the first event is group leader. The others follow the leader
+            Fd[thread][i] = OpenEvent(Type[i], Config[i], leader);
+            if (Fd[thread][i] < 0) {
+                printf("\nperf_event_open failed for counter %i: %s", i+1, strerror(errno));
+                if (errno == EACCES || errno == EPERM) {
+                    printf("\nCheck /proc/sys/kernel/perf_event_paranoid");
+                }
+                Close(thread);  return 1;
+            }
+            if (i == 0) leader = Fd[thread][0];
+            // map the page that tells the counter register number
+            void * p = mmap(0, sysconf(_SC_PAGESIZE), PROT_READ, MAP_SHARED, Fd[thread][i], 0);
+            if (p == MAP_FAILED) {
+                printf("\nCannot map perf event page for counter %i", i+1);
+                Close(thread);  return 1;
+            }
+            Page[thread][i] = (perf_event_mmap_page*)p;
+        }
+
+        // start all counters in the group
+        if (leader >= 0 && ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP)) {
+            printf("\nCannot enable perf events");
+            Close(thread);  return 1;
+        }
+
+        // get register numbers. The index in the mmap page is 1 + the rdpmc number
+        for (i = 0; i < NumEvents; i++) {
+            volatile perf_event_mmap_page * pc = Page[thread][i];
+            unsigned int seq, idx, cap;
+            do {
+                seq = pc->lock;
+                __sync_synchronize();
+                idx = pc->index;
+                cap = pc->cap_user_rdpmc;
+                __sync_synchronize();
+            } while (pc->lock != seq);
+            if (!cap) {
+                printf("\nrdpmc is not allowed with perf events. Check /sys/bus/event_source/devices/cpu/rdpmc");
+                Close(thread);  return 1;
+            }
+            if (idx == 0) {
+                printf("\nCounter %i could not be scheduled. It may be used by another program", i+1);
+                Close(thread);  return 1;
+            }
+            Index[thread][i] = idx - 1;
+            if (CounterIndex) CounterIndex[i] = idx - 1;
+        }
+
+        if (UseClock) {
+            // core clock count for calculating clock factor
+            ClockFd[thread] = OpenEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1);
+            if (ClockFd[thread] >= 0) ioctl(ClockFd[thread], PERF_EVENT_IOC_ENABLE, 0);
+            TscCount[thread] = -(int64)Readtsc64();
+            ClockCount[thread] = -ReadCount(ClockFd[thread]);
+        }
+        return 0;
+    }
+
+    // stop counting and close events for the calling thread
+    void Stop(int thread) {
+        if (thread < 0 || thread >= MAXTHREADS) return;
+        if (ClockFd[thread] >= 0) {
+            TscCount[thread] += Readtsc64();
+            ClockCount[thread] += ReadCount(ClockFd[thread]);
+        }
+        if (Fd[thread][0] >= 0) {
+            ioctl(Fd[thread][0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        }
+        Close(thread);
+    }
+
+    // rdpmc register number of counter i in thread
+    int GetIndex(int thread, int i) {
+        return Index[thread][i];
+    }
+
+    // ratio between core clock count and time stamp counter after Stop
+    double GetClockFactor(int thread) {
+        if (TscCount[thread] <= 0 || ClockCount[thread] <= 0) return 1.;
+        return double(ClockCount[thread]) / double(TscCount[thread]);
+    }
+
+protected:
+    // open one event counting user mode of the calling thread on any processor
+    static int OpenEvent(unsigned int type, uint64 config, int group) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = group < 0;             // group leader is enabled by Start
+        attr.pinned = group < 0;               // keep group on the PMU. No multiplexing
+        attr.exclude_kernel = 1;               // user mode only, same as with driver
+        attr.exclude_hv = 1;
+        return (int)syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+    }
+
+    // read 64 bit count from event
+    static int64 ReadCount(int fd) {
+        uint64 value = 0;
+        if (fd < 0 || read(fd, &value, sizeof(value)) != sizeof(value)) return 0;
+        return (int64)value;
+    }
+
+    // read all 64 bits of time stamp counter
+    static inline uint64 Readtsc64() {
+        unsigned int lo, hi;
+        __asm__ __volatile__ ( "rdtsc" : "=a"(lo), "=d"(hi));
+        return ((uint64)hi << 32) | lo;
+    }
+
+    // unmap and close all events of thread
+    void Close(int thread) {
+        for (int i = 0; i < MAXCOUNTERS; i++) {
+            if (Page[thread][i]) munmap(Page[thread][i], sysconf(_SC_PAGESIZE));
+            Page[thread][i] = 0;
+            if (Fd[thread][i] >= 0) close(Fd[thread][i]);
+            Fd[thread][i] = -1;
+        }
+        if (ClockFd[thread] >= 0) close(ClockFd[thread]);
+        ClockFd[thread] = -1;
+    }
+
+    int NumEvents;                             // number of events defined
+    int UseClock;                              // count core clock cycles for clock factor
+    unsigned int Type[MAXCOUNTERS];            // perf event type for each counter
+    uint64 Config[MAXCOUNTERS];                // perf event config for each counter
+    int Fd[MAXTHREADS][MAXCOUNTERS];           // file descriptor for each event
+    perf_event_mmap_page * Page[MAXTHREADS][MAXCOUNTERS]; // mmap page for each event
+    int Index[MAXTHREADS][MAXCOUNTERS];        // rdpmc register number for each event
+    int ClockFd[MAXTHREADS];                   // core clock event
+    int64 TscCount[MAXTHREADS];                // time stamp count during measurement
+    int64 ClockCount[MAXTHREADS];              // core clock count during measurement
+};
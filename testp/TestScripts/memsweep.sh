@@ -0,0 +1,213 @@
+#!/bin/bash
+# memsweep.sh                                            2026-10-16 agent
+# (c) Copyright 2026 by agent. GNU General Public License www.gnu.org/licenses
+
+# Sweep the working set size from level 1 cache to RAM and measure access time
+# and bandwidth for different access patterns, strides and numbers of threads.
+# The cache levels are detected from the steps in the access time.
+# This replaces the fixed block sizes of cache_latency.sh2 and
+# read_write_bandwidth.sh2 when you need the whole curve.
+#
+# Usage: ./memsweep.sh [options]
+#   -modes "LIN RND R W NTW"  access patterns. Default: all
+#              LIN  walk through linked list in linear order. Prefetching possible
+#              RND  walk through linked list in random order. Measures latency
+#              R    read one register of regsize bits at each access
+#              W    write one register of regsize bits at each access
+#              NTW  non-temporal write of regsize bits (streaming stores)
+#   -strides "64 128"  distances between accesses, bytes. Must be a multiple of
+#              regsize/8 for R, W and NTW. Default: cache line size for LIN and
+#              RND, regsize/8 for R, W and NTW
+#   -threads "1 2"     numbers of threads. Each thread has its own memory block.
+#              Default: 1
+#   -min n     smallest working set per thread, bytes. Default: 1024
+#   -max n     largest working set per thread, bytes. Default: 8 times the
+#              largest cache, at least 8 MB
+#   -steps n   number of sizes for each doubling of the size. Default: 4
+#   -regsize n register size for R, W and NTW: 128, 256 or 512.
+#              Default: 256 if AVX supported, otherwise 128
+#
+# Output:
+#   results2/memsweep.txt  one table for each mode, stride and number of threads,
+#                          followed by the detected cache levels
+#   results2/memsweep.csv  all measurements, one line for each working set size
+#
+# Clock counts are core clock cycles if available, otherwise time stamp counts.
+# clock/access is the time for each access in one thread. bytes/clock is the
+# sum for all threads of the bytes read or written per clock cycle.
+# A level is a range of sizes where the access time is almost constant. The
+# last size in a level is an estimate of the usable size of that cache level.
+#
+# Run ./init.sh first.
+
+# get CPU specific counters
+. vars.sh
+
+modes="LIN RND R W NTW"
+strides=
+threadlist=1
+minsize=1024
+maxsize=
+steps=4
+regsize=
+
+while [ $# -gt 0 ] ; do
+  case "$1" in
+    -modes)   modes=$2; shift ;;
+    -strides) strides=$2; shift ;;
+    -threads) threadlist=$2; shift ;;
+    -min)     minsize=$2; shift ;;
+    -max)     maxsize=$2; shift ;;
+    -steps)   steps=$2; shift ;;
+    -regsize) regsize=$2; shift ;;
+    *) echo "Unknown option $1" ; exit 1 ;;
+  esac
+  shift
+done
+
+linesize=`./cpugetinfo cachelinesize`
+if [ $linesize -eq 0 ] ; then
+linesize=64
+fi
+
+if [ -z "$maxsize" ] ; then
+cachesize=`./cpugetinfo cachesize`
+if [ $cachesize -le 1000000 ] ; then
+cachesize=1000000
+fi
+let maxsize=$cachesize*8
+fi
+
+# Check if AVX supported
+if [ -z "$regsize" ] ; then
+if  [ `grep -c -i "avx"  cpuinfo.txt ` -ne 0 ] ; then
+regsize=256
+else
+regsize=128
+fi
+fi
+
+out=results2/memsweep.txt
+csv=results2/memsweep.csv
+tmp=memsweep.tmp
+
+echo -e "\nMemory hierarchy sweep\n"  > $out
+echo -e "Test modes:"  >> $out
+echo -e "LIN:  walk through linked list in linear order. Hardware prefetching possible"  >> $out
+echo -e "RND:  walk through linked list in random order. Measures latency"  >> $out
+echo -e "R:    read, $regsize bits per access"  >> $out
+echo -e "W:    write, $regsize bits per access"  >> $out
+echo -e "NTW:  non-temporal write, $regsize bits per access"  >> $out
+echo -e "\nclock/access: clock cycles per access in each thread"  >> $out
+echo -e "bytes/clock:  bytes read or written per clock cycle, all threads"  >> $out
+echo -e "level:        cache level detected from constant access time. Empty between levels"  >> $out
+
+echo -e "\nCache sizes:"  >> $out
+echo -e "Level 1 data cache: `./cpugetinfo cache1size`"  >> $out
+echo -e "Level 2 data cache: `./cpugetinfo cache2size`"  >> $out
+echo -e "Level 3 data cache: `./cpugetinfo cache3size`"  >> $out
+echo -e "L1 cache line size: $linesize"  >> $out
+
+echo "mode,stride,threads,regsize,size,clock_per_access,bytes_per_clock,level" > $csv
+
+# C++ code for making linked list
+g++ -m64 -O2 -c -o c64.o shufflelist.cpp
+if [ $? -ne 0 ] ; then exit ; fi
+
+for tmode in $modes ; do
+
+# default stride and bytes per access
+if [ $tmode = LIN -o $tmode = RND ] ; then
+accessbytes=8
+defaultstride=$linesize
+else
+let accessbytes=$regsize/8
+defaultstride=$accessbytes
+fi
+
+for stride in ${strides:-$defaultstride} ; do
+for nthreads in $threadlist ; do
+
+echo "Mode $tmode, stride $stride, $nthreads threads"
+rm -f $tmp
+
+# sizes from minsize to maxsize with steps per doubling, rounded to multiple of stride
+sizes=`awk -v min=$minsize -v max=$maxsize -v steps=$steps -v stride=$stride 'BEGIN {
+  last = 0
+  for (k = 0; min * 2^(k/steps) <= max * 1.0001; k++) {
+    s = int(min * 2^(k/steps) / stride + 0.5) * stride
+    if (s > last) { print s; last = s }
+  }}'`
+
+for memsize in $sizes ; do
+
+let accesses=$memsize/$stride
+
+$ass -f elf64 -o b64.o -Dmemsize=$memsize -Dstride=$stride -Dtmode=$tmode -Dnthreads=$nthreads -Dregsize=$regsize -Dcounters=$CachePMCs -Pmemsweep.inc TemplateB64.nasm
+if [ $? -ne 0 ] ; then exit ; fi
+g++ -m64 a64.o b64.o c64.o -ox -lpthread
+if [ $? -ne 0 ] ; then exit ; fi
+
+# median clock count of each thread. Use core clock cycles if available
+clock=`./x csv ci=0.02 maxruns=5 | awk -F, 'NR > 1 {
+  gsub(/"/, "", $2)
+  p = $1
+  if ($2 == "Corrected") { c[p] = $8; pri[p] = 3 }
+  else if ($2 == "Core cyc" && pri[p] < 2) { c[p] = $8; pri[p] = 2 }
+  else if ($2 == "Clock" && pri[p] < 1) { c[p] = $8; pri[p] = 1 }
+  }
+  END { n = 0; s = 0; for (p in c) { s += c[p]; n++ }; if (n && s > 0) printf "%.6g", s / n }'`
+if [ -z "$clock" ] ; then
+  echo "Test failed for size $memsize" | tee -a $out
+  exit
+fi
+
+awk -v m=$memsize -v a=$accesses -v c=$clock -v t=$nthreads -v b=$accessbytes 'BEGIN {
+  printf "%i %.4g %.4g\n", m, c / a, t * a * b / c }' >> $tmp
+
+done
+
+# make table and detect levels
+echo -e "\n\nMode $tmode, stride $stride, $nthreads threads\n"  >> $out
+awk -v mode=$tmode -v stride=$stride -v threads=$nthreads -v regsize=$regsize -v csv=$csv '
+  { n = NR; size[n-1] = $1; v[n-1] = $2; bw[n-1] = $3 }
+  END {
+    # a step belongs to a level if the access time rises less than 15% from the
+    # previous size and less than 30% from the first size in the level
+    lev = 0; inlevel = 0
+    for (i = 0; i < n; i++) {
+      flat = i > 0 && v[i] <= v[i-1] * 1.15 && v[i] <= ref * 1.3
+      if (flat) {
+        if (!inlevel) { lev++; inlevel = 1; L[i-1] = lev; first[lev] = i-1 }
+        L[i] = lev; last[lev] = i
+      }
+      else {
+        inlevel = 0; L[i] = 0; ref = v[i]
+      }
+    }
+    printf "%12s %12s %12s %6s\n", "size", "clock/access", "bytes/clock", "level"
+    for (i = 0; i < n; i++) {
+      printf "%12i %12.4g %12.4g %6s\n", size[i], v[i], bw[i], L[i] ? L[i] : ""
+      printf "%s,%i,%i,%i,%i,%.4g,%.4g,%s\n", mode, stride, threads, regsize, size[i], v[i], bw[i], L[i] ? L[i] : "" >> csv
+    }
+    printf "\nDetected levels:\n"
+    for (k = 1; k <= lev; k++) {
+      # median of each level
+      m = 0
+      for (i = first[k]; i <= last[k]; i++) {
+        for (j = m; j > 0 && sv[j-1] > v[i]; j--) { sv[j] = sv[j-1]; sb[j] = sb[j-1] }
+        sv[j] = v[i]; sb[j] = bw[i]; m++
+      }
+      printf "Level %i: %i - %i bytes, %.4g clock/access, %.4g bytes/clock\n", k, size[first[k]], size[last[k]], sv[int(m/2)], sb[int(m/2)]
+    }
+    for (k = 1; k < lev; k++) {
+      printf "Boundary %i: between %i and %i bytes\n", k, size[last[k]], size[first[k+1]]
+    }
+  }' $tmp >> $out
+
+done
+done
+done
+
+rm -f $tmp
+echo -e "\n"  >> $out
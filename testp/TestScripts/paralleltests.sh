@@ -0,0 +1,323 @@
+#!/bin/bash
+# paralleltests.sh                                       2026-10-16 agent
+# (c) Copyright 2026 by agent. GNU General Public License www.gnu.org/licenses
+
+# Run the same tests as alltests.sh, with all assembling and linking done in
+# parallel. The measurements are still done one at a time.
+#
+# Usage: ./paralleltests.sh [options] [test ...]
+#   -j n       number of tests to build in parallel (default: number of cores - 1)
+#   -restart   start from the beginning. The object file cache is kept
+#   -64        run 64-bit mode only (same as ./init.sh 64)
+#   test       .csv, .sh1 or .sh2 files to run. Default: all, in the same order
+#              as alltests.sh
+#
+# How it works:
+# Each test script is run in its own directory under runstate/work with
+# wrappers for nasm and g++ first in the PATH. The nasm wrapper caches the
+# object files in runstate/objcache, keyed by the command line and the
+# contents of the source, the -P include file and all files they %include.
+# The g++ wrapper links the test program into runstate/bincache and puts a
+# small stub in place of x. When the script runs ./x, the stub only records
+# the job and leaves a placeholder in the output file.
+# The build processes are locked to all cores except core 0. The recorded
+# jobs are run one at a time, in the original order, while the other tests
+# are still building. PMCTestA locks the first test thread to core 0, so the
+# measurements run on a core that the builds don't use. Tests with multiple
+# threads will also use other cores.
+# When all jobs of a test are done, the placeholders are replaced by the
+# measurement results, both in the output files and in the terminal output of
+# the test. The output files are copied to results, results1 and results2.
+# The existing result files are put into the test directory as a one-line
+# mark. If the test appends to a file, the mark is replaced by the old
+# contents, so that files are appended or rewritten in the same way as with
+# alltests.sh.
+#
+# The state is kept in the directory runstate. If the run is interrupted, just
+# run the same command again. Completed tests are skipped, and a test that was
+# partly measured continues with the first job that was not finished.
+
+export PMCRUN_SCRIPT=$(cd "$(dirname "$0")" && pwd)/$(basename "$0")
+
+##############################################################################
+#  Wrapper mode. The wrappers in runstate/bin call this script
+##############################################################################
+
+# hash of a text and the contents of a list of files
+pmc_hash() {
+  local text="$1"; shift
+  { echo "$text"; for f in "$@"; do echo "$f"; cat "$f" 2>/dev/null; done; } | sha1sum | cut -c1-40
+}
+
+# nasm wrapper: assemble or get object file from cache
+pmc_nasm() {
+  local args=("$@") out= listing= source= options=() deps=() key= i a
+  for ((i = 0; i < ${#args[@]}; i++)) ; do
+    a=${args[$i]}
+    case "$a" in
+      -o) out=${args[$((i+1))]}; i=$((i+1)) ;;
+      -o*) out=${a#-o} ;;
+      -l|-l*) listing=1 ;;
+      -P*) deps+=("${a#-P}"); options+=("$a") ;;
+      -*) options+=("$a") ;;
+      *) source=$a; options+=("$a") ;;
+    esac
+  done
+  # a listing is only made by nasm itself
+  if [ -n "$listing" -o -z "$out" -o -z "$source" ] ; then
+    exec $PMCRUN_NASM "$@"
+  fi
+  deps+=("$source")
+  # add files included by the source and include files
+  for ((i = 0; i < ${#deps[@]}; i++)) ; do
+    for a in `sed -n 's/^[ \t]*%include[ \t]*"\([^"]*\)".*/\1/p' "${deps[$i]}" 2>/dev/null` ; do
+      case " ${deps[*]} " in *" $a "*) ;; *) deps+=("$a") ;; esac
+    done
+  done
+  key=`pmc_hash "nasm ${options[*]}" "${deps[@]}"`
+  local cached=$PMCRUN_STATE/objcache/$key.o
+  if [ ! -e $cached ] ; then
+    $PMCRUN_NASM "$@" || return $?
+    cp "$out" $cached.$$ && mv $cached.$$ $cached
+  else
+    cp $cached "$out"
+  fi
+  return 0
+}
+
+# g++ wrapper: link test program into cache and make stub for ./x
+pmc_gxx() {
+  local args=("$@") out= inputs=() options=() key= a i
+  for ((i = 0; i < ${#args[@]}; i++)) ; do
+    a=${args[$i]}
+    case "$a" in
+      -c|--version|-E|-S) exec $PMCRUN_GXX "$@" ;;
+      -o) out=${args[$((i+1))]}; i=$((i+1)) ;;
+      -o*) out=${a#-o} ;;
+      -*) options+=("$a") ;;
+      *) inputs+=("$a"); options+=("$a") ;;
+    esac
+  done
+  case "$out" in
+    x|x.exe|./x|./x.exe) ;;
+    *) exec $PMCRUN_GXX "$@" ;;
+  esac
+  key=`pmc_hash "g++ ${options[*]}" "${inputs[@]}"`
+  local cached=$PMCRUN_STATE/bincache/$key
+  if [ ! -e $cached ] ; then
+    $PMCRUN_GXX "${options[@]}" -o $cached.$$ || return $?
+    mv $cached.$$ $cached
+  fi
+  rm -f "$out"
+  echo -e "#!/bin/bash\nexec \"\$PMCRUN_SCRIPT\" --job $cached \"\$@\"" > "$out"
+  chmod +x "$out"
+  return 0
+}
+
+# ./x stub: record job and write placeholder to output file
+pmc_job() {
+  local bin=$1; shift
+  local n=$((`cat jobcount 2>/dev/null || echo 0` + 1))
+  echo $n > jobcount
+  local discard=0
+  if [ "`readlink /proc/$$/fd/1`" = /dev/null ] ; then discard=1 ; fi
+  echo "$n $discard $bin $(printf '%q ' "$@")" >> jobs.list
+  if [ $discard -eq 0 ] ; then printf '\001PMCJOB %i\n' $n ; fi
+  return 0
+}
+
+case "$1" in
+  --nasm) shift; pmc_nasm "$@"; exit $? ;;
+  --gxx)  shift; pmc_gxx "$@"; exit $? ;;
+  --job)  shift; pmc_job "$@"; exit $? ;;
+esac
+
+
+##############################################################################
+#  Main program
+##############################################################################
+
+cd "$(dirname "$PMCRUN_SCRIPT")"
+export PMCRUN_STATE=$PWD/runstate
+
+ncores=`nproc`
+njobs=$(($ncores - 1))
+initpar=
+restart=0
+tests=()
+while [ $# -gt 0 ] ; do
+  case "$1" in
+    -j) njobs=$2; shift ;;
+    -restart) restart=1 ;;
+    -64) initpar=64 ;;
+    *) tests+=("$1") ;;
+  esac
+  shift
+done
+if [ $njobs -lt 1 ] ; then njobs=1 ; fi
+
+# default: all tests in the same order as alltests.sh
+if [ ${#tests[@]} -eq 0 ] ; then
+  tests=(*.csv *.sh1 warmup_fp.sh2)
+  for f in *.sh2 ; do
+    if [ $f != warmup_fp.sh2 ] ; then tests+=($f) ; fi
+  done
+fi
+
+mkdir -p runstate/objcache runstate/bincache runstate/work runstate/done runstate/bin
+
+# only one run at a time
+exec 9> runstate/lock
+if ! flock -n 9 ; then
+  echo "Another paralleltests.sh is running"
+  exit 1
+fi
+if [ $restart -ne 0 ] ; then
+  rm -rf runstate/work runstate/done
+  mkdir -p runstate/work runstate/done
+fi
+
+# initalization
+./init.sh $initpar
+if [ $? -ne 0 -o ! -e a64.o ] ; then exit 1 ; fi
+
+# same header in statistics file as alltests.sh, unless an interrupted run is continued
+if [ -z "`ls runstate/done`" ] ; then
+  echo -e "Running all tests\n`date`\n`./cpugetinfo brand`.\nFamily `./cpugetinfo family hex`, model `./cpugetinfo model hex`"  >> results2/statistics.txt
+fi
+
+# find nasm and g++ before putting wrappers in PATH
+export PMCRUN_NASM=`which nasm`
+export PMCRUN_GXX=`which g++`
+echo -e "#!/bin/bash\nexec \"\$PMCRUN_SCRIPT\" --nasm \"\$@\"" > runstate/bin/nasm
+echo -e "#!/bin/bash\nexec \"\$PMCRUN_SCRIPT\" --gxx \"\$@\"" > runstate/bin/g++
+chmod +x runstate/bin/nasm runstate/bin/g++
+
+# cores for building. Core 0 is reserved for measurements
+if [ $ncores -gt 1 ] ; then buildcores=1-$(($ncores - 1)) ; else buildcores=0 ; fi
+
+# build one test in its own directory
+buildtest() {
+  local t=$1 w=runstate/work/$1
+  rm -rf $w
+  mkdir -p $w/results $w/results1 $w/results2
+  for f in * ; do
+    case "$f" in
+      runstate|results|results1|results2|x|x.exe|b32.o|b64.o|c64.o|t64.o|*.lst) ;;
+      *) ln -s ../../../"$f" $w/"$f" ;;
+    esac
+  done
+  # mark existing result files. The mark survives if the test appends to the file
+  for f in results*/* ; do
+    if [ -f "$f" ] ; then printf '\001PMCKEEP\n' > $w/"$f" ; fi
+  done
+  (
+    cd $w
+    export PATH=$PMCRUN_STATE/bin:$PATH
+    if [ "${t##*.}" = csv ] ; then
+      export outdir=results
+      taskset -c $buildcores ./runlist.sh $t
+    else
+      taskset -c $buildcores ./$t
+    fi
+  ) > $w/build.log 2>&1
+  touch $w/built
+}
+
+# replace placeholders by the output of the jobs
+pmc_results() {
+  awk -v w=$1 '
+    /^\001PMCJOB [0-9]+$/ {
+      n = $2
+      while ((getline line < (w "/job" n ".out")) > 0) print line
+      getline rc < (w "/job" n ".rc")
+      if (rc != 0) print "*** Execution failed with exit code " rc
+      next
+    }
+    { print }' "${@:2}"
+}
+
+# start builds in the background, njobs at a time
+(
+  for t in "${tests[@]}" ; do
+    if [ -e runstate/done/$t -o -e runstate/work/$t/built ] ; then continue ; fi
+    while [ `jobs -r | wc -l` -ge $njobs ] ; do wait -n ; done
+    buildtest $t &
+  done
+  wait
+) &
+builder=$!
+trap "kill 0" INT TERM
+
+Starttime=`date +%s`
+warm=0
+
+# measure tests in order
+for t in "${tests[@]}" ; do
+  if [ -e runstate/done/$t ] ; then continue ; fi
+  w=runstate/work/$t
+  echo -e "\n$t"
+  while [ ! -e $w/built ] ; do
+    if ! kill -0 $builder 2>/dev/null ; then
+      echo "Build of $t was interrupted"
+      exit 1
+    fi
+    sleep 1
+  done
+
+  # warm up processor to max clock frequency before the first measurement
+  if [ $warm -eq 0 -a -s $w/jobs.list ] ; then
+    $PMCRUN_NASM -f elf64 -o runstate/warmup.o -Dinstruct=nop -DWARMUPCOUNT=10000000 -Dnthreads=1 TemplateB64.nasm &&
+    $PMCRUN_GXX -m64 a64.o runstate/warmup.o -o runstate/warmup -lpthread &&
+    runstate/warmup > /dev/null
+    warm=1
+  fi
+
+  # run jobs that are not already done
+  if [ -e $w/jobs.list ] ; then
+    while read n discard bin args ; do
+      if [ -e $w/job$n.rc ] ; then continue ; fi
+      if [ $discard -ne 0 ] ; then
+        eval $bin $args < /dev/null > /dev/null
+      else
+        eval $bin $args < /dev/null > $w/job$n.out
+      fi
+      echo $? > $w/job$n.rc
+    done < $w/jobs.list
+  fi
+
+  # terminal output of the test
+  pmc_results $w $w/build.log
+
+  # put results into output files in results directories and any other directory made by the test
+  for f in $w/*/* ; do
+    if [ ! -f $f -o -L ${f%/*} ] ; then continue ; fi
+    r=${f#$w/}
+    keep=0
+    if [ "`head -n 1 $f`" = $'\001PMCKEEP' ] ; then
+      # file not written by the test
+      if [ `wc -l < $f` -eq 1 ] ; then continue ; fi
+      keep=1
+    fi
+    mkdir -p `dirname $r`
+    {
+      if [ $keep -ne 0 ] ; then cat $r 2>/dev/null ; fi
+      tail -n +$(($keep + 1)) $f | pmc_results $w
+    } > $r.new && mv $r.new $r
+  done
+  touch runstate/done/$t
+  rm -rf $w
+done
+
+wait $builder
+
+Endtime=`date +%s`
+Elapsedtime=$(($Endtime - $Starttime))
+Minutes=$(($Elapsedtime/60))
+Seconds=$(($Elapsedtime-($Minutes*60)))
+
+echo Executed ${#tests[@]} scripts. Elapsed time $Minutes m, $Seconds s
+echo -e "\nExecuted ${#tests[@]} scripts. Elapsed time $Minutes m, $Seconds s\n\n"  >> results2/statistics.txt
+
+# pack all results into zipfile
+./pack_results.sh
@@ -126,6 +126,42 @@ extern "C" char * shuffle(int listlen, int stride, int seed) {
 }
 
 
+/***********************************************************************
+  Create linked list of pointers in shuffled order. Thread safe
+***********************************************************************/
+// The buffer is allocated with AllocateBufferT. The return value is the
+// allocated buffer, which must be freed with DeAllocateBufferT. The list
+// starts at the first address aligned by align_by in the buffer.
+// The list is linear if seed = 0.
+
+extern "C" char * shuffleT(int listlen, int stride, int seed) {
+    int i;
+    StochasticLib1 ran(seed);
+    size_t bufferlen = (size_t)listlen * stride;
+    char * buff = AllocateBufferT(bufferlen + align_by);
+    char * aligned = (char*)(((size_t)buff+align_by-1) & -(size_t)align_by);
+    int * list = new int[listlen];
+    // make sequential list
+    for (i=0; i<listlen; i++) list[i] = i;
+    // shuffle list unless seed = 0
+    if (seed) {    
+        ran.Shuffle(list, 0, listlen);
+    }
+    // fill buffer to make sure all memory pages are mapped before the test
+    for (size_t j=0; j<bufferlen; j++) aligned[j] = 0;
+    // make circular chain of pointers
+    char * p0, * p1;
+    p1 = aligned + (size_t)list[listlen-1] * stride;
+    for (i=0; i<listlen; i++) {
+        p0 = p1;
+        p1 = aligned + (size_t)list[i] * stride;
+        *(char**)p0 = p1;
+    }
+    delete[] list;
+    return buff;
+}
+
+
 /***********************************************************************
  Random number generator class member functions
 ***********************************************************************/
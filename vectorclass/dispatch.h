@@ -0,0 +1,177 @@
+/****************************  dispatch.h   **********************************
+* Author:        agent
+* Date created:  2026-10-16
+* Last modified: 2026-10-16
+* Version:       1.17
+* Project:       vector classes
+* Description:
+* Header file with macros for CPU dispatching. The same source file is
+* compiled once for each instruction set, and a dispatcher selects the best
+* version for the CPU the first time the function is called (or when the
+* program is loaded, see below). See dispatch_example.cpp for an example.
+*
+* DISPATCH_DECLARE(rettype, name, (parameters))
+*   Declares the function name and the versions name_SSE2, name_SSE41,
+*   name_AVX, name_AVX2, name_AVX512, name_AVX512BW.
+*   Put this in a header file.
+*
+* DISPATCH_NAME(name)
+*   The name of the version for the current instruction set. Use this
+*   when defining the function:
+*   rettype DISPATCH_NAME(name) (parameters) { ... }
+*
+* DISPATCH_FUNCTION(rettype, name, (parameters), (arguments))
+*   Defines the dispatched function name and the function
+*   name_version(int iset), which returns a pointer to the best version
+*   for instruction set level iset. Put this in the source file, in a part
+*   that is compiled only for INSTRSET == 2, or in a separate source file
+*   compiled with -msse2.
+*
+* Two dispatching methods are supported:
+* > GNU indirect functions (ifunc). The dynamic linker selects the version
+*   when the program is loaded, and calls go directly to the selected
+*   version. This is used with Gnu and Clang compilers on Linux.
+*   Define DISPATCH_NO_IFUNC to disable it, e.g. in a shared object linked
+*   with -z now where instrset_detect may not be relocated in time.
+* > Function pointer. The pointer initially points to a dispatcher, which
+*   replaces the pointer by the selected version on the first call.
+*   Subsequent calls go through the pointer without any branching.
+*
+* The functions cannot have vector types as parameters or return type,
+* because the vector types differ between the versions.
+*
+* Define DISPATCH_MAX_INSTRSET as 8 or 9 if the compiler does not support
+* AVX512 or AVX512BW. The default is 10.
+*
+* # Example of compiling myfile.cpp with GCC compiler:
+* g++ -O2 -msse2                                         -c myfile.cpp -od2.o
+* g++ -O2 -msse4.1                                       -c myfile.cpp -od5.o
+* g++ -O2 -mavx                                          -c myfile.cpp -od7.o
+* g++ -O2 -mavx2 -mfma                                   -c myfile.cpp -od8.o
+* g++ -O2 -mavx512f -mfma                                -c myfile.cpp -od9.o
+* g++ -O2 -mavx512bw -mavx512dq -mavx512vl -mfma         -c myfile.cpp -od10.o
+* g++ -O2 -msse2 -otest instrset_detect.cpp d2.o d5.o d7.o d8.o d9.o d10.o
+*
+* Compile with optimization so that the inline member functions of the vector
+* classes are inlined. Otherwise the linker may choose a non-inlined copy
+* compiled for a higher instruction set than the CPU supports.
+*
+* (c) Copyright 2026 agent. GNU General Public License http://www.gnu.org/licenses
+******************************************************************************/
+
+#ifndef DISPATCH_H
+#define DISPATCH_H  117
+
+#include "instrset.h"
+
+#ifndef DISPATCH_MAX_INSTRSET
+#define DISPATCH_MAX_INSTRSET 10
+#endif
+
+// Use ifunc if supported
+#if !defined(DISPATCH_NO_IFUNC) && defined(__linux__) && defined(__ELF__) && (defined(__GNUC__) || defined(__clang__)) && ! defined (__INTEL_COMPILER)
+#define DISPATCH_IFUNC 1
+#else
+#define DISPATCH_IFUNC 0
+#endif
+
+// Name suffix for the instruction set we compile for
+#if   INSTRSET == 2                    // SSE2
+#define DISPATCH_SUFFIX _SSE2
+#elif INSTRSET == 5                    // SSE4.1
+#define DISPATCH_SUFFIX _SSE41
+#elif INSTRSET == 7                    // AVX
+#define DISPATCH_SUFFIX _AVX
+#elif INSTRSET == 8                    // AVX2
+#define DISPATCH_SUFFIX _AVX2
+#elif INSTRSET == 9                    // AVX512F
+#define DISPATCH_SUFFIX _AVX512
+#elif INSTRSET == 10                   // AVX512BW, AVX512DQ, AVX512VL
+#define DISPATCH_SUFFIX _AVX512BW
+#else
+#error Dispatching supports only INSTRSET 2, 5, 7, 8, 9 and 10. Use the compiler options listed in dispatch.h
+#endif
+
+#define DISPATCH_CAT2(a, b) a##b
+#define DISPATCH_CAT(a, b)  DISPATCH_CAT2(a, b)
+
+// Name of the version for the current instruction set
+#define DISPATCH_NAME(name) DISPATCH_CAT(name, DISPATCH_SUFFIX)
+
+// Declare function type, dispatched function and all versions
+#define DISPATCH_DECLARE(rettype, name, params)                               \
+    typedef rettype name##_type params;                                       \
+    name##_type name, name##_SSE2, name##_SSE41, name##_AVX, name##_AVX2,     \
+        name##_AVX512, name##_AVX512BW;                                       \
+    name##_type * name##_version(int iset);
+
+// Select versions above DISPATCH_MAX_INSTRSET only if they are compiled
+#if DISPATCH_MAX_INSTRSET >= 10
+#define DISPATCH_VERSION10(name) if (iset >= 10) return &name##_AVX512BW;
+#else
+#define DISPATCH_VERSION10(name)
+#endif
+#if DISPATCH_MAX_INSTRSET >= 9
+#define DISPATCH_VERSION9(name)  if (iset >= 9) return &name##_AVX512;
+#else
+#define DISPATCH_VERSION9(name)
+#endif
+#if DISPATCH_MAX_INSTRSET >= 8
+#define DISPATCH_VERSION8(name)  if (iset >= 8) return &name##_AVX2;
+#else
+#define DISPATCH_VERSION8(name)
+#endif
+#if DISPATCH_MAX_INSTRSET >= 7
+#define DISPATCH_VERSION7(name)  if (iset >= 7) return &name##_AVX;
+#else
+#define DISPATCH_VERSION7(name)
+#endif
+#if DISPATCH_MAX_INSTRSET >= 5
+#define DISPATCH_VERSION5(name)  if (iset >= 5) return &name##_SSE41;
+#else
+#define DISPATCH_VERSION5(name)
+#endif
+
+// Define name##_version(iset), which returns the best version for instruction set iset.
+// The SSE2 version is returned if iset < 2 because there is no lower version
+#define DISPATCH_VERSIONS(name)                                               \
+    name##_type * name##_version(int iset) {                                  \
+        DISPATCH_VERSION10(name)                                              \
+        DISPATCH_VERSION9(name)                                               \
+        DISPATCH_VERSION8(name)                                               \
+        DISPATCH_VERSION7(name)                                               \
+        DISPATCH_VERSION5(name)                                               \
+        return &name##_SSE2;                                                  \
+    }
+
+#if DISPATCH_IFUNC
+
+// The resolver is called by the dynamic linker when the program is loaded
+#define DISPATCH_FUNCTION(rettype, name, params, args)                        \
+    DISPATCH_VERSIONS(name)                                                   \
+    extern "C" {                                                              \
+        static name##_type * name##_resolver() {                              \
+            return name##_version(instrset_detect());                         \
+        }                                                                     \
+    }                                                                         \
+    rettype name params __attribute__((ifunc(#name "_resolver")));
+
+#else  // DISPATCH_IFUNC
+
+// The pointer initially points to the dispatcher. After the first call it
+// points to the selected version
+#define DISPATCH_FUNCTION(rettype, name, params, args)                        \
+    DISPATCH_VERSIONS(name)                                                   \
+    static name##_type name##_dispatch;                                       \
+    static name##_type * name##_pointer = &name##_dispatch;                   \
+    static rettype name##_dispatch params {                                   \
+        name##_pointer = name##_version(instrset_detect());                   \
+        return (*name##_pointer) args;                                        \
+    }                                                                         \
+    rettype name params {                                                     \
+        return (*name##_pointer) args;                                        \
+    }
+
+#endif  // DISPATCH_IFUNC
+
+#endif  // DISPATCH_H
@@ -1,13 +1,13 @@
 /**************************  instrset_detect.cpp   ****************************
 | Author:        Agner Fog
 | Date created:  2012-05-30
-| Last modified: 2014-07-23
-| Version:       1.14
+| Last modified: 2026-10-16
+| Version:       1.17
 | Project:       vector classes
 | Description:
 | Functions for checking which instruction sets are supported.
 |
-| (c) Copyright 2012 - 2014 GNU General Public License http://www.gnu.org/licenses
+| (c) Copyright 2012 - 2026 GNU General Public License http://www.gnu.org/licenses
 \*****************************************************************************/
 
 #include "instrset.h"
@@ -86,6 +86,7 @@ static inline int64_t xgetbv (int ctr) {
     7  or above = AVX supported by CPU and operating system
     8  or above = AVX2
     9  or above = AVX512F
+    10 or above = AVX512BW, AVX512DQ and AVX512VL
 */
 int instrset_detect(void) {
 
@@ -124,7 +125,12 @@ int instrset_detect(void) {
     iset = 8;                                              // 8: AVX2 supported
     cpuid(abcd, 0xD);                                      // call cpuid leaf 0xD for feature flags
     if ((abcd[0] & 0x60) != 0x60)   return iset;           // no AVX512
-    iset = 9;                                              // 8: AVX512F supported
+    iset = 9;                                              // 9: AVX512F supported
+    cpuid(abcd, 7);                                        // call cpuid leaf 7 for feature flags
+    if ((abcd[1] & (1 << 30)) == 0) return iset;           // no AVX512BW
+    if ((abcd[1] & (1 << 17)) == 0) return iset;           // no AVX512DQ
+    if ((abcd[1] & (1 << 31)) == 0) return iset;           // no AVX512VL
+    iset = 10;                                             // 10: AVX512BW, DQ and VL supported
     return iset;
 }
 
@@ -1,8 +1,8 @@
 /****************************  vectorclass.h   ********************************
 * Author:        Agner Fog
 * Date created:  2012-05-30
-* Last modified: 2014-10-24
-* Version:       1.16
+* Last modified: 2026-10-16
+* Version:       1.17
 * Project:       vector classes
 * Description:
 * Header file defining vector classes as interface to intrinsic functions 
@@ -25,7 +25,7 @@
 * (c) Copyright 2012 - 2014 GNU General Public License www.gnu.org/licenses
 ******************************************************************************/
 #ifndef VECTORCLASS_H
-#define VECTORCLASS_H  116
+#define VECTORCLASS_H  117
 
 // Maximum vector size, bits. Allowed values are 128, 256, 512
 #ifndef MAX_VECTOR_SIZE
@@ -62,6 +62,11 @@
   #include "vectori512e.h"   // 512-bit integer vectors, emulated
   #include "vectorf512e.h"   // 512-bit floating point vectors, emulated
 #endif  //  INSTRSET >= 9
+#if INSTRSET >= 10
+  #include "vectori512s.h"   // 512-bit vectors of 8-bit and 16-bit integers, requires AVX512BW instruction set
+#else
+  #include "vectori512se.h"  // 512-bit vectors of 8-bit and 16-bit integers, emulated
+#endif  //  INSTRSET >= 10
 #endif  //  MAX_VECTOR_SIZE >= 512
 
 #endif  // INSTRSET < 2 
@@ -1,8 +1,8 @@
 /****************************  vectorf128.h   *******************************
 * Author:        Agner Fog
 * Date created:  2012-05-30
-* Last modified: 2014-10-24
-* Version:       1.16
+* Last modified: 2026-10-16
+* Version:       1.17
 * Project:       vector classes
 * Description:
 * Header file defining floating point vector classes as interface to 
@@ -2566,6 +2566,113 @@ static inline Vec2d gather2d(void const * a) {
 
 
 
+/*****************************************************************************
+*
+*          Scatter functions
+*
+*****************************************************************************/
+// Store the elements of a vector into an array at the positions given by
+// indexes. See vectori128.h for details.
+// The float and double versions do not call the integer versions, because
+// storing floating point data through an integer pointer violates the
+// strict aliasing rule.
+
+// Store the elements of data into array[i0], array[i1], array[i2], array[i3]
+template <int i0, int i1, int i2, int i3>
+static inline void scatter(Vec4f const & data, void * array) {
+#if INSTRSET >= 9  // AVX512
+    __m512i indx = _mm512_castsi128_si512(Vec4i(i0,i1,i2,i3));
+    __mmask16 mask = uint16_t((i0>=0) | (i1>=0)<<1 | (i2>=0)<<2 | (i3>=0)<<3);
+    _mm512_mask_i32scatter_ps((float*)array, mask, indx, _mm512_castps128_ps512(data), 4);
+#else
+    float * arr = (float*)array;
+    float dat[4];
+    data.store(dat);
+    if (i0 >= 0) arr[i0] = dat[0];
+    if (i1 >= 0) arr[i1] = dat[1];
+    if (i2 >= 0) arr[i2] = dat[2];
+    if (i3 >= 0) arr[i3] = dat[3];
+#endif
+}
+
+// Store the elements of data into array[i0], array[i1]
+template <int i0, int i1>
+static inline void scatter(Vec2d const & data, void * array) {
+    double * arr = (double*)array;
+    double dat[2];
+    data.store(dat);
+    if (i0 >= 0) arr[i0] = dat[0];
+    if (i1 >= 0) arr[i1] = dat[1];
+}
+
+// Store data[i] into array[index[i]] where index[i] < limit
+static inline void scatter(Vec4i const & index, uint32_t limit, Vec4f const & data, void * array) {
+#if INSTRSET >= 9  // AVX512
+    __m512i indx = _mm512_castsi128_si512(index);
+    __mmask16 mask = _mm512_mask_cmplt_epu32_mask(0x0F, indx, _mm512_set1_epi32(limit));
+    _mm512_mask_i32scatter_ps((float*)array, mask, indx, _mm512_castps128_ps512(data), 4);
+#else
+    float * arr = (float*)array;
+    uint32_t ind[4];
+    float    dat[4];
+    index.store(ind);
+    data.store(dat);
+    for (int i = 0; i < 4; i++) {
+        if (ind[i] < limit) arr[ind[i]] = dat[i];
+    }
+#endif
+}
+
+static inline void scatter(Vec2q const & index, uint32_t limit, Vec2d const & data, void * array) {
+#if INSTRSET >= 9  // AVX512
+    __m512i indx = _mm512_castsi128_si512(index);
+    __mmask8 mask = _mm512_mask_cmplt_epu64_mask(0x03, indx, _mm512_set1_epi64(limit));
+    _mm512_mask_i64scatter_pd((double*)array, mask, indx, _mm512_castpd128_pd512(data), 8);
+#else
+    double * arr = (double*)array;
+    uint64_t ind[2];
+    double   dat[2];
+    index.store(ind);
+    data.store(dat);
+    for (int i = 0; i < 2; i++) {
+        if (ind[i] < uint64_t(limit)) arr[ind[i]] = dat[i];
+    }
+#endif
+}
+
+// Store data[i] into array[index[i]] where mask[i] is true
+static inline void scatter(Vec4fb const & mask, Vec4i const & index, Vec4f const & data, void * array) {
+    uint32_t bits = _mm_movemask_ps(mask);
+#if INSTRSET >= 9  // AVX512
+    _mm512_mask_i32scatter_ps((float*)array, __mmask16(bits), _mm512_castsi128_si512(index), _mm512_castps128_ps512(data), 4);
+#else
+    float * arr = (float*)array;
+    int32_t ind[4];
+    float   dat[4];
+    index.store(ind);
+    data.store(dat);
+    for (int i = 0; i < 4; i++) {
+        if (bits & (1 << i)) arr[ind[i]] = dat[i];
+    }
+#endif
+}
+
+static inline void scatter(Vec2db const & mask, Vec2q const & index, Vec2d const & data, void * array) {
+    uint32_t bits = _mm_movemask_pd(mask);
+#if INSTRSET >= 9  // AVX512
+    _mm512_mask_i64scatter_pd((double*)array, __mmask8(bits), _mm512_castsi128_si512(index), _mm512_castpd128_pd512(data), 8);
+#else
+    double * arr = (double*)array;
+    int64_t ind[2];
+    double  dat[2];
+    index.store(ind);
+    data.store(dat);
+    if (bits & 1) arr[ind[0]] = dat[0];
+    if (bits & 2) arr[ind[1]] = dat[1];
+#endif
+}
+
+
 /*****************************************************************************
 *
 *          Horizontal scan functions
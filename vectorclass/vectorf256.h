@@ -1,8 +1,8 @@
 /****************************  vectorf256.h   *******************************
 * Author:        Agner Fog
 * Date created:  2012-05-30
-* Last modified: 2014-10-22
-* Version:       1.16
+* Last modified: 2026-10-16
+* Version:       1.17
 * Project:       vector classes
 * Description:
 * Header file defining 256-bit floating point vector classes as interface
@@ -3113,6 +3113,127 @@ static inline Vec4d gather4d(void const * a) {
 
 
 
+/*****************************************************************************
+*
+*          Scatter functions
+*
+*****************************************************************************/
+// Store the elements of a vector into an array at the positions given by
+// indexes. See vectori128.h for details.
+// The float and double versions do not call the integer versions, because
+// storing floating point data through an integer pointer violates the
+// strict aliasing rule.
+
+// Store the elements of data into array[i0], array[i1], .. array[i7]
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7>
+static inline void scatter(Vec8f const & data, void * array) {
+#if INSTRSET >= 9  // AVX512
+    __m512i indx = _mm512_castsi256_si512(Vec8i(i0,i1,i2,i3,i4,i5,i6,i7));
+    __mmask16 mask = uint16_t((i0>=0) | (i1>=0)<<1 | (i2>=0)<<2 | (i3>=0)<<3 |
+        (i4>=0)<<4 | (i5>=0)<<5 | (i6>=0)<<6 | (i7>=0)<<7);
+    _mm512_mask_i32scatter_ps((float*)array, mask, indx, _mm512_castps256_ps512(data), 4);
+#else
+    float * arr = (float*)array;
+    float dat[8];
+    data.store(dat);
+    if (i0 >= 0) arr[i0] = dat[0];
+    if (i1 >= 0) arr[i1] = dat[1];
+    if (i2 >= 0) arr[i2] = dat[2];
+    if (i3 >= 0) arr[i3] = dat[3];
+    if (i4 >= 0) arr[i4] = dat[4];
+    if (i5 >= 0) arr[i5] = dat[5];
+    if (i6 >= 0) arr[i6] = dat[6];
+    if (i7 >= 0) arr[i7] = dat[7];
+#endif
+}
+
+// Store the elements of data into array[i0], array[i1], array[i2], array[i3]
+template <int i0, int i1, int i2, int i3>
+static inline void scatter(Vec4d const & data, void * array) {
+#if INSTRSET >= 9  // AVX512
+    __m512i indx = _mm512_castsi256_si512(Vec4q(i0,i1,i2,i3));
+    __mmask8 mask = uint8_t((i0>=0) | (i1>=0)<<1 | (i2>=0)<<2 | (i3>=0)<<3);
+    _mm512_mask_i64scatter_pd((double*)array, mask, indx, _mm512_castpd256_pd512(data), 8);
+#else
+    double * arr = (double*)array;
+    double dat[4];
+    data.store(dat);
+    if (i0 >= 0) arr[i0] = dat[0];
+    if (i1 >= 0) arr[i1] = dat[1];
+    if (i2 >= 0) arr[i2] = dat[2];
+    if (i3 >= 0) arr[i3] = dat[3];
+#endif
+}
+
+// Store data[i] into array[index[i]] where index[i] < limit
+static inline void scatter(Vec8i const & index, uint32_t limit, Vec8f const & data, void * array) {
+#if INSTRSET >= 9  // AVX512
+    __m512i indx = _mm512_castsi256_si512(index);
+    __mmask16 mask = _mm512_mask_cmplt_epu32_mask(0xFF, indx, _mm512_set1_epi32(limit));
+    _mm512_mask_i32scatter_ps((float*)array, mask, indx, _mm512_castps256_ps512(data), 4);
+#else
+    float * arr = (float*)array;
+    uint32_t ind[8];
+    float    dat[8];
+    index.store(ind);
+    data.store(dat);
+    for (int i = 0; i < 8; i++) {
+        if (ind[i] < limit) arr[ind[i]] = dat[i];
+    }
+#endif
+}
+
+static inline void scatter(Vec4q const & index, uint32_t limit, Vec4d const & data, void * array) {
+#if INSTRSET >= 9  // AVX512
+    __m512i indx = _mm512_castsi256_si512(index);
+    __mmask8 mask = _mm512_mask_cmplt_epu64_mask(0x0F, indx, _mm512_set1_epi64(limit));
+    _mm512_mask_i64scatter_pd((double*)array, mask, indx, _mm512_castpd256_pd512(data), 8);
+#else
+    double * arr = (double*)array;
+    uint64_t ind[4];
+    double   dat[4];
+    index.store(ind);
+    data.store(dat);
+    for (int i = 0; i < 4; i++) {
+        if (ind[i] < uint64_t(limit)) arr[ind[i]] = dat[i];
+    }
+#endif
+}
+
+// Store data[i] into array[index[i]] where mask[i] is true
+static inline void scatter(Vec8fb const & mask, Vec8i const & index, Vec8f const & data, void * array) {
+    uint32_t bits = _mm256_movemask_ps(mask);
+#if INSTRSET >= 9  // AVX512
+    _mm512_mask_i32scatter_ps((float*)array, __mmask16(bits), _mm512_castsi256_si512(index), _mm512_castps256_ps512(data), 4);
+#else
+    float * arr = (float*)array;
+    int32_t ind[8];
+    float   dat[8];
+    index.store(ind);
+    data.store(dat);
+    for (int i = 0; i < 8; i++) {
+        if (bits & (1 << i)) arr[ind[i]] = dat[i];
+    }
+#endif
+}
+
+static inline void scatter(Vec4db const & mask, Vec4q const & index, Vec4d const & data, void * array) {
+    uint32_t bits = _mm256_movemask_pd(mask);
+#if INSTRSET >= 9  // AVX512
+    _mm512_mask_i64scatter_pd((double*)array, __mmask8(bits), _mm512_castsi256_si512(index), _mm512_castpd256_pd512(data), 8);
+#else
+    double * arr = (double*)array;
+    int64_t ind[4];
+    double  dat[4];
+    index.store(ind);
+    data.store(dat);
+    for (int i = 0; i < 4; i++) {
+        if (bits & (1 << i)) arr[ind[i]] = dat[i];
+    }
+#endif
+}
+
+
 /*****************************************************************************
 *
 *          Horizontal scan functions
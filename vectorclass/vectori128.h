@@ -1,8 +1,8 @@
 /****************************  vectori128.h   *******************************
 * Author:        Agner Fog
 * Date created:  2012-05-30
-* Last modified: 2014-10-24
-* Version:       1.16
+* Last modified: 2026-10-16
+* Version:       1.17
 * Project:       vector classes
 * Description:
 * Header file defining integer vector classes as interface to intrinsic 
@@ -4617,7 +4617,7 @@ static inline Vec16c lookup32(Vec16c const & index, Vec16c const & table0, Vec16
     return r0 | r1;
 #else
     uint8_t ii[16];
-    int8_t  tt[16], rr[16];
+    int8_t  tt[32], rr[16];
     table0.store(tt);  table1.store(tt+16);  index.store(ii);
     for (int j = 0; j < 16; j++) rr[j] = tt[ii[j] & 0x1F];
     return Vec16c().load(rr);
@@ -4943,6 +4943,111 @@ static inline Vec2q gather2q(void const * a) {
 }
 
 
+/*****************************************************************************
+*
+*          Scatter functions
+*
+*****************************************************************************/
+// Store the elements of a vector into an array at the positions given by
+// indexes. This is the opposite of gather.
+// Example:
+// Vec4i a(10,11,12,13);
+// int32_t b[16] = {0};
+// scatter<0,-1,9,3>(a, b);          // b = {10,0,0,13,0,0,0,0,0,12,0,...}
+// scatter(Vec4i(1,2,3,20), 16, a, b);  // b[1]=10, b[2]=11, b[3]=12. 13 not stored
+//
+// The versions with compile-time constant indexes skip elements with a
+// negative index.
+// The versions with a variable index vector skip elements where the index is
+// not less than limit (compared as unsigned), or where the mask is false.
+// The masked versions do not check the index.
+// If two elements have the same index then the last one is stored.
+// AVX512 scatter instructions are used if available.
+
+// Store the elements of data into array[i0], array[i1], array[i2], array[i3]
+template <int i0, int i1, int i2, int i3>
+static inline void scatter(Vec4i const & data, void * array) {
+#if INSTRSET >= 9  // AVX512
+    __m512i indx = _mm512_castsi128_si512(Vec4i(i0,i1,i2,i3));
+    __mmask16 mask = uint16_t((i0>=0) | (i1>=0)<<1 | (i2>=0)<<2 | (i3>=0)<<3);
+    _mm512_mask_i32scatter_epi32((int*)array, mask, indx, _mm512_castsi128_si512(data), 4);
+#else
+    int32_t * arr = (int32_t*)array;
+    int32_t dat[4];
+    data.store(dat);
+    if (i0 >= 0) arr[i0] = dat[0];
+    if (i1 >= 0) arr[i1] = dat[1];
+    if (i2 >= 0) arr[i2] = dat[2];
+    if (i3 >= 0) arr[i3] = dat[3];
+#endif
+}
+
+// Store the elements of data into array[i0], array[i1]
+template <int i0, int i1>
+static inline void scatter(Vec2q const & data, void * array) {
+    int64_t * arr = (int64_t*)array;
+    if (i0 >= 0) arr[i0] = data[0];
+    if (i1 >= 0) arr[i1] = data[1];
+}
+
+// Store data[i] into array[index[i]] where index[i] < limit
+static inline void scatter(Vec4i const & index, uint32_t limit, Vec4i const & data, void * array) {
+#if INSTRSET >= 9  // AVX512
+    __m512i indx = _mm512_castsi128_si512(index);
+    __mmask16 mask = _mm512_mask_cmplt_epu32_mask(0x0F, indx, _mm512_set1_epi32(limit));
+    _mm512_mask_i32scatter_epi32((int*)array, mask, indx, _mm512_castsi128_si512(data), 4);
+#else
+    int32_t * arr = (int32_t*)array;
+    uint32_t ind[4];
+    int32_t  dat[4];
+    index.store(ind);
+    data.store(dat);
+    for (int i = 0; i < 4; i++) {
+        if (ind[i] < limit) arr[ind[i]] = dat[i];
+    }
+#endif
+}
+
+static inline void scatter(Vec2q const & index, uint32_t limit, Vec2q const & data, void * array) {
+#if INSTRSET >= 9  // AVX512
+    __m512i indx = _mm512_castsi128_si512(index);
+    __mmask8 mask = _mm512_mask_cmplt_epu64_mask(0x03, indx, _mm512_set1_epi64(limit));
+    _mm512_mask_i64scatter_epi64((long long *)array, mask, indx, _mm512_castsi128_si512(data), 8);
+#else
+    int64_t * arr = (int64_t*)array;
+    if (uint64_t(index[0]) < uint64_t(limit)) arr[index[0]] = data[0];
+    if (uint64_t(index[1]) < uint64_t(limit)) arr[index[1]] = data[1];
+#endif
+}
+
+// Store data[i] into array[index[i]] where mask[i] is true
+static inline void scatter(Vec4ib const & mask, Vec4i const & index, Vec4i const & data, void * array) {
+    uint32_t bits = _mm_movemask_ps(_mm_castsi128_ps(mask));
+#if INSTRSET >= 9  // AVX512
+    _mm512_mask_i32scatter_epi32((int*)array, __mmask16(bits), _mm512_castsi128_si512(index), _mm512_castsi128_si512(data), 4);
+#else
+    int32_t * arr = (int32_t*)array;
+    int32_t ind[4], dat[4];
+    index.store(ind);
+    data.store(dat);
+    for (int i = 0; i < 4; i++) {
+        if (bits & (1 << i)) arr[ind[i]] = dat[i];
+    }
+#endif
+}
+
+static inline void scatter(Vec2qb const & mask, Vec2q const & index, Vec2q const & data, void * array) {
+    uint32_t bits = _mm_movemask_pd(_mm_castsi128_pd(mask));
+#if INSTRSET >= 9  // AVX512
+    _mm512_mask_i64scatter_epi64((long long *)array, __mmask8(bits), _mm512_castsi128_si512(index), _mm512_castsi128_si512(data), 8);
+#else
+    int64_t * arr = (int64_t*)array;
+    if (bits & 1) arr[index[0]] = data[0];
+    if (bits & 2) arr[index[1]] = data[1];
+#endif
+}
+
+
 /*****************************************************************************
 *
 *          Functions for conversion between integer sizes
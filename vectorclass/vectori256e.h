@@ -1,8 +1,8 @@
 /****************************  vectori256e.h   *******************************
 * Author:        Agner Fog
 * Date created:  2012-05-30
-* Last modified: 2014-10-16
-* Version:       1.16
+* Last modified: 2026-10-16
+* Version:       1.17
 * Project:       vector classes
 * Description:
 * Header file defining 256-bit integer point vector classes as interface
@@ -3887,6 +3887,51 @@ static inline Vec4q gather4q(void const * a) {
 
 
 
+/*****************************************************************************
+*
+*          Scatter functions
+*
+*****************************************************************************/
+// Store the elements of a vector into an array at the positions given by
+// indexes. See vectori128.h for details
+
+// Store the elements of data into array[i0], array[i1], .. array[i7]
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7>
+static inline void scatter(Vec8i const & data, void * array) {
+    scatter<i0, i1, i2, i3>(data.get_low(),  array);
+    scatter<i4, i5, i6, i7>(data.get_high(), array);
+}
+
+// Store the elements of data into array[i0], array[i1], array[i2], array[i3]
+template <int i0, int i1, int i2, int i3>
+static inline void scatter(Vec4q const & data, void * array) {
+    scatter<i0, i1>(data.get_low(),  array);
+    scatter<i2, i3>(data.get_high(), array);
+}
+
+// Store data[i] into array[index[i]] where index[i] < limit
+static inline void scatter(Vec8i const & index, uint32_t limit, Vec8i const & data, void * array) {
+    scatter(index.get_low(),  limit, data.get_low(),  array);
+    scatter(index.get_high(), limit, data.get_high(), array);
+}
+
+static inline void scatter(Vec4q const & index, uint32_t limit, Vec4q const & data, void * array) {
+    scatter(index.get_low(),  limit, data.get_low(),  array);
+    scatter(index.get_high(), limit, data.get_high(), array);
+}
+
+// Store data[i] into array[index[i]] where mask[i] is true
+static inline void scatter(Vec8ib const & mask, Vec8i const & index, Vec8i const & data, void * array) {
+    scatter(mask.get_low(),  index.get_low(),  data.get_low(),  array);
+    scatter(mask.get_high(), index.get_high(), data.get_high(), array);
+}
+
+static inline void scatter(Vec4qb const & mask, Vec4q const & index, Vec4q const & data, void * array) {
+    scatter(mask.get_low(),  index.get_low(),  data.get_low(),  array);
+    scatter(mask.get_high(), index.get_high(), data.get_high(), array);
+}
+
+
 /*****************************************************************************
 *
 *          Functions for conversion between integer sizes
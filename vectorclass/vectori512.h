@@ -1,8 +1,8 @@
 /****************************  vectori512.h   *******************************
 * Author:        Agner Fog
 * Date created:  2014-07-23
-* Last modified: 2014-10-16
-* Version:       1.16
+* Last modified: 2026-10-16
+* Version:       1.17
 * Project:       vector classes
 * Description:
 * Header file defining integer vector classes as interface to intrinsic 
@@ -2331,6 +2331,53 @@ static inline Vec8q gather8q(void const * a) {
 }
 
 
+/*****************************************************************************
+*
+*          Scatter functions
+*
+*****************************************************************************/
+// Store the elements of a vector into an array at the positions given by
+// indexes. See vectori128.h for details
+
+// Store the elements of data into array[i0], array[i1], .. array[i15]
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7, 
+int i8, int i9, int i10, int i11, int i12, int i13, int i14, int i15>
+static inline void scatter(Vec16i const & data, void * array) {
+    __m512i indx = constant16i<i0,i1,i2,i3,i4,i5,i6,i7,i8,i9,i10,i11,i12,i13,i14,i15>();
+    Vec16b mask(i0>=0, i1>=0, i2>=0, i3>=0, i4>=0, i5>=0, i6>=0, i7>=0,
+        i8>=0, i9>=0, i10>=0, i11>=0, i12>=0, i13>=0, i14>=0, i15>=0);
+    _mm512_mask_i32scatter_epi32((int*)array, mask, indx, data, 4);
+}
+
+// Store the elements of data into array[i0], array[i1], .. array[i7]
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7>
+static inline void scatter(Vec8q const & data, void * array) {
+    __m512i indx = Vec8q(i0,i1,i2,i3,i4,i5,i6,i7);
+    Vec8b mask(i0>=0, i1>=0, i2>=0, i3>=0, i4>=0, i5>=0, i6>=0, i7>=0);
+    _mm512_mask_i64scatter_epi64((long long *)array, (__mmask8)mask, indx, data, 8);
+}
+
+// Store data[i] into array[index[i]] where index[i] < limit
+static inline void scatter(Vec16i const & index, uint32_t limit, Vec16i const & data, void * array) {
+    __mmask16 mask = _mm512_cmplt_epu32_mask(index, Vec16ui(limit));
+    _mm512_mask_i32scatter_epi32((int*)array, mask, index, data, 4);
+}
+
+static inline void scatter(Vec8q const & index, uint32_t limit, Vec8q const & data, void * array) {
+    __mmask8 mask = _mm512_cmplt_epu64_mask(index, Vec8uq(uint64_t(limit)));
+    _mm512_mask_i64scatter_epi64((long long *)array, mask, index, data, 8);
+}
+
+// Store data[i] into array[index[i]] where mask[i] is true
+static inline void scatter(Vec16ib const & mask, Vec16i const & index, Vec16i const & data, void * array) {
+    _mm512_mask_i32scatter_epi32((int*)array, mask, index, data, 4);
+}
+
+static inline void scatter(Vec8qb const & mask, Vec8q const & index, Vec8q const & data, void * array) {
+    _mm512_mask_i64scatter_epi64((long long *)array, (__mmask8)mask, index, data, 8);
+}
+
+
 /*****************************************************************************
 *
 *          Functions for conversion between integer sizes
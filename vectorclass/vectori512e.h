@@ -1,8 +1,8 @@
 /****************************  vectori512e.h   *******************************
 * Author:        Agner Fog
 * Date created:  2014-07-23
-* Last modified: 2014-10-16
-* Version:       1.16
+* Last modified: 2026-10-16
+* Version:       1.17
 * Project:       vector classes
 * Description:
 * Header file defining integer vector classes as interface to intrinsic 
@@ -2263,6 +2263,52 @@ static inline Vec8q gather8q(void const * a) {
 }
 
 
+/*****************************************************************************
+*
+*          Scatter functions
+*
+*****************************************************************************/
+// Store the elements of a vector into an array at the positions given by
+// indexes. See vectori128.h for details
+
+// Store the elements of data into array[i0], array[i1], .. array[i15]
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7, 
+int i8, int i9, int i10, int i11, int i12, int i13, int i14, int i15>
+static inline void scatter(Vec16i const & data, void * array) {
+    scatter<i0, i1, i2,  i3,  i4,  i5,  i6,  i7 >(data.get_low(),  array);
+    scatter<i8, i9, i10, i11, i12, i13, i14, i15>(data.get_high(), array);
+}
+
+// Store the elements of data into array[i0], array[i1], .. array[i7]
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7>
+static inline void scatter(Vec8q const & data, void * array) {
+    scatter<i0, i1, i2, i3>(data.get_low(),  array);
+    scatter<i4, i5, i6, i7>(data.get_high(), array);
+}
+
+// Store data[i] into array[index[i]] where index[i] < limit
+static inline void scatter(Vec16i const & index, uint32_t limit, Vec16i const & data, void * array) {
+    scatter(index.get_low(),  limit, data.get_low(),  array);
+    scatter(index.get_high(), limit, data.get_high(), array);
+}
+
+static inline void scatter(Vec8q const & index, uint32_t limit, Vec8q const & data, void * array) {
+    scatter(index.get_low(),  limit, data.get_low(),  array);
+    scatter(index.get_high(), limit, data.get_high(), array);
+}
+
+// Store data[i] into array[index[i]] where mask[i] is true
+static inline void scatter(Vec16ib const & mask, Vec16i const & index, Vec16i const & data, void * array) {
+    scatter(mask.get_low(),  index.get_low(),  data.get_low(),  array);
+    scatter(mask.get_high(), index.get_high(), data.get_high(), array);
+}
+
+static inline void scatter(Vec8qb const & mask, Vec8q const & index, Vec8q const & data, void * array) {
+    scatter(mask.get_low(),  index.get_low(),  data.get_low(),  array);
+    scatter(mask.get_high(), index.get_high(), data.get_high(), array);
+}
+
+
 /*****************************************************************************
 *
 *          Functions for conversion between integer sizes
@@ -0,0 +1,1763 @@
+/****************************  vectori512s.h   *******************************
+* Author:        agent
+* Date created:  2026-10-16
+* Last modified: 2026-10-16
+* Version:       1.17
+* Project:       vector classes
+* Description:
+* Header file defining 512-bit integer vector classes with 8-bit and 16-bit
+* elements as interface to intrinsic functions in x86 microprocessors with
+* AVX512BW and later instruction sets.
+*
+* Instructions:
+* Use Gnu, Intel or Microsoft C++ compiler. Compile for the desired
+* instruction set, which must be at least AVX512BW.
+*
+* The following vector classes are defined here:
+* Vec64c    Vector of  64   8-bit signed   integers
+* Vec64uc   Vector of  64   8-bit unsigned integers
+* Vec64cb   Vector of  64  Booleans for use with Vec64c and Vec64uc
+* Vec32s    Vector of  32  16-bit signed   integers
+* Vec32us   Vector of  32  16-bit unsigned integers
+* Vec32sb   Vector of  32  Booleans for use with Vec32s and Vec32us
+*
+* Each vector object is represented internally in the CPU as a 512-bit register.
+* The Boolean vectors are represented as mask registers, one bit per element.
+* This header file defines operators and functions for these vectors.
+*
+* For detailed instructions, see VectorClass.pdf
+*
+* (c) Copyright 2026 agent. GNU General Public License http://www.gnu.org/licenses
+*****************************************************************************/
+
+// check combination of header files
+#if defined (VECTORI512S_H)
+#if    VECTORI512S_H != 2
+#error Two different versions of vectori512s.h included
+#endif
+#else
+#define VECTORI512S_H  2
+
+#if INSTRSET < 10   // AVX512BW required
+#error Wrong instruction set for vectori512s.h, AVX512BW required or use vectori512se.h
+#endif
+
+#include "vectori512.h"
+
+
+/*****************************************************************************
+*
+*          Vec64cb: Vector of 64 Booleans for use with Vec64c and Vec64uc
+*
+*****************************************************************************/
+
+class Vec64cb {
+protected:
+    __mmask64  mm; // Boolean vector
+public:
+    // Default constructor:
+    Vec64cb () {
+    }
+    // Constructor to convert from type __mmask64 used in intrinsics:
+    Vec64cb (__mmask64 x) {
+        mm = x;
+    }
+    // Constructor to broadcast single value:
+    Vec64cb(bool b) {
+        mm = __mmask64(-int64_t(b));
+    }
+private: // Prevent constructing from int, etc.
+    Vec64cb(int b);
+public:
+    // Constructor to make from two halves
+    Vec64cb (Vec32cb const & x0, Vec32cb const & x1) {
+        mm = _mm512_movepi8_mask(Vec512b(x0, x1));
+    }
+    // Assignment operator to convert from type __mmask64 used in intrinsics:
+    Vec64cb & operator = (__mmask64 x) {
+        mm = x;
+        return *this;
+    }
+    // Assignment operator to broadcast scalar value:
+    Vec64cb & operator = (bool b) {
+        mm = Vec64cb(b);
+        return *this;
+    }
+private: // Prevent assigning int because of ambiguity
+    Vec64cb & operator = (int x);
+public:
+    // Type cast operator to convert to __mmask64 used in intrinsics
+    operator __mmask64() const {
+        return mm;
+    }
+    // split into two halves
+    Vec32cb get_low() const {
+        return _mm512_castsi512_si256(_mm512_movm_epi8(mm));
+    }
+    Vec32cb get_high() const {
+        return _mm512_extracti64x4_epi64(_mm512_movm_epi8(mm), 1);
+    }
+    // Member function to change a single element in vector
+    // Note: This function is inefficient. Use load function if changing more than one element
+    Vec64cb const & insert(uint32_t index, bool value) {
+        mm = __mmask64(((uint64_t)mm & ~(uint64_t(1) << (index & 63))) | uint64_t(value) << (index & 63));
+        return *this;
+    }
+    // Member function extract a single element from vector
+    bool extract(uint32_t index) const {
+        return ((uint64_t)mm >> (index & 63)) & 1;
+    }
+    // Extract a single element. Operator [] can only read an element, not write.
+    bool operator [] (uint32_t index) const {
+        return extract(index);
+    }
+    static int size () {
+        return 64;
+    }
+};
+
+// Define operators for Vec64cb
+
+// vector operator & : bitwise and
+static inline Vec64cb operator & (Vec64cb a, Vec64cb b) {
+    return __mmask64((uint64_t)__mmask64(a) & (uint64_t)__mmask64(b));
+}
+static inline Vec64cb operator && (Vec64cb a, Vec64cb b) {
+    return a & b;
+}
+
+// vector operator | : bitwise or
+static inline Vec64cb operator | (Vec64cb a, Vec64cb b) {
+    return __mmask64((uint64_t)__mmask64(a) | (uint64_t)__mmask64(b));
+}
+static inline Vec64cb operator || (Vec64cb a, Vec64cb b) {
+    return a | b;
+}
+
+// vector operator ^ : bitwise xor
+static inline Vec64cb operator ^ (Vec64cb a, Vec64cb b) {
+    return __mmask64((uint64_t)__mmask64(a) ^ (uint64_t)__mmask64(b));
+}
+
+// vector operator ~ : bitwise not
+static inline Vec64cb operator ~ (Vec64cb a) {
+    return __mmask64(~(uint64_t)__mmask64(a));
+}
+
+// vector operator ! : element not
+static inline Vec64cb operator ! (Vec64cb a) {
+    return ~a;
+}
+
+// vector operator &= : bitwise and
+static inline Vec64cb & operator &= (Vec64cb & a, Vec64cb b) {
+    a = a & b;
+    return a;
+}
+
+// vector operator |= : bitwise or
+static inline Vec64cb & operator |= (Vec64cb & a, Vec64cb b) {
+    a = a | b;
+    return a;
+}
+
+// vector operator ^= : bitwise xor
+static inline Vec64cb & operator ^= (Vec64cb & a, Vec64cb b) {
+    a = a ^ b;
+    return a;
+}
+
+// function andnot: a & ~ b
+static inline Vec64cb andnot (Vec64cb a, Vec64cb b) {
+    return __mmask64((uint64_t)__mmask64(a) & ~(uint64_t)__mmask64(b));
+}
+
+// horizontal_and. Returns true if all elements are true
+static inline bool horizontal_and (Vec64cb const & a) {
+    return (uint64_t)__mmask64(a) == 0xFFFFFFFFFFFFFFFFULL;
+}
+
+// horizontal_or. Returns true if at least one element is true
+static inline bool horizontal_or (Vec64cb const & a) {
+    return (uint64_t)__mmask64(a) != 0;
+}
+
+
+/*****************************************************************************
+*
+*          Vec32sb: Vector of 32 Booleans for use with Vec32s and Vec32us
+*
+*****************************************************************************/
+
+class Vec32sb {
+protected:
+    __mmask32  mm; // Boolean vector
+public:
+    // Default constructor:
+    Vec32sb () {
+    }
+    // Constructor to convert from type __mmask32 used in intrinsics:
+    Vec32sb (__mmask32 x) {
+        mm = x;
+    }
+    // Constructor to broadcast single value:
+    Vec32sb(bool b) {
+        mm = __mmask32(-int32_t(b));
+    }
+private: // Prevent constructing from int, etc.
+    Vec32sb(int b);
+public:
+    // Constructor to make from two halves
+    Vec32sb (Vec16sb const & x0, Vec16sb const & x1) {
+        mm = _mm512_movepi16_mask(Vec512b(x0, x1));
+    }
+    // Assignment operator to convert from type __mmask32 used in intrinsics:
+    Vec32sb & operator = (__mmask32 x) {
+        mm = x;
+        return *this;
+    }
+    // Assignment operator to broadcast scalar value:
+    Vec32sb & operator = (bool b) {
+        mm = Vec32sb(b);
+        return *this;
+    }
+private: // Prevent assigning int because of ambiguity
+    Vec32sb & operator = (int x);
+public:
+    // Type cast operator to convert to __mmask32 used in intrinsics
+    operator __mmask32() const {
+        return mm;
+    }
+    // split into two halves
+    Vec16sb get_low() const {
+        return _mm512_castsi512_si256(_mm512_movm_epi16(mm));
+    }
+    Vec16sb get_high() const {
+        return _mm512_extracti64x4_epi64(_mm512_movm_epi16(mm), 1);
+    }
+    // Member function to change a single element in vector
+    // Note: This function is inefficient. Use load function if changing more than one element
+    Vec32sb const & insert(uint32_t index, bool value) {
+        mm = __mmask32(((uint32_t)mm & ~(1u << (index & 31))) | uint32_t(value) << (index & 31));
+        return *this;
+    }
+    // Member function extract a single element from vector
+    bool extract(uint32_t index) const {
+        return ((uint32_t)mm >> (index & 31)) & 1;
+    }
+    // Extract a single element. Operator [] can only read an element, not write.
+    bool operator [] (uint32_t index) const {
+        return extract(index);
+    }
+    static int size () {
+        return 32;
+    }
+};
+
+// Define operators for Vec32sb
+
+// vector operator & : bitwise and
+static inline Vec32sb operator & (Vec32sb a, Vec32sb b) {
+    return __mmask32((uint32_t)__mmask32(a) & (uint32_t)__mmask32(b));
+}
+static inline Vec32sb operator && (Vec32sb a, Vec32sb b) {
+    return a & b;
+}
+
+// vector operator | : bitwise or
+static inline Vec32sb operator | (Vec32sb a, Vec32sb b) {
+    return __mmask32((uint32_t)__mmask32(a) | (uint32_t)__mmask32(b));
+}
+static inline Vec32sb operator || (Vec32sb a, Vec32sb b) {
+    return a | b;
+}
+
+// vector operator ^ : bitwise xor
+static inline Vec32sb operator ^ (Vec32sb a, Vec32sb b) {
+    return __mmask32((uint32_t)__mmask32(a) ^ (uint32_t)__mmask32(b));
+}
+
+// vector operator ~ : bitwise not
+static inline Vec32sb operator ~ (Vec32sb a) {
+    return __mmask32(~(uint32_t)__mmask32(a));
+}
+
+// vector operator ! : element not
+static inline Vec32sb operator ! (Vec32sb a) {
+    return ~a;
+}
+
+// vector operator &= : bitwise and
+static inline Vec32sb & operator &= (Vec32sb & a, Vec32sb b) {
+    a = a & b;
+    return a;
+}
+
+// vector operator |= : bitwise or
+static inline Vec32sb & operator |= (Vec32sb & a, Vec32sb b) {
+    a = a | b;
+    return a;
+}
+
+// vector operator ^= : bitwise xor
+static inline Vec32sb & operator ^= (Vec32sb & a, Vec32sb b) {
+    a = a ^ b;
+    return a;
+}
+
+// function andnot: a & ~ b
+static inline Vec32sb andnot (Vec32sb a, Vec32sb b) {
+    return __mmask32((uint32_t)__mmask32(a) & ~(uint32_t)__mmask32(b));
+}
+
+// horizontal_and. Returns true if all elements are true
+static inline bool horizontal_and (Vec32sb const & a) {
+    return (uint32_t)__mmask32(a) == 0xFFFFFFFFu;
+}
+
+// horizontal_or. Returns true if at least one element is true
+static inline bool horizontal_or (Vec32sb const & a) {
+    return (uint32_t)__mmask32(a) != 0;
+}
+
+
+/*****************************************************************************
+*
+*          Vector of 64 8-bit signed integers
+*
+*****************************************************************************/
+
+class Vec64c: public Vec512b {
+public:
+    // Default constructor:
+    Vec64c() {
+    }
+    // Constructor to broadcast the same value into all elements:
+    Vec64c(int i) {
+        zmm = _mm512_set1_epi8((char)i);
+    }
+    // Constructor to build from all elements:
+    Vec64c(int8_t i0, int8_t i1, int8_t i2, int8_t i3, int8_t i4, int8_t i5, int8_t i6, int8_t i7,
+        int8_t i8, int8_t i9, int8_t i10, int8_t i11, int8_t i12, int8_t i13, int8_t i14, int8_t i15,
+        int8_t i16, int8_t i17, int8_t i18, int8_t i19, int8_t i20, int8_t i21, int8_t i22, int8_t i23,
+        int8_t i24, int8_t i25, int8_t i26, int8_t i27, int8_t i28, int8_t i29, int8_t i30, int8_t i31,
+        int8_t i32, int8_t i33, int8_t i34, int8_t i35, int8_t i36, int8_t i37, int8_t i38, int8_t i39,
+        int8_t i40, int8_t i41, int8_t i42, int8_t i43, int8_t i44, int8_t i45, int8_t i46, int8_t i47,
+        int8_t i48, int8_t i49, int8_t i50, int8_t i51, int8_t i52, int8_t i53, int8_t i54, int8_t i55,
+        int8_t i56, int8_t i57, int8_t i58, int8_t i59, int8_t i60, int8_t i61, int8_t i62, int8_t i63) {
+        zmm = Vec512b(
+            Vec32c(i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15,
+            i16, i17, i18, i19, i20, i21, i22, i23, i24, i25, i26, i27, i28, i29, i30, i31),
+            Vec32c(i32, i33, i34, i35, i36, i37, i38, i39, i40, i41, i42, i43, i44, i45, i46, i47,
+            i48, i49, i50, i51, i52, i53, i54, i55, i56, i57, i58, i59, i60, i61, i62, i63));
+    }
+    // Constructor to build from two Vec32c:
+    Vec64c(Vec32c const & a0, Vec32c const & a1) {
+        zmm = _mm512_inserti64x4(_mm512_castsi256_si512(a0), a1, 1);
+    }
+    // Constructor to convert from type __m512i used in intrinsics:
+    Vec64c(__m512i const & x) {
+        zmm = x;
+    }
+    // Assignment operator to convert from type __m512i used in intrinsics:
+    Vec64c & operator = (__m512i const & x) {
+        zmm = x;
+        return *this;
+    }
+    // Type cast operator to convert to __m512i used in intrinsics
+    operator __m512i() const {
+        return zmm;
+    }
+    // Member function to load from array (unaligned)
+    Vec64c & load(void const * p) {
+        zmm = _mm512_loadu_si512(p);
+        return *this;
+    }
+    // Member function to load from array, aligned by 64
+    Vec64c & load_a(void const * p) {
+        zmm = _mm512_load_si512(p);
+        return *this;
+    }
+    // Partial load. Load n elements and set the rest to 0
+    Vec64c & load_partial(int n, void const * p) {
+        zmm = _mm512_maskz_loadu_epi8(__mmask64(n >= 64 ? ~0ULL : n <= 0 ? 0 : (1ULL << n) - 1), p);
+        return *this;
+    }
+    // Partial store. Store n elements
+    void store_partial(int n, void * p) const {
+        _mm512_mask_storeu_epi8(p, __mmask64(n >= 64 ? ~0ULL : n <= 0 ? 0 : (1ULL << n) - 1), zmm);
+    }
+    // cut off vector to n elements. The last 64-n elements are set to zero
+    Vec64c & cutoff(int n) {
+        zmm = _mm512_maskz_mov_epi8(__mmask64(n >= 64 ? ~0ULL : n <= 0 ? 0 : (1ULL << n) - 1), zmm);
+        return *this;
+    }
+    // Member function to change a single element in vector
+    Vec64c const & insert(uint32_t index, int8_t value) {
+        zmm = _mm512_mask_set1_epi8(zmm, __mmask64(1ULL << (index & 63)), value);
+        return *this;
+    }
+    // Member function extract a single element from vector
+    int8_t extract(uint32_t index) const {
+        int8_t a[64];
+        store(a);
+        return a[index & 63];
+    }
+    // Extract a single element. Use store function if extracting more than one element.
+    // Operator [] can only read an element, not write.
+    int8_t operator [] (uint32_t index) const {
+        return extract(index);
+    }
+    // Member functions to split into two Vec32c:
+    Vec32c get_low() const {
+        return _mm512_castsi512_si256(zmm);
+    }
+    Vec32c get_high() const {
+        return _mm512_extracti64x4_epi64(zmm,1);
+    }
+    static int size () {
+        return 64;
+    }
+};
+
+
+// Define operators for Vec64c
+
+// vector operator + : add element by element
+static inline Vec64c operator + (Vec64c const & a, Vec64c const & b) {
+    return _mm512_add_epi8(a, b);
+}
+
+// vector operator += : add
+static inline Vec64c & operator += (Vec64c & a, Vec64c const & b) {
+    a = a + b;
+    return a;
+}
+
+// postfix operator ++
+static inline Vec64c operator ++ (Vec64c & a, int) {
+    Vec64c a0 = a;
+    a = a + 1;
+    return a0;
+}
+
+// prefix operator ++
+static inline Vec64c & operator ++ (Vec64c & a) {
+    a = a + 1;
+    return a;
+}
+
+// vector operator - : subtract element by element
+static inline Vec64c operator - (Vec64c const & a, Vec64c const & b) {
+    return _mm512_sub_epi8(a, b);
+}
+
+// vector operator - : unary minus
+static inline Vec64c operator - (Vec64c const & a) {
+    return _mm512_sub_epi8(_mm512_setzero_si512(), a);
+}
+
+// vector operator -= : subtract
+static inline Vec64c & operator -= (Vec64c & a, Vec64c const & b) {
+    a = a - b;
+    return a;
+}
+
+// postfix operator --
+static inline Vec64c operator -- (Vec64c & a, int) {
+    Vec64c a0 = a;
+    a = a - 1;
+    return a0;
+}
+
+// prefix operator --
+static inline Vec64c & operator -- (Vec64c & a) {
+    a = a - 1;
+    return a;
+}
+
+// vector operator * : multiply element by element
+static inline Vec64c operator * (Vec64c const & a, Vec64c const & b) {
+    // There is no 8-bit multiply. Split into two 16-bit multiplies
+    __m512i aodd    = _mm512_srli_epi16(a,8);                 // odd numbered elements of a
+    __m512i bodd    = _mm512_srli_epi16(b,8);                 // odd numbered elements of b
+    __m512i muleven = _mm512_mullo_epi16(a,b);                // product of even numbered elements
+    __m512i mulodd  = _mm512_mullo_epi16(aodd,bodd);          // product of odd  numbered elements
+            mulodd  = _mm512_slli_epi16(mulodd,8);            // put odd numbered elements back in place
+    return _mm512_mask_mov_epi8(mulodd, 0x5555555555555555, muleven); // interleave even and odd
+}
+
+// vector operator *= : multiply
+static inline Vec64c & operator *= (Vec64c & a, Vec64c const & b) {
+    a = a * b;
+    return a;
+}
+
+// vector operator << : shift left all elements
+static inline Vec64c operator << (Vec64c const & a, int b) {
+    uint32_t mask = (uint32_t)0xFF >> (uint32_t)b;                  // mask to remove bits that are shifted out
+    __m512i am    = _mm512_and_si512(a,_mm512_set1_epi8((char)mask)); // remove bits that will overflow
+    __m512i res   = _mm512_sll_epi16(am,_mm_cvtsi32_si128(b));      // 16-bit shifts
+    return res;
+}
+
+// vector operator <<= : shift left
+static inline Vec64c & operator <<= (Vec64c & a, int b) {
+    a = a << b;
+    return a;
+}
+
+// vector operator >> : shift right arithmetic all elements
+static inline Vec64c operator >> (Vec64c const & a, int b) {
+    __m512i aeven = _mm512_slli_epi16(a,8);                           // even numbered elements of a. get sign bit in position
+            aeven = _mm512_sra_epi16(aeven,_mm_cvtsi32_si128(b+8));   // shift arithmetic, back to position
+    __m512i aodd  = _mm512_sra_epi16(a,_mm_cvtsi32_si128(b));         // shift odd numbered elements arithmetic
+    return _mm512_mask_mov_epi8(aodd, 0x5555555555555555, aeven);     // interleave even and odd
+}
+
+// vector operator >>= : shift right arithmetic
+static inline Vec64c & operator >>= (Vec64c & a, int b) {
+    a = a >> b;
+    return a;
+}
+
+// vector operator == : returns true for elements for which a == b
+static inline Vec64cb operator == (Vec64c const & a, Vec64c const & b) {
+    return _mm512_cmpeq_epi8_mask(a, b);
+}
+
+// vector operator != : returns true for elements for which a != b
+static inline Vec64cb operator != (Vec64c const & a, Vec64c const & b) {
+    return _mm512_cmpneq_epi8_mask(a, b);
+}
+
+// vector operator > : returns true for elements for which a > b
+static inline Vec64cb operator > (Vec64c const & a, Vec64c const & b) {
+    return _mm512_cmpgt_epi8_mask(a, b);
+}
+
+// vector operator < : returns true for elements for which a < b
+static inline Vec64cb operator < (Vec64c const & a, Vec64c const & b) {
+    return b > a;
+}
+
+// vector operator >= : returns true for elements for which a >= b (signed)
+static inline Vec64cb operator >= (Vec64c const & a, Vec64c const & b) {
+    return _mm512_cmpge_epi8_mask(a, b);
+}
+
+// vector operator <= : returns true for elements for which a <= b (signed)
+static inline Vec64cb operator <= (Vec64c const & a, Vec64c const & b) {
+    return b >= a;
+}
+
+// vector operator & : bitwise and
+static inline Vec64c operator & (Vec64c const & a, Vec64c const & b) {
+    return _mm512_and_si512(a, b);
+}
+static inline Vec64c operator && (Vec64c const & a, Vec64c const & b) {
+    return a & b;
+}
+// vector operator &= : bitwise and
+static inline Vec64c & operator &= (Vec64c & a, Vec64c const & b) {
+    a = a & b;
+    return a;
+}
+
+// vector operator | : bitwise or
+static inline Vec64c operator | (Vec64c const & a, Vec64c const & b) {
+    return _mm512_or_si512(a, b);
+}
+static inline Vec64c operator || (Vec64c const & a, Vec64c const & b) {
+    return a | b;
+}
+// vector operator |= : bitwise or
+static inline Vec64c & operator |= (Vec64c & a, Vec64c const & b) {
+    a = a | b;
+    return a;
+}
+
+// vector operator ^ : bitwise xor
+static inline Vec64c operator ^ (Vec64c const & a, Vec64c const & b) {
+    return _mm512_xor_si512(a, b);
+}
+// vector operator ^= : bitwise xor
+static inline Vec64c & operator ^= (Vec64c & a, Vec64c const & b) {
+    a = a ^ b;
+    return a;
+}
+
+// vector operator ~ : bitwise not
+static inline Vec64c operator ~ (Vec64c const & a) {
+    return Vec64c(~ Vec512b(a));
+}
+
+// vector operator ! : logical not, returns true for elements == 0
+static inline Vec64cb operator ! (Vec64c const & a) {
+    return _mm512_cmpeq_epi8_mask(a, _mm512_setzero_si512());
+}
+
+// Functions for this class
+
+// Select between two operands. Corresponds to this pseudocode:
+// for (int i = 0; i < 64; i++) result[i] = s[i] ? a[i] : b[i];
+static inline Vec64c select (Vec64cb const & s, Vec64c const & a, Vec64c const & b) {
+    return _mm512_mask_mov_epi8(b, s, a);  // conditional move may be optimized better by the compiler than blend
+}
+
+// Conditional add: For all vector elements i: result[i] = f[i] ? (a[i] + b[i]) : a[i]
+static inline Vec64c if_add (Vec64cb const & f, Vec64c const & a, Vec64c const & b) {
+    return _mm512_mask_add_epi8(a, f, a, b);
+}
+
+// Horizontal add: Calculates the sum of all vector elements.
+// Overflow will wrap around
+static inline uint32_t horizontal_add (Vec64c const & a) {
+    __m512i sum1 = _mm512_sad_epu8(a,_mm512_setzero_si512());   // sum of each 8 bytes, unsigned
+    int8_t  sum2 = (int8_t)horizontal_add(Vec8q(sum1));       // truncate to 8 bits
+    return  sum2;                                                // sign extend to 32 bits
+}
+
+// Horizontal add extended: Calculates the sum of all vector elements.
+// Each element is sign-extended before addition to avoid overflow
+static inline int32_t horizontal_add_x (Vec64c const & a) {
+    __m512i aplus = _mm512_xor_si512(a, _mm512_set1_epi8(-128)); // add 128 to all elements to make them unsigned
+    __m512i sum1  = _mm512_sad_epu8(aplus,_mm512_setzero_si512()); // sum of each 8 bytes
+    return (int32_t)horizontal_add(Vec8q(sum1)) - 64*128;      // subtract the 128 added to each element
+}
+
+// function add_saturated: add element by element, signed with saturation
+static inline Vec64c add_saturated(Vec64c const & a, Vec64c const & b) {
+    return _mm512_adds_epi8(a, b);
+}
+
+// function sub_saturated: subtract element by element, signed with saturation
+static inline Vec64c sub_saturated(Vec64c const & a, Vec64c const & b) {
+    return _mm512_subs_epi8(a, b);
+}
+
+// function max: a > b ? a : b
+static inline Vec64c max(Vec64c const & a, Vec64c const & b) {
+    return _mm512_max_epi8(a,b);
+}
+
+// function min: a < b ? a : b
+static inline Vec64c min(Vec64c const & a, Vec64c const & b) {
+    return _mm512_min_epi8(a,b);
+}
+
+// function abs: a >= 0 ? a : -a
+static inline Vec64c abs(Vec64c const & a) {
+    return _mm512_abs_epi8(a);
+}
+
+// function abs_saturated: same as abs, saturate if overflow
+static inline Vec64c abs_saturated(Vec64c const & a) {
+    return _mm512_min_epu8(abs(a), _mm512_set1_epi8(0x7F));
+}
+
+// function rotate_left all elements
+// Use negative count to rotate right
+static inline Vec64c rotate_left(Vec64c const & a, int b) {
+    __m128i bb        = _mm_cvtsi32_si128(b & 7);                // b modulo 8
+    __m128i mbb       = _mm_cvtsi32_si128((8-b) & 7);            // 8-b modulo 8
+    __m512i maskeven  = _mm512_set1_epi16(0x00FF);               // mask for even numbered bytes
+    __m512i even      = _mm512_and_si512(a,maskeven);            // even numbered bytes of a
+    __m512i odd       = _mm512_andnot_si512(maskeven,a);         // odd numbered bytes of a
+    __m512i evenleft  = _mm512_sll_epi16(even,bb);               // even bytes of a << b
+    __m512i oddleft   = _mm512_sll_epi16(odd,bb);                // odd  bytes of a << b
+    __m512i evenright = _mm512_srl_epi16(even,mbb);              // even bytes of a >> 8-b
+    __m512i oddright  = _mm512_srl_epi16(odd,mbb);               // odd  bytes of a >> 8-b
+    __m512i evenrot   = _mm512_or_si512(evenleft,evenright);     // even bytes of a rotated
+    __m512i oddrot    = _mm512_or_si512(oddleft,oddright);       // odd  bytes of a rotated
+    return _mm512_mask_mov_epi8(oddrot, 0x5555555555555555, evenrot); // all bytes rotated
+}
+
+
+/*****************************************************************************
+*
+*          Vector of 64 8-bit unsigned integers
+*
+*****************************************************************************/
+
+class Vec64uc : public Vec64c {
+public:
+    // Default constructor:
+    Vec64uc() {
+    }
+    // Constructor to broadcast the same value into all elements:
+    Vec64uc(uint32_t i) {
+        zmm = _mm512_set1_epi8((char)i);
+    }
+    // Constructor to build from all elements:
+    Vec64uc(uint8_t i0, uint8_t i1, uint8_t i2, uint8_t i3, uint8_t i4, uint8_t i5, uint8_t i6, uint8_t i7,
+        uint8_t i8, uint8_t i9, uint8_t i10, uint8_t i11, uint8_t i12, uint8_t i13, uint8_t i14, uint8_t i15,
+        uint8_t i16, uint8_t i17, uint8_t i18, uint8_t i19, uint8_t i20, uint8_t i21, uint8_t i22, uint8_t i23,
+        uint8_t i24, uint8_t i25, uint8_t i26, uint8_t i27, uint8_t i28, uint8_t i29, uint8_t i30, uint8_t i31,
+        uint8_t i32, uint8_t i33, uint8_t i34, uint8_t i35, uint8_t i36, uint8_t i37, uint8_t i38, uint8_t i39,
+        uint8_t i40, uint8_t i41, uint8_t i42, uint8_t i43, uint8_t i44, uint8_t i45, uint8_t i46, uint8_t i47,
+        uint8_t i48, uint8_t i49, uint8_t i50, uint8_t i51, uint8_t i52, uint8_t i53, uint8_t i54, uint8_t i55,
+        uint8_t i56, uint8_t i57, uint8_t i58, uint8_t i59, uint8_t i60, uint8_t i61, uint8_t i62, uint8_t i63)
+        : Vec64c(i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15,
+        i16, i17, i18, i19, i20, i21, i22, i23, i24, i25, i26, i27, i28, i29, i30, i31,
+        i32, i33, i34, i35, i36, i37, i38, i39, i40, i41, i42, i43, i44, i45, i46, i47,
+        i48, i49, i50, i51, i52, i53, i54, i55, i56, i57, i58, i59, i60, i61, i62, i63) {
+    }
+    // Constructor to build from two Vec32uc:
+    Vec64uc(Vec32uc const & a0, Vec32uc const & a1) {
+        zmm = _mm512_inserti64x4(_mm512_castsi256_si512(a0), a1, 1);
+    }
+    // Constructor to convert from type __m512i used in intrinsics:
+    Vec64uc(__m512i const & x) {
+        zmm = x;
+    }
+    // Assignment operator to convert from type __m512i used in intrinsics:
+    Vec64uc & operator = (__m512i const & x) {
+        zmm = x;
+        return *this;
+    }
+    // Member function to load from array (unaligned)
+    Vec64uc & load(void const * p) {
+        zmm = _mm512_loadu_si512(p);
+        return *this;
+    }
+    // Member function to load from array, aligned by 64
+    Vec64uc & load_a(void const * p) {
+        zmm = _mm512_load_si512(p);
+        return *this;
+    }
+    // Member function to change a single element in vector
+    Vec64uc const & insert(uint32_t index, uint8_t value) {
+        Vec64c::insert(index, value);
+        return *this;
+    }
+    // Member function extract a single element from vector
+    uint8_t extract(uint32_t index) const {
+        return Vec64c::extract(index);
+    }
+    // Extract a single element. Use store function if extracting more than one element.
+    // Operator [] can only read an element, not write.
+    uint8_t operator [] (uint32_t index) const {
+        return extract(index);
+    }
+    // Member functions to split into two Vec32uc:
+    Vec32uc get_low() const {
+        return Vec32uc(Vec64c::get_low());
+    }
+    Vec32uc get_high() const {
+        return Vec32uc(Vec64c::get_high());
+    }
+};
+
+// Define operators for this class
+
+// vector operator + : add
+static inline Vec64uc operator + (Vec64uc const & a, Vec64uc const & b) {
+    return Vec64uc (Vec64c(a) + Vec64c(b));
+}
+
+// vector operator - : subtract
+static inline Vec64uc operator - (Vec64uc const & a, Vec64uc const & b) {
+    return Vec64uc (Vec64c(a) - Vec64c(b));
+}
+
+// vector operator * : multiply
+static inline Vec64uc operator * (Vec64uc const & a, Vec64uc const & b) {
+    return Vec64uc (Vec64c(a) * Vec64c(b));
+}
+
+// vector operator >> : shift right logical all elements
+static inline Vec64uc operator >> (Vec64uc const & a, uint32_t b) {
+    uint32_t mask = (uint32_t)0xFF << (uint32_t)b;                  // mask to remove bits that are shifted out
+    __m512i am    = _mm512_and_si512(a,_mm512_set1_epi8((char)mask)); // remove bits that will overflow
+    __m512i res   = _mm512_srl_epi16(am,_mm_cvtsi32_si128(b));      // 16-bit shifts
+    return res;
+}
+
+// vector operator >> : shift right logical all elements
+static inline Vec64uc operator >> (Vec64uc const & a, int32_t b) {
+    return a >> (uint32_t)b;
+}
+
+// vector operator >>= : shift right logical
+static inline Vec64uc & operator >>= (Vec64uc & a, uint32_t b) {
+    a = a >> b;
+    return a;
+}
+
+// vector operator << : shift left all elements
+static inline Vec64uc operator << (Vec64uc const & a, uint32_t b) {
+    return Vec64uc(Vec64c(a) << (int32_t)b);
+}
+
+// vector operator << : shift left all elements
+static inline Vec64uc operator << (Vec64uc const & a, int32_t b) {
+    return Vec64uc(Vec64c(a) << b);
+}
+
+// vector operator >= : returns true for elements for which a >= b (unsigned)
+static inline Vec64cb operator >= (Vec64uc const & a, Vec64uc const & b) {
+    return _mm512_cmpge_epu8_mask(a, b);
+}
+
+// vector operator <= : returns true for elements for which a <= b (unsigned)
+static inline Vec64cb operator <= (Vec64uc const & a, Vec64uc const & b) {
+    return b >= a;
+}
+
+// vector operator > : returns true for elements for which a > b (unsigned)
+static inline Vec64cb operator > (Vec64uc const & a, Vec64uc const & b) {
+    return _mm512_cmpgt_epu8_mask(a, b);
+}
+
+// vector operator < : returns true for elements for which a < b (unsigned)
+static inline Vec64cb operator < (Vec64uc const & a, Vec64uc const & b) {
+    return b > a;
+}
+
+// vector operator & : bitwise and
+static inline Vec64uc operator & (Vec64uc const & a, Vec64uc const & b) {
+    return Vec64uc(Vec512b(a) & Vec512b(b));
+}
+static inline Vec64uc operator && (Vec64uc const & a, Vec64uc const & b) {
+    return a & b;
+}
+
+// vector operator | : bitwise or
+static inline Vec64uc operator | (Vec64uc const & a, Vec64uc const & b) {
+    return Vec64uc(Vec512b(a) | Vec512b(b));
+}
+static inline Vec64uc operator || (Vec64uc const & a, Vec64uc const & b) {
+    return a | b;
+}
+
+// vector operator ^ : bitwise xor
+static inline Vec64uc operator ^ (Vec64uc const & a, Vec64uc const & b) {
+    return Vec64uc(Vec512b(a) ^ Vec512b(b));
+}
+
+// vector operator ~ : bitwise not
+static inline Vec64uc operator ~ (Vec64uc const & a) {
+    return Vec64uc( ~ Vec512b(a));
+}
+
+// Functions for this class
+
+// Select between two operands. Corresponds to this pseudocode:
+// for (int i = 0; i < 64; i++) result[i] = s[i] ? a[i] : b[i];
+static inline Vec64uc select (Vec64cb const & s, Vec64uc const & a, Vec64uc const & b) {
+    return Vec64uc(select(s, Vec64c(a), Vec64c(b)));
+}
+
+// Conditional add: For all vector elements i: result[i] = f[i] ? (a[i] + b[i]) : a[i]
+static inline Vec64uc if_add (Vec64cb const & f, Vec64uc const & a, Vec64uc const & b) {
+    return _mm512_mask_add_epi8(a, f, a, b);
+}
+
+// Horizontal add: Calculates the sum of all vector elements.
+// Overflow will wrap around
+static inline uint32_t horizontal_add (Vec64uc const & a) {
+    __m512i sum1 = _mm512_sad_epu8(a,_mm512_setzero_si512());   // sum of each 8 bytes
+    return (uint8_t)horizontal_add(Vec8q(sum1));              // truncate to 8 bits
+}
+
+// Horizontal add extended: Calculates the sum of all vector elements.
+// Each element is zero-extended before addition to avoid overflow
+static inline uint32_t horizontal_add_x (Vec64uc const & a) {
+    __m512i sum1 = _mm512_sad_epu8(a,_mm512_setzero_si512());   // sum of each 8 bytes
+    return (uint32_t)horizontal_add(Vec8q(sum1));
+}
+
+// function add_saturated: add element by element, unsigned with saturation
+static inline Vec64uc add_saturated(Vec64uc const & a, Vec64uc const & b) {
+    return _mm512_adds_epu8(a, b);
+}
+
+// function sub_saturated: subtract element by element, unsigned with saturation
+static inline Vec64uc sub_saturated(Vec64uc const & a, Vec64uc const & b) {
+    return _mm512_subs_epu8(a, b);
+}
+
+// function max: a > b ? a : b
+static inline Vec64uc max(Vec64uc const & a, Vec64uc const & b) {
+    return _mm512_max_epu8(a,b);
+}
+
+// function min: a < b ? a : b
+static inline Vec64uc min(Vec64uc const & a, Vec64uc const & b) {
+    return _mm512_min_epu8(a,b);
+}
+
+
+/*****************************************************************************
+*
+*          Vector of 32 16-bit signed integers
+*
+*****************************************************************************/
+
+class Vec32s : public Vec512b {
+public:
+    // Default constructor:
+    Vec32s() {
+    }
+    // Constructor to broadcast the same value into all elements:
+    Vec32s(int i) {
+        zmm = _mm512_set1_epi16((int16_t)i);
+    }
+    // Constructor to build from all elements:
+    Vec32s(int16_t i0, int16_t i1, int16_t i2, int16_t i3, int16_t i4, int16_t i5, int16_t i6, int16_t i7,
+        int16_t i8, int16_t i9, int16_t i10, int16_t i11, int16_t i12, int16_t i13, int16_t i14, int16_t i15,
+        int16_t i16, int16_t i17, int16_t i18, int16_t i19, int16_t i20, int16_t i21, int16_t i22, int16_t i23,
+        int16_t i24, int16_t i25, int16_t i26, int16_t i27, int16_t i28, int16_t i29, int16_t i30, int16_t i31) {
+        zmm = Vec512b(
+            Vec16s(i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15),
+            Vec16s(i16, i17, i18, i19, i20, i21, i22, i23, i24, i25, i26, i27, i28, i29, i30, i31));
+    }
+    // Constructor to build from two Vec16s:
+    Vec32s(Vec16s const & a0, Vec16s const & a1) {
+        zmm = _mm512_inserti64x4(_mm512_castsi256_si512(a0), a1, 1);
+    }
+    // Constructor to convert from type __m512i used in intrinsics:
+    Vec32s(__m512i const & x) {
+        zmm = x;
+    }
+    // Assignment operator to convert from type __m512i used in intrinsics:
+    Vec32s & operator = (__m512i const & x) {
+        zmm = x;
+        return *this;
+    }
+    // Type cast operator to convert to __m512i used in intrinsics
+    operator __m512i() const {
+        return zmm;
+    }
+    // Member function to load from array (unaligned)
+    Vec32s & load(void const * p) {
+        zmm = _mm512_loadu_si512(p);
+        return *this;
+    }
+    // Member function to load from array, aligned by 64
+    Vec32s & load_a(void const * p) {
+        zmm = _mm512_load_si512(p);
+        return *this;
+    }
+    // Partial load. Load n elements and set the rest to 0
+    Vec32s & load_partial(int n, void const * p) {
+        zmm = _mm512_maskz_loadu_epi16(__mmask32(n >= 32 ? ~0u : n <= 0 ? 0 : (1u << n) - 1), p);
+        return *this;
+    }
+    // Partial store. Store n elements
+    void store_partial(int n, void * p) const {
+        _mm512_mask_storeu_epi16(p, __mmask32(n >= 32 ? ~0u : n <= 0 ? 0 : (1u << n) - 1), zmm);
+    }
+    // cut off vector to n elements. The last 32-n elements are set to zero
+    Vec32s & cutoff(int n) {
+        zmm = _mm512_maskz_mov_epi16(__mmask32(n >= 32 ? ~0u : n <= 0 ? 0 : (1u << n) - 1), zmm);
+        return *this;
+    }
+    // Member function to change a single element in vector
+    Vec32s const & insert(uint32_t index, int16_t value) {
+        zmm = _mm512_mask_set1_epi16(zmm, __mmask32(1u << (index & 31)), value);
+        return *this;
+    }
+    // Member function extract a single element from vector
+    int16_t extract(uint32_t index) const {
+        int16_t a[32];
+        store(a);
+        return a[index & 31];
+    }
+    // Extract a single element. Use store function if extracting more than one element.
+    // Operator [] can only read an element, not write.
+    int16_t operator [] (uint32_t index) const {
+        return extract(index);
+    }
+    // Member functions to split into two Vec16s:
+    Vec16s get_low() const {
+        return _mm512_castsi512_si256(zmm);
+    }
+    Vec16s get_high() const {
+        return _mm512_extracti64x4_epi64(zmm,1);
+    }
+    static int size () {
+        return 32;
+    }
+};
+
+
+// Define operators for Vec32s
+
+// vector operator + : add element by element
+static inline Vec32s operator + (Vec32s const & a, Vec32s const & b) {
+    return _mm512_add_epi16(a, b);
+}
+
+// vector operator += : add
+static inline Vec32s & operator += (Vec32s & a, Vec32s const & b) {
+    a = a + b;
+    return a;
+}
+
+// postfix operator ++
+static inline Vec32s operator ++ (Vec32s & a, int) {
+    Vec32s a0 = a;
+    a = a + 1;
+    return a0;
+}
+
+// prefix operator ++
+static inline Vec32s & operator ++ (Vec32s & a) {
+    a = a + 1;
+    return a;
+}
+
+// vector operator - : subtract element by element
+static inline Vec32s operator - (Vec32s const & a, Vec32s const & b) {
+    return _mm512_sub_epi16(a, b);
+}
+
+// vector operator - : unary minus
+static inline Vec32s operator - (Vec32s const & a) {
+    return _mm512_sub_epi16(_mm512_setzero_si512(), a);
+}
+
+// vector operator -= : subtract
+static inline Vec32s & operator -= (Vec32s & a, Vec32s const & b) {
+    a = a - b;
+    return a;
+}
+
+// postfix operator --
+static inline Vec32s operator -- (Vec32s & a, int) {
+    Vec32s a0 = a;
+    a = a - 1;
+    return a0;
+}
+
+// prefix operator --
+static inline Vec32s & operator -- (Vec32s & a) {
+    a = a - 1;
+    return a;
+}
+
+// vector operator * : multiply element by element
+static inline Vec32s operator * (Vec32s const & a, Vec32s const & b) {
+    return _mm512_mullo_epi16(a, b);
+}
+
+// vector operator *= : multiply
+static inline Vec32s & operator *= (Vec32s & a, Vec32s const & b) {
+    a = a * b;
+    return a;
+}
+
+// vector operator << : shift left
+static inline Vec32s operator << (Vec32s const & a, int b) {
+    return _mm512_sll_epi16(a,_mm_cvtsi32_si128(b));
+}
+
+// vector operator <<= : shift left
+static inline Vec32s & operator <<= (Vec32s & a, int b) {
+    a = a << b;
+    return a;
+}
+
+// vector operator >> : shift right arithmetic
+static inline Vec32s operator >> (Vec32s const & a, int b) {
+    return _mm512_sra_epi16(a,_mm_cvtsi32_si128(b));
+}
+
+// vector operator >>= : shift right arithmetic
+static inline Vec32s & operator >>= (Vec32s & a, int b) {
+    a = a >> b;
+    return a;
+}
+
+// vector operator == : returns true for elements for which a == b
+static inline Vec32sb operator == (Vec32s const & a, Vec32s const & b) {
+    return _mm512_cmpeq_epi16_mask(a, b);
+}
+
+// vector operator != : returns true for elements for which a != b
+static inline Vec32sb operator != (Vec32s const & a, Vec32s const & b) {
+    return _mm512_cmpneq_epi16_mask(a, b);
+}
+
+// vector operator > : returns true for elements for which a > b
+static inline Vec32sb operator > (Vec32s const & a, Vec32s const & b) {
+    return _mm512_cmpgt_epi16_mask(a, b);
+}
+
+// vector operator < : returns true for elements for which a < b
+static inline Vec32sb operator < (Vec32s const & a, Vec32s const & b) {
+    return b > a;
+}
+
+// vector operator >= : returns true for elements for which a >= b (signed)
+static inline Vec32sb operator >= (Vec32s const & a, Vec32s const & b) {
+    return _mm512_cmpge_epi16_mask(a, b);
+}
+
+// vector operator <= : returns true for elements for which a <= b (signed)
+static inline Vec32sb operator <= (Vec32s const & a, Vec32s const & b) {
+    return b >= a;
+}
+
+// vector operator & : bitwise and
+static inline Vec32s operator & (Vec32s const & a, Vec32s const & b) {
+    return _mm512_and_si512(a, b);
+}
+static inline Vec32s operator && (Vec32s const & a, Vec32s const & b) {
+    return a & b;
+}
+// vector operator &= : bitwise and
+static inline Vec32s & operator &= (Vec32s & a, Vec32s const & b) {
+    a = a & b;
+    return a;
+}
+
+// vector operator | : bitwise or
+static inline Vec32s operator | (Vec32s const & a, Vec32s const & b) {
+    return _mm512_or_si512(a, b);
+}
+static inline Vec32s operator || (Vec32s const & a, Vec32s const & b) {
+    return a | b;
+}
+// vector operator |= : bitwise or
+static inline Vec32s & operator |= (Vec32s & a, Vec32s const & b) {
+    a = a | b;
+    return a;
+}
+
+// vector operator ^ : bitwise xor
+static inline Vec32s operator ^ (Vec32s const & a, Vec32s const & b) {
+    return _mm512_xor_si512(a, b);
+}
+// vector operator ^= : bitwise xor
+static inline Vec32s & operator ^= (Vec32s & a, Vec32s const & b) {
+    a = a ^ b;
+    return a;
+}
+
+// vector operator ~ : bitwise not
+static inline Vec32s operator ~ (Vec32s const & a) {
+    return Vec32s(~ Vec512b(a));
+}
+
+// vector operator ! : logical not, returns true for elements == 0
+static inline Vec32sb operator ! (Vec32s const & a) {
+    return _mm512_cmpeq_epi16_mask(a, _mm512_setzero_si512());
+}
+
+// Functions for this class
+
+// Select between two operands. Corresponds to this pseudocode:
+// for (int i = 0; i < 32; i++) result[i] = s[i] ? a[i] : b[i];
+static inline Vec32s select (Vec32sb const & s, Vec32s const & a, Vec32s const & b) {
+    return _mm512_mask_mov_epi16(b, s, a);  // conditional move may be optimized better by the compiler than blend
+}
+
+// Conditional add: For all vector elements i: result[i] = f[i] ? (a[i] + b[i]) : a[i]
+static inline Vec32s if_add (Vec32sb const & f, Vec32s const & a, Vec32s const & b) {
+    return _mm512_mask_add_epi16(a, f, a, b);
+}
+
+// Horizontal add extended: Calculates the sum of all vector elements.
+// Elements are sign extended before adding to avoid overflow
+static inline int32_t horizontal_add_x (Vec32s const & a) {
+    __m512i sum1 = _mm512_madd_epi16(a, _mm512_set1_epi16(1));  // add pairs of elements, sign extended to 32 bits
+    return horizontal_add(Vec16i(sum1));
+}
+
+// Horizontal add: Calculates the sum of all vector elements.
+// Overflow will wrap around
+static inline int32_t horizontal_add (Vec32s const & a) {
+    return (int16_t)horizontal_add_x(a);                         // truncate to 16 bits and sign extend
+}
+
+// function add_saturated: add element by element, signed with saturation
+static inline Vec32s add_saturated(Vec32s const & a, Vec32s const & b) {
+    return _mm512_adds_epi16(a, b);
+}
+
+// function sub_saturated: subtract element by element, signed with saturation
+static inline Vec32s sub_saturated(Vec32s const & a, Vec32s const & b) {
+    return _mm512_subs_epi16(a, b);
+}
+
+// function max: a > b ? a : b
+static inline Vec32s max(Vec32s const & a, Vec32s const & b) {
+    return _mm512_max_epi16(a,b);
+}
+
+// function min: a < b ? a : b
+static inline Vec32s min(Vec32s const & a, Vec32s const & b) {
+    return _mm512_min_epi16(a,b);
+}
+
+// function abs: a >= 0 ? a : -a
+static inline Vec32s abs(Vec32s const & a) {
+    return _mm512_abs_epi16(a);
+}
+
+// function abs_saturated: same as abs, saturate if overflow
+static inline Vec32s abs_saturated(Vec32s const & a) {
+    return _mm512_min_epu16(abs(a), _mm512_set1_epi16(0x7FFF));
+}
+
+// function rotate_left all elements
+// Use negative count to rotate right
+static inline Vec32s rotate_left(Vec32s const & a, int b) {
+    __m512i left  = _mm512_sll_epi16(a,_mm_cvtsi32_si128(b & 0xF));      // a << b
+    __m512i right = _mm512_srl_epi16(a,_mm_cvtsi32_si128((16-b) & 0xF)); // a >> (16 - b)
+    __m512i rot   = _mm512_or_si512(left,right);                         // or
+    return  rot;
+}
+
+
+/*****************************************************************************
+*
+*          Vector of 32 16-bit unsigned integers
+*
+*****************************************************************************/
+
+class Vec32us : public Vec32s {
+public:
+    // Default constructor:
+    Vec32us() {
+    }
+    // Constructor to broadcast the same value into all elements:
+    Vec32us(uint32_t i) {
+        zmm = _mm512_set1_epi16((int16_t)i);
+    }
+    // Constructor to build from all elements:
+    Vec32us(uint16_t i0, uint16_t i1, uint16_t i2, uint16_t i3, uint16_t i4, uint16_t i5, uint16_t i6, uint16_t i7,
+        uint16_t i8, uint16_t i9, uint16_t i10, uint16_t i11, uint16_t i12, uint16_t i13, uint16_t i14, uint16_t i15,
+        uint16_t i16, uint16_t i17, uint16_t i18, uint16_t i19, uint16_t i20, uint16_t i21, uint16_t i22, uint16_t i23,
+        uint16_t i24, uint16_t i25, uint16_t i26, uint16_t i27, uint16_t i28, uint16_t i29, uint16_t i30, uint16_t i31)
+        : Vec32s(i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15,
+        i16, i17, i18, i19, i20, i21, i22, i23, i24, i25, i26, i27, i28, i29, i30, i31) {
+    }
+    // Constructor to build from two Vec16us:
+    Vec32us(Vec16us const & a0, Vec16us const & a1) {
+        zmm = _mm512_inserti64x4(_mm512_castsi256_si512(a0), a1, 1);
+    }
+    // Constructor to convert from type __m512i used in intrinsics:
+    Vec32us(__m512i const & x) {
+        zmm = x;
+    }
+    // Assignment operator to convert from type __m512i used in intrinsics:
+    Vec32us & operator = (__m512i const & x) {
+        zmm = x;
+        return *this;
+    }
+    // Member function to load from array (unaligned)
+    Vec32us & load(void const * p) {
+        zmm = _mm512_loadu_si512(p);
+        return *this;
+    }
+    // Member function to load from array, aligned by 64
+    Vec32us & load_a(void const * p) {
+        zmm = _mm512_load_si512(p);
+        return *this;
+    }
+    // Member function to change a single element in vector
+    Vec32us const & insert(uint32_t index, uint16_t value) {
+        Vec32s::insert(index, value);
+        return *this;
+    }
+    // Member function extract a single element from vector
+    uint16_t extract(uint32_t index) const {
+        return Vec32s::extract(index);
+    }
+    // Extract a single element. Use store function if extracting more than one element.
+    // Operator [] can only read an element, not write.
+    uint16_t operator [] (uint32_t index) const {
+        return extract(index);
+    }
+    // Member functions to split into two Vec16us:
+    Vec16us get_low() const {
+        return Vec16us(Vec32s::get_low());
+    }
+    Vec16us get_high() const {
+        return Vec16us(Vec32s::get_high());
+    }
+};
+
+// Define operators for this class
+
+// vector operator + : add
+static inline Vec32us operator + (Vec32us const & a, Vec32us const & b) {
+    return Vec32us (Vec32s(a) + Vec32s(b));
+}
+
+// vector operator - : subtract
+static inline Vec32us operator - (Vec32us const & a, Vec32us const & b) {
+    return Vec32us (Vec32s(a) - Vec32s(b));
+}
+
+// vector operator * : multiply
+static inline Vec32us operator * (Vec32us const & a, Vec32us const & b) {
+    return Vec32us (Vec32s(a) * Vec32s(b));
+}
+
+// vector operator >> : shift right logical all elements
+static inline Vec32us operator >> (Vec32us const & a, uint32_t b) {
+    return _mm512_srl_epi16(a,_mm_cvtsi32_si128(b));
+}
+
+// vector operator >> : shift right logical all elements
+static inline Vec32us operator >> (Vec32us const & a, int32_t b) {
+    return a >> (uint32_t)b;
+}
+
+// vector operator >>= : shift right logical
+static inline Vec32us & operator >>= (Vec32us & a, uint32_t b) {
+    a = a >> b;
+    return a;
+}
+
+// vector operator << : shift left all elements
+static inline Vec32us operator << (Vec32us const & a, uint32_t b) {
+    return _mm512_sll_epi16(a,_mm_cvtsi32_si128(b));
+}
+
+// vector operator << : shift left all elements
+static inline Vec32us operator << (Vec32us const & a, int32_t b) {
+    return a << (uint32_t)b;
+}
+
+// vector operator >= : returns true for elements for which a >= b (unsigned)
+static inline Vec32sb operator >= (Vec32us const & a, Vec32us const & b) {
+    return _mm512_cmpge_epu16_mask(a, b);
+}
+
+// vector operator <= : returns true for elements for which a <= b (unsigned)
+static inline Vec32sb operator <= (Vec32us const & a, Vec32us const & b) {
+    return b >= a;
+}
+
+// vector operator > : returns true for elements for which a > b (unsigned)
+static inline Vec32sb operator > (Vec32us const & a, Vec32us const & b) {
+    return _mm512_cmpgt_epu16_mask(a, b);
+}
+
+// vector operator < : returns true for elements for which a < b (unsigned)
+static inline Vec32sb operator < (Vec32us const & a, Vec32us const & b) {
+    return b > a;
+}
+
+// vector operator & : bitwise and
+static inline Vec32us operator & (Vec32us const & a, Vec32us const & b) {
+    return Vec32us(Vec512b(a) & Vec512b(b));
+}
+static inline Vec32us operator && (Vec32us const & a, Vec32us const & b) {
+    return a & b;
+}
+
+// vector operator | : bitwise or
+static inline Vec32us operator | (Vec32us const & a, Vec32us const & b) {
+    return Vec32us(Vec512b(a) | Vec512b(b));
+}
+static inline Vec32us operator || (Vec32us const & a, Vec32us const & b) {
+    return a | b;
+}
+
+// vector operator ^ : bitwise xor
+static inline Vec32us operator ^ (Vec32us const & a, Vec32us const & b) {
+    return Vec32us(Vec512b(a) ^ Vec512b(b));
+}
+
+// vector operator ~ : bitwise not
+static inline Vec32us operator ~ (Vec32us const & a) {
+    return Vec32us( ~ Vec512b(a));
+}
+
+// Functions for this class
+
+// Select between two operands. Corresponds to this pseudocode:
+// for (int i = 0; i < 32; i++) result[i] = s[i] ? a[i] : b[i];
+static inline Vec32us select (Vec32sb const & s, Vec32us const & a, Vec32us const & b) {
+    return Vec32us(select(s, Vec32s(a), Vec32s(b)));
+}
+
+// Conditional add: For all vector elements i: result[i] = f[i] ? (a[i] + b[i]) : a[i]
+static inline Vec32us if_add (Vec32sb const & f, Vec32us const & a, Vec32us const & b) {
+    return _mm512_mask_add_epi16(a, f, a, b);
+}
+
+// Horizontal add extended: Calculates the sum of all vector elements.
+// Each element is zero-extended before addition to avoid overflow
+static inline uint32_t horizontal_add_x (Vec32us const & a) {
+    __m512i even = _mm512_and_si512(a, _mm512_set1_epi32(0x0000FFFF)); // even numbered elements, zero extended
+    __m512i odd  = _mm512_srli_epi32(a, 16);                           // odd numbered elements, zero extended
+    return (uint32_t)horizontal_add(Vec16i(_mm512_add_epi32(even, odd)));
+}
+
+// Horizontal add: Calculates the sum of all vector elements.
+// Overflow will wrap around
+static inline uint32_t horizontal_add (Vec32us const & a) {
+    return (uint16_t)horizontal_add_x(a);                        // truncate to 16 bits
+}
+
+// function add_saturated: add element by element, unsigned with saturation
+static inline Vec32us add_saturated(Vec32us const & a, Vec32us const & b) {
+    return _mm512_adds_epu16(a, b);
+}
+
+// function sub_saturated: subtract element by element, unsigned with saturation
+static inline Vec32us sub_saturated(Vec32us const & a, Vec32us const & b) {
+    return _mm512_subs_epu16(a, b);
+}
+
+// function max: a > b ? a : b
+static inline Vec32us max(Vec32us const & a, Vec32us const & b) {
+    return _mm512_max_epu16(a,b);
+}
+
+// function min: a < b ? a : b
+static inline Vec32us min(Vec32us const & a, Vec32us const & b) {
+    return _mm512_min_epu16(a,b);
+}
+
+
+/*****************************************************************************
+*
+*          Vector permute functions
+*
+******************************************************************************
+*
+* These permute functions can reorder the elements of a vector and optionally
+* set some elements to zero.
+*
+* The indexes are inserted as template parameters in <>. These indexes must be
+* constants. Each template parameter is an index to the element you want to
+* select. An index of -1 will generate zero.
+*
+* permute32s uses one VPERMW instruction. permute64c uses one VPSHUFB
+* instruction if no element crosses a 128-bit lane, otherwise the byte
+* lookup below.
+*
+*****************************************************************************/
+
+// Permute vector of 32 16-bit integers.
+// Index -1 gives 0
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7, int i8, int i9, int i10, int i11, int i12, int i13, int i14, int i15,
+    int i16, int i17, int i18, int i19, int i20, int i21, int i22, int i23, int i24, int i25, int i26, int i27, int i28, int i29, int i30, int i31>
+static inline Vec32s permute32s(Vec32s const & a) {
+    // mask for elements not zeroed
+    const __mmask32 z = __mmask32(
+        (uint32_t)(i0>=0)<<0 | (uint32_t)(i1>=0)<<1 | (uint32_t)(i2>=0)<<2 | (uint32_t)(i3>=0)<<3 |
+        (uint32_t)(i4>=0)<<4 | (uint32_t)(i5>=0)<<5 | (uint32_t)(i6>=0)<<6 | (uint32_t)(i7>=0)<<7 |
+        (uint32_t)(i8>=0)<<8 | (uint32_t)(i9>=0)<<9 | (uint32_t)(i10>=0)<<10 | (uint32_t)(i11>=0)<<11 |
+        (uint32_t)(i12>=0)<<12 | (uint32_t)(i13>=0)<<13 | (uint32_t)(i14>=0)<<14 | (uint32_t)(i15>=0)<<15 |
+        (uint32_t)(i16>=0)<<16 | (uint32_t)(i17>=0)<<17 | (uint32_t)(i18>=0)<<18 | (uint32_t)(i19>=0)<<19 |
+        (uint32_t)(i20>=0)<<20 | (uint32_t)(i21>=0)<<21 | (uint32_t)(i22>=0)<<22 | (uint32_t)(i23>=0)<<23 |
+        (uint32_t)(i24>=0)<<24 | (uint32_t)(i25>=0)<<25 | (uint32_t)(i26>=0)<<26 | (uint32_t)(i27>=0)<<27 |
+        (uint32_t)(i28>=0)<<28 | (uint32_t)(i29>=0)<<29 | (uint32_t)(i30>=0)<<30 | (uint32_t)(i31>=0)<<31);
+
+    // no shuffling, only zeroing
+    const bool noperm =
+        (i0<0||i0==0) && (i1<0||i1==1) && (i2<0||i2==2) && (i3<0||i3==3) && (i4<0||i4==4) && (i5<0||i5==5) && (i6<0||i6==6) && (i7<0||i7==7) &&
+        (i8<0||i8==8) && (i9<0||i9==9) && (i10<0||i10==10) && (i11<0||i11==11) && (i12<0||i12==12) && (i13<0||i13==13) && (i14<0||i14==14) && (i15<0||i15==15) &&
+        (i16<0||i16==16) && (i17<0||i17==17) && (i18<0||i18==18) && (i19<0||i19==19) && (i20<0||i20==20) && (i21<0||i21==21) && (i22<0||i22==22) && (i23<0||i23==23) &&
+        (i24<0||i24==24) && (i25<0||i25==25) && (i26<0||i26==26) && (i27<0||i27==27) && (i28<0||i28==28) && (i29<0||i29==29) && (i30<0||i30==30) && (i31<0||i31==31);
+
+    // special case: all zero
+    if (z == 0) return _mm512_setzero_si512();
+
+    if (noperm) {
+        if (z == 0xFFFFFFFF) return a;            // do nothing
+        return _mm512_maskz_mov_epi16(z, a);      // zero some elements
+    }
+
+    // full permute
+    static const union {
+        int16_t i[32];
+        __m512i zmm;
+    } u = {{
+        i0&31, i1&31, i2&31, i3&31, i4&31, i5&31, i6&31, i7&31, i8&31, i9&31, i10&31, i11&31, i12&31, i13&31, i14&31, i15&31,
+        i16&31, i17&31, i18&31, i19&31, i20&31, i21&31, i22&31, i23&31, i24&31, i25&31, i26&31, i27&31, i28&31, i29&31, i30&31, i31&31 }};
+    if (z == 0xFFFFFFFF) return _mm512_permutexvar_epi16(u.zmm, a);
+    return _mm512_maskz_permutexvar_epi16(z, u.zmm, a);
+}
+
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7, int i8, int i9, int i10, int i11, int i12, int i13, int i14, int i15,
+    int i16, int i17, int i18, int i19, int i20, int i21, int i22, int i23, int i24, int i25, int i26, int i27, int i28, int i29, int i30, int i31>
+static inline Vec32us permute32us(Vec32us const & a) {
+    return Vec32us (permute32s <
+        i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15,
+        i16, i17, i18, i19, i20, i21, i22, i23, i24, i25, i26, i27, i28, i29, i30, i31> (a));
+}
+
+// lookup64 is defined below
+static inline Vec64c lookup64(Vec64c const & index, Vec64c const & table);
+
+// Permute vector of 64 8-bit integers.
+// Index -1 gives 0
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7, int i8, int i9, int i10, int i11, int i12, int i13, int i14, int i15,
+    int i16, int i17, int i18, int i19, int i20, int i21, int i22, int i23, int i24, int i25, int i26, int i27, int i28, int i29, int i30, int i31,
+    int i32, int i33, int i34, int i35, int i36, int i37, int i38, int i39, int i40, int i41, int i42, int i43, int i44, int i45, int i46, int i47,
+    int i48, int i49, int i50, int i51, int i52, int i53, int i54, int i55, int i56, int i57, int i58, int i59, int i60, int i61, int i62, int i63>
+static inline Vec64c permute64c(Vec64c const & a) {
+    // mask for elements not zeroed
+    const __mmask64 z = __mmask64(
+        (uint64_t)(i0>=0)<<0 | (uint64_t)(i1>=0)<<1 | (uint64_t)(i2>=0)<<2 | (uint64_t)(i3>=0)<<3 |
+        (uint64_t)(i4>=0)<<4 | (uint64_t)(i5>=0)<<5 | (uint64_t)(i6>=0)<<6 | (uint64_t)(i7>=0)<<7 |
+        (uint64_t)(i8>=0)<<8 | (uint64_t)(i9>=0)<<9 | (uint64_t)(i10>=0)<<10 | (uint64_t)(i11>=0)<<11 |
+        (uint64_t)(i12>=0)<<12 | (uint64_t)(i13>=0)<<13 | (uint64_t)(i14>=0)<<14 | (uint64_t)(i15>=0)<<15 |
+        (uint64_t)(i16>=0)<<16 | (uint64_t)(i17>=0)<<17 | (uint64_t)(i18>=0)<<18 | (uint64_t)(i19>=0)<<19 |
+        (uint64_t)(i20>=0)<<20 | (uint64_t)(i21>=0)<<21 | (uint64_t)(i22>=0)<<22 | (uint64_t)(i23>=0)<<23 |
+        (uint64_t)(i24>=0)<<24 | (uint64_t)(i25>=0)<<25 | (uint64_t)(i26>=0)<<26 | (uint64_t)(i27>=0)<<27 |
+        (uint64_t)(i28>=0)<<28 | (uint64_t)(i29>=0)<<29 | (uint64_t)(i30>=0)<<30 | (uint64_t)(i31>=0)<<31 |
+        (uint64_t)(i32>=0)<<32 | (uint64_t)(i33>=0)<<33 | (uint64_t)(i34>=0)<<34 | (uint64_t)(i35>=0)<<35 |
+        (uint64_t)(i36>=0)<<36 | (uint64_t)(i37>=0)<<37 | (uint64_t)(i38>=0)<<38 | (uint64_t)(i39>=0)<<39 |
+        (uint64_t)(i40>=0)<<40 | (uint64_t)(i41>=0)<<41 | (uint64_t)(i42>=0)<<42 | (uint64_t)(i43>=0)<<43 |
+        (uint64_t)(i44>=0)<<44 | (uint64_t)(i45>=0)<<45 | (uint64_t)(i46>=0)<<46 | (uint64_t)(i47>=0)<<47 |
+        (uint64_t)(i48>=0)<<48 | (uint64_t)(i49>=0)<<49 | (uint64_t)(i50>=0)<<50 | (uint64_t)(i51>=0)<<51 |
+        (uint64_t)(i52>=0)<<52 | (uint64_t)(i53>=0)<<53 | (uint64_t)(i54>=0)<<54 | (uint64_t)(i55>=0)<<55 |
+        (uint64_t)(i56>=0)<<56 | (uint64_t)(i57>=0)<<57 | (uint64_t)(i58>=0)<<58 | (uint64_t)(i59>=0)<<59 |
+        (uint64_t)(i60>=0)<<60 | (uint64_t)(i61>=0)<<61 | (uint64_t)(i62>=0)<<62 | (uint64_t)(i63>=0)<<63);
+
+    // no shuffling, only zeroing
+    const bool noperm =
+        (i0<0||i0==0) && (i1<0||i1==1) && (i2<0||i2==2) && (i3<0||i3==3) && (i4<0||i4==4) && (i5<0||i5==5) && (i6<0||i6==6) && (i7<0||i7==7) &&
+        (i8<0||i8==8) && (i9<0||i9==9) && (i10<0||i10==10) && (i11<0||i11==11) && (i12<0||i12==12) && (i13<0||i13==13) && (i14<0||i14==14) && (i15<0||i15==15) &&
+        (i16<0||i16==16) && (i17<0||i17==17) && (i18<0||i18==18) && (i19<0||i19==19) && (i20<0||i20==20) && (i21<0||i21==21) && (i22<0||i22==22) && (i23<0||i23==23) &&
+        (i24<0||i24==24) && (i25<0||i25==25) && (i26<0||i26==26) && (i27<0||i27==27) && (i28<0||i28==28) && (i29<0||i29==29) && (i30<0||i30==30) && (i31<0||i31==31) &&
+        (i32<0||i32==32) && (i33<0||i33==33) && (i34<0||i34==34) && (i35<0||i35==35) && (i36<0||i36==36) && (i37<0||i37==37) && (i38<0||i38==38) && (i39<0||i39==39) &&
+        (i40<0||i40==40) && (i41<0||i41==41) && (i42<0||i42==42) && (i43<0||i43==43) && (i44<0||i44==44) && (i45<0||i45==45) && (i46<0||i46==46) && (i47<0||i47==47) &&
+        (i48<0||i48==48) && (i49<0||i49==49) && (i50<0||i50==50) && (i51<0||i51==51) && (i52<0||i52==52) && (i53<0||i53==53) && (i54<0||i54==54) && (i55<0||i55==55) &&
+        (i56<0||i56==56) && (i57<0||i57==57) && (i58<0||i58==58) && (i59<0||i59==59) && (i60<0||i60==60) && (i61<0||i61==61) && (i62<0||i62==62) && (i63<0||i63==63);
+
+    // no exchange of data between the four 128-bit lanes
+    const bool inlane =
+        (i0<0||(i0&~15)==0) && (i1<0||(i1&~15)==0) && (i2<0||(i2&~15)==0) && (i3<0||(i3&~15)==0) &&
+        (i4<0||(i4&~15)==0) && (i5<0||(i5&~15)==0) && (i6<0||(i6&~15)==0) && (i7<0||(i7&~15)==0) &&
+        (i8<0||(i8&~15)==0) && (i9<0||(i9&~15)==0) && (i10<0||(i10&~15)==0) && (i11<0||(i11&~15)==0) &&
+        (i12<0||(i12&~15)==0) && (i13<0||(i13&~15)==0) && (i14<0||(i14&~15)==0) && (i15<0||(i15&~15)==0) &&
+        (i16<0||(i16&~15)==16) && (i17<0||(i17&~15)==16) && (i18<0||(i18&~15)==16) && (i19<0||(i19&~15)==16) &&
+        (i20<0||(i20&~15)==16) && (i21<0||(i21&~15)==16) && (i22<0||(i22&~15)==16) && (i23<0||(i23&~15)==16) &&
+        (i24<0||(i24&~15)==16) && (i25<0||(i25&~15)==16) && (i26<0||(i26&~15)==16) && (i27<0||(i27&~15)==16) &&
+        (i28<0||(i28&~15)==16) && (i29<0||(i29&~15)==16) && (i30<0||(i30&~15)==16) && (i31<0||(i31&~15)==16) &&
+        (i32<0||(i32&~15)==32) && (i33<0||(i33&~15)==32) && (i34<0||(i34&~15)==32) && (i35<0||(i35&~15)==32) &&
+        (i36<0||(i36&~15)==32) && (i37<0||(i37&~15)==32) && (i38<0||(i38&~15)==32) && (i39<0||(i39&~15)==32) &&
+        (i40<0||(i40&~15)==32) && (i41<0||(i41&~15)==32) && (i42<0||(i42&~15)==32) && (i43<0||(i43&~15)==32) &&
+        (i44<0||(i44&~15)==32) && (i45<0||(i45&~15)==32) && (i46<0||(i46&~15)==32) && (i47<0||(i47&~15)==32) &&
+        (i48<0||(i48&~15)==48) && (i49<0||(i49&~15)==48) && (i50<0||(i50&~15)==48) && (i51<0||(i51&~15)==48) &&
+        (i52<0||(i52&~15)==48) && (i53<0||(i53&~15)==48) && (i54<0||(i54&~15)==48) && (i55<0||(i55&~15)==48) &&
+        (i56<0||(i56&~15)==48) && (i57<0||(i57&~15)==48) && (i58<0||(i58&~15)==48) && (i59<0||(i59&~15)==48) &&
+        (i60<0||(i60&~15)==48) && (i61<0||(i61&~15)==48) && (i62<0||(i62&~15)==48) && (i63<0||(i63&~15)==48);
+
+    // special case: all zero
+    if (z == 0) return _mm512_setzero_si512();
+
+    if (noperm) {
+        if (z == 0xFFFFFFFFFFFFFFFFULL) return a; // do nothing
+        return _mm512_maskz_mov_epi8(z, a);       // zero some elements
+    }
+
+    if (inlane) {
+        // permute within lanes. Index -1 gives zero
+        static const union {
+            int8_t i[64];
+            __m512i zmm;
+        } u = {{
+        i0<0?-1:i0&15, i1<0?-1:i1&15, i2<0?-1:i2&15, i3<0?-1:i3&15, i4<0?-1:i4&15, i5<0?-1:i5&15, i6<0?-1:i6&15, i7<0?-1:i7&15,
+        i8<0?-1:i8&15, i9<0?-1:i9&15, i10<0?-1:i10&15, i11<0?-1:i11&15, i12<0?-1:i12&15, i13<0?-1:i13&15, i14<0?-1:i14&15, i15<0?-1:i15&15,
+        i16<0?-1:i16&15, i17<0?-1:i17&15, i18<0?-1:i18&15, i19<0?-1:i19&15, i20<0?-1:i20&15, i21<0?-1:i21&15, i22<0?-1:i22&15, i23<0?-1:i23&15,
+        i24<0?-1:i24&15, i25<0?-1:i25&15, i26<0?-1:i26&15, i27<0?-1:i27&15, i28<0?-1:i28&15, i29<0?-1:i29&15, i30<0?-1:i30&15, i31<0?-1:i31&15,
+        i32<0?-1:i32&15, i33<0?-1:i33&15, i34<0?-1:i34&15, i35<0?-1:i35&15, i36<0?-1:i36&15, i37<0?-1:i37&15, i38<0?-1:i38&15, i39<0?-1:i39&15,
+        i40<0?-1:i40&15, i41<0?-1:i41&15, i42<0?-1:i42&15, i43<0?-1:i43&15, i44<0?-1:i44&15, i45<0?-1:i45&15, i46<0?-1:i46&15, i47<0?-1:i47&15,
+        i48<0?-1:i48&15, i49<0?-1:i49&15, i50<0?-1:i50&15, i51<0?-1:i51&15, i52<0?-1:i52&15, i53<0?-1:i53&15, i54<0?-1:i54&15, i55<0?-1:i55&15,
+        i56<0?-1:i56&15, i57<0?-1:i57&15, i58<0?-1:i58&15, i59<0?-1:i59&15, i60<0?-1:i60&15, i61<0?-1:i61&15, i62<0?-1:i62&15, i63<0?-1:i63&15 }};
+        return _mm512_shuffle_epi8(a, u.zmm);
+    }
+
+    // full permute
+    static const union {
+        int8_t i[64];
+        __m512i zmm;
+    } u = {{
+        i0&63, i1&63, i2&63, i3&63, i4&63, i5&63, i6&63, i7&63, i8&63, i9&63, i10&63, i11&63, i12&63, i13&63, i14&63, i15&63,
+        i16&63, i17&63, i18&63, i19&63, i20&63, i21&63, i22&63, i23&63, i24&63, i25&63, i26&63, i27&63, i28&63, i29&63, i30&63, i31&63,
+        i32&63, i33&63, i34&63, i35&63, i36&63, i37&63, i38&63, i39&63, i40&63, i41&63, i42&63, i43&63, i44&63, i45&63, i46&63, i47&63,
+        i48&63, i49&63, i50&63, i51&63, i52&63, i53&63, i54&63, i55&63, i56&63, i57&63, i58&63, i59&63, i60&63, i61&63, i62&63, i63&63 }};
+    if (z == 0xFFFFFFFFFFFFFFFFULL) return lookup64(u.zmm, a);
+    return _mm512_maskz_mov_epi8(z, lookup64(u.zmm, a));
+}
+
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7, int i8, int i9, int i10, int i11, int i12, int i13, int i14, int i15,
+    int i16, int i17, int i18, int i19, int i20, int i21, int i22, int i23, int i24, int i25, int i26, int i27, int i28, int i29, int i30, int i31,
+    int i32, int i33, int i34, int i35, int i36, int i37, int i38, int i39, int i40, int i41, int i42, int i43, int i44, int i45, int i46, int i47,
+    int i48, int i49, int i50, int i51, int i52, int i53, int i54, int i55, int i56, int i57, int i58, int i59, int i60, int i61, int i62, int i63>
+static inline Vec64uc permute64uc(Vec64uc const & a) {
+    return Vec64uc (permute64c <
+        i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15,
+        i16, i17, i18, i19, i20, i21, i22, i23, i24, i25, i26, i27, i28, i29, i30, i31,
+        i32, i33, i34, i35, i36, i37, i38, i39, i40, i41, i42, i43, i44, i45, i46, i47,
+        i48, i49, i50, i51, i52, i53, i54, i55, i56, i57, i58, i59, i60, i61, i62, i63> (a));
+}
+
+
+/*****************************************************************************
+*
+*          Vector lookup functions
+*
+******************************************************************************
+*
+* These functions use vector elements as indexes into a table.
+* The table is given as one or more vectors or as an array.
+*
+* An index out of range may produce any value - the actual value produced is
+* implementation dependent and may be different for different instruction
+* sets. An index out of range does not produce an error message or exception.
+*
+* The template function lookup<n> limits the index to the table size,
+* and it does not read beyond the end of the table.
+*
+*****************************************************************************/
+
+static inline Vec64c lookup64(Vec64c const & index, Vec64c const & table) {
+    // There is no byte permute instruction in AVX512BW.
+    // Permute 16-bit words and then pick the right byte from each word
+    __m512i ieven = _mm512_srli_epi16(_mm512_slli_epi16(index, 8), 9); // word index for even numbered elements
+    __m512i iodd  = _mm512_srli_epi16(index, 9);                       // word index for odd numbered elements
+    __m512i teven = _mm512_permutexvar_epi16(ieven, table);            // words containing even numbered elements
+    __m512i todd  = _mm512_permutexvar_epi16(iodd,  table);            // words containing odd numbered elements
+    // byte position within 128-bit lane: 2*(element number / 2) + (index & 1)
+    __m512i bpos  = _mm512_or_si512(_mm512_and_si512(index, _mm512_set1_epi8(1)),
+        constant16i<0x02020000,0x06060404,0x0A0A0808,0x0E0E0C0C,0x02020000,0x06060404,0x0A0A0808,0x0E0E0C0C,
+        0x02020000,0x06060404,0x0A0A0808,0x0E0E0C0C,0x02020000,0x06060404,0x0A0A0808,0x0E0E0C0C>());
+    __m512i reven = _mm512_shuffle_epi8(teven, bpos);
+    __m512i rodd  = _mm512_shuffle_epi8(todd,  bpos);
+    return _mm512_mask_mov_epi8(reven, 0xAAAAAAAAAAAAAAAA, rodd);     // interleave even and odd
+}
+
+static inline Vec64c lookup128(Vec64c const & index, Vec64c const & table1, Vec64c const & table2) {
+    // Same method as lookup64, using two tables
+    __m512i ieven = _mm512_srli_epi16(_mm512_slli_epi16(index, 8), 9); // word index for even numbered elements
+    __m512i iodd  = _mm512_srli_epi16(index, 9);                       // word index for odd numbered elements
+    __m512i teven = _mm512_permutex2var_epi16(table1, ieven, table2);  // words containing even numbered elements
+    __m512i todd  = _mm512_permutex2var_epi16(table1, iodd,  table2);  // words containing odd numbered elements
+    // byte position within 128-bit lane: 2*(element number / 2) + (index & 1)
+    __m512i bpos  = _mm512_or_si512(_mm512_and_si512(index, _mm512_set1_epi8(1)),
+        constant16i<0x02020000,0x06060404,0x0A0A0808,0x0E0E0C0C,0x02020000,0x06060404,0x0A0A0808,0x0E0E0C0C,
+        0x02020000,0x06060404,0x0A0A0808,0x0E0E0C0C,0x02020000,0x06060404,0x0A0A0808,0x0E0E0C0C>());
+    __m512i reven = _mm512_shuffle_epi8(teven, bpos);
+    __m512i rodd  = _mm512_shuffle_epi8(todd,  bpos);
+    return _mm512_mask_mov_epi8(reven, 0xAAAAAAAAAAAAAAAA, rodd);     // interleave even and odd
+}
+
+template <int n>
+static inline Vec64c lookup(Vec64uc const & index, void const * table) {
+    if (n <=  0) return 0;
+    if (n <= 64) return lookup64(index, Vec64c().load_partial(n, table));
+    if (n <= 128) return lookup128(index, Vec64c().load(table), Vec64c().load_partial(n-64, (int8_t const*)table + 64));
+    // n > 128. Limit index
+    Vec64uc index1;
+    if ((n & (n-1)) == 0) {
+        // n is a power of 2, make index modulo n
+        index1 = Vec64uc(index) & uint8_t(n-1);
+    }
+    else {
+        // n is not a power of 2, limit to n-1
+        index1 = min(Vec64uc(index), uint8_t(n-1));
+    }
+    Vec64c r0 = lookup128(index1, Vec64c().load(table), Vec64c().load((int8_t const*)table + 64));
+    Vec64c r1 = lookup128(index1, Vec64c().load_partial(n-128, (int8_t const*)table + 128),
+        Vec64c().load_partial(n-192, (int8_t const*)table + 192));
+    return _mm512_mask_mov_epi8(r0, _mm512_movepi8_mask(index1), r1); // select r1 if index >= 128
+}
+
+template <int n>
+static inline Vec64c lookup(Vec64c const & index, void const * table) {
+    return lookup<n>(Vec64uc(index), table);
+}
+
+
+static inline Vec32s lookup32(Vec32s const & index, Vec32s const & table) {
+    return _mm512_permutexvar_epi16(index, table);
+}
+
+static inline Vec32s lookup64(Vec32s const & index, Vec32s const & table1, Vec32s const & table2) {
+    return _mm512_permutex2var_epi16(table1, index, table2);
+}
+
+template <int n>
+static inline Vec32s lookup(Vec32s const & index, void const * table) {
+    if (n <=  0) return 0;
+    if (n <= 32) return lookup32(index, Vec32s().load_partial(n, table));
+    if (n <= 64) return lookup64(index, Vec32s().load(table), Vec32s().load_partial(n-32, (int16_t const*)table + 32));
+    // n > 64. Limit index
+    Vec32us index1;
+    if ((n & (n-1)) == 0) {
+        // n is a power of 2, make index modulo n
+        index1 = Vec32us(index) & (n-1);
+    }
+    else {
+        // n is not a power of 2, limit to n-1
+        index1 = min(Vec32us(index), n-1);
+    }
+    __m512i t1 = _mm512_i32gather_epi32(_mm512_and_si512(index1, _mm512_set1_epi32(0x0000FFFF)), (const int *)table, 2); // even positions
+    __m512i t2 = _mm512_i32gather_epi32(_mm512_srli_epi32(index1, 16), (const int *)table, 2);                          // odd  positions
+    return _mm512_mask_mov_epi16(t1, 0xAAAAAAAA, _mm512_slli_epi32(t2, 16));
+}
+
+
+/*****************************************************************************
+*
+*          Horizontal scan functions
+*
+*****************************************************************************/
+
+// Get index to the first element that is true. Return -1 if all are false
+static inline int horizontal_find_first(Vec64cb const & x) {
+    uint64_t a = __mmask64(x);
+    if (a == 0) return -1;
+    if ((uint32_t)a != 0) return bit_scan_forward((uint32_t)a);
+    return bit_scan_forward((uint32_t)(a >> 32)) + 32;
+}
+
+static inline int horizontal_find_first(Vec32sb const & x) {
+    uint32_t a = __mmask32(x);
+    if (a == 0) return -1;
+    return bit_scan_forward(a);
+}
+
+// Count the number of elements that are true
+static inline uint32_t horizontal_count(Vec64cb const & x) {
+    uint64_t a = __mmask64(x);
+    return vml_popcnt((uint32_t)a) + vml_popcnt((uint32_t)(a >> 32));
+}
+
+static inline uint32_t horizontal_count(Vec32sb const & x) {
+    return vml_popcnt((uint32_t)__mmask32(x));
+}
+
+
+/*****************************************************************************
+*
+*          Boolean <-> bitfield conversion functions
+*
+*****************************************************************************/
+
+// to_bits: convert boolean vector to integer bitfield
+static inline uint64_t to_bits(Vec64cb x) {
+    return (uint64_t)__mmask64(x);
+}
+
+// to_Vec64cb: convert integer bitfield to boolean vector
+static inline Vec64cb to_Vec64cb(uint64_t x) {
+    return __mmask64(x);
+}
+
+// to_bits: convert boolean vector to integer bitfield
+static inline uint32_t to_bits(Vec32sb x) {
+    return (uint32_t)__mmask32(x);
+}
+
+// to_Vec32sb: convert integer bitfield to boolean vector
+static inline Vec32sb to_Vec32sb(uint32_t x) {
+    return __mmask32(x);
+}
+
+#endif // VECTORI512S_H
@@ -0,0 +1,1613 @@
+/****************************  vectori512se.h   ******************************
+* Author:        agent
+* Date created:  2026-10-16
+* Last modified: 2026-10-16
+* Version:       1.17
+* Project:       vector classes
+* Description:
+* Header file defining 512-bit integer vector classes with 8-bit and 16-bit
+* elements for computers without AVX512BW instruction set.
+* The operations are emulated with two 256-bit vectors.
+*
+* Instructions:
+* Use Gnu, Intel or Microsoft C++ compiler. Compile for the desired
+* instruction set, which must be at least SSE2. Specify the supported
+* instruction set by a command line define, e.g. __SSE4_1__ if the
+* compiler does not automatically do so.
+*
+* The following vector classes are defined here:
+* Vec64c    Vector of  64   8-bit signed   integers
+* Vec64uc   Vector of  64   8-bit unsigned integers
+* Vec64cb   Vector of  64  Booleans for use with Vec64c and Vec64uc
+* Vec32s    Vector of  32  16-bit signed   integers
+* Vec32us   Vector of  32  16-bit unsigned integers
+* Vec32sb   Vector of  32  Booleans for use with Vec32s and Vec32us
+*
+* Each vector object is represented internally as two 256-bit vectors.
+* This header file defines operators and functions for these vectors.
+*
+* For detailed instructions, see VectorClass.pdf
+*
+* (c) Copyright 2026 agent. GNU General Public License http://www.gnu.org/licenses
+*****************************************************************************/
+
+// check combination of header files
+#if defined (VECTORI512S_H)
+#if    VECTORI512S_H != 1
+#error Two different versions of vectori512s.h included
+#endif
+#else
+#define VECTORI512S_H  1
+
+#ifndef VECTORI512_H
+#error Please include vectori512.h or vectori512e.h before vectori512se.h
+#endif
+
+
+/*****************************************************************************
+*
+*          Vec64cb: Vector of 64 Booleans for use with Vec64c and Vec64uc
+*
+*****************************************************************************/
+
+class Vec64cb {
+protected:
+    Vec32cb z0;                         // low half
+    Vec32cb z1;                         // high half
+public:
+    // Default constructor:
+    Vec64cb () {
+    }
+    // Constructor to broadcast single value:
+    Vec64cb(bool b) {
+        z0 = z1 = Vec32cb(b);
+    }
+private: // Prevent constructing from int, etc.
+    Vec64cb(int b);
+public:
+    // Constructor to make from two halves
+    Vec64cb (Vec32cb const & x0, Vec32cb const & x1) {
+        z0 = x0;  z1 = x1;
+    }
+    // Assignment operator to broadcast scalar value:
+    Vec64cb & operator = (bool b) {
+        *this = Vec64cb(b);
+        return *this;
+    }
+private: // Prevent assigning int because of ambiguity
+    Vec64cb & operator = (int x);
+public:
+    // split into two halves
+    Vec32cb get_low() const {
+        return z0;
+    }
+    Vec32cb get_high() const {
+        return z1;
+    }
+    // Member function to change a single element in vector
+    // Note: This function is inefficient. Use load function if changing more than one element
+    Vec64cb const & insert(uint32_t index, bool value) {
+        if (index < 32) {
+            z0.insert(index, value);
+        }
+        else {
+            z1.insert(index - 32, value);
+        }
+        return *this;
+    }
+    // Member function extract a single element from vector
+    bool extract(uint32_t index) const {
+        if (index < 32) {
+            return z0.extract(index);
+        }
+        else {
+            return z1.extract(index - 32);
+        }
+    }
+    // Extract a single element. Operator [] can only read an element, not write.
+    bool operator [] (uint32_t index) const {
+        return extract(index);
+    }
+    static int size () {
+        return 64;
+    }
+};
+
+// Define operators for Vec64cb
+
+// vector operator & : bitwise and
+static inline Vec64cb operator & (Vec64cb const & a, Vec64cb const & b) {
+    return Vec64cb(a.get_low() & b.get_low(), a.get_high() & b.get_high());
+}
+static inline Vec64cb operator && (Vec64cb const & a, Vec64cb const & b) {
+    return a & b;
+}
+
+// vector operator | : bitwise or
+static inline Vec64cb operator | (Vec64cb const & a, Vec64cb const & b) {
+    return Vec64cb(a.get_low() | b.get_low(), a.get_high() | b.get_high());
+}
+static inline Vec64cb operator || (Vec64cb const & a, Vec64cb const & b) {
+    return a | b;
+}
+
+// vector operator ^ : bitwise xor
+static inline Vec64cb operator ^ (Vec64cb const & a, Vec64cb const & b) {
+    return Vec64cb(a.get_low() ^ b.get_low(), a.get_high() ^ b.get_high());
+}
+
+// vector operator ~ : bitwise not
+static inline Vec64cb operator ~ (Vec64cb const & a) {
+    return Vec64cb(~a.get_low(), ~a.get_high());
+}
+
+// vector operator ! : element not
+static inline Vec64cb operator ! (Vec64cb const & a) {
+    return ~a;
+}
+
+// vector operator &= : bitwise and
+static inline Vec64cb & operator &= (Vec64cb & a, Vec64cb const & b) {
+    a = a & b;
+    return a;
+}
+
+// vector operator |= : bitwise or
+static inline Vec64cb & operator |= (Vec64cb & a, Vec64cb const & b) {
+    a = a | b;
+    return a;
+}
+
+// vector operator ^= : bitwise xor
+static inline Vec64cb & operator ^= (Vec64cb & a, Vec64cb const & b) {
+    a = a ^ b;
+    return a;
+}
+
+// function andnot: a & ~ b
+static inline Vec64cb andnot (Vec64cb const & a, Vec64cb const & b) {
+    return Vec64cb(andnot(a.get_low(), b.get_low()), andnot(a.get_high(), b.get_high()));
+}
+
+// horizontal_and. Returns true if all elements are true
+static inline bool horizontal_and (Vec64cb const & a) {
+    return horizontal_and(a.get_low() & a.get_high());
+}
+
+// horizontal_or. Returns true if at least one element is true
+static inline bool horizontal_or (Vec64cb const & a) {
+    return horizontal_or(a.get_low() | a.get_high());
+}
+
+
+/*****************************************************************************
+*
+*          Vec32sb: Vector of 32 Booleans for use with Vec32s and Vec32us
+*
+*****************************************************************************/
+
+class Vec32sb {
+protected:
+    Vec16sb z0;                         // low half
+    Vec16sb z1;                         // high half
+public:
+    // Default constructor:
+    Vec32sb () {
+    }
+    // Constructor to broadcast single value:
+    Vec32sb(bool b) {
+        z0 = z1 = Vec16sb(b);
+    }
+private: // Prevent constructing from int, etc.
+    Vec32sb(int b);
+public:
+    // Constructor to make from two halves
+    Vec32sb (Vec16sb const & x0, Vec16sb const & x1) {
+        z0 = x0;  z1 = x1;
+    }
+    // Assignment operator to broadcast scalar value:
+    Vec32sb & operator = (bool b) {
+        *this = Vec32sb(b);
+        return *this;
+    }
+private: // Prevent assigning int because of ambiguity
+    Vec32sb & operator = (int x);
+public:
+    // split into two halves
+    Vec16sb get_low() const {
+        return z0;
+    }
+    Vec16sb get_high() const {
+        return z1;
+    }
+    // Member function to change a single element in vector
+    // Note: This function is inefficient. Use load function if changing more than one element
+    Vec32sb const & insert(uint32_t index, bool value) {
+        if (index < 16) {
+            z0.insert(index, value);
+        }
+        else {
+            z1.insert(index - 16, value);
+        }
+        return *this;
+    }
+    // Member function extract a single element from vector
+    bool extract(uint32_t index) const {
+        if (index < 16) {
+            return z0.extract(index);
+        }
+        else {
+            return z1.extract(index - 16);
+        }
+    }
+    // Extract a single element. Operator [] can only read an element, not write.
+    bool operator [] (uint32_t index) const {
+        return extract(index);
+    }
+    static int size () {
+        return 32;
+    }
+};
+
+// Define operators for Vec32sb
+
+// vector operator & : bitwise and
+static inline Vec32sb operator & (Vec32sb const & a, Vec32sb const & b) {
+    return Vec32sb(a.get_low() & b.get_low(), a.get_high() & b.get_high());
+}
+static inline Vec32sb operator && (Vec32sb const & a, Vec32sb const & b) {
+    return a & b;
+}
+
+// vector operator | : bitwise or
+static inline Vec32sb operator | (Vec32sb const & a, Vec32sb const & b) {
+    return Vec32sb(a.get_low() | b.get_low(), a.get_high() | b.get_high());
+}
+static inline Vec32sb operator || (Vec32sb const & a, Vec32sb const & b) {
+    return a | b;
+}
+
+// vector operator ^ : bitwise xor
+static inline Vec32sb operator ^ (Vec32sb const & a, Vec32sb const & b) {
+    return Vec32sb(a.get_low() ^ b.get_low(), a.get_high() ^ b.get_high());
+}
+
+// vector operator ~ : bitwise not
+static inline Vec32sb operator ~ (Vec32sb const & a) {
+    return Vec32sb(~a.get_low(), ~a.get_high());
+}
+
+// vector operator ! : element not
+static inline Vec32sb operator ! (Vec32sb const & a) {
+    return ~a;
+}
+
+// vector operator &= : bitwise and
+static inline Vec32sb & operator &= (Vec32sb & a, Vec32sb const & b) {
+    a = a & b;
+    return a;
+}
+
+// vector operator |= : bitwise or
+static inline Vec32sb & operator |= (Vec32sb & a, Vec32sb const & b) {
+    a = a | b;
+    return a;
+}
+
+// vector operator ^= : bitwise xor
+static inline Vec32sb & operator ^= (Vec32sb & a, Vec32sb const & b) {
+    a = a ^ b;
+    return a;
+}
+
+// function andnot: a & ~ b
+static inline Vec32sb andnot (Vec32sb const & a, Vec32sb const & b) {
+    return Vec32sb(andnot(a.get_low(), b.get_low()), andnot(a.get_high(), b.get_high()));
+}
+
+// horizontal_and. Returns true if all elements are true
+static inline bool horizontal_and (Vec32sb const & a) {
+    return horizontal_and(a.get_low() & a.get_high());
+}
+
+// horizontal_or. Returns true if at least one element is true
+static inline bool horizontal_or (Vec32sb const & a) {
+    return horizontal_or(a.get_low() | a.get_high());
+}
+
+
+/*****************************************************************************
+*
+*          Vector of 64 8-bit signed integers
+*
+*****************************************************************************/
+
+class Vec64c {
+protected:
+    Vec32c z0;                          // low half
+    Vec32c z1;                          // high half
+public:
+    // Default constructor:
+    Vec64c() {
+    }
+    // Constructor to broadcast the same value into all elements:
+    Vec64c(int i) {
+        z0 = z1 = Vec32c(i);
+    }
+    // Constructor to build from all elements:
+    Vec64c(int8_t i0, int8_t i1, int8_t i2, int8_t i3, int8_t i4, int8_t i5, int8_t i6, int8_t i7,
+        int8_t i8, int8_t i9, int8_t i10, int8_t i11, int8_t i12, int8_t i13, int8_t i14, int8_t i15,
+        int8_t i16, int8_t i17, int8_t i18, int8_t i19, int8_t i20, int8_t i21, int8_t i22, int8_t i23,
+        int8_t i24, int8_t i25, int8_t i26, int8_t i27, int8_t i28, int8_t i29, int8_t i30, int8_t i31,
+        int8_t i32, int8_t i33, int8_t i34, int8_t i35, int8_t i36, int8_t i37, int8_t i38, int8_t i39,
+        int8_t i40, int8_t i41, int8_t i42, int8_t i43, int8_t i44, int8_t i45, int8_t i46, int8_t i47,
+        int8_t i48, int8_t i49, int8_t i50, int8_t i51, int8_t i52, int8_t i53, int8_t i54, int8_t i55,
+        int8_t i56, int8_t i57, int8_t i58, int8_t i59, int8_t i60, int8_t i61, int8_t i62, int8_t i63) {
+        z0 = Vec32c(i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15,
+            i16, i17, i18, i19, i20, i21, i22, i23, i24, i25, i26, i27, i28, i29, i30, i31);
+        z1 = Vec32c(i32, i33, i34, i35, i36, i37, i38, i39, i40, i41, i42, i43, i44, i45, i46, i47,
+            i48, i49, i50, i51, i52, i53, i54, i55, i56, i57, i58, i59, i60, i61, i62, i63);
+    }
+    // Constructor to build from two Vec32c:
+    Vec64c(Vec32c const & a0, Vec32c const & a1) {
+        z0 = a0;  z1 = a1;
+    }
+    // Member function to load from array (unaligned)
+    Vec64c & load(void const * p) {
+        z0.load(p);
+        z1.load((int8_t const*)p + 32);
+        return *this;
+    }
+    // Member function to load from array, aligned by 64
+    Vec64c & load_a(void const * p) {
+        z0.load_a(p);
+        z1.load_a((int8_t const*)p + 32);
+        return *this;
+    }
+    // Member function to store into array (unaligned)
+    void store(void * p) const {
+        z0.store(p);
+        z1.store((int8_t*)p + 32);
+    }
+    // Member function to store into array, aligned by 64
+    void store_a(void * p) const {
+        z0.store_a(p);
+        z1.store_a((int8_t*)p + 32);
+    }
+    // Partial load. Load n elements and set the rest to 0
+    Vec64c & load_partial(int n, void const * p) {
+        if (n < 32) {
+            z0.load_partial(n, p);
+            z1 = Vec32c(0);
+        }
+        else {
+            z0.load(p);
+            z1.load_partial(n - 32, (int8_t const*)p + 32);
+        }
+        return *this;
+    }
+    // Partial store. Store n elements
+    void store_partial(int n, void * p) const {
+        if (n < 32) {
+            z0.store_partial(n, p);
+        }
+        else {
+            z0.store(p);
+            z1.store_partial(n - 32, (int8_t*)p + 32);
+        }
+    }
+    // cut off vector to n elements. The last 64-n elements are set to zero
+    Vec64c & cutoff(int n) {
+        if (n < 32) {
+            z0.cutoff(n);
+            z1 = Vec32c(0);
+        }
+        else {
+            z1.cutoff(n - 32);
+        }
+        return *this;
+    }
+    // Member function to change a single element in vector
+    Vec64c const & insert(uint32_t index, int8_t value) {
+        if (index < 32) {
+            z0.insert(index, value);
+        }
+        else {
+            z1.insert(index - 32, value);
+        }
+        return *this;
+    }
+    // Member function extract a single element from vector
+    int8_t extract(uint32_t index) const {
+        if (index < 32) {
+            return z0.extract(index);
+        }
+        else {
+            return z1.extract(index - 32);
+        }
+    }
+    // Extract a single element. Use store function if extracting more than one element.
+    // Operator [] can only read an element, not write.
+    int8_t operator [] (uint32_t index) const {
+        return extract(index);
+    }
+    // Member functions to split into two Vec32c:
+    Vec32c get_low() const {
+        return z0;
+    }
+    Vec32c get_high() const {
+        return z1;
+    }
+    static int size () {
+        return 64;
+    }
+};
+
+
+// Define operators for Vec64c
+
+// vector operator + : add element by element
+static inline Vec64c operator + (Vec64c const & a, Vec64c const & b) {
+    return Vec64c(a.get_low() + b.get_low(), a.get_high() + b.get_high());
+}
+
+// vector operator += : add
+static inline Vec64c & operator += (Vec64c & a, Vec64c const & b) {
+    a = a + b;
+    return a;
+}
+
+// postfix operator ++
+static inline Vec64c operator ++ (Vec64c & a, int) {
+    Vec64c a0 = a;
+    a = a + 1;
+    return a0;
+}
+
+// prefix operator ++
+static inline Vec64c & operator ++ (Vec64c & a) {
+    a = a + 1;
+    return a;
+}
+
+// vector operator - : subtract element by element
+static inline Vec64c operator - (Vec64c const & a, Vec64c const & b) {
+    return Vec64c(a.get_low() - b.get_low(), a.get_high() - b.get_high());
+}
+
+// vector operator - : unary minus
+static inline Vec64c operator - (Vec64c const & a) {
+    return Vec64c(-a.get_low(), -a.get_high());
+}
+
+// vector operator -= : subtract
+static inline Vec64c & operator -= (Vec64c & a, Vec64c const & b) {
+    a = a - b;
+    return a;
+}
+
+// postfix operator --
+static inline Vec64c operator -- (Vec64c & a, int) {
+    Vec64c a0 = a;
+    a = a - 1;
+    return a0;
+}
+
+// prefix operator --
+static inline Vec64c & operator -- (Vec64c & a) {
+    a = a - 1;
+    return a;
+}
+
+// vector operator * : multiply element by element
+static inline Vec64c operator * (Vec64c const & a, Vec64c const & b) {
+    return Vec64c(a.get_low() * b.get_low(), a.get_high() * b.get_high());
+}
+
+// vector operator *= : multiply
+static inline Vec64c & operator *= (Vec64c & a, Vec64c const & b) {
+    a = a * b;
+    return a;
+}
+
+// vector operator << : shift left all elements
+static inline Vec64c operator << (Vec64c const & a, int b) {
+    return Vec64c(a.get_low() << b, a.get_high() << b);
+}
+
+// vector operator <<= : shift left
+static inline Vec64c & operator <<= (Vec64c & a, int b) {
+    a = a << b;
+    return a;
+}
+
+// vector operator >> : shift right arithmetic all elements
+static inline Vec64c operator >> (Vec64c const & a, int b) {
+    return Vec64c(a.get_low() >> b, a.get_high() >> b);
+}
+
+// vector operator >>= : shift right arithmetic
+static inline Vec64c & operator >>= (Vec64c & a, int b) {
+    a = a >> b;
+    return a;
+}
+
+// vector operator == : returns true for elements for which a == b
+static inline Vec64cb operator == (Vec64c const & a, Vec64c const & b) {
+    return Vec64cb(a.get_low() == b.get_low(), a.get_high() == b.get_high());
+}
+
+// vector operator != : returns true for elements for which a != b
+static inline Vec64cb operator != (Vec64c const & a, Vec64c const & b) {
+    return Vec64cb(a.get_low() != b.get_low(), a.get_high() != b.get_high());
+}
+
+// vector operator > : returns true for elements for which a > b
+static inline Vec64cb operator > (Vec64c const & a, Vec64c const & b) {
+    return Vec64cb(a.get_low() > b.get_low(), a.get_high() > b.get_high());
+}
+
+// vector operator < : returns true for elements for which a < b
+static inline Vec64cb operator < (Vec64c const & a, Vec64c const & b) {
+    return b > a;
+}
+
+// vector operator >= : returns true for elements for which a >= b (signed)
+static inline Vec64cb operator >= (Vec64c const & a, Vec64c const & b) {
+    return Vec64cb(a.get_low() >= b.get_low(), a.get_high() >= b.get_high());
+}
+
+// vector operator <= : returns true for elements for which a <= b (signed)
+static inline Vec64cb operator <= (Vec64c const & a, Vec64c const & b) {
+    return b >= a;
+}
+
+// vector operator & : bitwise and
+static inline Vec64c operator & (Vec64c const & a, Vec64c const & b) {
+    return Vec64c(a.get_low() & b.get_low(), a.get_high() & b.get_high());
+}
+static inline Vec64c operator && (Vec64c const & a, Vec64c const & b) {
+    return a & b;
+}
+// vector operator &= : bitwise and
+static inline Vec64c & operator &= (Vec64c & a, Vec64c const & b) {
+    a = a & b;
+    return a;
+}
+
+// vector operator | : bitwise or
+static inline Vec64c operator | (Vec64c const & a, Vec64c const & b) {
+    return Vec64c(a.get_low() | b.get_low(), a.get_high() | b.get_high());
+}
+static inline Vec64c operator || (Vec64c const & a, Vec64c const & b) {
+    return a | b;
+}
+// vector operator |= : bitwise or
+static inline Vec64c & operator |= (Vec64c & a, Vec64c const & b) {
+    a = a | b;
+    return a;
+}
+
+// vector operator ^ : bitwise xor
+static inline Vec64c operator ^ (Vec64c const & a, Vec64c const & b) {
+    return Vec64c(a.get_low() ^ b.get_low(), a.get_high() ^ b.get_high());
+}
+// vector operator ^= : bitwise xor
+static inline Vec64c & operator ^= (Vec64c & a, Vec64c const & b) {
+    a = a ^ b;
+    return a;
+}
+
+// vector operator ~ : bitwise not
+static inline Vec64c operator ~ (Vec64c const & a) {
+    return Vec64c(~a.get_low(), ~a.get_high());
+}
+
+// vector operator ! : logical not, returns true for elements == 0
+static inline Vec64cb operator ! (Vec64c const & a) {
+    return Vec64cb(!a.get_low(), !a.get_high());
+}
+
+// Functions for this class
+
+// Select between two operands. Corresponds to this pseudocode:
+// for (int i = 0; i < 64; i++) result[i] = s[i] ? a[i] : b[i];
+static inline Vec64c select (Vec64cb const & s, Vec64c const & a, Vec64c const & b) {
+    return Vec64c(select(s.get_low(), a.get_low(), b.get_low()), select(s.get_high(), a.get_high(), b.get_high()));
+}
+
+// Conditional add: For all vector elements i: result[i] = f[i] ? (a[i] + b[i]) : a[i]
+static inline Vec64c if_add (Vec64cb const & f, Vec64c const & a, Vec64c const & b) {
+    return Vec64c(if_add(f.get_low(), a.get_low(), b.get_low()), if_add(f.get_high(), a.get_high(), b.get_high()));
+}
+
+// Horizontal add: Calculates the sum of all vector elements.
+// Overflow will wrap around
+static inline uint32_t horizontal_add (Vec64c const & a) {
+    int8_t sum = (int8_t)(horizontal_add(a.get_low()) + horizontal_add(a.get_high())); // truncate to 8 bits
+    return sum;                                                                        // sign extend to 32 bits
+}
+
+// Horizontal add extended: Calculates the sum of all vector elements.
+// Each element is sign-extended before addition to avoid overflow
+static inline int32_t horizontal_add_x (Vec64c const & a) {
+    return horizontal_add_x(a.get_low()) + horizontal_add_x(a.get_high());
+}
+
+// function add_saturated: add element by element, signed with saturation
+static inline Vec64c add_saturated(Vec64c const & a, Vec64c const & b) {
+    return Vec64c(add_saturated(a.get_low(), b.get_low()), add_saturated(a.get_high(), b.get_high()));
+}
+
+// function sub_saturated: subtract element by element, signed with saturation
+static inline Vec64c sub_saturated(Vec64c const & a, Vec64c const & b) {
+    return Vec64c(sub_saturated(a.get_low(), b.get_low()), sub_saturated(a.get_high(), b.get_high()));
+}
+
+// function max: a > b ? a : b
+static inline Vec64c max(Vec64c const & a, Vec64c const & b) {
+    return Vec64c(max(a.get_low(), b.get_low()), max(a.get_high(), b.get_high()));
+}
+
+// function min: a < b ? a : b
+static inline Vec64c min(Vec64c const & a, Vec64c const & b) {
+    return Vec64c(min(a.get_low(), b.get_low()), min(a.get_high(), b.get_high()));
+}
+
+// function abs: a >= 0 ? a : -a
+static inline Vec64c abs(Vec64c const & a) {
+    return Vec64c(abs(a.get_low()), abs(a.get_high()));
+}
+
+// function abs_saturated: same as abs, saturate if overflow
+static inline Vec64c abs_saturated(Vec64c const & a) {
+    return Vec64c(abs_saturated(a.get_low()), abs_saturated(a.get_high()));
+}
+
+// function rotate_left all elements
+// Use negative count to rotate right
+static inline Vec64c rotate_left(Vec64c const & a, int b) {
+    return Vec64c(rotate_left(a.get_low(), b), rotate_left(a.get_high(), b));
+}
+
+
+/*****************************************************************************
+*
+*          Vector of 64 8-bit unsigned integers
+*
+*****************************************************************************/
+
+class Vec64uc : public Vec64c {
+public:
+    // Default constructor:
+    Vec64uc() {
+    }
+    // Constructor to broadcast the same value into all elements:
+    Vec64uc(uint32_t i) {
+        z0 = z1 = Vec32uc(i);
+    }
+    // Constructor to build from all elements:
+    Vec64uc(uint8_t i0, uint8_t i1, uint8_t i2, uint8_t i3, uint8_t i4, uint8_t i5, uint8_t i6, uint8_t i7,
+        uint8_t i8, uint8_t i9, uint8_t i10, uint8_t i11, uint8_t i12, uint8_t i13, uint8_t i14, uint8_t i15,
+        uint8_t i16, uint8_t i17, uint8_t i18, uint8_t i19, uint8_t i20, uint8_t i21, uint8_t i22, uint8_t i23,
+        uint8_t i24, uint8_t i25, uint8_t i26, uint8_t i27, uint8_t i28, uint8_t i29, uint8_t i30, uint8_t i31,
+        uint8_t i32, uint8_t i33, uint8_t i34, uint8_t i35, uint8_t i36, uint8_t i37, uint8_t i38, uint8_t i39,
+        uint8_t i40, uint8_t i41, uint8_t i42, uint8_t i43, uint8_t i44, uint8_t i45, uint8_t i46, uint8_t i47,
+        uint8_t i48, uint8_t i49, uint8_t i50, uint8_t i51, uint8_t i52, uint8_t i53, uint8_t i54, uint8_t i55,
+        uint8_t i56, uint8_t i57, uint8_t i58, uint8_t i59, uint8_t i60, uint8_t i61, uint8_t i62, uint8_t i63)
+        : Vec64c(i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15,
+        i16, i17, i18, i19, i20, i21, i22, i23, i24, i25, i26, i27, i28, i29, i30, i31,
+        i32, i33, i34, i35, i36, i37, i38, i39, i40, i41, i42, i43, i44, i45, i46, i47,
+        i48, i49, i50, i51, i52, i53, i54, i55, i56, i57, i58, i59, i60, i61, i62, i63) {
+    }
+    // Constructor to build from two Vec32uc:
+    Vec64uc(Vec32uc const & a0, Vec32uc const & a1) {
+        z0 = a0;  z1 = a1;
+    }
+    // Constructor to convert from Vec64c
+    Vec64uc(Vec64c const & x) {
+        z0 = x.get_low();  z1 = x.get_high();
+    }
+    // Member function to load from array (unaligned)
+    Vec64uc & load(void const * p) {
+        Vec64c::load(p);
+        return *this;
+    }
+    // Member function to load from array, aligned by 64
+    Vec64uc & load_a(void const * p) {
+        Vec64c::load_a(p);
+        return *this;
+    }
+    // Member function to change a single element in vector
+    Vec64uc const & insert(uint32_t index, uint8_t value) {
+        Vec64c::insert(index, value);
+        return *this;
+    }
+    // Member function extract a single element from vector
+    uint8_t extract(uint32_t index) const {
+        return Vec64c::extract(index);
+    }
+    // Extract a single element. Use store function if extracting more than one element.
+    // Operator [] can only read an element, not write.
+    uint8_t operator [] (uint32_t index) const {
+        return extract(index);
+    }
+    // Member functions to split into two Vec32uc:
+    Vec32uc get_low() const {
+        return Vec32uc(z0);
+    }
+    Vec32uc get_high() const {
+        return Vec32uc(z1);
+    }
+};
+
+// Define operators for this class
+
+// vector operator + : add
+static inline Vec64uc operator + (Vec64uc const & a, Vec64uc const & b) {
+    return Vec64uc (Vec64c(a) + Vec64c(b));
+}
+
+// vector operator - : subtract
+static inline Vec64uc operator - (Vec64uc const & a, Vec64uc const & b) {
+    return Vec64uc (Vec64c(a) - Vec64c(b));
+}
+
+// vector operator * : multiply
+static inline Vec64uc operator * (Vec64uc const & a, Vec64uc const & b) {
+    return Vec64uc (Vec64c(a) * Vec64c(b));
+}
+
+// vector operator >> : shift right logical all elements
+static inline Vec64uc operator >> (Vec64uc const & a, uint32_t b) {
+    return Vec64uc(a.get_low() >> b, a.get_high() >> b);
+}
+
+// vector operator >> : shift right logical all elements
+static inline Vec64uc operator >> (Vec64uc const & a, int32_t b) {
+    return a >> (uint32_t)b;
+}
+
+// vector operator >>= : shift right logical
+static inline Vec64uc & operator >>= (Vec64uc & a, uint32_t b) {
+    a = a >> b;
+    return a;
+}
+
+// vector operator << : shift left all elements
+static inline Vec64uc operator << (Vec64uc const & a, uint32_t b) {
+    return Vec64uc(Vec64c(a) << (int32_t)b);
+}
+
+// vector operator << : shift left all elements
+static inline Vec64uc operator << (Vec64uc const & a, int32_t b) {
+    return Vec64uc(Vec64c(a) << b);
+}
+
+// vector operator >= : returns true for elements for which a >= b (unsigned)
+static inline Vec64cb operator >= (Vec64uc const & a, Vec64uc const & b) {
+    return Vec64cb(a.get_low() >= b.get_low(), a.get_high() >= b.get_high());
+}
+
+// vector operator <= : returns true for elements for which a <= b (unsigned)
+static inline Vec64cb operator <= (Vec64uc const & a, Vec64uc const & b) {
+    return b >= a;
+}
+
+// vector operator > : returns true for elements for which a > b (unsigned)
+static inline Vec64cb operator > (Vec64uc const & a, Vec64uc const & b) {
+    return Vec64cb(a.get_low() > b.get_low(), a.get_high() > b.get_high());
+}
+
+// vector operator < : returns true for elements for which a < b (unsigned)
+static inline Vec64cb operator < (Vec64uc const & a, Vec64uc const & b) {
+    return b > a;
+}
+
+// vector operator & : bitwise and
+static inline Vec64uc operator & (Vec64uc const & a, Vec64uc const & b) {
+    return Vec64uc(Vec64c(a) & Vec64c(b));
+}
+static inline Vec64uc operator && (Vec64uc const & a, Vec64uc const & b) {
+    return a & b;
+}
+
+// vector operator | : bitwise or
+static inline Vec64uc operator | (Vec64uc const & a, Vec64uc const & b) {
+    return Vec64uc(Vec64c(a) | Vec64c(b));
+}
+static inline Vec64uc operator || (Vec64uc const & a, Vec64uc const & b) {
+    return a | b;
+}
+
+// vector operator ^ : bitwise xor
+static inline Vec64uc operator ^ (Vec64uc const & a, Vec64uc const & b) {
+    return Vec64uc(Vec64c(a) ^ Vec64c(b));
+}
+
+// vector operator ~ : bitwise not
+static inline Vec64uc operator ~ (Vec64uc const & a) {
+    return Vec64uc( ~ Vec64c(a));
+}
+
+// Functions for this class
+
+// Select between two operands. Corresponds to this pseudocode:
+// for (int i = 0; i < 64; i++) result[i] = s[i] ? a[i] : b[i];
+static inline Vec64uc select (Vec64cb const & s, Vec64uc const & a, Vec64uc const & b) {
+    return Vec64uc(select(s, Vec64c(a), Vec64c(b)));
+}
+
+// Conditional add: For all vector elements i: result[i] = f[i] ? (a[i] + b[i]) : a[i]
+static inline Vec64uc if_add (Vec64cb const & f, Vec64uc const & a, Vec64uc const & b) {
+    return Vec64uc(if_add(f, Vec64c(a), Vec64c(b)));
+}
+
+// Horizontal add: Calculates the sum of all vector elements.
+// Overflow will wrap around
+static inline uint32_t horizontal_add (Vec64uc const & a) {
+    return (uint8_t)(horizontal_add(a.get_low()) + horizontal_add(a.get_high())); // truncate to 8 bits
+}
+
+// Horizontal add extended: Calculates the sum of all vector elements.
+// Each element is zero-extended before addition to avoid overflow
+static inline uint32_t horizontal_add_x (Vec64uc const & a) {
+    return horizontal_add_x(a.get_low()) + horizontal_add_x(a.get_high());
+}
+
+// function add_saturated: add element by element, unsigned with saturation
+static inline Vec64uc add_saturated(Vec64uc const & a, Vec64uc const & b) {
+    return Vec64uc(add_saturated(a.get_low(), b.get_low()), add_saturated(a.get_high(), b.get_high()));
+}
+
+// function sub_saturated: subtract element by element, unsigned with saturation
+static inline Vec64uc sub_saturated(Vec64uc const & a, Vec64uc const & b) {
+    return Vec64uc(sub_saturated(a.get_low(), b.get_low()), sub_saturated(a.get_high(), b.get_high()));
+}
+
+// function max: a > b ? a : b
+static inline Vec64uc max(Vec64uc const & a, Vec64uc const & b) {
+    return Vec64uc(max(a.get_low(), b.get_low()), max(a.get_high(), b.get_high()));
+}
+
+// function min: a < b ? a : b
+static inline Vec64uc min(Vec64uc const & a, Vec64uc const & b) {
+    return Vec64uc(min(a.get_low(), b.get_low()), min(a.get_high(), b.get_high()));
+}
+
+
+/*****************************************************************************
+*
+*          Vector of 32 16-bit signed integers
+*
+*****************************************************************************/
+
+class Vec32s {
+protected:
+    Vec16s z0;                          // low half
+    Vec16s z1;                          // high half
+public:
+    // Default constructor:
+    Vec32s() {
+    }
+    // Constructor to broadcast the same value into all elements:
+    Vec32s(int i) {
+        z0 = z1 = Vec16s(i);
+    }
+    // Constructor to build from all elements:
+    Vec32s(int16_t i0, int16_t i1, int16_t i2, int16_t i3, int16_t i4, int16_t i5, int16_t i6, int16_t i7,
+        int16_t i8, int16_t i9, int16_t i10, int16_t i11, int16_t i12, int16_t i13, int16_t i14, int16_t i15,
+        int16_t i16, int16_t i17, int16_t i18, int16_t i19, int16_t i20, int16_t i21, int16_t i22, int16_t i23,
+        int16_t i24, int16_t i25, int16_t i26, int16_t i27, int16_t i28, int16_t i29, int16_t i30, int16_t i31) {
+        z0 = Vec16s(i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15);
+        z1 = Vec16s(i16, i17, i18, i19, i20, i21, i22, i23, i24, i25, i26, i27, i28, i29, i30, i31);
+    }
+    // Constructor to build from two Vec16s:
+    Vec32s(Vec16s const & a0, Vec16s const & a1) {
+        z0 = a0;  z1 = a1;
+    }
+    // Member function to load from array (unaligned)
+    Vec32s & load(void const * p) {
+        z0.load(p);
+        z1.load((int16_t const*)p + 16);
+        return *this;
+    }
+    // Member function to load from array, aligned by 64
+    Vec32s & load_a(void const * p) {
+        z0.load_a(p);
+        z1.load_a((int16_t const*)p + 16);
+        return *this;
+    }
+    // Member function to store into array (unaligned)
+    void store(void * p) const {
+        z0.store(p);
+        z1.store((int16_t*)p + 16);
+    }
+    // Member function to store into array, aligned by 64
+    void store_a(void * p) const {
+        z0.store_a(p);
+        z1.store_a((int16_t*)p + 16);
+    }
+    // Partial load. Load n elements and set the rest to 0
+    Vec32s & load_partial(int n, void const * p) {
+        if (n < 16) {
+            z0.load_partial(n, p);
+            z1 = Vec16s(0);
+        }
+        else {
+            z0.load(p);
+            z1.load_partial(n - 16, (int16_t const*)p + 16);
+        }
+        return *this;
+    }
+    // Partial store. Store n elements
+    void store_partial(int n, void * p) const {
+        if (n < 16) {
+            z0.store_partial(n, p);
+        }
+        else {
+            z0.store(p);
+            z1.store_partial(n - 16, (int16_t*)p + 16);
+        }
+    }
+    // cut off vector to n elements. The last 32-n elements are set to zero
+    Vec32s & cutoff(int n) {
+        if (n < 16) {
+            z0.cutoff(n);
+            z1 = Vec16s(0);
+        }
+        else {
+            z1.cutoff(n - 16);
+        }
+        return *this;
+    }
+    // Member function to change a single element in vector
+    Vec32s const & insert(uint32_t index, int16_t value) {
+        if (index < 16) {
+            z0.insert(index, value);
+        }
+        else {
+            z1.insert(index - 16, value);
+        }
+        return *this;
+    }
+    // Member function extract a single element from vector
+    int16_t extract(uint32_t index) const {
+        if (index < 16) {
+            return z0.extract(index);
+        }
+        else {
+            return z1.extract(index - 16);
+        }
+    }
+    // Extract a single element. Use store function if extracting more than one element.
+    // Operator [] can only read an element, not write.
+    int16_t operator [] (uint32_t index) const {
+        return extract(index);
+    }
+    // Member functions to split into two Vec16s:
+    Vec16s get_low() const {
+        return z0;
+    }
+    Vec16s get_high() const {
+        return z1;
+    }
+    static int size () {
+        return 32;
+    }
+};
+
+
+// Define operators for Vec32s
+
+// vector operator + : add element by element
+static inline Vec32s operator + (Vec32s const & a, Vec32s const & b) {
+    return Vec32s(a.get_low() + b.get_low(), a.get_high() + b.get_high());
+}
+
+// vector operator += : add
+static inline Vec32s & operator += (Vec32s & a, Vec32s const & b) {
+    a = a + b;
+    return a;
+}
+
+// postfix operator ++
+static inline Vec32s operator ++ (Vec32s & a, int) {
+    Vec32s a0 = a;
+    a = a + 1;
+    return a0;
+}
+
+// prefix operator ++
+static inline Vec32s & operator ++ (Vec32s & a) {
+    a = a + 1;
+    return a;
+}
+
+// vector operator - : subtract element by element
+static inline Vec32s operator - (Vec32s const & a, Vec32s const & b) {
+    return Vec32s(a.get_low() - b.get_low(), a.get_high() - b.get_high());
+}
+
+// vector operator - : unary minus
+static inline Vec32s operator - (Vec32s const & a) {
+    return Vec32s(-a.get_low(), -a.get_high());
+}
+
+// vector operator -= : subtract
+static inline Vec32s & operator -= (Vec32s & a, Vec32s const & b) {
+    a = a - b;
+    return a;
+}
+
+// postfix operator --
+static inline Vec32s operator -- (Vec32s & a, int) {
+    Vec32s a0 = a;
+    a = a - 1;
+    return a0;
+}
+
+// prefix operator --
+static inline Vec32s & operator -- (Vec32s & a) {
+    a = a - 1;
+    return a;
+}
+
+// vector operator * : multiply element by element
+static inline Vec32s operator * (Vec32s const & a, Vec32s const & b) {
+    return Vec32s(a.get_low() * b.get_low(), a.get_high() * b.get_high());
+}
+
+// vector operator *= : multiply
+static inline Vec32s & operator *= (Vec32s & a, Vec32s const & b) {
+    a = a * b;
+    return a;
+}
+
+// vector operator << : shift left
+static inline Vec32s operator << (Vec32s const & a, int b) {
+    return Vec32s(a.get_low() << b, a.get_high() << b);
+}
+
+// vector operator <<= : shift left
+static inline Vec32s & operator <<= (Vec32s & a, int b) {
+    a = a << b;
+    return a;
+}
+
+// vector operator >> : shift right arithmetic
+static inline Vec32s operator >> (Vec32s const & a, int b) {
+    return Vec32s(a.get_low() >> b, a.get_high() >> b);
+}
+
+// vector operator >>= : shift right arithmetic
+static inline Vec32s & operator >>= (Vec32s & a, int b) {
+    a = a >> b;
+    return a;
+}
+
+// vector operator == : returns true for elements for which a == b
+static inline Vec32sb operator == (Vec32s const & a, Vec32s const & b) {
+    return Vec32sb(a.get_low() == b.get_low(), a.get_high() == b.get_high());
+}
+
+// vector operator != : returns true for elements for which a != b
+static inline Vec32sb operator != (Vec32s const & a, Vec32s const & b) {
+    return Vec32sb(a.get_low() != b.get_low(), a.get_high() != b.get_high());
+}
+
+// vector operator > : returns true for elements for which a > b
+static inline Vec32sb operator > (Vec32s const & a, Vec32s const & b) {
+    return Vec32sb(a.get_low() > b.get_low(), a.get_high() > b.get_high());
+}
+
+// vector operator < : returns true for elements for which a < b
+static inline Vec32sb operator < (Vec32s const & a, Vec32s const & b) {
+    return b > a;
+}
+
+// vector operator >= : returns true for elements for which a >= b (signed)
+static inline Vec32sb operator >= (Vec32s const & a, Vec32s const & b) {
+    return Vec32sb(a.get_low() >= b.get_low(), a.get_high() >= b.get_high());
+}
+
+// vector operator <= : returns true for elements for which a <= b (signed)
+static inline Vec32sb operator <= (Vec32s const & a, Vec32s const & b) {
+    return b >= a;
+}
+
+// vector operator & : bitwise and
+static inline Vec32s operator & (Vec32s const & a, Vec32s const & b) {
+    return Vec32s(a.get_low() & b.get_low(), a.get_high() & b.get_high());
+}
+static inline Vec32s operator && (Vec32s const & a, Vec32s const & b) {
+    return a & b;
+}
+// vector operator &= : bitwise and
+static inline Vec32s & operator &= (Vec32s & a, Vec32s const & b) {
+    a = a & b;
+    return a;
+}
+
+// vector operator | : bitwise or
+static inline Vec32s operator | (Vec32s const & a, Vec32s const & b) {
+    return Vec32s(a.get_low() | b.get_low(), a.get_high() | b.get_high());
+}
+static inline Vec32s operator || (Vec32s const & a, Vec32s const & b) {
+    return a | b;
+}
+// vector operator |= : bitwise or
+static inline Vec32s & operator |= (Vec32s & a, Vec32s const & b) {
+    a = a | b;
+    return a;
+}
+
+// vector operator ^ : bitwise xor
+static inline Vec32s operator ^ (Vec32s const & a, Vec32s const & b) {
+    return Vec32s(a.get_low() ^ b.get_low(), a.get_high() ^ b.get_high());
+}
+// vector operator ^= : bitwise xor
+static inline Vec32s & operator ^= (Vec32s & a, Vec32s const & b) {
+    a = a ^ b;
+    return a;
+}
+
+// vector operator ~ : bitwise not
+static inline Vec32s operator ~ (Vec32s const & a) {
+    return Vec32s(~a.get_low(), ~a.get_high());
+}
+
+// vector operator ! : logical not, returns true for elements == 0
+static inline Vec32sb operator ! (Vec32s const & a) {
+    return Vec32sb(!a.get_low(), !a.get_high());
+}
+
+// Functions for this class
+
+// Select between two operands. Corresponds to this pseudocode:
+// for (int i = 0; i < 32; i++) result[i] = s[i] ? a[i] : b[i];
+static inline Vec32s select (Vec32sb const & s, Vec32s const & a, Vec32s const & b) {
+    return Vec32s(select(s.get_low(), a.get_low(), b.get_low()), select(s.get_high(), a.get_high(), b.get_high()));
+}
+
+// Conditional add: For all vector elements i: result[i] = f[i] ? (a[i] + b[i]) : a[i]
+static inline Vec32s if_add (Vec32sb const & f, Vec32s const & a, Vec32s const & b) {
+    return Vec32s(if_add(f.get_low(), a.get_low(), b.get_low()), if_add(f.get_high(), a.get_high(), b.get_high()));
+}
+
+// Horizontal add extended: Calculates the sum of all vector elements.
+// Elements are sign extended before adding to avoid overflow
+static inline int32_t horizontal_add_x (Vec32s const & a) {
+    return horizontal_add_x(a.get_low()) + horizontal_add_x(a.get_high());
+}
+
+// Horizontal add: Calculates the sum of all vector elements.
+// Overflow will wrap around
+static inline int32_t horizontal_add (Vec32s const & a) {
+    return (int16_t)(horizontal_add(a.get_low()) + horizontal_add(a.get_high())); // truncate to 16 bits and sign extend
+}
+
+// function add_saturated: add element by element, signed with saturation
+static inline Vec32s add_saturated(Vec32s const & a, Vec32s const & b) {
+    return Vec32s(add_saturated(a.get_low(), b.get_low()), add_saturated(a.get_high(), b.get_high()));
+}
+
+// function sub_saturated: subtract element by element, signed with saturation
+static inline Vec32s sub_saturated(Vec32s const & a, Vec32s const & b) {
+    return Vec32s(sub_saturated(a.get_low(), b.get_low()), sub_saturated(a.get_high(), b.get_high()));
+}
+
+// function max: a > b ? a : b
+static inline Vec32s max(Vec32s const & a, Vec32s const & b) {
+    return Vec32s(max(a.get_low(), b.get_low()), max(a.get_high(), b.get_high()));
+}
+
+// function min: a < b ? a : b
+static inline Vec32s min(Vec32s const & a, Vec32s const & b) {
+    return Vec32s(min(a.get_low(), b.get_low()), min(a.get_high(), b.get_high()));
+}
+
+// function abs: a >= 0 ? a : -a
+static inline Vec32s abs(Vec32s const & a) {
+    return Vec32s(abs(a.get_low()), abs(a.get_high()));
+}
+
+// function abs_saturated: same as abs, saturate if overflow
+static inline Vec32s abs_saturated(Vec32s const & a) {
+    return Vec32s(abs_saturated(a.get_low()), abs_saturated(a.get_high()));
+}
+
+// function rotate_left all elements
+// Use negative count to rotate right
+static inline Vec32s rotate_left(Vec32s const & a, int b) {
+    return Vec32s(rotate_left(a.get_low(), b), rotate_left(a.get_high(), b));
+}
+
+
+/*****************************************************************************
+*
+*          Vector of 32 16-bit unsigned integers
+*
+*****************************************************************************/
+
+class Vec32us : public Vec32s {
+public:
+    // Default constructor:
+    Vec32us() {
+    }
+    // Constructor to broadcast the same value into all elements:
+    Vec32us(uint32_t i) {
+        z0 = z1 = Vec16us(i);
+    }
+    // Constructor to build from all elements:
+    Vec32us(uint16_t i0, uint16_t i1, uint16_t i2, uint16_t i3, uint16_t i4, uint16_t i5, uint16_t i6, uint16_t i7,
+        uint16_t i8, uint16_t i9, uint16_t i10, uint16_t i11, uint16_t i12, uint16_t i13, uint16_t i14, uint16_t i15,
+        uint16_t i16, uint16_t i17, uint16_t i18, uint16_t i19, uint16_t i20, uint16_t i21, uint16_t i22, uint16_t i23,
+        uint16_t i24, uint16_t i25, uint16_t i26, uint16_t i27, uint16_t i28, uint16_t i29, uint16_t i30, uint16_t i31)
+        : Vec32s(i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15,
+        i16, i17, i18, i19, i20, i21, i22, i23, i24, i25, i26, i27, i28, i29, i30, i31) {
+    }
+    // Constructor to build from two Vec16us:
+    Vec32us(Vec16us const & a0, Vec16us const & a1) {
+        z0 = a0;  z1 = a1;
+    }
+    // Constructor to convert from Vec32s
+    Vec32us(Vec32s const & x) {
+        z0 = x.get_low();  z1 = x.get_high();
+    }
+    // Member function to load from array (unaligned)
+    Vec32us & load(void const * p) {
+        Vec32s::load(p);
+        return *this;
+    }
+    // Member function to load from array, aligned by 64
+    Vec32us & load_a(void const * p) {
+        Vec32s::load_a(p);
+        return *this;
+    }
+    // Member function to change a single element in vector
+    Vec32us const & insert(uint32_t index, uint16_t value) {
+        Vec32s::insert(index, value);
+        return *this;
+    }
+    // Member function extract a single element from vector
+    uint16_t extract(uint32_t index) const {
+        return Vec32s::extract(index);
+    }
+    // Extract a single element. Use store function if extracting more than one element.
+    // Operator [] can only read an element, not write.
+    uint16_t operator [] (uint32_t index) const {
+        return extract(index);
+    }
+    // Member functions to split into two Vec16us:
+    Vec16us get_low() const {
+        return Vec16us(z0);
+    }
+    Vec16us get_high() const {
+        return Vec16us(z1);
+    }
+};
+
+// Define operators for this class
+
+// vector operator + : add
+static inline Vec32us operator + (Vec32us const & a, Vec32us const & b) {
+    return Vec32us (Vec32s(a) + Vec32s(b));
+}
+
+// vector operator - : subtract
+static inline Vec32us operator - (Vec32us const & a, Vec32us const & b) {
+    return Vec32us (Vec32s(a) - Vec32s(b));
+}
+
+// vector operator * : multiply
+static inline Vec32us operator * (Vec32us const & a, Vec32us const & b) {
+    return Vec32us (Vec32s(a) * Vec32s(b));
+}
+
+// vector operator >> : shift right logical all elements
+static inline Vec32us operator >> (Vec32us const & a, uint32_t b) {
+    return Vec32us(a.get_low() >> b, a.get_high() >> b);
+}
+
+// vector operator >> : shift right logical all elements
+static inline Vec32us operator >> (Vec32us const & a, int32_t b) {
+    return a >> (uint32_t)b;
+}
+
+// vector operator >>= : shift right logical
+static inline Vec32us & operator >>= (Vec32us & a, uint32_t b) {
+    a = a >> b;
+    return a;
+}
+
+// vector operator << : shift left all elements
+static inline Vec32us operator << (Vec32us const & a, uint32_t b) {
+    return Vec32us(Vec32s(a) << (int32_t)b);
+}
+
+// vector operator << : shift left all elements
+static inline Vec32us operator << (Vec32us const & a, int32_t b) {
+    return Vec32us(Vec32s(a) << b);
+}
+
+// vector operator >= : returns true for elements for which a >= b (unsigned)
+static inline Vec32sb operator >= (Vec32us const & a, Vec32us const & b) {
+    return Vec32sb(a.get_low() >= b.get_low(), a.get_high() >= b.get_high());
+}
+
+// vector operator <= : returns true for elements for which a <= b (unsigned)
+static inline Vec32sb operator <= (Vec32us const & a, Vec32us const & b) {
+    return b >= a;
+}
+
+// vector operator > : returns true for elements for which a > b (unsigned)
+static inline Vec32sb operator > (Vec32us const & a, Vec32us const & b) {
+    return Vec32sb(a.get_low() > b.get_low(), a.get_high() > b.get_high());
+}
+
+// vector operator < : returns true for elements for which a < b (unsigned)
+static inline Vec32sb operator < (Vec32us const & a, Vec32us const & b) {
+    return b > a;
+}
+
+// vector operator & : bitwise and
+static inline Vec32us operator & (Vec32us const & a, Vec32us const & b) {
+    return Vec32us(Vec32s(a) & Vec32s(b));
+}
+static inline Vec32us operator && (Vec32us const & a, Vec32us const & b) {
+    return a & b;
+}
+
+// vector operator | : bitwise or
+static inline Vec32us operator | (Vec32us const & a, Vec32us const & b) {
+    return Vec32us(Vec32s(a) | Vec32s(b));
+}
+static inline Vec32us operator || (Vec32us const & a, Vec32us const & b) {
+    return a | b;
+}
+
+// vector operator ^ : bitwise xor
+static inline Vec32us operator ^ (Vec32us const & a, Vec32us const & b) {
+    return Vec32us(Vec32s(a) ^ Vec32s(b));
+}
+
+// vector operator ~ : bitwise not
+static inline Vec32us operator ~ (Vec32us const & a) {
+    return Vec32us( ~ Vec32s(a));
+}
+
+// Functions for this class
+
+// Select between two operands. Corresponds to this pseudocode:
+// for (int i = 0; i < 32; i++) result[i] = s[i] ? a[i] : b[i];
+static inline Vec32us select (Vec32sb const & s, Vec32us const & a, Vec32us const & b) {
+    return Vec32us(select(s, Vec32s(a), Vec32s(b)));
+}
+
+// Conditional add: For all vector elements i: result[i] = f[i] ? (a[i] + b[i]) : a[i]
+static inline Vec32us if_add (Vec32sb const & f, Vec32us const & a, Vec32us const & b) {
+    return Vec32us(if_add(f, Vec32s(a), Vec32s(b)));
+}
+
+// Horizontal add extended: Calculates the sum of all vector elements.
+// Each element is zero-extended before addition to avoid overflow
+static inline uint32_t horizontal_add_x (Vec32us const & a) {
+    return horizontal_add_x(a.get_low()) + horizontal_add_x(a.get_high());
+}
+
+// Horizontal add: Calculates the sum of all vector elements.
+// Overflow will wrap around
+static inline uint32_t horizontal_add (Vec32us const & a) {
+    return (uint16_t)(horizontal_add(a.get_low()) + horizontal_add(a.get_high())); // truncate to 16 bits
+}
+
+// function add_saturated: add element by element, unsigned with saturation
+static inline Vec32us add_saturated(Vec32us const & a, Vec32us const & b) {
+    return Vec32us(add_saturated(a.get_low(), b.get_low()), add_saturated(a.get_high(), b.get_high()));
+}
+
+// function sub_saturated: subtract element by element, unsigned with saturation
+static inline Vec32us sub_saturated(Vec32us const & a, Vec32us const & b) {
+    return Vec32us(sub_saturated(a.get_low(), b.get_low()), sub_saturated(a.get_high(), b.get_high()));
+}
+
+// function max: a > b ? a : b
+static inline Vec32us max(Vec32us const & a, Vec32us const & b) {
+    return Vec32us(max(a.get_low(), b.get_low()), max(a.get_high(), b.get_high()));
+}
+
+// function min: a < b ? a : b
+static inline Vec32us min(Vec32us const & a, Vec32us const & b) {
+    return Vec32us(min(a.get_low(), b.get_low()), min(a.get_high(), b.get_high()));
+}
+
+
+/*****************************************************************************
+*
+*          Vector permute functions
+*
+******************************************************************************
+*
+* These permute functions can reorder the elements of a vector and optionally
+* set some elements to zero.
+*
+* The indexes are inserted as template parameters in <>. These indexes must be
+* constants. Each template parameter is an index to the element you want to
+* select. An index of -1 will generate zero.
+*
+* Each half of the result is made by blending the two halves of the input.
+*
+*****************************************************************************/
+
+// Permute vector of 32 16-bit integers.
+// Index -1 gives 0
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7, int i8, int i9, int i10, int i11, int i12, int i13, int i14, int i15,
+    int i16, int i17, int i18, int i19, int i20, int i21, int i22, int i23, int i24, int i25, int i26, int i27, int i28, int i29, int i30, int i31>
+static inline Vec32s permute32s(Vec32s const & a) {
+    return Vec32s(
+        blend16s<i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15> (a.get_low(), a.get_high()),
+        blend16s<i16, i17, i18, i19, i20, i21, i22, i23, i24, i25, i26, i27, i28, i29, i30, i31> (a.get_low(), a.get_high()));
+}
+
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7, int i8, int i9, int i10, int i11, int i12, int i13, int i14, int i15,
+    int i16, int i17, int i18, int i19, int i20, int i21, int i22, int i23, int i24, int i25, int i26, int i27, int i28, int i29, int i30, int i31>
+static inline Vec32us permute32us(Vec32us const & a) {
+    return Vec32us (permute32s <
+        i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15,
+        i16, i17, i18, i19, i20, i21, i22, i23, i24, i25, i26, i27, i28, i29, i30, i31> (a));
+}
+
+// Permute vector of 64 8-bit integers.
+// Index -1 gives 0
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7, int i8, int i9, int i10, int i11, int i12, int i13, int i14, int i15,
+    int i16, int i17, int i18, int i19, int i20, int i21, int i22, int i23, int i24, int i25, int i26, int i27, int i28, int i29, int i30, int i31,
+    int i32, int i33, int i34, int i35, int i36, int i37, int i38, int i39, int i40, int i41, int i42, int i43, int i44, int i45, int i46, int i47,
+    int i48, int i49, int i50, int i51, int i52, int i53, int i54, int i55, int i56, int i57, int i58, int i59, int i60, int i61, int i62, int i63>
+static inline Vec64c permute64c(Vec64c const & a) {
+    return Vec64c(
+        blend32c<i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15,
+            i16, i17, i18, i19, i20, i21, i22, i23, i24, i25, i26, i27, i28, i29, i30, i31> (a.get_low(), a.get_high()),
+        blend32c<i32, i33, i34, i35, i36, i37, i38, i39, i40, i41, i42, i43, i44, i45, i46, i47,
+            i48, i49, i50, i51, i52, i53, i54, i55, i56, i57, i58, i59, i60, i61, i62, i63> (a.get_low(), a.get_high()));
+}
+
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7, int i8, int i9, int i10, int i11, int i12, int i13, int i14, int i15,
+    int i16, int i17, int i18, int i19, int i20, int i21, int i22, int i23, int i24, int i25, int i26, int i27, int i28, int i29, int i30, int i31,
+    int i32, int i33, int i34, int i35, int i36, int i37, int i38, int i39, int i40, int i41, int i42, int i43, int i44, int i45, int i46, int i47,
+    int i48, int i49, int i50, int i51, int i52, int i53, int i54, int i55, int i56, int i57, int i58, int i59, int i60, int i61, int i62, int i63>
+static inline Vec64uc permute64uc(Vec64uc const & a) {
+    return Vec64uc (permute64c <
+        i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15,
+        i16, i17, i18, i19, i20, i21, i22, i23, i24, i25, i26, i27, i28, i29, i30, i31,
+        i32, i33, i34, i35, i36, i37, i38, i39, i40, i41, i42, i43, i44, i45, i46, i47,
+        i48, i49, i50, i51, i52, i53, i54, i55, i56, i57, i58, i59, i60, i61, i62, i63> (a));
+}
+
+
+/*****************************************************************************
+*
+*          Vector lookup functions
+*
+******************************************************************************
+*
+* These functions use vector elements as indexes into a table.
+* The table is given as one or more vectors or as an array.
+*
+* An index out of range may produce any value - the actual value produced is
+* implementation dependent and may be different for different instruction
+* sets. An index out of range does not produce an error message or exception.
+*
+*****************************************************************************/
+
+static inline Vec64c lookup64(Vec64c const & index, Vec64c const & table) {
+    // look up the low 5 bits of the index in each half of the table and select by bit 5
+    Vec32c i0 = index.get_low()  & Vec32c(0x1F);
+    Vec32c i1 = index.get_high() & Vec32c(0x1F);
+    Vec32cb s0 = (index.get_low()  & Vec32c(0x20)) != Vec32c(0);
+    Vec32cb s1 = (index.get_high() & Vec32c(0x20)) != Vec32c(0);
+    Vec32c r0 = select(s0, lookup32(i0, table.get_high()), lookup32(i0, table.get_low()));
+    Vec32c r1 = select(s1, lookup32(i1, table.get_high()), lookup32(i1, table.get_low()));
+    return Vec64c(r0, r1);
+}
+
+static inline Vec64c lookup128(Vec64c const & index, Vec64c const & table1, Vec64c const & table2) {
+    Vec64c i0 = index & Vec64c(0x3F);
+    Vec64cb s = (index & Vec64c(0x40)) != Vec64c(0);
+    return select(s, lookup64(i0, table2), lookup64(i0, table1));
+}
+
+template <int n>
+static inline Vec64c lookup(Vec64uc const & index, void const * table) {
+    return Vec64c(lookup<n>(index.get_low(), table), lookup<n>(index.get_high(), table));
+}
+
+template <int n>
+static inline Vec64c lookup(Vec64c const & index, void const * table) {
+    return lookup<n>(Vec64uc(index), table);
+}
+
+
+static inline Vec32s lookup32(Vec32s const & index, Vec32s const & table) {
+    // look up the low 4 bits of the index in each half of the table and select by bit 4
+    Vec16s i0 = index.get_low()  & Vec16s(0x0F);
+    Vec16s i1 = index.get_high() & Vec16s(0x0F);
+    Vec16sb s0 = (index.get_low()  & Vec16s(0x10)) != Vec16s(0);
+    Vec16sb s1 = (index.get_high() & Vec16s(0x10)) != Vec16s(0);
+    Vec16s r0 = select(s0, lookup16(i0, table.get_high()), lookup16(i0, table.get_low()));
+    Vec16s r1 = select(s1, lookup16(i1, table.get_high()), lookup16(i1, table.get_low()));
+    return Vec32s(r0, r1);
+}
+
+static inline Vec32s lookup64(Vec32s const & index, Vec32s const & table1, Vec32s const & table2) {
+    Vec32s i0 = index & Vec32s(0x1F);
+    Vec32sb s = (index & Vec32s(0x20)) != Vec32s(0);
+    return select(s, lookup32(i0, table2), lookup32(i0, table1));
+}
+
+template <int n>
+static inline Vec32s lookup(Vec32s const & index, void const * table) {
+    return Vec32s(lookup<n>(index.get_low(), table), lookup<n>(index.get_high(), table));
+}
+
+
+/*****************************************************************************
+*
+*          Horizontal scan functions
+*
+*****************************************************************************/
+
+// Get index to the first element that is true. Return -1 if all are false
+static inline int horizontal_find_first(Vec64cb const & x) {
+    int a1 = horizontal_find_first(x.get_low());
+    if (a1 >= 0) return a1;
+    int a2 = horizontal_find_first(x.get_high());
+    if (a2 < 0) return a2;
+    return a2 + 32;
+}
+
+static inline int horizontal_find_first(Vec32sb const & x) {
+    int a1 = horizontal_find_first(x.get_low());
+    if (a1 >= 0) return a1;
+    int a2 = horizontal_find_first(x.get_high());
+    if (a2 < 0) return a2;
+    return a2 + 16;
+}
+
+// Count the number of elements that are true
+static inline uint32_t horizontal_count(Vec64cb const & x) {
+    return horizontal_count(x.get_low()) + horizontal_count(x.get_high());
+}
+
+static inline uint32_t horizontal_count(Vec32sb const & x) {
+    return horizontal_count(x.get_low()) + horizontal_count(x.get_high());
+}
+
+
+/*****************************************************************************
+*
+*          Boolean <-> bitfield conversion functions
+*
+*****************************************************************************/
+
+// to_bits: convert boolean vector to integer bitfield
+static inline uint64_t to_bits(Vec64cb const & x) {
+    return (uint64_t)to_bits(x.get_low()) | (uint64_t)to_bits(x.get_high()) << 32;
+}
+
+// to_Vec64cb: convert integer bitfield to boolean vector
+static inline Vec64cb to_Vec64cb(uint64_t x) {
+    return Vec64cb(to_Vec32cb(uint32_t(x)), to_Vec32cb(uint32_t(x >> 32)));
+}
+
+// to_bits: convert boolean vector to integer bitfield
+static inline uint32_t to_bits(Vec32sb const & x) {
+    return (uint32_t)to_bits(x.get_low()) | (uint32_t)to_bits(x.get_high()) << 16;
+}
+
+// to_Vec32sb: convert integer bitfield to boolean vector
+static inline Vec32sb to_Vec32sb(uint32_t x) {
+    return Vec32sb(to_Vec16sb(uint16_t(x)), to_Vec16sb(uint16_t(x >> 16)));
+}
+
+#endif // VECTORI512S_H
@@ -0,0 +1,296 @@
+/***************************  vectormath_apply.h   *****************************
+* Author:        agent
+* Date created:  2026-10-16
+* Last modified: 2026-10-16
+* Version:       1.17
+* Project:       vector classes
+* Description:
+* Header file containing templates for applying a vector function to all
+* elements of an array:
+* vm_apply       apply unary, binary or ternary function to arrays
+* vm_apply_sum   sum of unary or binary function applied to arrays
+*
+* The function can be any of the mathematical functions in vectormath_exp.h,
+* vectormath_trig.h, vectormath_hyp.h or vectormath_lib.h, or any other
+* function or function object that takes vectors as parameters and returns
+* a vector of the same type. The vector type must be specified explicitly,
+* and the arrays must have the corresponding element type, e.g.:
+*
+* float a[100], b[100];
+* vm_apply<Vec8f>(exp, a, b, 100);               // b[i] = exp(a[i])
+* float s = vm_apply_sum<Vec8f>(log, a, 100);    // s = sum of log(a[i])
+*
+* The types vm_vecf and vm_vecd are defined as the widest float and double
+* vectors supported by the instruction set, e.g. vm_apply<vm_vecf>(exp, a, b, 100).
+*
+* The loops process two vectors at a time so that the two function calls can
+* execute in parallel. Aligned loads and stores are used if all arrays are
+* aligned by the vector size. The remaining elements are handled with
+* load_partial and store_partial, which use masked instructions with AVX512.
+* The input and output arrays may be the same, but they should not overlap
+* partially.
+*
+* For detailed instructions, see VectorClass.pdf
+*
+* (c) Copyright 2026 agent. GNU General Public License http://www.gnu.org/licenses
+******************************************************************************/
+
+#ifndef VECTORMATH_APPLY_H
+#define VECTORMATH_APPLY_H  1
+
+#include <stddef.h>
+#include "vectorclass.h"
+
+
+/******************************************************************************
+                widest vector types supported
+******************************************************************************/
+
+#if MAX_VECTOR_SIZE >= 512 && INSTRSET >= 9
+typedef Vec16f vm_vecf;
+typedef Vec8d  vm_vecd;
+#elif MAX_VECTOR_SIZE >= 256 && INSTRSET >= 7
+typedef Vec8f  vm_vecf;
+typedef Vec4d  vm_vecd;
+#else
+typedef Vec4f  vm_vecf;
+typedef Vec2d  vm_vecd;
+#endif
+
+
+/******************************************************************************
+                helper functions, used internally
+******************************************************************************/
+
+// load full vector, aligned or unaligned
+template <class VTYPE, int ALIGNED, class T>
+static inline VTYPE vm_apply_load(T const * p) {
+    VTYPE a;
+    if (ALIGNED) a.load_a(p); else a.load(p);
+    return a;
+}
+
+// store full vector, aligned or unaligned
+template <int ALIGNED, class VTYPE, class T>
+static inline void vm_apply_store(VTYPE const & a, T * p) {
+    if (ALIGNED) a.store_a(p); else a.store(p);
+}
+
+// check if pointer is aligned by the vector size
+template <class VTYPE, class T>
+static inline bool vm_apply_aligned(T const * p) {
+    return ((size_t)p & (sizeof(VTYPE) - 1)) == 0;
+}
+
+// Main loops. Two vectors in each iteration.
+// Return the number of elements done. The rest is done by the caller
+template <class VTYPE, int ALIGNED, class FUNC, class T>
+static inline int vm_apply_loop(FUNC func, T const * a, T * r, int n) {
+    const int vs = VTYPE::size();
+    int i;
+    for (i = 0; i <= n - 2*vs; i += 2*vs) {
+        VTYPE r0 = func(vm_apply_load<VTYPE,ALIGNED>(a + i));
+        VTYPE r1 = func(vm_apply_load<VTYPE,ALIGNED>(a + i + vs));
+        vm_apply_store<ALIGNED>(r0, r + i);
+        vm_apply_store<ALIGNED>(r1, r + i + vs);
+    }
+    return i;
+}
+
+template <class VTYPE, int ALIGNED, class FUNC, class T>
+static inline int vm_apply_loop(FUNC func, T const * a, T const * b, T * r, int n) {
+    const int vs = VTYPE::size();
+    int i;
+    for (i = 0; i <= n - 2*vs; i += 2*vs) {
+        VTYPE r0 = func(vm_apply_load<VTYPE,ALIGNED>(a + i), vm_apply_load<VTYPE,ALIGNED>(b + i));
+        VTYPE r1 = func(vm_apply_load<VTYPE,ALIGNED>(a + i + vs), vm_apply_load<VTYPE,ALIGNED>(b + i + vs));
+        vm_apply_store<ALIGNED>(r0, r + i);
+        vm_apply_store<ALIGNED>(r1, r + i + vs);
+    }
+    return i;
+}
+
+template <class VTYPE, int ALIGNED, class FUNC, class T>
+static inline int vm_apply_loop(FUNC func, T const * a, T const * b, T const * c, T * r, int n) {
+    const int vs = VTYPE::size();
+    int i;
+    for (i = 0; i <= n - 2*vs; i += 2*vs) {
+        VTYPE r0 = func(vm_apply_load<VTYPE,ALIGNED>(a + i), vm_apply_load<VTYPE,ALIGNED>(b + i),
+            vm_apply_load<VTYPE,ALIGNED>(c + i));
+        VTYPE r1 = func(vm_apply_load<VTYPE,ALIGNED>(a + i + vs), vm_apply_load<VTYPE,ALIGNED>(b + i + vs),
+            vm_apply_load<VTYPE,ALIGNED>(c + i + vs));
+        vm_apply_store<ALIGNED>(r0, r + i);
+        vm_apply_store<ALIGNED>(r1, r + i + vs);
+    }
+    return i;
+}
+
+template <class VTYPE, int ALIGNED, class FUNC, class T>
+static inline int vm_apply_sum_loop(FUNC func, T const * a, int n, VTYPE & sum) {
+    const int vs = VTYPE::size();
+    VTYPE s0 = sum, s1 = VTYPE(0);
+    int i;
+    for (i = 0; i <= n - 2*vs; i += 2*vs) {
+        s0 += func(vm_apply_load<VTYPE,ALIGNED>(a + i));
+        s1 += func(vm_apply_load<VTYPE,ALIGNED>(a + i + vs));
+    }
+    sum = s0 + s1;
+    return i;
+}
+
+template <class VTYPE, int ALIGNED, class FUNC, class T>
+static inline int vm_apply_sum_loop(FUNC func, T const * a, T const * b, int n, VTYPE & sum) {
+    const int vs = VTYPE::size();
+    VTYPE s0 = sum, s1 = VTYPE(0);
+    int i;
+    for (i = 0; i <= n - 2*vs; i += 2*vs) {
+        s0 += func(vm_apply_load<VTYPE,ALIGNED>(a + i), vm_apply_load<VTYPE,ALIGNED>(b + i));
+        s1 += func(vm_apply_load<VTYPE,ALIGNED>(a + i + vs), vm_apply_load<VTYPE,ALIGNED>(b + i + vs));
+    }
+    sum = s0 + s1;
+    return i;
+}
+
+
+/******************************************************************************
+                vm_apply: apply function to arrays
+******************************************************************************/
+
+// r[i] = func(a[i]), i = 0 .. n-1
+template <class VTYPE, class FUNC, class T>
+static inline void vm_apply(FUNC func, T const * a, T * r, int n) {
+    const int vs = VTYPE::size();
+    int i;
+    if (vm_apply_aligned<VTYPE>(a) && vm_apply_aligned<VTYPE>(r)) {
+        i = vm_apply_loop<VTYPE,1>(func, a, r, n);
+    }
+    else {
+        i = vm_apply_loop<VTYPE,0>(func, a, r, n);
+    }
+    if (i <= n - vs) {                           // one full vector left
+        func(VTYPE().load(a + i)).store(r + i);
+        i += vs;
+    }
+    if (i < n) {                                 // partial vector left
+        func(VTYPE().load_partial(n - i, a + i)).store_partial(n - i, r + i);
+    }
+}
+
+// r[i] = func(a[i], b[i]), i = 0 .. n-1
+template <class VTYPE, class FUNC, class T>
+static inline void vm_apply(FUNC func, T const * a, T const * b, T * r, int n) {
+    const int vs = VTYPE::size();
+    int i;
+    if (vm_apply_aligned<VTYPE>(a) && vm_apply_aligned<VTYPE>(b) && vm_apply_aligned<VTYPE>(r)) {
+        i = vm_apply_loop<VTYPE,1>(func, a, b, r, n);
+    }
+    else {
+        i = vm_apply_loop<VTYPE,0>(func, a, b, r, n);
+    }
+    if (i <= n - vs) {
+        func(VTYPE().load(a + i), VTYPE().load(b + i)).store(r + i);
+        i += vs;
+    }
+    if (i < n) {
+        func(VTYPE().load_partial(n - i, a + i), VTYPE().load_partial(n - i, b + i)).store_partial(n - i, r + i);
+    }
+}
+
+// r[i] = func(a[i], b[i], c[i]), i = 0 .. n-1
+template <class VTYPE, class FUNC, class T>
+static inline void vm_apply(FUNC func, T const * a, T const * b, T const * c, T * r, int n) {
+    const int vs = VTYPE::size();
+    int i;
+    if (vm_apply_aligned<VTYPE>(a) && vm_apply_aligned<VTYPE>(b) && vm_apply_aligned<VTYPE>(c) && vm_apply_aligned<VTYPE>(r)) {
+        i = vm_apply_loop<VTYPE,1>(func, a, b, c, r, n);
+    }
+    else {
+        i = vm_apply_loop<VTYPE,0>(func, a, b, c, r, n);
+    }
+    if (i <= n - vs) {
+        func(VTYPE().load(a + i), VTYPE().load(b + i), VTYPE().load(c + i)).store(r + i);
+        i += vs;
+    }
+    if (i < n) {
+        func(VTYPE().load_partial(n - i, a + i), VTYPE().load_partial(n - i, b + i),
+            VTYPE().load_partial(n - i, c + i)).store_partial(n - i, r + i);
+    }
+}
+
+// Overloaded functions such as exp cannot be passed as a template parameter.
+// These versions take a function pointer of the specified vector type
+template <class VTYPE, class T>
+static inline void vm_apply(VTYPE (*func)(VTYPE const &), T const * a, T * r, int n) {
+    vm_apply<VTYPE, VTYPE (*)(VTYPE const &)>(func, a, r, n);
+}
+
+template <class VTYPE, class T>
+static inline void vm_apply(VTYPE (*func)(VTYPE const &, VTYPE const &), T const * a, T const * b, T * r, int n) {
+    vm_apply<VTYPE, VTYPE (*)(VTYPE const &, VTYPE const &)>(func, a, b, r, n);
+}
+
+template <class VTYPE, class T>
+static inline void vm_apply(VTYPE (*func)(VTYPE const &, VTYPE const &, VTYPE const &), T const * a, T const * b, T const * c, T * r, int n) {
+    vm_apply<VTYPE, VTYPE (*)(VTYPE const &, VTYPE const &, VTYPE const &)>(func, a, b, c, r, n);
+}
+
+
+/******************************************************************************
+                vm_apply_sum: sum of function applied to arrays
+******************************************************************************/
+
+// return sum of func(a[i]), i = 0 .. n-1
+template <class VTYPE, class FUNC, class T>
+static inline T vm_apply_sum(FUNC func, T const * a, int n) {
+    const int vs = VTYPE::size();
+    VTYPE sum(0);
+    int i;
+    if (vm_apply_aligned<VTYPE>(a)) {
+        i = vm_apply_sum_loop<VTYPE,1>(func, a, n, sum);
+    }
+    else {
+        i = vm_apply_sum_loop<VTYPE,0>(func, a, n, sum);
+    }
+    if (i <= n - vs) {
+        sum += func(VTYPE().load(a + i));
+        i += vs;
+    }
+    if (i < n) {                                 // func(0) may be nonzero. Cut off unused elements
+        sum += func(VTYPE().load_partial(n - i, a + i)).cutoff(n - i);
+    }
+    return horizontal_add(sum);
+}
+
+// return sum of func(a[i], b[i]), i = 0 .. n-1
+template <class VTYPE, class FUNC, class T>
+static inline T vm_apply_sum(FUNC func, T const * a, T const * b, int n) {
+    const int vs = VTYPE::size();
+    VTYPE sum(0);
+    int i;
+    if (vm_apply_aligned<VTYPE>(a) && vm_apply_aligned<VTYPE>(b)) {
+        i = vm_apply_sum_loop<VTYPE,1>(func, a, b, n, sum);
+    }
+    else {
+        i = vm_apply_sum_loop<VTYPE,0>(func, a, b, n, sum);
+    }
+    if (i <= n - vs) {
+        sum += func(VTYPE().load(a + i), VTYPE().load(b + i));
+        i += vs;
+    }
+    if (i < n) {
+        sum += func(VTYPE().load_partial(n - i, a + i), VTYPE().load_partial(n - i, b + i)).cutoff(n - i);
+    }
+    return horizontal_add(sum);
+}
+
+template <class VTYPE, class T>
+static inline T vm_apply_sum(VTYPE (*func)(VTYPE const &), T const * a, int n) {
+    return vm_apply_sum<VTYPE, VTYPE (*)(VTYPE const &)>(func, a, n);
+}
+
+template <class VTYPE, class T>
+static inline T vm_apply_sum(VTYPE (*func)(VTYPE const &, VTYPE const &), T const * a, T const * b, int n) {
+    return vm_apply_sum<VTYPE, VTYPE (*)(VTYPE const &, VTYPE const &)>(func, a, b, n);
+}
+
+#endif  // VECTORMATH_APPLY_H
@@ -0,0 +1,810 @@
+/****************************  vectorsort.h   ********************************
+* Author:        agent
+* Date created:  2026-10-16
+* Last modified: 2026-10-16
+* Version:       1.17
+* Project:       vector classes
+* Description:
+* Header file with functions for sorting vectors and arrays:
+*
+* sort(a)                    Sort the elements of vector a in ascending order
+* sort_keys(k, v)            Sort the elements of vector k in ascending order and
+*                            move the elements of vector v together with k
+* sort_merge(a, b)           Merge sorted vectors a and b. The lowest elements
+*                            are returned in a and the highest in b, both sorted
+* sort_merge_keys(ka, va, kb, vb)  Same, with values moved together with keys
+* sort_array(p, n)           Sort array p of n elements in ascending order
+* sort_array(k, v, n)        Sort array k of n keys in ascending order and move
+*                            the elements of array v together with the keys
+*
+* The vector functions are defined for these key vectors and value vectors:
+* Vec4d with Vec4q, Vec8f with Vec8i, Vec8i with Vec8i,
+* Vec8d with Vec8q, Vec16f with Vec16i, Vec16i with Vec16i.
+* Use reinterpret_i or reinterpret_f if the values have another type.
+*
+* The array functions are defined for float, int32_t and double keys with
+* int32_t, int32_t and int64_t values, respectively.
+*
+* The vectors are sorted with bitonic sorting networks of min, max, permute
+* and blend. The arrays are sorted with quicksort, using vectors for
+* partitioning and sorting networks for the small partitions. The partitioning
+* uses compress instructions with AVX512, otherwise a table of permutations.
+* A partition is sorted with heapsort if quicksort goes too deep, so that
+* the time is O(n*log(n)) for any input.
+* The sorting is not stable: elements with equal keys may come in any order.
+* The result is undefined if floating point keys contain NAN.
+*
+* For detailed instructions, see VectorClass.pdf
+*
+* (c) Copyright 2026 agent. GNU General Public License http://www.gnu.org/licenses
+******************************************************************************/
+
+#ifndef VECTORSORT_H
+#define VECTORSORT_H  117
+
+#include "vectorclass.h"
+
+#if MAX_VECTOR_SIZE < 256
+#error vectorsort.h requires MAX_VECTOR_SIZE >= 256
+#endif
+
+
+/*****************************************************************************
+*
+*          Permute and blend overloaded for the vector types used in sorting
+*
+*****************************************************************************/
+
+template <int i0, int i1, int i2, int i3>
+static inline Vec4d sort_permute(Vec4d const & a) {
+    return permute4d<i0, i1, i2, i3>(a);
+}
+
+template <int i0, int i1, int i2, int i3>
+static inline Vec4q sort_permute(Vec4q const & a) {
+    return permute4q<i0, i1, i2, i3>(a);
+}
+
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7>
+static inline Vec8f sort_permute(Vec8f const & a) {
+    return permute8f<i0, i1, i2, i3, i4, i5, i6, i7>(a);
+}
+
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7>
+static inline Vec8i sort_permute(Vec8i const & a) {
+    return permute8i<i0, i1, i2, i3, i4, i5, i6, i7>(a);
+}
+
+template <int i0, int i1, int i2, int i3>
+static inline Vec4d sort_blend(Vec4d const & a, Vec4d const & b) {
+    return blend4d<i0, i1, i2, i3>(a, b);
+}
+
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7>
+static inline Vec8f sort_blend(Vec8f const & a, Vec8f const & b) {
+    return blend8f<i0, i1, i2, i3, i4, i5, i6, i7>(a, b);
+}
+
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7>
+static inline Vec8i sort_blend(Vec8i const & a, Vec8i const & b) {
+    return blend8i<i0, i1, i2, i3, i4, i5, i6, i7>(a, b);
+}
+
+#if MAX_VECTOR_SIZE >= 512
+
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7>
+static inline Vec8d sort_permute(Vec8d const & a) {
+    return permute8d<i0, i1, i2, i3, i4, i5, i6, i7>(a);
+}
+
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7>
+static inline Vec8q sort_permute(Vec8q const & a) {
+    return permute8q<i0, i1, i2, i3, i4, i5, i6, i7>(a);
+}
+
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7,
+int i8, int i9, int i10, int i11, int i12, int i13, int i14, int i15>
+static inline Vec16f sort_permute(Vec16f const & a) {
+    return permute16f<i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15>(a);
+}
+
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7,
+int i8, int i9, int i10, int i11, int i12, int i13, int i14, int i15>
+static inline Vec16i sort_permute(Vec16i const & a) {
+    return permute16i<i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15>(a);
+}
+
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7>
+static inline Vec8d sort_blend(Vec8d const & a, Vec8d const & b) {
+    return blend8d<i0, i1, i2, i3, i4, i5, i6, i7>(a, b);
+}
+
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7,
+int i8, int i9, int i10, int i11, int i12, int i13, int i14, int i15>
+static inline Vec16f sort_blend(Vec16f const & a, Vec16f const & b) {
+    return blend16f<i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15>(a, b);
+}
+
+template <int i0, int i1, int i2, int i3, int i4, int i5, int i6, int i7,
+int i8, int i9, int i10, int i11, int i12, int i13, int i14, int i15>
+static inline Vec16i sort_blend(Vec16i const & a, Vec16i const & b) {
+    return blend16i<i0, i1, i2, i3, i4, i5, i6, i7, i8, i9, i10, i11, i12, i13, i14, i15>(a, b);
+}
+
+#endif // MAX_VECTOR_SIZE >= 512
+
+
+/*****************************************************************************
+*
+*          Compare-exchange steps of sorting networks
+*
+*****************************************************************************/
+
+// Compare each key k[i] with the key at a partner position and exchange
+// them if they are out of order. The template parameter ci is the partner
+// position, plus the vector size if element i should get the maximum of the
+// two keys, otherwise it gets the minimum. The values v are moved together
+// with the keys. Keys that are equal are not exchanged.
+// The exchange is decided by comparing the keys rather than by comparing
+// min and max with the original keys, because -0.0 == +0.0 would make the
+// values go wrong when the keys are exchanged.
+
+template <int c0, int c1, int c2, int c3, class V, class VI>
+static inline void sort_exchange4(V & k, VI & v) {
+    V pk = sort_permute<c0&3, c1&3, c2&3, c3&3>(k);
+    // exchange if pk < k where element i gets the minimum, or k < pk where it gets the maximum
+    V a = sort_blend<0|(c0&4), 1|(c1&4), 2|(c2&4), 3|(c3&4)>(pk, k);
+    V b = sort_blend<0|(c0&4), 1|(c1&4), 2|(c2&4), 3|(c3&4)>(k, pk);
+    v = select(a < b, sort_permute<c0&3, c1&3, c2&3, c3&3>(v), v);
+    k = select(a < b, pk, k);
+}
+
+template <int c0, int c1, int c2, int c3, int c4, int c5, int c6, int c7, class V, class VI>
+static inline void sort_exchange8(V & k, VI & v) {
+    V pk = sort_permute<c0&7, c1&7, c2&7, c3&7, c4&7, c5&7, c6&7, c7&7>(k);
+    V a = sort_blend<0|(c0&8), 1|(c1&8), 2|(c2&8), 3|(c3&8), 4|(c4&8), 5|(c5&8), 6|(c6&8), 7|(c7&8)>(pk, k);
+    V b = sort_blend<0|(c0&8), 1|(c1&8), 2|(c2&8), 3|(c3&8), 4|(c4&8), 5|(c5&8), 6|(c6&8), 7|(c7&8)>(k, pk);
+    v = select(a < b, sort_permute<c0&7, c1&7, c2&7, c3&7, c4&7, c5&7, c6&7, c7&7>(v), v);
+    k = select(a < b, pk, k);
+}
+
+#if MAX_VECTOR_SIZE >= 512
+
+template <int c0, int c1, int c2, int c3, int c4, int c5, int c6, int c7,
+int c8, int c9, int c10, int c11, int c12, int c13, int c14, int c15, class V, class VI>
+static inline void sort_exchange16(V & k, VI & v) {
+    V pk = sort_permute<c0&15, c1&15, c2&15, c3&15, c4&15, c5&15, c6&15, c7&15,
+        c8&15, c9&15, c10&15, c11&15, c12&15, c13&15, c14&15, c15&15>(k);
+    V a = sort_blend<0|(c0&16), 1|(c1&16), 2|(c2&16), 3|(c3&16), 4|(c4&16), 5|(c5&16), 6|(c6&16), 7|(c7&16),
+        8|(c8&16), 9|(c9&16), 10|(c10&16), 11|(c11&16), 12|(c12&16), 13|(c13&16), 14|(c14&16), 15|(c15&16)>(pk, k);
+    V b = sort_blend<0|(c0&16), 1|(c1&16), 2|(c2&16), 3|(c3&16), 4|(c4&16), 5|(c5&16), 6|(c6&16), 7|(c7&16),
+        8|(c8&16), 9|(c9&16), 10|(c10&16), 11|(c11&16), 12|(c12&16), 13|(c13&16), 14|(c14&16), 15|(c15&16)>(k, pk);
+    v = select(a < b, sort_permute<c0&15, c1&15, c2&15, c3&15, c4&15, c5&15, c6&15, c7&15,
+        c8&15, c9&15, c10&15, c11&15, c12&15, c13&15, c14&15, c15&15>(v), v);
+    k = select(a < b, pk, k);
+}
+
+#endif // MAX_VECTOR_SIZE >= 512
+
+
+/*****************************************************************************
+*
+*          Bitonic sorting networks
+*
+*****************************************************************************/
+
+// sort_bitonic: sort a bitonic sequence of keys in ascending order.
+// sort_network: sort keys in ascending order.
+// The values are moved together with the keys. The functions without
+// values use a dummy value vector which the compiler optimizes away.
+
+template <class V, class VI>
+static inline void sort_bitonic4(V & k, VI & v) {
+    sort_exchange4<2,3,4,5>(k, v);
+    sort_exchange4<1,4,3,6>(k, v);
+}
+
+template <class V, class VI>
+static inline void sort_network4(V & k, VI & v) {
+    sort_exchange4<1,4,7,2>(k, v);
+    sort_bitonic4(k, v);
+}
+
+// merge sorted vectors: reverse b to make a bitonic sequence of a and b,
+// then split into a lower and an upper bitonic sequence
+template <class V, class VI>
+static inline void sort_merge4(V & ka, VI & va, V & kb, VI & vb) {
+    kb = sort_permute<3,2,1,0>(kb);
+    vb = sort_permute<3,2,1,0>(vb);
+    // exchange where kb < ka
+    V lo = select(kb < ka, kb, ka), hi = select(kb < ka, ka, kb);
+    VI vlo = select(kb < ka, vb, va);
+    vb = select(kb < ka, va, vb);
+    ka = lo;  kb = hi;  va = vlo;
+    sort_bitonic4(ka, va);
+    sort_bitonic4(kb, vb);
+}
+
+template <class V, class VI>
+static inline void sort_bitonic8(V & k, VI & v) {
+    sort_exchange8<4,5,6,7,8,9,10,11>(k, v);
+    sort_exchange8<2,3,8,9,6,7,12,13>(k, v);
+    sort_exchange8<1,8,3,10,5,12,7,14>(k, v);
+}
+
+template <class V, class VI>
+static inline void sort_network8(V & k, VI & v) {
+    sort_exchange8<1,8,11,2,5,12,15,6>(k, v);
+    sort_exchange8<2,3,8,9,14,15,4,5>(k, v);
+    sort_exchange8<1,8,3,10,13,4,15,6>(k, v);
+    sort_bitonic8(k, v);
+}
+
+template <class V, class VI>
+static inline void sort_merge8(V & ka, VI & va, V & kb, VI & vb) {
+    kb = sort_permute<7,6,5,4,3,2,1,0>(kb);
+    vb = sort_permute<7,6,5,4,3,2,1,0>(vb);
+    // exchange where kb < ka
+    V lo = select(kb < ka, kb, ka), hi = select(kb < ka, ka, kb);
+    VI vlo = select(kb < ka, vb, va);
+    vb = select(kb < ka, va, vb);
+    ka = lo;  kb = hi;  va = vlo;
+    sort_bitonic8(ka, va);
+    sort_bitonic8(kb, vb);
+}
+
+#if MAX_VECTOR_SIZE >= 512
+
+template <class V, class VI>
+static inline void sort_bitonic16(V & k, VI & v) {
+    sort_exchange16<8,9,10,11,12,13,14,15,16,17,18,19,20,21,22,23>(k, v);
+    sort_exchange16<4,5,6,7,16,17,18,19,12,13,14,15,24,25,26,27>(k, v);
+    sort_exchange16<2,3,16,17,6,7,20,21,10,11,24,25,14,15,28,29>(k, v);
+    sort_exchange16<1,16,3,18,5,20,7,22,9,24,11,26,13,28,15,30>(k, v);
+}
+
+template <class V, class VI>
+static inline void sort_network16(V & k, VI & v) {
+    sort_exchange16<1,16,19,2,5,20,23,6,9,24,27,10,13,28,31,14>(k, v);
+    sort_exchange16<2,3,16,17,22,23,4,5,10,11,24,25,30,31,12,13>(k, v);
+    sort_exchange16<1,16,3,18,21,4,23,6,9,24,11,26,29,12,31,14>(k, v);
+    sort_exchange16<4,5,6,7,16,17,18,19,28,29,30,31,8,9,10,11>(k, v);
+    sort_exchange16<2,3,16,17,6,7,20,21,26,27,8,9,30,31,12,13>(k, v);
+    sort_exchange16<1,16,3,18,5,20,7,22,25,8,27,10,29,12,31,14>(k, v);
+    sort_bitonic16(k, v);
+}
+
+template <class V, class VI>
+static inline void sort_merge16(V & ka, VI & va, V & kb, VI & vb) {
+    kb = sort_permute<15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0>(kb);
+    vb = sort_permute<15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0>(vb);
+    // exchange where kb < ka
+    V lo = select(kb < ka, kb, ka), hi = select(kb < ka, ka, kb);
+    VI vlo = select(kb < ka, vb, va);
+    vb = select(kb < ka, va, vb);
+    ka = lo;  kb = hi;  va = vlo;
+    sort_bitonic16(ka, va);
+    sort_bitonic16(kb, vb);
+}
+
+#endif // MAX_VECTOR_SIZE >= 512
+
+
+/*****************************************************************************
+*
+*          Sort vectors
+*
+*****************************************************************************/
+
+// Vec4d with Vec4q values
+static inline Vec4d sort(Vec4d const & a) {
+    Vec4d k = a;  Vec4q v(0);
+    sort_network4(k, v);
+    return k;
+}
+
+static inline void sort_keys(Vec4d & keys, Vec4q & values) {
+    sort_network4(keys, values);
+}
+
+static inline void sort_merge(Vec4d & a, Vec4d & b) {
+    Vec4q va(0), vb(0);
+    sort_merge4(a, va, b, vb);
+}
+
+static inline void sort_merge_keys(Vec4d & ka, Vec4q & va, Vec4d & kb, Vec4q & vb) {
+    sort_merge4(ka, va, kb, vb);
+}
+
+// Vec8f with Vec8i values
+static inline Vec8f sort(Vec8f const & a) {
+    Vec8f k = a;  Vec8i v(0);
+    sort_network8(k, v);
+    return k;
+}
+
+static inline void sort_keys(Vec8f & keys, Vec8i & values) {
+    sort_network8(keys, values);
+}
+
+static inline void sort_merge(Vec8f & a, Vec8f & b) {
+    Vec8i va(0), vb(0);
+    sort_merge8(a, va, b, vb);
+}
+
+static inline void sort_merge_keys(Vec8f & ka, Vec8i & va, Vec8f & kb, Vec8i & vb) {
+    sort_merge8(ka, va, kb, vb);
+}
+
+// Vec8i with Vec8i values
+static inline Vec8i sort(Vec8i const & a) {
+    Vec8i k = a;  Vec8i v(0);
+    sort_network8(k, v);
+    return k;
+}
+
+static inline void sort_keys(Vec8i & keys, Vec8i & values) {
+    sort_network8(keys, values);
+}
+
+static inline void sort_merge(Vec8i & a, Vec8i & b) {
+    Vec8i va(0), vb(0);
+    sort_merge8(a, va, b, vb);
+}
+
+static inline void sort_merge_keys(Vec8i & ka, Vec8i & va, Vec8i & kb, Vec8i & vb) {
+    sort_merge8(ka, va, kb, vb);
+}
+
+#if MAX_VECTOR_SIZE >= 512
+
+// Vec8d with Vec8q values
+static inline Vec8d sort(Vec8d const & a) {
+    Vec8d k = a;  Vec8q v(0);
+    sort_network8(k, v);
+    return k;
+}
+
+static inline void sort_keys(Vec8d & keys, Vec8q & values) {
+    sort_network8(keys, values);
+}
+
+static inline void sort_merge(Vec8d & a, Vec8d & b) {
+    Vec8q va(0), vb(0);
+    sort_merge8(a, va, b, vb);
+}
+
+static inline void sort_merge_keys(Vec8d & ka, Vec8q & va, Vec8d & kb, Vec8q & vb) {
+    sort_merge8(ka, va, kb, vb);
+}
+
+// Vec16f with Vec16i values
+static inline Vec16f sort(Vec16f const & a) {
+    Vec16f k = a;  Vec16i v(0);
+    sort_network16(k, v);
+    return k;
+}
+
+static inline void sort_keys(Vec16f & keys, Vec16i & values) {
+    sort_network16(keys, values);
+}
+
+static inline void sort_merge(Vec16f & a, Vec16f & b) {
+    Vec16i va(0), vb(0);
+    sort_merge16(a, va, b, vb);
+}
+
+static inline void sort_merge_keys(Vec16f & ka, Vec16i & va, Vec16f & kb, Vec16i & vb) {
+    sort_merge16(ka, va, kb, vb);
+}
+
+// Vec16i with Vec16i values
+static inline Vec16i sort(Vec16i const & a) {
+    Vec16i k = a;  Vec16i v(0);
+    sort_network16(k, v);
+    return k;
+}
+
+static inline void sort_keys(Vec16i & keys, Vec16i & values) {
+    sort_network16(keys, values);
+}
+
+static inline void sort_merge(Vec16i & a, Vec16i & b) {
+    Vec16i va(0), vb(0);
+    sort_merge16(a, va, b, vb);
+}
+
+static inline void sort_merge_keys(Vec16i & ka, Vec16i & va, Vec16i & kb, Vec16i & vb) {
+    sort_merge16(ka, va, kb, vb);
+}
+
+#endif // MAX_VECTOR_SIZE >= 512
+
+
+/*****************************************************************************
+*
+*          Partition vectors
+*
+*****************************************************************************/
+
+// sort_compress: permute keys k and values v so that the elements where m
+// is true come first and the rest last, both in the original order.
+// The values are permuted only if kv is nonzero.
+// Returns the number of true elements in m
+
+// permutation index for 4 elements from mask bits
+static inline Vec4q sort_compress_index4(int bits) {
+    static const int64_t table[16*4] = {
+        0, 1, 2, 3,
+        0, 1, 2, 3,
+        1, 0, 2, 3,
+        0, 1, 2, 3,
+        2, 0, 1, 3,
+        0, 2, 1, 3,
+        1, 2, 0, 3,
+        0, 1, 2, 3,
+        3, 0, 1, 2,
+        0, 3, 1, 2,
+        1, 3, 0, 2,
+        0, 1, 3, 2,
+        2, 3, 0, 1,
+        0, 2, 3, 1,
+        1, 2, 3, 0,
+        0, 1, 2, 3,
+    };
+    return Vec4q().load(table + bits * 4);
+}
+
+// permutation index for 8 elements from mask bits. The table has 4 bits for each index
+static inline Vec8i sort_compress_index8(int bits) {
+    static const uint32_t table[256] = {
+        0x76543210, 0x76543210, 0x76543201, 0x76543210, 0x76543102, 0x76543120, 0x76543021, 0x76543210,
+        0x76542103, 0x76542130, 0x76542031, 0x76542310, 0x76541032, 0x76541320, 0x76540321, 0x76543210,
+        0x76532104, 0x76532140, 0x76532041, 0x76532410, 0x76531042, 0x76531420, 0x76530421, 0x76534210,
+        0x76521043, 0x76521430, 0x76520431, 0x76524310, 0x76510432, 0x76514320, 0x76504321, 0x76543210,
+        0x76432105, 0x76432150, 0x76432051, 0x76432510, 0x76431052, 0x76431520, 0x76430521, 0x76435210,
+        0x76421053, 0x76421530, 0x76420531, 0x76425310, 0x76410532, 0x76415320, 0x76405321, 0x76453210,
+        0x76321054, 0x76321540, 0x76320541, 0x76325410, 0x76310542, 0x76315420, 0x76305421, 0x76354210,
+        0x76210543, 0x76215430, 0x76205431, 0x76254310, 0x76105432, 0x76154320, 0x76054321, 0x76543210,
+        0x75432106, 0x75432160, 0x75432061, 0x75432610, 0x75431062, 0x75431620, 0x75430621, 0x75436210,
+        0x75421063, 0x75421630, 0x75420631, 0x75426310, 0x75410632, 0x75416320, 0x75406321, 0x75463210,
+        0x75321064, 0x75321640, 0x75320641, 0x75326410, 0x75310642, 0x75316420, 0x75306421, 0x75364210,
+        0x75210643, 0x75216430, 0x75206431, 0x75264310, 0x75106432, 0x75164320, 0x75064321, 0x75643210,
+        0x74321065, 0x74321650, 0x74320651, 0x74326510, 0x74310652, 0x74316520, 0x74306521, 0x74365210,
+        0x74210653, 0x74216530, 0x74206531, 0x74265310, 0x74106532, 0x74165320, 0x74065321, 0x74653210,
+        0x73210654, 0x73216540, 0x73206541, 0x73265410, 0x73106542, 0x73165420, 0x73065421, 0x73654210,
+        0x72106543, 0x72165430, 0x72065431, 0x72654310, 0x71065432, 0x71654320, 0x70654321, 0x76543210,
+        0x65432107, 0x65432170, 0x65432071, 0x65432710, 0x65431072, 0x65431720, 0x65430721, 0x65437210,
+        0x65421073, 0x65421730, 0x65420731, 0x65427310, 0x65410732, 0x65417320, 0x65407321, 0x65473210,
+        0x65321074, 0x65321740, 0x65320741, 0x65327410, 0x65310742, 0x65317420, 0x65307421, 0x65374210,
+        0x65210743, 0x65217430, 0x65207431, 0x65274310, 0x65107432, 0x65174320, 0x65074321, 0x65743210,
+        0x64321075, 0x64321750, 0x64320751, 0x64327510, 0x64310752, 0x64317520, 0x64307521, 0x64375210,
+        0x64210753, 0x64217530, 0x64207531, 0x64275310, 0x64107532, 0x64175320, 0x64075321, 0x64753210,
+        0x63210754, 0x63217540, 0x63207541, 0x63275410, 0x63107542, 0x63175420, 0x63075421, 0x63754210,
+        0x62107543, 0x62175430, 0x62075431, 0x62754310, 0x61075432, 0x61754320, 0x60754321, 0x67543210,
+        0x54321076, 0x54321760, 0x54320761, 0x54327610, 0x54310762, 0x54317620, 0x54307621, 0x54376210,
+        0x54210763, 0x54217630, 0x54207631, 0x54276310, 0x54107632, 0x54176320, 0x54076321, 0x54763210,
+        0x53210764, 0x53217640, 0x53207641, 0x53276410, 0x53107642, 0x53176420, 0x53076421, 0x53764210,
+        0x52107643, 0x52176430, 0x52076431, 0x52764310, 0x51076432, 0x51764320, 0x50764321, 0x57643210,
+        0x43210765, 0x43217650, 0x43207651, 0x43276510, 0x43107652, 0x43176520, 0x43076521, 0x43765210,
+        0x42107653, 0x42176530, 0x42076531, 0x42765310, 0x41076532, 0x41765320, 0x40765321, 0x47653210,
+        0x32107654, 0x32176540, 0x32076541, 0x32765410, 0x31076542, 0x31765420, 0x30765421, 0x37654210,
+        0x21076543, 0x21765430, 0x20765431, 0x27654310, 0x10765432, 0x17654320, 0x07654321, 0x76543210,
+    };
+    // shift each index into the upper 4 bits by multiplication, then down
+    Vec8i t = Vec8i(table[bits]) * Vec8i(1<<28, 1<<24, 1<<20, 1<<16, 1<<12, 1<<8, 1<<4, 1);
+    return Vec8i(Vec8ui(t) >> 28);
+}
+
+static inline int sort_compress(Vec4d & k, Vec4q & v, Vec4db const & m, int kv) {
+    int bits = to_bits(m);
+    Vec4q index = sort_compress_index4(bits);
+    k = lookup4(index, k);
+    if (kv) v = lookup4(index, v);
+    return vml_popcnt(bits);
+}
+
+static inline int sort_compress(Vec8f & k, Vec8i & v, Vec8fb const & m, int kv) {
+    int bits = to_bits(m);
+    Vec8i index = sort_compress_index8(bits);
+    k = lookup8(index, k);
+    if (kv) v = lookup8(index, v);
+    return vml_popcnt(bits);
+}
+
+static inline int sort_compress(Vec8i & k, Vec8i & v, Vec8ib const & m, int kv) {
+    int bits = to_bits(m);
+    Vec8i index = sort_compress_index8(bits);
+    k = lookup8(index, k);
+    if (kv) v = lookup8(index, v);
+    return vml_popcnt(bits);
+}
+
+#if MAX_VECTOR_SIZE >= 512 && INSTRSET >= 9
+// AVX512: compress the true elements to the low end and expand the false elements into the high end
+
+static inline int sort_compress(Vec8d & k, Vec8q & v, Vec8db const & m, int kv) {
+    __mmask8 mt = __mmask8(m), mf = __mmask8(~mt);
+    int n = vml_popcnt(mt);
+    __mmask8 mh = __mmask8(0xFF << n);
+    k = _mm512_mask_expand_pd(_mm512_maskz_compress_pd(mt, k), mh, _mm512_maskz_compress_pd(mf, k));
+    if (kv) v = _mm512_mask_expand_epi64(_mm512_maskz_compress_epi64(mt, v), mh, _mm512_maskz_compress_epi64(mf, v));
+    return n;
+}
+
+static inline int sort_compress(Vec16f & k, Vec16i & v, Vec16fb const & m, int kv) {
+    __mmask16 mt = __mmask16(m), mf = __mmask16(~mt);
+    int n = vml_popcnt(mt);
+    __mmask16 mh = __mmask16(0xFFFF << n);
+    k = _mm512_mask_expand_ps(_mm512_maskz_compress_ps(mt, k), mh, _mm512_maskz_compress_ps(mf, k));
+    if (kv) v = _mm512_mask_expand_epi32(_mm512_maskz_compress_epi32(mt, v), mh, _mm512_maskz_compress_epi32(mf, v));
+    return n;
+}
+
+static inline int sort_compress(Vec16i & k, Vec16i & v, Vec16ib const & m, int kv) {
+    __mmask16 mt = __mmask16(m), mf = __mmask16(~mt);
+    int n = vml_popcnt(mt);
+    __mmask16 mh = __mmask16(0xFFFF << n);
+    k = _mm512_mask_expand_epi32(_mm512_maskz_compress_epi32(mt, k), mh, _mm512_maskz_compress_epi32(mf, k));
+    if (kv) v = _mm512_mask_expand_epi32(_mm512_maskz_compress_epi32(mt, v), mh, _mm512_maskz_compress_epi32(mf, v));
+    return n;
+}
+
+#endif // MAX_VECTOR_SIZE >= 512 && INSTRSET >= 9
+
+
+/*****************************************************************************
+*
+*          Sort arrays
+*
+*****************************************************************************/
+
+// Vector types used for sorting arrays
+#if MAX_VECTOR_SIZE >= 512 && INSTRSET >= 9
+typedef Vec16f sort_vecf;                        // float keys
+typedef Vec16i sort_veci;                        // int32_t keys and values
+typedef Vec8d  sort_vecd;                        // double keys
+typedef Vec8q  sort_vecq;                        // int64_t values
+#else
+typedef Vec8f  sort_vecf;
+typedef Vec8i  sort_veci;
+typedef Vec4d  sort_vecd;
+typedef Vec4q  sort_vecq;
+#endif
+
+// Sort array of n <= 2*N elements with sorting networks, where N is the vector size.
+// The vectors are padded with maxval, which must be the highest possible key.
+// V is key vector type, VI is value vector type, T is key type, TI is value type.
+// The values q are used only if KV is nonzero
+template <class V, class VI, int KV, class T, class TI>
+static inline void sort_array_small(T * p, TI * q, int n, T maxval) {
+    const int N = sizeof(V) / sizeof(T);      // vector size
+    T  kt[2*N];                                  // keys padded with maxval
+    TI vt[2*N];                                  // values
+    int i;
+    if (n < 2) return;
+    for (i = 0; i < 2*N; i++) {
+        kt[i] = i < n ? p[i] : maxval;
+        if (KV) vt[i] = i < n ? q[i] : 0;
+    }
+    V  ka = V().load(kt),  kb = V().load(kt + N);
+    VI va(0), vb(0);
+    if (KV) {
+        va.load(vt);  vb.load(vt + N);
+    }
+    if (n <= N) {
+        if (KV) sort_keys(ka, va); else ka = sort(ka);
+    }
+    else if (KV) {
+        sort_keys(ka, va);  sort_keys(kb, vb);
+        sort_merge_keys(ka, va, kb, vb);
+    }
+    else {
+        kb = sort(kb);  ka = sort(ka);
+        sort_merge(ka, kb);
+    }
+    ka.store(kt);  kb.store(kt + N);
+    if (KV) {
+        va.store(vt);  vb.store(vt + N);
+        if (kt[n-1] == maxval) {
+            // Keys equal to maxval may have been mixed with the padding.
+            // Get the values for these keys from the input
+            int j = n;
+            while (j > 0 && kt[j-1] == maxval) j--;
+            for (i = 0; i < n; i++) {
+                if (p[i] == maxval) vt[j++] = q[i];
+            }
+        }
+    }
+    for (i = 0; i < n; i++) {
+        p[i] = kt[i];
+        if (KV) q[i] = vt[i];
+    }
+}
+
+// Partition array of n >= 2*N elements so that the keys below pivot come first.
+// Keys equal to pivot come first if orequal is true.
+// Returns the number of elements in the first part.
+// The first and the last vector are saved in registers to make space, then one
+// vector at a time is read from the end with the least free space, partitioned
+// and written to both ends of the free space.
+template <class V, class VI, int KV, class T, class TI>
+static inline int sort_partition(T * p, TI * q, int n, T pivot, bool orequal) {
+    const int N = sizeof(V) / sizeof(T);      // vector size
+    V  piv(pivot);
+    V  kl = V().load(p), kr = V().load(p + n - N), kx;
+    VI vl(0), vr(0), vx(0);
+    if (KV) {
+        vl.load(q);  vr.load(q + n - N);
+    }
+    int rl = N, rr = n - N;                      // elements not read yet: rl .. rr-1
+    int wl = 0, wr = n;                          // free space: wl .. rl-1 and rr .. wr-1
+    int i, c;
+    while (rr - rl >= N) {
+        if (rl - wl <= wr - rr) {
+            i = rl;  rl += N;
+        }
+        else {
+            rr -= N;  i = rr;
+        }
+        kx.load(p + i);
+        if (KV) vx.load(q + i);
+        c = sort_compress(kx, vx, orequal ? kx <= piv : kx < piv, KV);
+        // there are at least N free elements at each end
+        kx.store(p + wl);  kx.store(p + wr - N);
+        if (KV) {
+            vx.store(q + wl);  vx.store(q + wr - N);
+        }
+        wl += c;  wr -= N - c;
+    }
+    // The remaining elements and the two saved vectors fill the free space exactly
+    T  kt[3*N];
+    TI vt[3*N];
+    int r = rr - rl;
+    for (i = 0; i < r; i++) {
+        kt[i] = p[rl + i];
+        if (KV) vt[i] = q[rl + i];
+    }
+    kl.store(kt + r);  kr.store(kt + r + N);
+    if (KV) {
+        vl.store(vt + r);  vr.store(vt + r + N);
+    }
+    for (i = 0; i < r + 2*N; i++) {
+        c = (orequal ? kt[i] <= pivot : kt[i] < pivot) ? wl++ : --wr;
+        p[c] = kt[i];
+        if (KV) q[c] = vt[i];
+    }
+    return wl;
+}
+
+// Move element r of a heap with n elements down to its place. The parent is not below its children.
+// The values q are used only if KV is nonzero
+template <int KV, class T, class TI>
+static inline void sort_heap_sift(T * p, TI * q, int r, int n) {
+    T  kt = p[r];
+    TI vt = KV ? q[r] : 0;
+    int j;
+    while ((j = 2 * r + 1) < n) {
+        if (j + 1 < n && p[j] < p[j+1]) j++;     // biggest child
+        if (!(kt < p[j])) break;
+        p[r] = p[j];
+        if (KV) q[r] = q[j];
+        r = j;
+    }
+    p[r] = kt;
+    if (KV) q[r] = vt;
+}
+
+// Heapsort, used by sort_array_quick if the partitions are too unbalanced
+template <int KV, class T, class TI>
+static inline void sort_array_heap(T * p, TI * q, int n) {
+    int i;
+    // make a heap with the maximum at p[0]
+    for (i = n / 2 - 1; i >= 0; i--) {
+        sort_heap_sift<KV>(p, q, i, n);
+    }
+    // move the maximum to the end and make a heap of the rest
+    for (i = n - 1; i > 0; i--) {
+        T kt = p[0];  p[0] = p[i];  p[i] = kt;
+        if (KV) {
+            TI vt = q[0];  q[0] = q[i];  q[i] = vt;
+        }
+        sort_heap_sift<KV>(p, q, 0, i);
+    }
+}
+
+// Maximum recursion depth of sort_array_quick before it switches to heapsort
+static inline int sort_depth(int n) {
+    int d = 0;
+    while (n > 1) {
+        n >>= 1;  d += 2;
+    }
+    return d;
+}
+
+// Quicksort with vectorized partitioning. Small partitions are sorted with sorting networks.
+// Bad pivots cannot make the time quadratic because the rest of a partition is sorted
+// with heapsort when depth has been used up
+template <class V, class VI, int KV, class T, class TI>
+static inline void sort_array_quick(T * p, TI * q, int n, T maxval, int depth) {
+    const int N = sizeof(V) / sizeof(T);      // vector size
+    int m;
+    while (n > 2*N) {
+        if (--depth < 0) {
+            sort_array_heap<KV>(p, q, n);
+            return;
+        }
+        // pivot is median of first, middle and last element
+        T a = p[0], b = p[n/2], c = p[n-1];
+        T pivot = a < b ? (b < c ? b : (a < c ? c : a)) : (a < c ? a : (b < c ? c : b));
+        m = sort_partition<V, VI, KV>(p, q, n, pivot, false);
+        if (m == 0) {
+            // no keys below pivot. Put the keys equal to pivot first. They are finished
+            m = sort_partition<V, VI, KV>(p, q, n, pivot, true);
+            p += m;  n -= m;
+            if (KV) q += m;
+        }
+        else if (m < n - m) {
+            // sort the smallest part recursively and the biggest part in this loop
+            sort_array_quick<V, VI, KV>(p, q, m, maxval, depth);
+            p += m;  n -= m;
+            if (KV) q += m;
+        }
+        else {
+            sort_array_quick<V, VI, KV>(p + m, KV ? q + m : q, n - m, maxval, depth);
+            n = m;
+        }
+    }
+    sort_array_small<V, VI, KV>(p, q, n, maxval);
+}
+
+// highest possible key of each type, used for padding
+static inline float sort_maxval(float) {
+    union {
+        uint32_t i;
+        float    f;
+    } u;
+    u.i = 0x7F800000;                            // infinity
+    return u.f;
+}
+
+static inline double sort_maxval(double) {
+    union {
+        uint64_t i;
+        double   f;
+    } u;
+    u.i = 0x7FF0000000000000ULL;                 // infinity
+    return u.f;
+}
+
+static inline int32_t sort_maxval(int32_t) {
+    return 0x7FFFFFFF;
+}
+
+// Sort arrays of keys
+static inline void sort_array(float * p, int n) {
+    sort_array_quick<sort_vecf, sort_veci, 0>(p, (int32_t*)0, n, sort_maxval(0.f), sort_depth(n));
+}
+
+static inline void sort_array(int32_t * p, int n) {
+    sort_array_quick<sort_veci, sort_veci, 0>(p, (int32_t*)0, n, sort_maxval(int32_t(0)), sort_depth(n));
+}
+
+static inline void sort_array(double * p, int n) {
+    sort_array_quick<sort_vecd, sort_vecq, 0>(p, (int64_t*)0, n, sort_maxval(0.), sort_depth(n));
+}
+
+// Sort arrays of keys and move values together with the keys
+static inline void sort_array(float * keys, int32_t * values, int n) {
+    sort_array_quick<sort_vecf, sort_veci, 1>(keys, values, n, sort_maxval(0.f), sort_depth(n));
+}
+
+static inline void sort_array(int32_t * keys, int32_t * values, int n) {
+    sort_array_quick<sort_veci, sort_veci, 1>(keys, values, n, sort_maxval(int32_t(0)), sort_depth(n));
+}
+
+static inline void sort_array(double * keys, int64_t * values, int n) {
+    sort_array_quick<sort_vecd, sort_vecq, 1>(keys, values, n, sort_maxval(0.), sort_depth(n));
+}
+
+#endif // VECTORSORT_H